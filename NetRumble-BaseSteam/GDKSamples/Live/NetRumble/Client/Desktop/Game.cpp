@@ -29,6 +29,7 @@ Game::~Game()
 	CleanupUser();
 	Managers::Shutdown();
 	WaitForAndCleanupHandles();
+	DebugShutdown();
 }
 
 // Initialize the Direct3D resources required to run.
@@ -44,9 +45,8 @@ void Game::Initialize(HWND window)
 	DebugInit();
 #endif
 
-	// Lock the game to 60FPS
-	m_timer.SetFixedTimeStep(true);
-	m_timer.SetTargetElapsedSeconds(1.0 / 60);
+	// Frames follow the display; only the world keeps a fixed step, on m_simulationClock
+	m_timer.SetFixedTimeStep(false);
 
 	Managers::Initialize();
 
@@ -67,6 +67,43 @@ void Game::Initialize(HWND window)
 
 	Managers::Get<ScreenManager>()->AddBackgroundScreen(std::make_unique<StarfieldScreen>());
 	Managers::Get<ScreenManager>()->AddForegroundScreen(std::make_unique<DebugOverlayScreen>());
+
+	RegisterFrameSystems();
+}
+
+// Registers every per-frame system once, in the order they run. Particles run after the
+// screens so effects spawned by this frame's world update are advanced in the same frame.
+// Send runs last so everything the frame queued leaves in one bundle per connection.
+void Game::RegisterFrameSystems()
+{
+	m_scheduler.AddSystem("AsyncTasks", [](DX::StepTimer const&) { Managers::Get<AsyncTaskManager>()->Tick(); });
+	m_scheduler.AddSystem("Screens", [](DX::StepTimer const& timer) { Managers::Get<ScreenManager>()->Update(timer); });
+	m_scheduler.AddSystem("Input", [](DX::StepTimer const&) { Managers::Get<InputManager>()->Update(); });
+	m_scheduler.AddSystem("Audio", [](DX::StepTimer const&) { Managers::Get<AudioManager>()->Tick(); });
+	m_scheduler.AddSystem("Particles", [](DX::StepTimer const& timer)
+		{
+			Managers::Get<ParticleEffectManager>()->Update(static_cast<float_t>(timer.GetElapsedSeconds()));
+		});
+	m_scheduler.AddSystem("GameState", [](DX::StepTimer const&) { Managers::Get<GameStateManager>()->Update(); });
+	m_scheduler.AddSystem("Online", [](DX::StepTimer const& timer)
+		{
+			Managers::Get<OnlineManager>()->Tick(static_cast<float_t>(timer.GetElapsedSeconds()));
+		});
+	m_scheduler.AddSystem("Server", [this](DX::StepTimer const&)
+		{
+			if (GetGameServer())
+			{
+				GetGameServer()->Tick();
+			}
+		});
+	m_scheduler.AddSystem("Send", [this](DX::StepTimer const&)
+		{
+			Managers::Get<OnlineManager>()->FlushGameMessages();
+			if (GetGameServer())
+			{
+				GetGameServer()->FlushMessages();
+			}
+		});
 }
 
 // Executes the basic game loop.
@@ -80,7 +117,7 @@ void Game::Tick()
 	Render();
 }
 
-void NetRumble::Game::ProcessGameNetworkMessage(uint64_t steamID, GameMessage* message)
+void NetRumble::Game::ProcessGameNetworkMessage(uint64_t steamID, const GameMessageView& message)
 {
 	UNREFERENCED_PARAMETER(steamID);
 	UNREFERENCED_PARAMETER(message);
@@ -89,16 +126,7 @@ void NetRumble::Game::ProcessGameNetworkMessage(uint64_t steamID, GameMessage* m
 // Updates the world.
 void Game::Update(DX::StepTimer const& timer)
 {
-	Managers::Get<AsyncTaskManager>()->Tick();
-	Managers::Get<ScreenManager>()->Update(timer);
-	Managers::Get<InputManager>()->Update();
-	Managers::Get<AudioManager>()->Tick();
-	Managers::Get<ParticleEffectManager>()->Update(static_cast<float_t>(timer.GetElapsedSeconds()));
-	Managers::Get<GameStateManager>()->Update();
-	Managers::Get<OnlineManager>()->Tick(static_cast<float_t>(timer.GetElapsedSeconds()));
-	if (GetGameServer()) {
-		GetGameServer()->Tick();
-	}
+	m_scheduler.Update(timer);
 }
 
 // Draws the scene.
@@ -150,6 +178,7 @@ void Game::OnResuming()
 	Managers::Get<ScreenManager>()->Resume();
 
 	m_timer.ResetElapsedTime();
+	m_simulationClock.ResetLeftOver();
 
 	// We need to go back to the start menu (this already waits for networking connectivity)
 	Managers::Get<GameStateManager>()->SwitchToState(GameState::MainMenu);
@@ -230,19 +259,6 @@ std::shared_ptr<PlayerState> Game::GetPlayerState(uint64_t peer)
 	return nullptr;
 }
 
-std::shared_ptr<PlayerState> Game::GetLocalPlayerState()
-{
-	for (const auto& peer : m_peers)
-	{
-		if (peer.second->IsLocalPlayer)
-		{
-			return peer.second;
-		}
-	}
-
-	return nullptr;
-}
-
 void Game::SetPlayerState(uint64_t id, std::shared_ptr<PlayerState> state)
 {
 	std::shared_ptr<PlayerState> peer = GetPlayerState(id);
@@ -256,6 +272,8 @@ void Game::SetPlayerState(uint64_t id, std::shared_ptr<PlayerState> state)
 	{
 		m_peers[id] = state;
 	}
+
+	PlayersChanged();
 }
 
 void Game::ClearPlayerScores()
@@ -271,6 +289,7 @@ void NetRumble::Game::RemovePeers(uint64 playerId)
 	if (m_peers[playerId] && m_peers[playerId]->InGame == false)
 	{
 		m_peers.erase(playerId);
+		PlayersChanged();
 	}
 }
 
@@ -298,6 +317,7 @@ bool NetRumble::Game::RemovePlayerFromGamePeers(uint64 playerId)
 		{
 			DEBUGLOG("m_peers[%d] has left the game\n", playerId);
 			m_peers.erase(playerId);
+			PlayersChanged();
 			return true;
 		}
 		else
@@ -326,6 +346,7 @@ bool NetRumble::Game::RemovePlayerFromGamePeers(std::shared_ptr<PlayerState> pla
 	{
 		DEBUGLOG("m_peers[%d] has left the game\n", player->PeerId);
 		m_peers.erase(player->PeerId);
+		PlayersChanged();
 		return true;
 	}
 }
@@ -342,6 +363,7 @@ void NetRumble::Game::AddPlayerToLobbyPeers(uint64 playerId)
 	player->PeerId = playerId;
 
 	m_peers[player->PeerId] = player;
+	PlayersChanged();
 }
 
 void NetRumble::Game::AddPlayerToLobbyPeers(std::shared_ptr<PlayerState> player)
@@ -349,6 +371,7 @@ void NetRumble::Game::AddPlayerToLobbyPeers(std::shared_ptr<PlayerState> player)
 	if (player)
 	{
 		m_peers[player->PeerId] = player;
+		PlayersChanged();
 	}
 }
 
@@ -369,6 +392,8 @@ void NetRumble::Game::DeleteOtherPlayerInPeersAndExitLobby()
 			item++;
 		}
 	}
+
+	PlayersChanged();
 }
 
 void Game::ServerPrepareGameEnviroment()
@@ -440,15 +465,23 @@ void Game::DrawWorld(float elapsedTime)
 {
 	if (m_world->IsInitialized())
 	{
+		m_world->SetDrawBlend(m_simulationClock.GetBlend());
 		m_world->Draw(elapsedTime);
 	}
 }
 
 void Game::UpdateWorld(float totalTime, float elapsedTime)
 {
+	UNREFERENCED_PARAMETER(totalTime);
+
 	if (m_world->IsInitialized())
 	{
-		m_world->Update(totalTime, elapsedTime);
+		// However long the frame was, the world only ever moves in whole steps of the same length
+		FrameScheduler::Section section = m_scheduler.Measure("World");
+		m_simulationClock.Advance(DX::StepTimer::SecondsToTicks(elapsedTime), [&]()
+			{
+				m_world->Update(m_simulationClock.GetTotalSeconds(), m_simulationClock.GetStepSeconds());
+			});
 	}
 }
 
@@ -464,6 +497,11 @@ std::vector<std::shared_ptr<PlayerState>> Game::GetAllPlayerStates()
 	return players;
 }
 
+void Game::PlayersChanged()
+{
+	m_roster.Rebuild(m_peers);
+}
+
 void Game::ResetGameplayData()
 {
 	// Reset any existing game world to its defaults
@@ -530,6 +568,7 @@ void Game::LocalPlayerInitialize()
 	Managers::Get<OnlineManager>()->SetLocalSteamID(SteamUser()->GetSteamID());
 
 	m_peers[localPlayer->PeerId] = localPlayer;
+	PlayersChanged();
 }
 
 void Game::CleanupUser()
@@ -552,6 +591,7 @@ void Game::CleanupUser()
 	{
 		m_peers.erase(Managers::Get<OnlineManager>()->GetNetworkId());
 		m_localPlayerName.clear();
+		PlayersChanged();
 	}
 
 	HANDLE shutdownEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
@@ -2,6 +2,9 @@
 #pragma once
 
 #include "pch.h"
+#include "FrameScheduler.h"
+#include "PlayerRoster.h"
+#include "SimulationClock.h"
 
 namespace NetRumble
 {
@@ -45,8 +48,9 @@ namespace NetRumble
 
 		// Game Player Management
 		std::shared_ptr<PlayerState> GetPlayerState(uint64_t peer);
-		std::shared_ptr<PlayerState> GetLocalPlayerState();
+		inline const std::shared_ptr<PlayerState>& GetLocalPlayerState() const { return m_roster.LocalPlayer(); }
 		void SetPlayerState(uint64_t id, std::shared_ptr<PlayerState> state);
+		// A copy for callers that keep players; per-frame code walks GetPlayers instead
 		std::vector<std::shared_ptr<PlayerState>> GetAllPlayerStates();
 		void ClearPlayerScores();
 		bool RemovePlayerFromLobbyPeers(uint64 playerId);
@@ -66,10 +70,19 @@ namespace NetRumble
 		inline DirectX::XMVECTORF32 GetWinningColor() const { return m_world->WinningColor; }
 
 		inline std::unique_ptr<World>& GetWorld() { return m_world; }
-		inline std::map<uint64_t, std::shared_ptr<PlayerState>>& GetPeers() { return m_peers; }
+		inline FrameScheduler& GetScheduler() { return m_scheduler; }
+		inline const std::map<uint64_t, std::shared_ptr<PlayerState>>& GetPeers() const { return m_peers; }
+
+		// Every player, and the local one, without allocating; see PlayerRoster
+		inline PlayerRoster::View GetPlayers() const { return m_roster.Players(); }
+		inline PlayerState* GetLocalPlayer() const { return m_roster.LocalPlayer().get(); }
 
 		const uint64 GetGameTickCount() const { return m_timer.GetTotalTicks(); }
 
+		// World updates per second, whatever the frame rate; a 30 Hz host halves the simulation's cost
+		inline uint32_t GetSimulationRate() const { return m_simulationClock.GetStepsPerSecond(); }
+		inline void SetSimulationRate(uint32_t stepsPerSecond) { m_simulationClock.SetStepsPerSecond(stepsPerSecond); }
+
 		// Game server is created by a local client and all the players who join this server will be connected via Steam P2P network
 		// since we don't need a dedicated server and the max players number per server (2-16) is relatively small
 		// If current client is the host of the game server, m_server will not be nullptr
@@ -87,13 +100,17 @@ namespace NetRumble
 		void WaitForAndCleanupHandles();
 
 		// Checks for any incoming network data, then dispatches it
-		void ProcessGameNetworkMessage(uint64_t steamID, GameMessage* message);
+		void ProcessGameNetworkMessage(uint64_t steamID, const GameMessageView& message);
 
+		void RegisterFrameSystems();
 		void Update(DX::StepTimer const& timer);
 		void Render();
 
 		void PrefetchContent();
 
+		// Called after every change to m_peers
+		void PlayersChanged();
+
 		uint32_t m_signInCallbackToken{ 0 };
 		uint32_t m_signOutCallbackToken{ 0 };
 
@@ -110,6 +127,7 @@ namespace NetRumble
 		// Players
 		std::string m_localPlayerName;
 		std::map<uint64_t, std::shared_ptr<PlayerState>> m_peers;
+		PlayerRoster m_roster;
 
 		// Server info
 		// Server we create as the host, will be nullptr if the server was not created by us
@@ -117,13 +135,19 @@ namespace NetRumble
 		std::unique_ptr<NetRumbleServer> m_server;
 
 		// List of steamIDs for each player
-		CSteamID m_SteamIDPlayers[MAX_PLAYERS_PER_SERVER];
+		CSteamID m_SteamIDPlayers[MAX_SERVER_SLOTS];
 
 		// Time the last state transition occurred (so we can count-down round restarts)
 		uint64 m_stateTransitionTime;
 
 		// Rendering loop timer.
 		DX::StepTimer m_timer;
+
+		// Steps the world at its own fixed rate within the rendered frames
+		SimulationClock m_simulationClock;
+
+		// Per-frame system updates and their timings
+		FrameScheduler m_scheduler;
 	};
 }
 
@@ -106,6 +106,26 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 	const char* pServerAddress, * pLobbyID;
 	char szCommandLine[1024] = {};
 	WideCharToMultiByte(CP_ACP, 0, lpCmdLine, -1, szCommandLine, sizeof(szCommandLine) / sizeof(szCommandLine[0]), nullptr, nullptr);
+
+	// -network-thread moves game traffic off the game thread, to compare against pumping it inline
+	if (strstr(szCommandLine, "-network-thread") != nullptr)
+	{
+		Managers::Get<OnlineManager>()->SetNetworkThreadEnabled(true);
+	}
+
+	// -max-players N sizes the lobby and game server this client hosts, up to MAX_SERVER_SLOTS
+	if (const char* maxPlayers = strstr(szCommandLine, "-max-players "))
+	{
+		Managers::Get<OnlineManager>()->SetMaxPlayersPerServer(static_cast<uint32>(strtoul(maxPlayers + strlen("-max-players "), nullptr, 10)));
+	}
+
+	// -tick-rate N steps the world N times a second, however fast frames are drawn. Peers in
+	// a rollback match must all use the same rate.
+	if (const char* tickRate = strstr(szCommandLine, "-tick-rate "))
+	{
+		g_game->SetSimulationRate(static_cast<uint32_t>(strtoul(tickRate + strlen("-tick-rate "), nullptr, 10)));
+	}
+
 	if (!ParseCommandLine(szCommandLine, &pServerAddress, &pLobbyID))
 	{
 		if (SteamApps()->GetLaunchCommandLine(szCommandLine, sizeof(szCommandLine)) > 0)
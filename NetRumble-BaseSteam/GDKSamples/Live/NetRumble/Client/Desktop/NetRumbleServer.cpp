@@ -2,15 +2,24 @@
 
 using namespace NetRumble;
 
-NetRumbleServer::NetRumbleServer() noexcept :
+NetRumbleServer::NetRumbleServer(uint32 maxPlayers) :
+	m_maxPlayers(std::clamp<uint32>(maxPlayers, 1, MAX_SERVER_SLOTS)),
 	m_connectedToSteam(false),
+	m_playerScores(m_maxPlayers, 0),
 	m_lastGameWinner(0),
 	m_lastServerUpdateTick(0),
 	m_playerCount(0),
-	m_gameState(ServerGameState::SvrGameStateWaitingPlayers)
+	m_gameState(ServerGameState::SvrGameStateWaitingPlayers),
+	m_clientData(m_maxPlayers),
+	m_pendingClientData(m_maxPlayers),
+	m_slots(m_maxPlayers),
+	m_bundler([](uint64_t connection, int sendFlags, DataBufferView message)
+		{
+			SteamGameServerNetworkingSockets()->SendMessageToConnection(static_cast<HSteamNetConnection>(connection), message.data(), static_cast<uint32>(message.size()), sendFlags, nullptr);
+		})
 {
 	// Seed random num generator
-	srand((uint32)time(nullptr));
+	RandomMath::Seed((uint32)time(nullptr));
 
 	const char* pchGameDir = "NetRumble";
 
@@ -45,10 +54,6 @@ NetRumbleServer::NetRumbleServer() noexcept :
 		DEBUGLOG("Invalid SteamGameServer() interface\n");
 	}
 
-	// Zero the client connection data
-	memset(&m_clientData, 0, sizeof(m_clientData));
-	memset(&m_pendingClientData, 0, sizeof(m_pendingClientData));
-
 	// Create the listen socket for listening for new connecting from clients
 	m_listenSocket = SteamGameServerNetworkingSockets()->CreateListenSocketP2P(0, 0, nullptr);
 
@@ -60,6 +65,7 @@ NetRumbleServer::~NetRumbleServer()
 {
 	MsgServerExiting_t msg;
 	SendMessageToAll((char*)&msg, sizeof(msg));
+	FlushMessages();
 
 	SteamGameServerNetworkingSockets()->CloseListenSocket(m_listenSocket);
 	SteamGameServerNetworkingSockets()->DestroyPollGroup(m_netPollGroup);
@@ -89,7 +95,7 @@ void NetRumbleServer::OnNetConnectionStatusChanged(SteamNetConnectionStatusChang
 		info.m_eState == k_ESteamNetworkingConnectionState_Connecting)
 	{
 		// Search an available slot for new client connection  
-		for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+		for (uint32 i = 0; i < m_maxPlayers; ++i)
 		{
 			if (!m_clientData[i].m_active && !m_pendingClientData[i].m_connectionHandle)
 			{
@@ -131,20 +137,11 @@ void NetRumbleServer::OnNetConnectionStatusChanged(SteamNetConnectionStatusChang
 	{
 		CSteamID identityRemote = info.m_identityRemote.GetSteamID();
 		// Handle disconnecting a client
-		for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+		const uint32 slot = m_slots.Find(hConn);
+		if (slot != ServerSlots::c_noSlot)
 		{
-			// If there is no ship, skip
-			if (!m_clientData[i].m_active)
-			{
-				continue;
-			}
-
-			if (m_clientData[i].m_SteamIDUser == identityRemote)
-			{
-				RemoveDroppedUser(info.m_eState, m_clientData[i].m_SteamIDUser);
-				RemovePlayerFromServer(i, DisconnectReason::ClientDisconnect);
-				break;
-			}
+			RemoveDroppedUser(info.m_eState, m_clientData[slot].m_SteamIDUser);
+			RemovePlayerFromServer(slot, DisconnectReason::ClientDisconnect);
 		}
 
 		auto& peers = g_game->GetPeers();
@@ -163,7 +160,7 @@ void NetRumbleServer::OnNetConnectionStatusChanged(SteamNetConnectionStatusChang
 // Handle sending msg to a client at a given index
 bool NetRumbleServer::SendMessageToClientAtIndex(uint32 index, char* msg, uint32 msgSize)
 {
-	if (index >= MAX_PLAYERS_PER_SERVER)
+	if (index >= m_maxPlayers)
 	{
 		return false;
 	}
@@ -181,17 +178,14 @@ bool NetRumbleServer::SendMessageToClientAtIndex(uint32 index, char* msg, uint32
 void NetRumbleServer::OnClientBeginAuthentication(CSteamID steamIDClient, HSteamNetConnection connectionID, void* token, int tokenLen)
 {
 	// First, check this isn't a duplicate and we already have a user logged on from the same steamid
-	for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+	if (m_slots.Find(connectionID) != ServerSlots::c_noSlot)
 	{
-		if (m_clientData[i].m_connectionHandle == connectionID)
-		{
-			return;
-		}
+		return;
 	}
 
 	// Second, do we have room to let them in
 	uint32 nPendingOrActivePlayerCount = 0;
-	for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+	for (uint32 i = 0; i < m_maxPlayers; ++i)
 	{
 		if (m_pendingClientData[i].m_active)
 		{
@@ -205,13 +199,13 @@ void NetRumbleServer::OnClientBeginAuthentication(CSteamID steamIDClient, HSteam
 	}
 
 	// We are full (or will be if the pending players auth), deny new login
-	if (nPendingOrActivePlayerCount >= MAX_PLAYERS_PER_SERVER)
+	if (nPendingOrActivePlayerCount >= m_maxPlayers)
 	{
 		SteamGameServerNetworkingSockets()->CloseConnection(connectionID, DisconnectReason::ServerFull, "Server is full", false);
 	}
 
 	// If we get here there is room, add the player as pending
-	for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+	for (uint32 i = 0; i < m_maxPlayers; ++i)
 	{
 		if (!m_pendingClientData[i].m_active)
 		{
@@ -262,19 +256,20 @@ void NetRumbleServer::OnAuthCompleted(bool authSuccessful, uint32 pendingAuthInd
 		MsgServerFailAuthentication_t msg;
 		int64 outMessage;
 		SteamGameServerNetworkingSockets()->SendMessageToConnection(m_pendingClientData[pendingAuthIndex].m_connectionHandle, &msg, sizeof(msg), k_nSteamNetworkingSend_Reliable, &outMessage);
-		memset(&m_pendingClientData[pendingAuthIndex], 0, sizeof(ClientConnectionData));
+		m_pendingClientData[pendingAuthIndex] = ClientConnectionData{};
 		return;
 	}
 
 	bool addedOk = false;
-	for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+	for (uint32 i = 0; i < m_maxPlayers; ++i)
 	{
 		if (!m_clientData[i].m_active)
 		{
 			// Copy over the data from the pending array
-			memcpy(&m_clientData[i], &m_pendingClientData[pendingAuthIndex], sizeof(ClientConnectionData));
-			memset(&m_pendingClientData[pendingAuthIndex], 0, sizeof(ClientConnectionData));
+			m_clientData[i] = m_pendingClientData[pendingAuthIndex];
+			m_pendingClientData[pendingAuthIndex] = ClientConnectionData{};
 			m_clientData[i].m_tickCountLastData = g_game->GetGameTickCount();
+			m_slots.Assign(i, m_clientData[i].m_connectionHandle);
 
 			MsgServerPassAuthentication_t msg;
 			msg.SetPlayerPosition(i);
@@ -290,7 +285,7 @@ void NetRumbleServer::OnAuthCompleted(bool authSuccessful, uint32 pendingAuthInd
 	if (addedOk)
 	{
 		uint32 players = 0;
-		for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+		for (uint32 i = 0; i < m_maxPlayers; ++i)
 		{
 			if (m_clientData[i].m_active)
 			{
@@ -303,16 +298,13 @@ void NetRumbleServer::OnAuthCompleted(bool authSuccessful, uint32 pendingAuthInd
 // Used to reset scores (at start of a new game usually)
 void NetRumbleServer::ResetScores()
 {
-	for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
-	{
-		m_playerScores[i] = 0;
-	}
+	std::fill(m_playerScores.begin(), m_playerScores.end(), 0);
 }
 
 // Removes a player at the given position
 void NetRumbleServer::RemovePlayerFromServer(uint32 shipPosition, DisconnectReason reason)
 {
-	if (shipPosition >= MAX_PLAYERS_PER_SERVER)
+	if (shipPosition >= m_maxPlayers)
 	{
 		DEBUGLOG("Trying to remove player at invalid position\n");
 		return;
@@ -328,7 +320,8 @@ void NetRumbleServer::RemovePlayerFromServer(uint32 shipPosition, DisconnectReas
 	// Tell the game server the user is leaving the server
 	SteamGameServer()->EndAuthSession(m_clientData[shipPosition].m_SteamIDUser);
 #endif
-	memset(&m_clientData[shipPosition], 0, sizeof(ClientConnectionData));
+	m_clientData[shipPosition] = ClientConnectionData{};
+	m_slots.Release(shipPosition);
 }
 
 // Used to transition game state
@@ -350,215 +343,237 @@ void NetRumbleServer::ProcessNetworkMessageOnPollGroup()
 	for (int i = 0; i < numMsgs; i++)
 	{
 		SteamNetworkingMessage_t* msg = msgs[i];
-		// Message payload size
-		const uint32 msgSize = msg->GetSize();
 
-		if (msgSize < sizeof(GameMessageType))
+		// Whatever a client sent in one frame arrives as one bundle; its packets are handled in order
+		const DataBufferView message(static_cast<const uint8_t*>(msg->GetData()), msg->GetSize());
+		if (!MessageBundler::ForEachPacket(message, [&](DataBufferView packet) { ProcessClientPacket(*msg, packet); }))
 		{
-			DEBUGLOG("Got garbage on server socket, too short\n");
-			msg->Release();
-			msg = nullptr;
-			continue;
+			DEBUGLOG("Got a malformed message bundle on server socket\n");
 		}
 
-		// Message payload data
-		const auto msgData = msg->GetData();
-		CSteamID steamIDRemote = msg->m_identityPeer.GetSteamID();
-		HSteamNetConnection senderConnectionHandle = msg->m_conn;
-		GameMessageType msgType = (GameMessageType)(*(GameMessageType*)msgData);
+		msg->Release();
+		msg = nullptr;
+	}
+}
+
+// One packet from a client, either sent on its own or unpacked from a bundle
+void NetRumbleServer::ProcessClientPacket(const SteamNetworkingMessage_t& msg, DataBufferView packet)
+{
+	// Message payload size
+	const uint32 msgSize = static_cast<uint32>(packet.size());
+
+	if (msgSize < sizeof(GameMessageType))
+	{
+		DEBUGLOG("Got garbage on server socket, too short\n");
+		return;
+	}
 
-		for (uint32 j = 0; j < MAX_PLAYERS_PER_SERVER; ++j)
+	// Message payload data. The voice relay below stamps the sender into it in place, which is
+	// safe because Steam's receive buffer belongs to us until the message is released.
+	void* const msgData = const_cast<uint8_t*>(packet.data());
+	CSteamID steamIDRemote = msg.m_identityPeer.GetSteamID();
+	HSteamNetConnection senderConnectionHandle = msg.m_conn;
+	GameMessageType msgType;
+	memcpy(&msgType, msgData, sizeof(msgType));
+
+	const uint32 senderSlot = m_slots.Find(senderConnectionHandle);
+	if (senderSlot != ServerSlots::c_noSlot)
+	{
+		DEBUGLOG("Server receives message:[%s] from client at index:[%d] SteamIDUser:[%llu] \n", MessageTypeString(msgType), senderSlot, m_clientData[senderSlot].m_SteamIDUser);
+	}
+	const SlotMask senderMask = senderSlot != ServerSlots::c_noSlot ? ServerSlots::Bit(senderSlot) : 0;
+
+	// Steam authentication and login message structure is different from game play message(GameMessage.Serialize())
+	// We have to process them seperately
+	if (msgType > GameMessageType::ServerMessageBegin) // Steam auth and login related messages
+	{
+		switch (msgType)
+		{
+		case GameMessageType::ClientBeginAuthentication:
 		{
-			if (m_clientData[j].m_connectionHandle == senderConnectionHandle)
+			if (msgSize != sizeof(MsgClientBeginAuthentication_t))
 			{
-				DEBUGLOG("Server receives message:[%s] from client at index:[%d] SteamIDUser:[%llu] \n", MessageTypeString(msgType), j, m_clientData[j].m_SteamIDUser);
+				DEBUGLOG("Bad connection attempt msg\n");
+				return;
 			}
+			MsgClientBeginAuthentication_t* pMsg = (MsgClientBeginAuthentication_t*)msgData;
+#ifdef USE_GS_AUTH_API
+			OnClientBeginAuthentication(steamIDRemote, senderConnectionHandle, (void*)pMsg->GetTokenPtr(), static_cast<int>(pMsg->GetTokenLen()));
+#else
+			OnClientBeginAuthentication(connection, 0);
+#endif
 		}
-
-		// Steam authentication and login message structure is different from game play message(GameMessage.Serialize())
-		// We have to process them seperately
-		if (msgType > GameMessageType::ServerMessageBegin) // Steam auth and login related messages
+		break;
+		case GameMessageType::VoiceChatData:
+		{
+			// Received voice chat messages, broadcast to all other players
+			MsgVoiceChatData_t* voiceChatMsg = (MsgVoiceChatData_t*)msgData;
+			// Make sure sender steam ID is set.
+			voiceChatMsg->SetSteamID(msg.m_identityPeer.GetSteamID());
+			SendMessageToAllIgnore(voiceChatMsg, msgSize, senderMask);
+			break;
+		}
+		case GameMessageType::P2PSendingTicket:
 		{
-			switch (msgType)
+			// Received a P2P auth ticket, forward it to the intended recipient
+			MsgP2PSendingTicket_t msgP2PSendingTicket;
+			memcpy(&msgP2PSendingTicket, msgData, sizeof(MsgP2PSendingTicket_t));
+			CSteamID toSteamID = msgP2PSendingTicket.GetSteamID();
+
+			HSteamNetConnection toHConn = 0;
+			const uint32 index = FindSlotBySteamID(toSteamID);
+			if (index != ServerSlots::c_noSlot)
 			{
-			case GameMessageType::ClientBeginAuthentication:
+				// Mutate the msg,waw replacing the destination SteamID with the sender's SteamID
+				msgP2PSendingTicket.SetSteamID(msg.m_identityPeer.GetSteamID64());
+
+				toHConn = m_clientData[index].m_connectionHandle;
+				SteamGameServerNetworkingSockets()->SendMessageToConnection(toHConn, &msgP2PSendingTicket, sizeof(msgP2PSendingTicket), k_nSteamNetworkingSend_Reliable, nullptr);
+			}
+
+			if (toHConn == 0)
 			{
-				if (msgSize != sizeof(MsgClientBeginAuthentication_t))
-				{
-					DEBUGLOG("Bad connection attempt msg\n");
-					msg->Release();
-					msg = nullptr;
-					continue;
-				}
-				MsgClientBeginAuthentication_t* pMsg = (MsgClientBeginAuthentication_t*)msgData;
-#ifdef USE_GS_AUTH_API
-				OnClientBeginAuthentication(steamIDRemote, senderConnectionHandle, (void*)pMsg->GetTokenPtr(), static_cast<int>(pMsg->GetTokenLen()));
-#else
-				OnClientBeginAuthentication(connection, 0);
-#endif
+				DEBUGLOG("msgP2PSendingTicket received with no valid target to send to.");
 			}
-			break;
-			case GameMessageType::VoiceChatData:
+		}
+		break;
+
+		default:
+			// We can check miss msg here. neo
+			DEBUGLOG("Invalid msg %x\n", msgType);
+		}
+	}
+	else
+	{
+		// These messages need to be broadcasted by the server, they contain a sourceID in their message header
+		// Message structure: GameMessageType|SourceID|MessagePayLoad
+		if (msgType == GameMessageType::WorldDataAck)
+		{
+			// World data acknowledgements are only for the server, don't relay them
+			const size_t headerSize = sizeof(GameMessageType) + sizeof(uint64);
+			std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(msg.m_identityPeer.GetSteamID64());
+			if (playerState != nullptr && msgSize >= headerSize + sizeof(uint32_t) && g_game->GetWorld()->IsInitialized())
 			{
-				// Received voice chat messages, broadcast to all other players
-				MsgVoiceChatData_t* voiceChatMsg = (MsgVoiceChatData_t*)msgData;
-				// Make sure sender steam ID is set.
-				voiceChatMsg->SetSteamID(msg->m_identityPeer.GetSteamID());
-				std::set<HSteamNetConnection> ignoreConnectionSet = { senderConnectionHandle };
-				SendMessageToAllIgnore(voiceChatMsg, msgSize, ignoreConnectionSet);
-				break;
+				uint32_t sequence = 0;
+				memcpy(&sequence, static_cast<const uint8_t*>(msgData) + headerSize, sizeof(sequence));
+				g_game->GetWorld()->AcknowledgeWorldData(*playerState, sequence);
 			}
-			case GameMessageType::P2PSendingTicket:
+		}
+		else if (msgType == GameMessageType::ShipInput ||
+			msgType == GameMessageType::ShipSpawn ||
+			msgType == GameMessageType::ShipDeath ||
+			msgType == GameMessageType::PlayerInfo ||
+			msgType == GameMessageType::PlayerJoined)
+		{
+			if (msgSize < sizeof(GameMessageType) + sizeof(uint64))
 			{
-				// Received a P2P auth ticket, forward it to the intended recipient
-				MsgP2PSendingTicket_t msgP2PSendingTicket;
-				memcpy(&msgP2PSendingTicket, msgData, sizeof(MsgP2PSendingTicket_t));
-				CSteamID toSteamID = msgP2PSendingTicket.GetSteamID();
+				DEBUGLOG("Got garbage on server socket, no source ID\n");
+				return;
+			}
 
-				HSteamNetConnection toHConn = 0;
-				for (int index = 0; index < MAX_PLAYERS_PER_SERVER; index++)
-				{
-					if (toSteamID == m_clientData[index].m_SteamIDUser)
-					{
-						// Mutate the msg,waw replacing the destination SteamID with the sender's SteamID
-						msgP2PSendingTicket.SetSteamID(msg->m_identityPeer.GetSteamID64());
+			// Dispatch the message to all players except for message sender and the server
+			int sendFlag = k_nSteamNetworkingSend_Reliable;
+			if (msgType == GameMessageType::ShipInput)
+			{
+				sendFlag = k_nSteamNetworkingSend_Unreliable;
+			}
+			const SlotMask ignoreSlots = senderMask | m_slots.MaskOf(Managers::Get<OnlineManager>()->GetConnectedServerHandle());
+			SendMessageToAllIgnore(msgData, msgSize, ignoreSlots, sendFlag);
 
-						SteamNetworkingSockets()->SendMessageToConnection(m_clientData[index].m_connectionHandle, &msgP2PSendingTicket, sizeof(msgP2PSendingTicket), k_nSteamNetworkingSend_Reliable, nullptr);
-						break;
-					}
-				}
+			// The server host will process the message immediately
+			uint64 sourceId = msg.m_identityPeer.GetSteamID64();
 
-				if (toHConn == 0)
-				{
-					DEBUGLOG("msgP2PSendingTicket received with no valid target to send to.");
-				}
+			std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(sourceId);
+			if (!g_game->GetWorld()->IsInitialized())
+			{
+				DEBUGLOG("Server receive [%s] from client when world is not initialized!\n", MessageTypeString(msgType));
 			}
-			break;
-
-			default:
-				// We can check miss msg here. neo
-				DEBUGLOG("Invalid msg %x\n", msgType);
+			else if (playerState == nullptr)
+			{
+				DEBUGLOG("Server receive [%s] when peerState is nullptr!\n", MessageTypeString(msgType));
 			}
-		}
-		else
-		{
-			// These messages need to be broadcasted by the server, they contain a sourceID in their message header
-			// Message structure: GameMessageType|SourceID|MessagePayLoad
-			if (msgType == GameMessageType::ShipInput ||
-				msgType == GameMessageType::ShipSpawn ||
-				msgType == GameMessageType::ShipData ||
-				msgType == GameMessageType::ShipDeath ||
-				msgType == GameMessageType::PlayerInfo ||
-				msgType == GameMessageType::PlayerJoined)
+			else
 			{
-				// Dispatch the message to all players except for message sender and the server
-				int sendFlag = k_nSteamNetworkingSend_Reliable;
-				if (msgType == GameMessageType::ShipInput || msgType == GameMessageType::ShipData)
+				DEBUGLOG("Received [%s] from %u\n", MessageTypeString(msgType), sourceId);
+				const size_t msgTypeSize = sizeof(GameMessageType);
+				// Size of the payload. These messages contain both message type and sourceId as appended header.
+				const size_t sourceIdSize = sizeof(sourceId);
+				const size_t gamePlayMsgSize = msgSize - msgTypeSize - sourceIdSize;
+				// Message payload start pos
+				const uint8_t* dataBegin = packet.data() + msgTypeSize + sourceIdSize;
+				// Message payload
+				const DataBufferView messageData(dataBegin, gamePlayMsgSize);
+				if (msgType == GameMessageType::ShipInput)
 				{
-					sendFlag = k_nSteamNetworkingSend_Unreliable;
+					// The host applies the owner's moves and reports back where they left the ship
+					if (sourceId != g_game->GetLocalPlayerState()->PeerId)
+					{
+						playerState->GetShip()->DeserializeMoves(messageData);
+					}
 				}
-				std::set<HSteamNetConnection> ignoreSet = { senderConnectionHandle, Managers::Get<OnlineManager>()->GetConnectedServerHandle() };
-				SendMessageToAllIgnore(msgData, msgSize, ignoreSet, sendFlag);
-
-				// The server host will process the message immediately
-				uint64 sourceId = msg->m_identityPeer.GetSteamID64();
-
-				std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(sourceId);
-				if (!g_game->GetWorld()->IsInitialized())
+				else if (msgType == GameMessageType::ShipDeath)
 				{
-					DEBUGLOG("Server receive [%s] from client when world is not initialized!\n", MessageTypeString(msgType));
+					g_game->GetWorld()->DeserializeShipDeath(sourceId, messageData);
 				}
-				else if (playerState == nullptr)
+				else if (msgType == GameMessageType::ShipSpawn)
 				{
-					DEBUGLOG("Server receive [%s] when peerState is nullptr!\n", MessageTypeString(msgType));
+					g_game->GetWorld()->DeserializeShipSpawn(messageData);
 				}
-				else
+				else if (msgType == GameMessageType::PlayerJoined)
 				{
-					DEBUGLOG("Received [%s] from %u\n", MessageTypeString(msgType), sourceId);
-					const size_t msgTypeSize = sizeof(GameMessageType);
-					// Size of the payload. These messages contain both message type and sourceId as appended header.
-					const size_t sourceIdSize = sizeof(sourceId);
-					const size_t gamePlayMsgSize = msg->GetSize() - msgTypeSize - sourceIdSize;
-					// Message payload start pos
-					const uint8_t* dataBegin = static_cast<const uint8_t*>(msg->GetData()) + msgTypeSize + sourceIdSize;
-					const uint8_t* dataEnd = dataBegin + gamePlayMsgSize;
-					// Message payload
-					const std::vector<uint8_t>& messageData = std::vector<uint8_t>(dataBegin, dataEnd);
-					if (msgType == GameMessageType::ShipInput)
-					{
-						if (sourceId != g_game->GetLocalPlayerState()->PeerId)
-						{
-							playerState->GetShip()->Deserialize(messageData);
-						}
-					}
-					else if (msgType == GameMessageType::ShipData)
+					if (!playerState->IsLocalPlayer)
 					{
-						playerState->GetShip()->Deserialize(messageData);
+						playerState->DeserializePlayerStateData(messageData);
 					}
-					else if (msgType == GameMessageType::ShipDeath)
-					{
-						g_game->GetWorld()->DeserializeShipDeath(sourceId, messageData);
-					}
-					else if (msgType == GameMessageType::ShipSpawn)
-					{
-						g_game->GetWorld()->DeserializeShipSpawn(messageData);
-					}
-					else if (msgType == GameMessageType::PlayerJoined)
-					{
-						if (!playerState->IsLocalPlayer)
-						{
-							playerState->DeserializePlayerStateData(messageData);
-						}
 
-						if (playerState->InGame == true && playerState->InLobby == false)
+					if (playerState->InGame == true && playerState->InLobby == false)
+					{
+						const AudioManager* audioManager = Managers::Get<AudioManager>();
+						if (audioManager)
 						{
-							const AudioManager* audioManager = Managers::Get<AudioManager>();
-							if (audioManager)
+							OnlineVoiceChat& voiceChatManager = OnlineVoiceChat::GetInstance();
+							if (!audioManager->IsVoiceChatActive())
 							{
-								OnlineVoiceChat& voiceChatManager = OnlineVoiceChat::GetInstance();
-								if (!audioManager->IsVoiceChatActive())
-								{
-									voiceChatManager.StartVoiceChat();
-								}
-								voiceChatManager.GetVoiceChat()->MarkPlayerAsActive(sourceId);
+								voiceChatManager.StartVoiceChat();
 							}
+							voiceChatManager.GetVoiceChat()->MarkPlayerAsActive(sourceId);
 						}
 					}
-					else if (msgType == GameMessageType::PlayerInfo)
+				}
+				else if (msgType == GameMessageType::PlayerInfo)
+				{
+					if (!playerState->IsLocalPlayer)
 					{
-						if (!playerState->IsLocalPlayer)
-						{
-							// Msg comes from one of other player joins in same game
-							playerState->DisplayName = GameMessage(messageData).StringValue().c_str();
+						// Msg comes from one of other player joins in same game
+						playerState->DisplayName = GameMessageView::FromPacket(messageData).StringValue().c_str();
 
-							// Server will dispatch the msg to all connected clients execept for the msg sender and the server host player
-							std::set<HSteamNetConnection> ignoreSet = { static_cast<HSteamNetConnection>(sourceId) };
-							for (auto& [id, peer] : g_game->GetPeers())
+						// Server will dispatch the msg to all connected clients execept for the msg sender and the server host player
+						SlotMask ignoreSlots = senderMask;
+						const std::shared_ptr<PlayerState>& localPlayer = g_game->GetLocalPlayerState();
+						if (localPlayer)
+						{
+							// Server host player
+							const uint32 hostSlot = FindSlotBySteamID(CSteamID(localPlayer->PeerId));
+							if (hostSlot != ServerSlots::c_noSlot)
 							{
-								// Server host player
-								if (peer->IsLocalPlayer)
-								{
-									ignoreSet.emplace(static_cast<HSteamNetConnection>(id));
-								}
+								ignoreSlots |= ServerSlots::Bit(hostSlot);
 							}
-
-							const bool serializeWithSourceID = true;
-							Managers::Get<OnlineManager>()->ServerSendMessageToAllIgnore(GameMessage(
-								GameMessageType::PlayerInfo,
-								playerState->DisplayName
-							), ignoreSet, serializeWithSourceID);
 						}
-						DEBUGLOG("Received PlayerInfo for: %ws\n", playerState->DisplayName.c_str());
-					}
-					else
-					{
-						DEBUGLOG("Unhandled msg:[%s] from client:[%d]\n", MessageTypeString(msgType), sourceId);
+
+						const bool serializeWithSourceID = true;
+						Managers::Get<OnlineManager>()->ServerSendMessageToAllIgnore(GameMessage(
+							GameMessageType::PlayerInfo,
+							playerState->DisplayName
+						), ignoreSlots, serializeWithSourceID);
 					}
+					DEBUGLOG("Received PlayerInfo for: %ws\n", playerState->DisplayName.c_str());
+				}
+				else
+				{
+					DEBUGLOG("Unhandled msg:[%s] from client:[%d]\n", MessageTypeString(msgType), sourceId);
 				}
 			}
 		}
-		msg->Release();
-		msg = nullptr;
 	}
 }
 
@@ -573,7 +588,7 @@ void NetRumbleServer::Tick()
 
 	// Timeout stale player connections, also update player count msg
 	uint32 playerCount = 0;
-	for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+	for (uint32 i = 0; i < m_maxPlayers; ++i)
 	{
 		// If there is no ship, skip
 		if (!m_clientData[i].m_active)
@@ -602,7 +617,7 @@ void NetRumbleServer::Tick()
 		if (g_game->GetGameTickCount() - m_lastStateTransitionTime >= MILLISECONDS_BETWEEN_ROUNDS)
 		{
 			// Just keep waiting until at least one ship is active
-			for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+			for (uint32 i = 0; i < m_maxPlayers; ++i)
 			{
 				if (m_clientData[i].m_active)
 				{
@@ -636,7 +651,7 @@ void NetRumbleServer::SendUpdateDataToAllClients()
 
 	m_lastServerUpdateTick = g_game->GetGameTickCount();
 
-	for (int i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+	for (uint32 i = 0; i < m_maxPlayers; ++i)
 	{
 		if (!m_clientData[i].m_active)
 		{
@@ -654,33 +669,45 @@ void NetRumbleServer::SendMessageToAll(const void* msg, uint32 msgSize, int send
 		return;
 	}
 
-	for (int i = 0; i < MAX_PLAYERS_PER_SERVER; i++)
-	{
-		if (m_clientData[i].m_connectionHandle != k_HSteamNetConnection_Invalid)
+	ServerSlots::ForEachSlot(m_slots.Held(), [&](uint32 slot)
 		{
-			DEBUGLOG("NetRumbleServer::SendMessageToAll m_connectionHandle == %llu\n", m_clientData[i].m_connectionHandle);
-			SteamNetworkingSockets()->SendMessageToConnection(m_clientData[i].m_connectionHandle, msg, msgSize, sendFlags, nullptr);
-		}
-	}
+			DEBUGLOG("NetRumbleServer::SendMessageToAll m_connectionHandle == %llu\n", m_slots.ConnectionAt(slot));
+			m_bundler.Queue(m_slots.ConnectionAt(slot), sendFlags, DataBufferView(static_cast<const uint8_t*>(msg), msgSize));
+		});
 }
 
-void NetRumbleServer::SendMessageToAllIgnore(const void* msg, uint32 msgSize, std::set<HSteamNetConnection>& ignoreConnectionSet, int sendFlags)
+void NetRumbleServer::SendMessageToAllIgnore(const void* msg, uint32 msgSize, SlotMask ignoreSlots, int sendFlags)
 {
 	if (msgSize >= k_cbMaxSteamNetworkingSocketsMessageSizeSend)
 	{
 		DEBUGLOG("Message size is %d, it is larger than max size (k_cbMaxSteamNetworkingSocketsMessageSizeSend = 512*1024) of a single msg that we can SEND.\n", msgSize);
 		return;
 	}
-	// Invalid connection also have to be excluded 
-	ignoreConnectionSet.emplace(k_HSteamNetConnection_Invalid);
-	for (int i = 0; i < MAX_PLAYERS_PER_SERVER; i++)
-	{
-		// Send message to valid client connection handles that are not in the ignored set
-		if (ignoreConnectionSet.find(m_clientData[i].m_connectionHandle) == ignoreConnectionSet.end())
+
+	// Only slots with a connection are held, so empty ones are already left out
+	ServerSlots::ForEachSlot(m_slots.Held() & ~ignoreSlots, [&](uint32 slot)
 		{
-			SteamNetworkingSockets()->SendMessageToConnection(m_clientData[i].m_connectionHandle, msg, msgSize, sendFlags, nullptr);
-		}
-	}
+			m_bundler.Queue(m_slots.ConnectionAt(slot), sendFlags, DataBufferView(static_cast<const uint8_t*>(msg), msgSize));
+		});
+}
+
+uint32 NetRumbleServer::FindSlotBySteamID(CSteamID steamID) const
+{
+	uint32 found = ServerSlots::c_noSlot;
+	ServerSlots::ForEachSlot(m_slots.Held(), [&](uint32 slot)
+		{
+			if (found == ServerSlots::c_noSlot && m_clientData[slot].m_SteamIDUser == steamID)
+			{
+				found = slot;
+			}
+		});
+
+	return found;
+}
+
+void NetRumbleServer::FlushMessages()
+{
+	m_bundler.Flush();
 }
 
 // Take any action we need to on Steam notifying us we are now logged in
@@ -740,14 +767,14 @@ void NetRumbleServer::SendUpdatedServerDetailsToSteam()
 
 	// Set state variables, relevant to any master server updates or client pings
 	// These server state variables may be changed at any time.
-	SteamGameServer()->SetMaxPlayerCount(MAX_PLAYERS_PER_SERVER);
+	SteamGameServer()->SetMaxPlayerCount(static_cast<int>(m_maxPlayers));
 	SteamGameServer()->SetPasswordProtected(false);
 	SteamGameServer()->SetServerName(m_serverName.c_str());
 	SteamGameServer()->SetMapName("Galaxy");
 
 #ifdef USE_GS_AUTH_API
 	// Update all the players names/scores
-	for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+	for (uint32 i = 0; i < m_maxPlayers; ++i)
 	{
 		if (m_clientData[i].m_active)
 		{
@@ -764,7 +791,7 @@ void NetRumbleServer::OnValidateAuthTicketResponse(ValidateAuthTicketResponse_t*
 	{
 		DEBUGLOG("localPlayerID == %d\n", SteamUser()->GetSteamID().ConvertToUint64());
 		// This is the final approval, and means we should let the client play (find the pending auth by steamid)
-		for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+		for (uint32 i = 0; i < m_maxPlayers; ++i)
 		{
 			if (m_pendingClientData[i].m_active && m_pendingClientData[i].m_SteamIDUser == response->m_SteamID)
 			{
@@ -780,7 +807,7 @@ void NetRumbleServer::OnValidateAuthTicketResponse(ValidateAuthTicketResponse_t*
 	else
 	{
 		// Looks like we shouldn't let this user play, kick them
-		for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+		for (uint32 i = 0; i < m_maxPlayers; ++i)
 		{
 			if (m_pendingClientData[i].m_active && m_pendingClientData[i].m_SteamIDUser == response->m_SteamID)
 			{
@@ -807,7 +834,7 @@ CSteamID NetRumbleServer::GetSteamID() const
 void NetRumbleServer::KickPlayerOffServer(CSteamID steamID)
 {
 	uint32 playerCount = 0;
-	for (uint32 i = 0; i < MAX_PLAYERS_PER_SERVER; ++i)
+	for (uint32 i = 0; i < m_maxPlayers; ++i)
 	{
 		// If there is no ship, skip
 		if (!m_clientData[i].m_active)
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "pch.h"
+#include "MessageBundle.h"
 #include "NetworkMessages.h"
+#include "ServerSlots.h"
 
 namespace NetRumble
 {
@@ -17,7 +19,8 @@ namespace NetRumble
 	class NetRumbleServer final
 	{
 	public:
-		NetRumbleServer() noexcept;
+		// Holds maxPlayers players, clamped to [1, MAX_SERVER_SLOTS]
+		explicit NetRumbleServer(uint32 maxPlayers);
 		NetRumbleServer(const NetRumbleServer&) = delete;
 		NetRumbleServer(NetRumbleServer&&) noexcept = delete;
 		NetRumbleServer& operator=(const NetRumbleServer&) = delete;
@@ -43,13 +46,18 @@ namespace NetRumble
 		// Kick a given player off the server
 		void KickPlayerOffServer(CSteamID steamID);
 
+		inline uint32 GetMaxPlayers() const { return m_maxPlayers; }
+
 		// Whether the connection to steam has already formed
 		bool IsConnectedToSteam() const { return m_connectedToSteam; }
 		CSteamID GetSteamID() const;
 
-		// Send the same message to all clients, except the ignored connection if any
+		// Send the same message to all clients, except those in the ignored slots if any. Messages are
+		// queued per client and delivery class until FlushMessages, which bundles each queue into one send,
+		// so the inputs relayed to a client in a frame go out together as one unreliable bundle.
 		void SendMessageToAll(const void* msg, uint32 msgSize, int sendFlags = k_nSteamNetworkingSend_UnreliableNoDelay);
-		void SendMessageToAllIgnore(const void* msg, uint32 msgSize, std::set<HSteamNetConnection>& ignoreConnectionSet, int sendFlags = k_nSteamNetworkingSend_UnreliableNoDelay);
+		void SendMessageToAllIgnore(const void* msg, uint32 msgSize, SlotMask ignoreSlots, int sendFlags = k_nSteamNetworkingSend_UnreliableNoDelay);
+		void FlushMessages();
 
 		// Removes a player from the server
 		void RemovePlayerFromServer(uint32 shipPosition, DisconnectReason reason);
@@ -87,9 +95,14 @@ namespace NetRumble
 		// Tell Steam about our servers details
 		void SendUpdatedServerDetailsToSteam();
 
+		void ProcessClientPacket(const SteamNetworkingMessage_t& msg, DataBufferView packet);
+
 		// Send msg to a client at the given ship index
 		bool SendMessageToClientAtIndex(uint32 index, char* message, uint32 msgSize);
 
+		// The slot of the active player with this SteamID, or ServerSlots::c_noSlot
+		uint32 FindSlotBySteamID(CSteamID steamID) const;
+
 		void OnClientBeginAuthentication(CSteamID steamIDClient, HSteamNetConnection connectionID, void* pToken, int tokenLen);
 
 		// Handles authentication completing for a client
@@ -98,12 +111,15 @@ namespace NetRumble
 		// Send world update to all clients
 		void SendUpdateDataToAllClients();
 
+		// Slots this server holds, fixed when it is created
+		const uint32 m_maxPlayers;
+
 		// Track whether our server is connected to Steam ok (meaning we can restrict who plays based on 
 		// ownership and VAC bans, etc...)
 		bool m_connectedToSteam;
 
 		// Player scores
-		uint32 m_playerScores[MAX_PLAYERS_PER_SERVER]{ 0 };
+		std::vector<uint32> m_playerScores;
 
 		// Server name
 		std::string m_serverName;
@@ -124,16 +140,22 @@ namespace NetRumble
 		ServerGameState m_gameState;
 
 		// Client connections
-		ClientConnectionData m_clientData[MAX_PLAYERS_PER_SERVER];
+		std::vector<ClientConnectionData> m_clientData;
 
 		// Client connections which are pending auth
-		ClientConnectionData m_pendingClientData[MAX_PLAYERS_PER_SERVER];
+		std::vector<ClientConnectionData> m_pendingClientData;
+
+		// Which slot of m_clientData each active connection holds
+		ServerSlots m_slots;
 
 		// Socket to listen for new connections on 
 		HSteamListenSocket m_listenSocket;
 
 		// Poll group used to receive messages from all clients at once
 		HSteamNetPollGroup m_netPollGroup;
+
+		// Messages to each client, held until the end of the frame
+		MessageBundler m_bundler;
 	};
 }
 
@@ -15,6 +15,19 @@ AudioManager::AudioManager() noexcept :
 {
 }
 
+#ifdef NETRUMBLE_HEADLESS
+// A dedicated server has no audio device; gameplay code still calls in, so every entry point is a no-op
+void AudioManager::Initialize() {}
+void AudioManager::Suspend() {}
+void AudioManager::Resume() {}
+void AudioManager::ShutDown() {}
+void AudioManager::Tick() {}
+void AudioManager::PlaySoundTrack(bool play) { SoundTrackOn = play; }
+void AudioManager::PlaySound(const std::wstring& soundName, bool loop) { UNREFERENCED_PARAMETER(soundName); UNREFERENCED_PARAMETER(loop); }
+void AudioManager::SetMasterVolume(float volume) { UNREFERENCED_PARAMETER(volume); }
+bool AudioManager::StartVoiceChat() { return false; }
+bool AudioManager::StopVoiceChat() { return false; }
+#else
 void AudioManager::LoadSound(const std::wstring& name, const std::wstring& path)
 {
 	// Stuff the data into our map
@@ -155,4 +168,4 @@ bool AudioManager::StopVoiceChat()
 {
 	return OnlineVoiceChat::GetInstance().StopVoiceChat();
 }
-
+#endif
@@ -31,6 +31,7 @@ namespace NetRumble
 		bool SoundTrackOn;
 		bool PlaySoundEffects;
 
+#ifndef NETRUMBLE_HEADLESS
 		void LoadSound(const std::wstring& name, const std::wstring& path);
 		std::shared_ptr<DirectX::AudioEngine> GetAudioEngine() { return m_audEngine; }
 
@@ -39,6 +40,9 @@ namespace NetRumble
 		std::unique_ptr<DirectX::SoundEffect>                         m_backgroundSound;
 		std::unique_ptr<DirectX::SoundEffectInstance>                 m_backgroundSoundInstance;
 		std::map<std::wstring, std::shared_ptr<DirectX::SoundEffect>> m_soundEffects;
+#else
+	private:
+#endif
 
 		bool m_voiceChatActive{ false };
 	};
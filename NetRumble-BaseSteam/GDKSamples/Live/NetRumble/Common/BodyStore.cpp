@@ -0,0 +1,88 @@
+//--------------------------------------------------------------------------------------
+// BodyStore.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "BodyStore.h"
+
+using namespace NetRumble;
+
+void BodyStore::Gather(BatchRemovalCollection<std::shared_ptr<GameplayObject>>& collection)
+{
+	const size_t size = collection.size();
+
+	m_objects.resize(size);
+	Positions.resize(size);
+	Velocities.resize(size);
+	Radii.resize(size);
+	Masses.resize(size);
+	Lives.resize(size);
+	Active.resize(size);
+	Collided.resize(size);
+	Projectile.resize(size);
+	Moving.resize(size);
+
+	for (size_t body = 0; body < size; body++)
+	{
+		const std::shared_ptr<GameplayObject>& object = collection[body];
+		m_objects[body] = object;
+		Positions[body] = object->Position;
+		Velocities[body] = object->Velocity;
+		Radii[body] = object->Radius;
+		Masses[body] = object->Mass;
+		Lives[body] = object->Life;
+		Active[body] = object->Active();
+		Collided[body] = object->CollidedThisFrame;
+		Projectile[body] = object->GetType() == GameplayObjectType::Projectile;
+		Moving[body] = true;
+	}
+
+	m_generation = collection.current_generation();
+}
+
+void BodyStore::Refresh(uint32_t body)
+{
+	const GameplayObject* object = m_objects[body].get();
+	Positions[body] = object->Position;
+	Velocities[body] = object->Velocity;
+	Radii[body] = object->Radius;
+	Masses[body] = object->Mass;
+	Lives[body] = object->Life;
+	Active[body] = object->Active();
+	Collided[body] = object->CollidedThisFrame;
+}
+
+void BodyStore::RefreshActive(size_t generation)
+{
+	if (generation == m_generation)
+	{
+		return;
+	}
+
+	for (size_t body = 0; body < m_objects.size(); body++)
+	{
+		Active[body] = m_objects[body]->Active();
+	}
+	m_generation = generation;
+}
+
+void BodyStore::Scatter() const
+{
+	for (size_t body = 0; body < m_objects.size(); body++)
+	{
+		if (Active[body])
+		{
+			GameplayObject* object = m_objects[body].get();
+			object->Position = Positions[body];
+			object->Velocity = Velocities[body];
+		}
+	}
+}
+
+void BodyStore::Clear()
+{
+	m_objects.clear();
+	m_generation = SIZE_MAX;
+}
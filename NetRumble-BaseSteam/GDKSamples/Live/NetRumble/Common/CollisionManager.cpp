@@ -8,6 +8,8 @@
 
 #include "CollisionMath.h"
 
+#include <chrono>
+
 using namespace NetRumble;
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
@@ -20,15 +22,175 @@ enum class CollisionSide
 	Right
 };
 
+namespace
+{
+	// The edge of the world a circle is closest to, if it has reached it
+	bool ReachesEdge(const RECT& dimensions, const Vector2& position, float radius, CollisionSide& side, float& distance)
+	{
+		std::array<std::pair<CollisionSide, float>, 4> DistanceToEdge = {
+			std::pair<CollisionSide, float>{ CollisionSide::Left, position.x - dimensions.left },
+			std::pair<CollisionSide, float>{ CollisionSide::Right, dimensions.right - position.x },
+			std::pair<CollisionSide, float>{ CollisionSide::Top, position.y - dimensions.top },
+			std::pair<CollisionSide, float>{ CollisionSide::Bottom, dimensions.bottom - position.y }
+		};
+
+		auto min = std::min_element(std::begin(DistanceToEdge), std::end(DistanceToEdge), [](auto&& left, auto&& right)
+			{
+				return left.second < right.second;
+			});
+
+		side = min->first;
+		distance = min->second;
+		return distance < radius;
+	}
+
+	// Exchanges the momentum of two circles along the line between their centers, as an
+	// elastic collision; circles with no mass, or on top of each other, are left alone
+	void Rebound(const Vector2& position1, float mass1, Vector2& velocity1, const Vector2& position2, float mass2, Vector2& velocity2)
+	{
+		// Don't adjust velocities if at least one has negative mass
+		if (mass1 <= 0.0f || mass2 <= 0.0f)
+		{
+			return;
+		}
+
+		// Determine the vectors normal and tangent to the collision
+		Vector2 collisionNormal = position2 - position1;
+		float lengthsq = collisionNormal.LengthSquared();
+		if (lengthsq > 0.0f)
+		{
+			collisionNormal /= sqrt(lengthsq);
+		}
+		else
+		{
+			return;
+		}
+
+		Vector2 collisionTangent = Vector2(-collisionNormal.y, collisionNormal.x);
+
+		// Determine the velocity components along the normal and tangent vectors
+		float velocityNormal1 = velocity1.Dot(collisionNormal);
+		float velocityTangent1 = velocity1.Dot(collisionTangent);
+		float velocityNormal2 = velocity2.Dot(collisionNormal);
+		float velocityTangent2 = velocity2.Dot(collisionTangent);
+
+		// Determine the new velocities along the normal
+		float massDelta = mass1 - mass2;
+		float massSum = mass1 + mass2;
+		float velocityNormal1New = ((velocityNormal1 * massDelta) + (2.0f * mass2 * velocityNormal2)) / massSum;
+		float velocityNormal2New = ((velocityNormal2 * -massDelta) + (2.0f * mass1 * velocityNormal1)) / massSum;
+
+		// Determine the new total velocities
+		velocity1 = (velocityNormal1New * collisionNormal) + (velocityTangent1 * collisionTangent);
+		velocity2 = (velocityNormal2New * collisionNormal) + (velocityTangent2 * collisionTangent);
+	}
+
+	// Pushes a circle that reached an edge back inside, and reflects its velocity off it
+	void BounceOffEdge(const RECT& dimensions, CollisionSide side, float distance, float radius, Vector2& position, Vector2& velocity)
+	{
+		Vector2 closestPoint = position;
+
+		switch (side)
+		{
+		case CollisionSide::Left:
+			closestPoint.x = static_cast<float>(dimensions.left);
+			break;
+		case CollisionSide::Right:
+			closestPoint.x = static_cast<float>(dimensions.right);
+			break;
+		case CollisionSide::Top:
+			closestPoint.y = static_cast<float>(dimensions.top);
+			break;
+		case CollisionSide::Bottom:
+			closestPoint.y = static_cast<float>(dimensions.bottom);
+			break;
+		}
+
+		Vector2 normal = position - closestPoint;
+		normal.Normalize();
+
+		velocity = Vector2::Reflect(velocity, normal);
+		normal *= radius - distance;
+		position += normal;
+	}
+
+	// Whether a circle's movement reaches another circle, and where. Projectiles move far for
+	// their size, so only an exact sweep can't step over a target at a low tick rate;
+	// everything else keeps the cheaper test.
+	bool Reaches(const Vector2& position, float radius, const Vector2& movement, float movementLength, bool swept, const Vector2& target, float targetRadius, CollisionResult& result)
+	{
+		// Calculate the target vector
+		Vector2 checkVector = target - position;
+		if (checkVector.LengthSquared() <= 0.0f)
+		{
+			return false;
+		}
+
+		if (swept)
+		{
+			if (!CollisionMath::SweptCircleCircle(position, radius, movement, target, targetRadius, result.TimeOfImpact))
+			{
+				return false;
+			}
+			result.Distance = result.TimeOfImpact * movementLength;
+		}
+		else
+		{
+			if (!CollisionMath::CircleMovementReachesCircle(position, radius, movement, target, targetRadius, result.Distance))
+			{
+				return false;
+			}
+			result.TimeOfImpact = std::min(result.Distance / movementLength, 1.0f);
+		}
+
+		result.Normal = checkVector;
+		result.Normal.Normalize();
+		return true;
+	}
+}
+
+void CollisionManager::SetDimensions(RECT dimensions)
+{
+	m_dimensions = dimensions;
+	m_broadphase.Initialize(m_dimensions, broadphaseCellSize);
+	m_broadphaseGeneration = SIZE_MAX;
+}
+
 void CollisionManager::Update(float elapsedTime)
 {
 	std::lock_guard<std::mutex> lock(m_lock);
 
+	auto startTime = std::chrono::steady_clock::now();
+
 	m_collection.ApplyPendingRemovals();
+	RebuildBroadphase();
+
+	if (m_useBodyStore)
+	{
+		UpdateBodies(elapsedTime);
+	}
+	else
+	{
+		UpdateObjects(elapsedTime);
+	}
+
+	std::chrono::duration<float, std::milli> updateTime = std::chrono::steady_clock::now() - startTime;
+	m_lastUpdateMilliseconds = updateTime.count();
+}
+
+void CollisionManager::UpdateObjects(float elapsedTime)
+{
+	m_inUpdate = true;
+
+	// Explosions set off since the last update
+	ResolveExplosions();
 
 	// Move each object
-	for (auto& item : m_collection)
+	for (size_t index = 0; index < m_collection.size(); index++)
 	{
+		// Hold a strong reference while it collides. Whatever dies meanwhile stays in the
+		// collection, inactive, until the next update applies the removals.
+		auto item = m_collection[index];
 		if (item->Active())
 		{
 			// Determine how far they are going to move
@@ -44,19 +206,9 @@ void CollisionManager::Update(float elapsedTime)
 			// Dtermine the new position
 			item->Position += movement;
 
-			std::array<std::pair<CollisionSide, float>, 4> DistanceToEdge = {
-				std::pair<CollisionSide, float>{ CollisionSide::Left, item->Position.x - Dimensions().left },
-				std::pair<CollisionSide, float>{ CollisionSide::Right, Dimensions().right - item->Position.x },
-				std::pair<CollisionSide, float>{ CollisionSide::Top, item->Position.y - Dimensions().top },
-				std::pair<CollisionSide, float>{ CollisionSide::Bottom, Dimensions().bottom - item->Position.y }
-			};
-
-			auto min = std::min_element(std::begin(DistanceToEdge), std::end(DistanceToEdge), [](auto&& left, auto&& right)
-				{
-					return left.second < right.second;
-				});
-
-			if (min->second < item->Radius)
+			CollisionSide side;
+			float edgeDistance;
+			if (ReachesEdge(Dimensions(), item->Position, item->Radius, side, edgeDistance))
 			{
 				if (item->GetType() == GameplayObjectType::Projectile)
 				{
@@ -64,101 +216,210 @@ void CollisionManager::Update(float elapsedTime)
 				}
 				else
 				{
-					Vector2 closestPoint = item->Position;
-
-					switch (min->first)
-					{
-					case CollisionSide::Left:
-						closestPoint.x = static_cast<float>(Dimensions().left);
-						break;
-					case CollisionSide::Right:
-						closestPoint.x = static_cast<float>(Dimensions().right);
-						break;
-					case CollisionSide::Top:
-						closestPoint.y = static_cast<float>(Dimensions().top);
-						break;
-					case CollisionSide::Bottom:
-						closestPoint.y = static_cast<float>(Dimensions().bottom);
-						break;
-					}
-
-					Vector2 normal = item->Position - closestPoint;
-					normal.Normalize();
-
-					float distance = item->Radius - min->second;
-
-					item->Velocity = Vector2::Reflect(item->Velocity, normal);
-					normal *= distance;
-					item->Position += normal;
+					BounceOffEdge(Dimensions(), side, edgeDistance, item->Radius, item->Position, item->Velocity);
 				}
 			}
+
+			// Keep the broadphase in step so later objects this frame see the new position
+			if (m_broadphaseGeneration == m_collection.current_generation())
+			{
+				m_broadphase.Move(static_cast<uint32_t>(index), item->Position, item->Radius);
+			}
 		}
 	}
+
+	ResolveExplosions();
+
+	m_inUpdate = false;
 }
 
-void CollisionManager::Collide(GameplayObject* gameplayObject, const Vector2& movement)
+/// <summary>
+/// The same frame as UpdateObjects, run as passes over the BodyStore. Contacts are found
+/// first, all against where the objects started the frame, and handled by the objects
+/// themselves; only then does everything that didn't stop against another move its whole
+/// step, and bounce off the edges of the world. Projectiles that reached an edge die last,
+/// once the moves are written back. The explosions set off before the update, by the
+/// contacts and by the projectiles dying at the edge are each resolved after that pass.
+///
+/// Two things come out differently from UpdateObjects. No object has moved when the
+/// contacts are found, so which objects touch doesn't depend on the order they are in the
+/// collection; the walk tests each object against the ones before it at their new
+/// positions. And the bodies are gathered once, so an object added to the collection during
+/// the update waits where it was placed until the next one, even if a ship dying meanwhile
+/// flushes it into the collection; the walk would reach it and move it in the same update.
+/// The headless --body-order-test checks both.
+/// </summary>
+void CollisionManager::UpdateBodies(float elapsedTime)
 {
-	m_collisionResults.clear();
+	m_bodies.Gather(m_collection);
+	m_bodiesGathered = true;
 
-	if (!gameplayObject->Active())
-		return;
+	ResolveExplosions();
 
-	float movementLength = movement.Length();
-	if (movementLength <= 0)
-		return;
+	const uint32_t bodies = m_bodies.Size();
 
-	// Check each gameplayObject
-	for (auto& checkActor : m_collection)
+	// Only allow objects that have not collided yet this frame to collide
+	// -- otherwise, objects can "double-hit" and trade their momentum
+	for (uint32_t body = 0; body < bodies; body++)
 	{
-		if (gameplayObject == checkActor.get() || !checkActor->Active())
-			continue;
-
-		// Calculate the target vector
-		Vector2 checkVector = checkActor->Position - gameplayObject->Position;
-		float checkVectorLength = checkVector.Length();
-		if (checkVectorLength <= 0.0f)
+		if (m_bodies.Active[body] && !m_bodies.Collided[body])
 		{
-			continue;
+			if (MoveAndCollideBody(body, m_bodies.Velocities[body] * elapsedTime))
+			{
+				m_bodies.Moving[body] = false;
+			}
 		}
+	}
 
-		float combinedRadius = checkActor->Radius + gameplayObject->Radius;
-		float distanceBetween = std::max<float>(checkVectorLength - combinedRadius, 0.0f);
+	ResolveExplosions();
 
-		// Check if they could possibly touch no matter the direction
-		if (movementLength < distanceBetween)
+	for (uint32_t body = 0; body < bodies; body++)
+	{
+		if (m_bodies.Active[body] && m_bodies.Moving[body])
 		{
-			continue;
+			m_bodies.Positions[body] += m_bodies.Velocities[body] * elapsedTime;
 		}
+	}
 
-		// Determine how much of the movement is bringing the two together
-		float movementTowards = movement.Dot(checkVector);
+	m_expiredBodies.clear();
+	for (uint32_t body = 0; body < bodies; body++)
+	{
+		CollisionSide side;
+		float edgeDistance;
+		if (m_bodies.Active[body] && ReachesEdge(m_dimensions, m_bodies.Positions[body], m_bodies.Radii[body], side, edgeDistance))
+		{
+			if (m_bodies.Projectile[body])
+			{
+				m_expiredBodies.push_back(body);
+			}
+			else
+			{
+				BounceOffEdge(m_dimensions, side, edgeDistance, m_bodies.Radii[body], m_bodies.Positions[body], m_bodies.Velocities[body]);
+			}
+		}
+	}
+
+	m_bodies.Scatter();
 
-		// Check to see if the movement is away from each other
-		if (movementTowards < 0.0f)
+	// Re-bucket, so a rocket exploding against the edge below finds what is near it now
+	if (!m_expiredBodies.empty() && m_broadphase.IsInitialized())
+	{
+		for (uint32_t body = 0; body < bodies; body++)
 		{
-			continue;
+			if (m_bodies.Active[body])
+			{
+				m_broadphase.Move(body, m_bodies.Positions[body], m_bodies.Radii[body]);
+			}
 		}
+	}
 
-		if (movementTowards < distanceBetween)
+	for (uint32_t body : m_expiredBodies)
+	{
+		GameplayObject* projectile = m_bodies.Object(body);
+		if (projectile->Active())
 		{
-			continue;
+			projectile->Die(nullptr, false);
 		}
+	}
 
-		CollisionResult result;
-		result.Distance = distanceBetween;
+	ResolveExplosions();
 
-		result.Normal = checkVector;
-		result.Normal.Normalize();
-		result.GameplayObject = checkActor.get();
+	m_bodiesGathered = false;
+	m_bodies.Clear();
+}
 
-		m_collisionResults.push_back(result);
+void CollisionManager::RebuildBroadphase()
+{
+	m_broadphase.Clear();
+	for (size_t index = 0; index < m_collection.size(); index++)
+	{
+		auto& object = m_collection[index];
+		m_broadphase.Insert(static_cast<uint32_t>(index), object->Position, object->Radius);
+	}
+	m_broadphaseGeneration = m_collection.current_generation();
+}
+
+void CollisionManager::RefreshBroadphase()
+{
+	// Rebuild if the membership changed since the grid was filled. Inside Update the grid
+	// is kept current as objects move; outside of it, objects may have been placed
+	// directly (spawns, network state), so re-bucket anything that has wandered.
+	if (m_broadphaseGeneration != m_collection.current_generation())
+	{
+		RebuildBroadphase();
+	}
+	else if (!m_inUpdate)
+	{
+		for (size_t index = 0; index < m_collection.size(); index++)
+		{
+			auto& object = m_collection[index];
+			m_broadphase.Move(static_cast<uint32_t>(index), object->Position, object->Radius);
+		}
 	}
 }
 
+void CollisionManager::Collide(GameplayObject* gameplayObject, const Vector2& movement)
+{
+	m_collisionResults.clear();
+
+	if (!gameplayObject->Active())
+		return;
+
+	float movementLength = movement.Length();
+	if (movementLength <= 0)
+		return;
+
+	const bool swept = gameplayObject->GetType() == GameplayObjectType::Projectile;
+
+	// Check each gameplayObject that could be reached by this movement
+	ForEachNearby(gameplayObject->Position, movementLength + gameplayObject->Radius, [&](GameplayObject* checkActor)
+	{
+		if (gameplayObject == checkActor || !checkActor->Active())
+			return true;
+
+		CollisionResult result;
+		if (Reaches(gameplayObject->Position, gameplayObject->Radius, movement, movementLength, swept, checkActor->Position, checkActor->Radius, result))
+		{
+			result.GameplayObject = checkActor;
+			result.Body = UINT32_MAX;
+			m_collisionResults.push_back(result);
+		}
+		return true;
+	});
+}
+
+void CollisionManager::CollideBody(uint32_t body, const Vector2& movement)
+{
+	m_collisionResults.clear();
+
+	float movementLength = movement.Length();
+	if (movementLength <= 0)
+		return;
+
+	const Vector2 position = m_bodies.Positions[body];
+	const float radius = m_bodies.Radii[body];
+	const bool swept = m_bodies.Projectile[body];
+
+	// Check each body that could be reached by this movement
+	ForEachNearbyBody(position, movementLength + radius, [&](uint32_t checkBody)
+	{
+		if (body == checkBody || !m_bodies.Active[checkBody])
+			return true;
+
+		CollisionResult result;
+		if (Reaches(position, radius, movement, movementLength, swept, m_bodies.Positions[checkBody], m_bodies.Radii[checkBody], result))
+		{
+			result.GameplayObject = m_bodies.Object(checkBody);
+			result.Body = checkBody;
+			m_collisionResults.push_back(result);
+		}
+		return true;
+	});
+}
+
 Vector2 CollisionManager::FindSpawnPoint(GameplayObject* spawnedObject, float radius)
 {
 	// Try to find a valid point
-	static int maxAttemptsRequired = 1;
 	int attemptNum = 1;
 	constexpr float spawnPointPadding = 100.0f;
 	float paddedRadius = radius + spawnPointPadding;
@@ -172,19 +433,20 @@ Vector2 CollisionManager::FindSpawnPoint(GameplayObject* spawnedObject, float ra
 	{
 		bool valid = true;
 
-		// Check the other objects
-		for (auto& otherObject : m_collection)
+		// Check the other objects near the candidate point
+		ForEachNearby(spawnPoint, paddedRadius, [&](GameplayObject* otherObject)
 		{
-			if (!otherObject->Active() || otherObject.get() == spawnedObject)
+			if (!otherObject->Active() || otherObject == spawnedObject)
 			{
-				continue;
+				return true;
 			}
 			if (CollisionMath::CircleCircleIntersect(spawnPoint, paddedRadius, otherObject->Position, otherObject->Radius))
 			{
 				valid = false;
-				break;
+				return false;
 			}
-		}
+			return true;
+		});
 
 		if (valid)
 		{
@@ -198,9 +460,9 @@ Vector2 CollisionManager::FindSpawnPoint(GameplayObject* spawnedObject, float ra
 			RandomMath::RandomBetween(0.0f, m_dimensions.bottom - m_dimensions.top - radius));
 	}
 
-	if (attemptNum > maxAttemptsRequired)
+	if (attemptNum > m_maxSpawnAttemptsRequired)
 	{
-		maxAttemptsRequired = attemptNum;
+		m_maxSpawnAttemptsRequired = attemptNum;
 	}
 
 	if (attemptNum > findSpawnPointAttempts)
@@ -215,7 +477,10 @@ Vector2 CollisionManager::FindSpawnPoint(GameplayObject* spawnedObject, float ra
 }
 
 /// <summary>
-/// Process an explosion in the world against the objects in it.
+/// Process an explosion in the world against the objects in it. The explosion is queued,
+/// and resolved with any others by the end of the Update pass it went off in, or at the
+/// start of the next Update; so a chain of mines is worked through a wave at a time rather
+/// than as one blast inside another.
 /// </summary>
 /// <param name="source">The source of the explosion.</param>
 /// <param name="target">The target of the attack.</param>
@@ -230,49 +495,198 @@ void CollisionManager::Explode(GameplayObject* source, GameplayObject* target, f
 		return;
 	}
 
-	for (auto& object : m_collection)
+	if (!m_batchExplosions)
 	{
-		// Don't bother if it's already dead
-		if (!object->Active() || object->Life <= 0.0f)
+		BlastNow(source, target, damageAmount, position, damageRadius, damageOwner);
+		return;
+	}
+
+	m_explosions.push_back(Explosion{ source->shared_from_this(), target, damageAmount, position, damageRadius, damageOwner });
+}
+
+// One explosion against everything in its reach, as it goes off
+void CollisionManager::BlastNow(GameplayObject* source, GameplayObject* target, float damageAmount, const Vector2& position, float damageRadius, bool damageOwner)
+{
+	// Mid-update, skip the dead without touching them, and copy back what the blast did
+	if (m_bodiesGathered)
+	{
+		ForEachNearbyBody(position, damageRadius, [&](uint32_t body)
 		{
-			continue;
-		}
+			if (m_bodies.Active[body] && m_bodies.Lives[body] > 0.0f)
+			{
+				Blast(source, target, m_bodies.Object(body), damageAmount, position, damageRadius, damageOwner);
+				m_bodies.Refresh(body);
+			}
+			return true;
+		});
+		m_bodies.RefreshActive(m_collection.current_generation());
+		return;
+	}
+
+	ForEachNearby(position, damageRadius, [&](GameplayObject* object)
+	{
+		Blast(source, target, object, damageAmount, position, damageRadius, damageOwner);
+		return true;
+	});
+}
 
-		// Don't hurt the GameplayObject that the projectile hit, it's hurt
-		if (object.get() == target)
+/// <summary>
+/// Resolves the queued explosions, and then any they set off, a wave at a time. With the
+/// bodies gathered each wave is one pass that totals what every body takes before any of
+/// it is applied; otherwise each explosion is blasted in turn.
+/// </summary>
+void CollisionManager::ResolveExplosions()
+{
+	while (!m_explosions.empty())
+	{
+		// Whatever this wave sets off queues up for the next
+		m_resolvingExplosions.swap(m_explosions);
+
+		if (m_bodiesGathered)
 		{
-			continue;
+			BlastBodies(m_resolvingExplosions);
 		}
-
-		// Don't hit the owner if the damageOwner flag is off
-		if ((object.get() == source) && !damageOwner)
+		else
 		{
-			continue;
+			for (const Explosion& explosion : m_resolvingExplosions)
+			{
+				BlastNow(explosion.Source.get(), explosion.Target, explosion.DamageAmount, explosion.Position, explosion.DamageRadius, explosion.DamageOwner);
+			}
 		}
 
-		// Measure the distance to the GameplayObject and see if it's in range
-		float damageRadiusSquared = damageRadius * damageRadius;
-		Vector2 direction = object->Position - position;
-		float distanceSquared = direction.LengthSquared();
-		if (distanceSquared <= damageRadiusSquared)
+		m_resolvingExplosions.clear();
+	}
+}
+
+/// <summary>
+/// Finds the damage and push every gathered body takes from a wave of explosions, each
+/// found through the broadphase, and then applies them. A body hit by several explosions
+/// takes each one's damage from that explosion's source, in the order they went off, as it
+/// would have had they blasted one at a time; the pushes are added up and applied together.
+/// </summary>
+void CollisionManager::BlastBodies(const std::vector<Explosion>& explosions)
+{
+	m_blastTotals.resize(m_bodies.Size());
+
+	for (uint32_t index = 0; index < explosions.size(); index++)
+	{
+		const Explosion& explosion = explosions[index];
+		const float damageRadiusSquared = explosion.DamageRadius * explosion.DamageRadius;
+
+		ForEachNearbyBody(explosion.Position, explosion.DamageRadius, [&](uint32_t body)
 		{
-			float distance = std::sqrt(distanceSquared);
+			// Skip the dead, the target the projectile already hurt, and the owner unless it's to be hit
+			GameplayObject* object = m_bodies.Object(body);
+			if (!m_bodies.Active[body] || m_bodies.Lives[body] <= 0.0f || object == explosion.Target ||
+				(object == explosion.Source.get() && !explosion.DamageOwner))
+			{
+				return true;
+			}
+
+			Vector2 direction = m_bodies.Positions[body] - explosion.Position;
+			float distanceSquared = direction.LengthSquared();
+			if (distanceSquared > damageRadiusSquared)
+			{
+				return true;
+			}
 
 			// Adjust the amount of damage based on the distance
-			float adjustedDamage = damageAmount * (damageRadius - distance) / damageRadius;
+			float distance = std::sqrt(distanceSquared);
+			float adjustedDamage = explosion.DamageAmount * (explosion.DamageRadius - distance) / explosion.DamageRadius;
+			if (adjustedDamage <= 0.0f)
+			{
+				return true;
+			}
 
-			// If we're still damaging the GameplayObject, then apply it
-			if (adjustedDamage > 0.0f)
+			BlastTotal& total = m_blastTotals[body];
+			if (!total.Blasted)
 			{
-				object->TakeDamage(source, adjustedDamage);
+				total.Blasted = true;
+				m_blastedBodies.push_back(body);
+			}
 
-				// Move those affected by the blast
-				if (object.get() != source)
-				{
-					direction.Normalize();
-					Vector2 adjustedVelocity = direction * adjustedDamage * speedDamageRatio;
-					object->Velocity += adjustedVelocity;
-				}
+			m_blastShares.push_back(BlastShare{ body, index, adjustedDamage });
+
+			// Move those affected by the blast
+			if (object != explosion.Source.get())
+			{
+				direction.Normalize();
+				total.Impulse += direction * adjustedDamage * speedDamageRatio;
+			}
+			return true;
+		});
+	}
+
+	// Only now apply it, so every explosion in the wave found the bodies as the wave began.
+	// A share that comes after the body has been killed is dropped, as its blast would have
+	// passed over the dead.
+	for (const BlastShare& share : m_blastShares)
+	{
+		GameplayObject* object = m_bodies.Object(share.Body);
+		if (object->Active() && object->Life > 0.0f)
+		{
+			object->TakeDamage(explosions[share.Explosion].Source.get(), share.Damage);
+		}
+	}
+	m_blastShares.clear();
+
+	for (uint32_t body : m_blastedBodies)
+	{
+		BlastTotal& total = m_blastTotals[body];
+		GameplayObject* object = m_bodies.Object(body);
+
+		object->Velocity += total.Impulse;
+		m_bodies.Refresh(body);
+
+		total = BlastTotal{};
+	}
+	m_blastedBodies.clear();
+
+	m_bodies.RefreshActive(m_collection.current_generation());
+}
+
+void CollisionManager::Blast(GameplayObject* source, GameplayObject* target, GameplayObject* object, float damageAmount, const Vector2& position, float damageRadius, bool damageOwner)
+{
+	// Don't bother if it's already dead
+	if (!object->Active() || object->Life <= 0.0f)
+	{
+		return;
+	}
+
+	// Don't hurt the GameplayObject that the projectile hit, it's hurt
+	if (object == target)
+	{
+		return;
+	}
+
+	// Don't hit the owner if the damageOwner flag is off
+	if ((object == source) && !damageOwner)
+	{
+		return;
+	}
+
+	// Measure the distance to the GameplayObject and see if it's in range
+	float damageRadiusSquared = damageRadius * damageRadius;
+	Vector2 direction = object->Position - position;
+	float distanceSquared = direction.LengthSquared();
+	if (distanceSquared <= damageRadiusSquared)
+	{
+		float distance = std::sqrt(distanceSquared);
+
+		// Adjust the amount of damage based on the distance
+		float adjustedDamage = damageAmount * (damageRadius - distance) / damageRadius;
+
+		// If we're still damaging the GameplayObject, then apply it
+		if (adjustedDamage > 0.0f)
+		{
+			object->TakeDamage(source, adjustedDamage);
+
+			// Move those affected by the blast
+			if (object != source)
+			{
+				direction.Normalize();
+				Vector2 adjustedVelocity = direction * adjustedDamage * speedDamageRatio;
+				object->Velocity += adjustedVelocity;
 			}
 		}
 	}
@@ -296,9 +710,20 @@ Vector2 CollisionManager::MoveAndCollide(GameplayObject* gameplayObject, const V
 	// Determine if we had any collisions
 	if (m_collisionResults.size() > 0)
 	{
+		// Earliest touch first, so a projectile hits what it reaches first
 		std::sort(m_collisionResults.begin(), m_collisionResults.end());
+
+		const bool swept = gameplayObject->GetType() == GameplayObjectType::Projectile;
+		const Vector2 start = gameplayObject->Position;
 		for (auto& collision : m_collisionResults)
 		{
+			// A projectile touches from where its sweep met the target, so a rocket explodes
+			// at the point of impact rather than a step short of it
+			if (swept)
+			{
+				gameplayObject->Position = start + movement * collision.TimeOfImpact;
+			}
+
 			// Let the two objects touch each other, and see what happens
 			if (gameplayObject->OnTouch(collision.GameplayObject) && collision.GameplayObject->OnTouch(gameplayObject))
 			{
@@ -307,47 +732,87 @@ Vector2 CollisionManager::MoveAndCollide(GameplayObject* gameplayObject, const V
 				AdjustVelocities(gameplayObject, collision.GameplayObject);
 				return Vector2::Zero;
 			}
+
+			gameplayObject->Position = start;
 		}
 	}
 
 	return movement;
 }
 
-void CollisionManager::AdjustVelocities(GameplayObject* actor1, GameplayObject* actor2)
+/// <summary>
+/// MoveAndCollide for a gathered body. The touch itself still goes through the objects,
+/// and the bodies are refreshed from them after. Returns true if the body stopped against
+/// another, and so doesn't move this frame.
+/// </summary>
+bool CollisionManager::MoveAndCollideBody(uint32_t body, const Vector2& movement)
 {
-	// Don't adjust velocities if at least one has negative mass
-	if (actor1->Mass <= 0.0f || actor2->Mass <= 0.0f)
-	{
-		return;
-	}
+	// Make sure the movement is significant
+	if (movement.LengthSquared() <= 0.0f)
+		return false;
 
-	// Determine the vectors normal and tangent to the collision
-	Vector2 collisionNormal = actor2->Position - actor1->Position;
-	float lengthsq = collisionNormal.LengthSquared();
-	if (lengthsq > 0.0f)
-	{
-		collisionNormal /= sqrt(lengthsq);
-	}
-	else
+	// Generate the list of collisions
+	CollideBody(body, movement);
+	if (m_collisionResults.empty())
+		return false;
+
+	// Earliest touch first, so a projectile hits what it reaches first
+	std::sort(m_collisionResults.begin(), m_collisionResults.end());
+
+	GameplayObject* gameplayObject = m_bodies.Object(body);
+	const bool swept = m_bodies.Projectile[body];
+	const Vector2 start = m_bodies.Positions[body];
+	bool stopped = false;
+	for (auto& collision : m_collisionResults)
 	{
-		return;
+		// A projectile touches from where its sweep met the target
+		if (swept)
+		{
+			gameplayObject->Position = start + movement * collision.TimeOfImpact;
+		}
+
+		// Let the two objects touch each other, and see what happens
+		if (gameplayObject->OnTouch(collision.GameplayObject) && collision.GameplayObject->OnTouch(gameplayObject))
+		{
+			gameplayObject->CollidedThisFrame = collision.GameplayObject->CollidedThisFrame = true;
+			// They should react to the other, even if they just died
+			m_bodies.Refresh(body);
+			m_bodies.Refresh(collision.Body);
+			AdjustBodyVelocities(body, collision.Body);
+			stopped = true;
+		}
+		else
+		{
+			gameplayObject->Position = start;
+		}
+
+		m_bodies.Refresh(collision.Body);
+		if (stopped)
+		{
+			break;
+		}
 	}
 
-	Vector2 collisionTangent = Vector2(-collisionNormal.y, collisionNormal.x);
+	m_bodies.Refresh(body);
+	m_bodies.RefreshActive(m_collection.current_generation());
+	return stopped;
+}
 
-	// Determine the velocity components along the normal and tangent vectors
-	float velocityNormal1 = actor1->Velocity.Dot(collisionNormal);
-	float velocityTangent1 = actor1->Velocity.Dot(collisionTangent);
-	float velocityNormal2 = actor2->Velocity.Dot(collisionNormal);
-	float velocityTangent2 = actor2->Velocity.Dot(collisionTangent);
+void CollisionManager::AdjustVelocities(GameplayObject* actor1, GameplayObject* actor2)
+{
+	Rebound(actor1->Position, actor1->Mass, actor1->Velocity, actor2->Position, actor2->Mass, actor2->Velocity);
+}
 
-	// Determine the new velocities along the normal
-	float massDelta = actor1->Mass - actor2->Mass;
-	float massSum = actor1->Mass + actor2->Mass;
-	float velocityNormal1New = ((velocityNormal1 * massDelta) + (2.0f * actor2->Mass * velocityNormal2)) / massSum;
-	float velocityNormal2New = ((velocityNormal2 * -massDelta) + (2.0f * actor1->Mass * velocityNormal1)) / massSum;
+/// <summary>
+/// AdjustVelocities for two gathered bodies, from their arrays. The new velocities go
+/// through to the objects as well, which stay the authority until the bodies are scattered.
+/// </summary>
+void CollisionManager::AdjustBodyVelocities(uint32_t body1, uint32_t body2)
+{
+	Rebound(
+		m_bodies.Positions[body1], m_bodies.Masses[body1], m_bodies.Velocities[body1],
+		m_bodies.Positions[body2], m_bodies.Masses[body2], m_bodies.Velocities[body2]);
 
-	// Determine the new total velocities
-	actor1->Velocity = (velocityNormal1New * collisionNormal) + (velocityTangent1 * collisionTangent);
-	actor2->Velocity = (velocityNormal2New * collisionNormal) + (velocityTangent2 * collisionTangent);
+	m_bodies.Object(body1)->Velocity = m_bodies.Velocities[body1];
+	m_bodies.Object(body2)->Velocity = m_bodies.Velocities[body2];
 }
\ No newline at end of file
@@ -8,6 +8,8 @@
 
 #include "Manager.h"
 #include "BatchRemovalCollection.h"
+#include "SpatialHash.h"
+#include "BodyStore.h"
 
 namespace NetRumble
 {
@@ -17,10 +19,16 @@ namespace NetRumble
 	struct CollisionResult
 	{
 		float                           Distance;
+		// Fraction of the movement at which the objects touch
+		float                           TimeOfImpact;
 		DirectX::SimpleMath::Vector2    Normal;
-		GameplayObject* GameplayObject;
+		NetRumble::GameplayObject* GameplayObject;
+		// Which body it is, while an update has them gathered
+		uint32_t                        Body;
 
-		bool operator<(const CollisionResult& rhs) const { return Distance < rhs.Distance; }
+		// Touches at the same moment go to the earlier body, so the order does not depend on
+		// the order the broadphase found them in
+		bool operator<(const CollisionResult& rhs) const { return TimeOfImpact < rhs.TimeOfImpact || (TimeOfImpact == rhs.TimeOfImpact && Body < rhs.Body); }
 	};
 
 	class CollisionManager : public Manager
@@ -28,13 +36,37 @@ namespace NetRumble
 	public:
 		BatchRemovalCollection<std::shared_ptr<GameplayObject>>& Collection() { return m_collection; }
 		RECT Dimensions() const { return m_dimensions; }
-		void SetDimensions(RECT dimensions) { m_dimensions = dimensions; }
+		void SetDimensions(RECT dimensions);
 		std::vector<RECT>& Barriers() { return m_barriers; }
 		void Update(float elapsedTime);
 		void Collide(GameplayObject* gameplayObject, const DirectX::SimpleMath::Vector2& movement);
 		DirectX::SimpleMath::Vector2 FindSpawnPoint(GameplayObject* gameplayObject, float radius);
 		void Explode(GameplayObject* source, GameplayObject* target, float damageAmount, const DirectX::SimpleMath::Vector2& position, float damageRadius, bool damageOwner);
 
+		// Switch between the spatial hash and the original all-pairs scan, for profiling.
+		bool UseBroadphase() const { return m_useBroadphase; }
+		void SetUseBroadphase(bool useBroadphase) { m_useBroadphase = useBroadphase; }
+		float LastUpdateMilliseconds() const { return m_lastUpdateMilliseconds; }
+
+		// Switch between moving the objects through the BodyStore's arrays and the original
+		// walk over the objects themselves, for profiling. The two differ in order: the walk
+		// tests each object against those that have already moved this update, the BodyStore
+		// tests everything against where it started; see UpdateBodies.
+		bool UseBodyStore() const { return m_useBodyStore; }
+		void SetUseBodyStore(bool useBodyStore) { m_useBodyStore = useBodyStore; }
+
+		// True while the walk is going through the collection. Removals applied then would
+		// swap objects it has yet to reach into places it has already passed.
+		bool IsWalkingObjects() const { return m_inUpdate; }
+
+		// Switch between resolving explosions together during Update and the original blast
+		// as each one goes off, for profiling.
+		bool BatchExplosions() const { return m_batchExplosions; }
+		void SetBatchExplosions(bool batchExplosions) { m_batchExplosions = batchExplosions; }
+
+		// Forgets explosions not yet resolved, when the world they went off in is torn down
+		void CancelExplosions() { m_explosions.clear(); }
+
 	private:
 		// The ratio of speed to damage applied, for explosions.
 		static constexpr float speedDamageRatio = 0.5f;
@@ -42,14 +74,136 @@ namespace NetRumble
 		// The number of times that the FindSpawnPoint method will try to find a point.
 		static constexpr int findSpawnPointAttempts = 25;
 
+		// Edge length of a broadphase cell; a few ship diameters keeps the buckets small.
+		static constexpr float broadphaseCellSize = 128.0f;
+
+		struct Explosion
+		{
+			// Held so a pooled projectile isn't launched again before its blast is resolved
+			std::shared_ptr<GameplayObject> Source;
+			GameplayObject* Target;
+			float DamageAmount;
+			DirectX::SimpleMath::Vector2 Position;
+			float DamageRadius;
+			bool DamageOwner;
+		};
+
+		// The push one body takes from the explosions resolved together
+		struct BlastTotal
+		{
+			DirectX::SimpleMath::Vector2 Impulse = DirectX::SimpleMath::Vector2::Zero;
+			bool Blasted = false;
+		};
+
+		// The damage one explosion does to one body, credited to that explosion's source
+		struct BlastShare
+		{
+			uint32_t Body;
+			uint32_t Explosion;
+			float Damage;
+		};
+
+		void UpdateObjects(float elapsedTime);
+		void UpdateBodies(float elapsedTime);
+
 		DirectX::SimpleMath::Vector2 MoveAndCollide(GameplayObject* gameplayObject, const DirectX::SimpleMath::Vector2& movement);
+		void CollideBody(uint32_t body, const DirectX::SimpleMath::Vector2& movement);
+		bool MoveAndCollideBody(uint32_t body, const DirectX::SimpleMath::Vector2& movement);
 		void AdjustVelocities(GameplayObject* actor1, GameplayObject* actor2);
+		void AdjustBodyVelocities(uint32_t body1, uint32_t body2);
+		void Blast(GameplayObject* source, GameplayObject* target, GameplayObject* object, float damageAmount, const DirectX::SimpleMath::Vector2& position, float damageRadius, bool damageOwner);
+		void BlastNow(GameplayObject* source, GameplayObject* target, float damageAmount, const DirectX::SimpleMath::Vector2& position, float damageRadius, bool damageOwner);
+		void ResolveExplosions();
+		void BlastBodies(const std::vector<Explosion>& explosions);
+		void RebuildBroadphase();
+		void RefreshBroadphase();
+
+		template<typename Func>
+		void ForEachNearby(const DirectX::SimpleMath::Vector2& center, float radius, Func&& func);
+
+		template<typename Func>
+		void ForEachNearbyBody(const DirectX::SimpleMath::Vector2& center, float radius, Func&& func);
 
 		BatchRemovalCollection<std::shared_ptr<GameplayObject>> m_collection;
 		RECT m_dimensions;
 		std::vector<RECT> m_barriers;
 		std::vector<CollisionResult> m_collisionResults;
+		BodyStore m_bodies;
+		std::vector<uint32_t> m_expiredBodies;
+		std::vector<Explosion> m_explosions;
+		std::vector<Explosion> m_resolvingExplosions;
+		std::vector<BlastTotal> m_blastTotals;
+		std::vector<BlastShare> m_blastShares;
+		std::vector<uint32_t> m_blastedBodies;
 		std::mutex m_lock;
+
+		SpatialHash m_broadphase;
+		size_t m_broadphaseGeneration = SIZE_MAX;
+		int m_maxSpawnAttemptsRequired = 1;
+		bool m_inUpdate = false;
+		bool m_bodiesGathered = false;
+		bool m_useBroadphase = true;
+		bool m_useBodyStore = true;
+		bool m_batchExplosions = true;
+		float m_lastUpdateMilliseconds = 0.0f;
 	};
 
+	/// <summary>
+	/// Visits every object in the collection that could be within radius of center.
+	/// The callback returns false to stop visiting.
+	/// </summary>
+	template<typename Func>
+	void CollisionManager::ForEachNearby(const DirectX::SimpleMath::Vector2& center, float radius, Func&& func)
+	{
+		if (m_bodiesGathered)
+		{
+			ForEachNearbyBody(center, radius, [&](uint32_t body)
+				{
+					return func(m_bodies.Object(body));
+				});
+			return;
+		}
+
+		if (!m_useBroadphase || !m_broadphase.IsInitialized())
+		{
+			for (auto& object : m_collection)
+			{
+				if (!func(object.get()))
+				{
+					return;
+				}
+			}
+			return;
+		}
+
+		RefreshBroadphase();
+		m_broadphase.Query(center, radius, [&](uint32_t index)
+			{
+				return func(m_collection[index].get());
+			});
+	}
+
+	/// <summary>
+	/// Visits every gathered body that could be within radius of center. The broadphase was
+	/// filled in body order when they were gathered, and is not rebuilt while they are.
+	/// The callback returns false to stop visiting.
+	/// </summary>
+	template<typename Func>
+	void CollisionManager::ForEachNearbyBody(const DirectX::SimpleMath::Vector2& center, float radius, Func&& func)
+	{
+		if (!m_useBroadphase || !m_broadphase.IsInitialized())
+		{
+			for (uint32_t body = 0; body < m_bodies.Size(); body++)
+			{
+				if (!func(body))
+				{
+					return;
+				}
+			}
+			return;
+		}
+
+		m_broadphase.Query(center, radius, func);
+	}
+
 }
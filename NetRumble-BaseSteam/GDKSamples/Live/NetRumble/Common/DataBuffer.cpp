@@ -9,7 +9,7 @@
 
 using namespace NetRumble;
 
-DataBufferReader::DataBufferReader(const std::vector<uint8_t>& buffer) :
+DataBufferReader::DataBufferReader(DataBufferView buffer) :
 	m_pos(0),
 	m_buffer(buffer)
 {
@@ -51,6 +51,22 @@ uint64_t DataBufferReader::ReadUInt64()
 	return data;
 }
 
+uint32_t DataBufferReader::ReadVarUInt32()
+{
+	uint32_t data = 0;
+	for (uint32_t shift = 0; shift < 35; shift += 7)
+	{
+		uint8_t group = ReadByte();
+		data |= static_cast<uint32_t>(group & 0x7f) << shift;
+		if ((group & 0x80) == 0)
+		{
+			return data;
+		}
+	}
+
+	throw std::runtime_error("Ill-formed variable length integer");
+}
+
 float DataBufferReader::ReadSingle()
 {
 	float data;
@@ -71,8 +87,12 @@ double DataBufferReader::ReadDouble()
 
 std::string DataBufferReader::ReadString()
 {
-	size_t length;
-	ReadData(&length, sizeof(length));
+	size_t length = ReadVarUInt32();
+
+	if (length > RemainingBytes())
+	{
+		throw std::runtime_error("Attempted to read beyond the length of the buffer");
+	}
 
 	const char* start = reinterpret_cast<const char*>(m_buffer.data() + m_pos);
 	const char* end = start + (length / sizeof(char));
@@ -120,6 +140,16 @@ void DataBufferWriter::WriteUInt64(uint64_t data)
 	WriteData(&data, sizeof(data));
 }
 
+void DataBufferWriter::WriteVarUInt32(uint32_t data)
+{
+	while (data >= 0x80)
+	{
+		WriteByte(static_cast<uint8_t>((data & 0x7f) | 0x80));
+		data >>= 7;
+	}
+	WriteByte(static_cast<uint8_t>(data));
+}
+
 void DataBufferWriter::WriteSingle(float data)
 {
 	WriteData(&data, sizeof(data));
@@ -133,7 +163,7 @@ void DataBufferWriter::WriteDouble(double data)
 void DataBufferWriter::WriteString(std::string_view data)
 {
 	size_t length = data.length() * sizeof(char);
-	WriteData(&length, sizeof(size_t));
+	WriteVarUInt32(static_cast<uint32_t>(length));
 	WriteData(data.data(), length);
 }
 
@@ -6,19 +6,24 @@
 
 #pragma once
 
+#include "ArrayView.h"
+
 namespace NetRumble
 {
+	// Non-owning view over serialized bytes, either a std::vector or a transport receive buffer
+	using DataBufferView = NetRunbleTools::ArrayView<const uint8_t>;
 
 	class DataBufferReader
 	{
 	public:
-		DataBufferReader(const std::vector<uint8_t>& buffer);
+		DataBufferReader(DataBufferView buffer);
 
 		uint8_t ReadByte(void);
 
 		int32_t ReadInt32(void);
 		uint32_t ReadUInt32(void);
 		uint64_t ReadUInt64(void);
+		uint32_t ReadVarUInt32(void);
 
 		float ReadSingle(void);
 		double ReadDouble(void);
@@ -38,7 +43,7 @@ namespace NetRumble
 		void ReadData(void* dest, size_t length);
 
 		size_t m_pos;
-		const std::vector<uint8_t>& m_buffer;
+		DataBufferView m_buffer;
 	};
 
 	class DataBufferWriter
@@ -51,6 +56,8 @@ namespace NetRumble
 		void WriteInt32(int32_t data);
 		void WriteUInt32(uint32_t data);
 		void WriteUInt64(uint64_t data);
+		// 7 bits per byte, high bit set while more bytes follow
+		void WriteVarUInt32(uint32_t data);
 
 		void WriteSingle(float data);
 		void WriteDouble(double data);
@@ -65,6 +72,11 @@ namespace NetRumble
 
 		std::vector<uint8_t>&& GetBuffer();
 
+		// Rewinds the writer but keeps its buffer, so a long-lived writer stops allocating once warmed up
+		void Reset() { m_pos = 0; }
+		// The bytes written so far; invalidated by the next write or Reset
+		DataBufferView View() const { return DataBufferView(m_buffer.data(), m_pos); }
+
 		size_t TotalBytes() { return m_pos; }
 
 	private:
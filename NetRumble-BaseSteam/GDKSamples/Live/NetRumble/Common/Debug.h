@@ -7,16 +7,87 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 #define DEBUG_LOGGING
 #define DEBUG_LOG_CREATE_NEW_ON_LAUNCH          1
 #define DEBUG_LOG_FILENAME                      "NetRumbleDebugLog-"
 #define DEBUG_LOG_ENTRY_PREFIX                  "NETRUMBLE: "
 
+// Per-packet logging is compiled out unless this is defined; even then, only one line in
+// DEBUG_LOG_PACKET_SAMPLE_RATE is kept so the log shows traffic without flooding
+//#define DEBUG_LOG_PACKETS
+#define DEBUG_LOG_PACKET_SAMPLE_RATE            60
+
+enum class LogCategory : uint32_t
+{
+	General,        // Lifecycle, state changes and errors
+	Packet,         // Individual network messages, sent and received
+	Count
+};
+
+enum class LogLevel : uint32_t
+{
+	Off,
+	Error,
+	Info,
+	Verbose
+};
+
+// Lines are queued to a background thread that owns the log file and writes them in
+// batches, so the calling thread only pays for formatting
 void DebugInit();
-std::string DebugWrite(const char* format, ...);
+void DebugShutdown();
+void DebugWrite(const char* format, ...);
+
+#ifdef NETRUMBLE_HEADLESS
+// The headless server only logs to stderr when asked to
+void DebugSetEnabled(bool enabled);
+#endif
+
+// Runtime filtering: the most detailed level logged per category, and keeping one line in N
+inline std::atomic<uint32_t> g_debugLogLevels[static_cast<size_t>(LogCategory::Count)] = { static_cast<uint32_t>(LogLevel::Verbose), static_cast<uint32_t>(LogLevel::Verbose) };
+inline std::atomic<uint32_t> g_debugSampleRates[static_cast<size_t>(LogCategory::Count)] = { 1, DEBUG_LOG_PACKET_SAMPLE_RATE };
+
+inline void DebugSetLevel(LogCategory category, LogLevel level)
+{
+	g_debugLogLevels[static_cast<size_t>(category)].store(static_cast<uint32_t>(level), std::memory_order_relaxed);
+}
+
+inline void DebugSetSampleRate(LogCategory category, uint32_t oneIn)
+{
+	g_debugSampleRates[static_cast<size_t>(category)].store(oneIn > 0 ? oneIn : 1, std::memory_order_relaxed);
+}
+
+inline bool DebugShouldLog(LogCategory category, LogLevel level)
+{
+	size_t index = static_cast<size_t>(category);
+	if (static_cast<uint32_t>(level) > g_debugLogLevels[index].load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	uint32_t sampleRate = g_debugSampleRates[index].load(std::memory_order_relaxed);
+	if (sampleRate <= 1)
+	{
+		return true;
+	}
+
+	thread_local uint32_t sampleCounters[static_cast<size_t>(LogCategory::Count)] = {};
+	return (sampleCounters[index]++ % sampleRate) == 0;
+}
 
 #ifdef DEBUG_LOGGING
-#define DEBUGLOG(x, ...)    DebugWrite(x, __VA_ARGS__)
-#elif
+#define DEBUGLOG(x, ...)    DebugWrite(x, ##__VA_ARGS__)
+#define DEBUGLOG_CATEGORY(category, level, x, ...)    do { if (DebugShouldLog(category, level)) { DebugWrite(x, ##__VA_ARGS__); } } while (0)
+#else
 #define DEBUGLOG(x, ...)
+#define DEBUGLOG_CATEGORY(category, level, x, ...)
+#endif
+
+#if defined(DEBUG_LOGGING) && defined(DEBUG_LOG_PACKETS)
+#define DEBUGLOG_PACKET(x, ...)    DEBUGLOG_CATEGORY(LogCategory::Packet, LogLevel::Verbose, x, ##__VA_ARGS__)
+#else
+#define DEBUGLOG_PACKET(x, ...)
 #endif
\ No newline at end of file
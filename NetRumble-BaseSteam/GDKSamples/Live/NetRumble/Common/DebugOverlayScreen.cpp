@@ -34,21 +34,21 @@ void DebugOverlayScreen::Draw(float totalTime, float elapsedTime)
 	// Draw a status line for each player
 	int count = 0;
 	XMVECTOR lineWidth = spriteFont->MeasureString("X");
-	std::vector<std::shared_ptr<PlayerState>> playerStates = g_game->GetAllPlayerStates();
+	PlayerRoster::View playerStates = g_game->GetPlayers();
 
 	if (playerStates.size() > 0)
 	{
-		for (const auto& playerState : playerStates)
+		for (PlayerState* playerState : playerStates)
 		{
 			if (playerState != nullptr)
 			{
-				std::shared_ptr<Ship> ship = playerState->GetShip();
+				const std::shared_ptr<Ship>& ship = playerState->GetShip();
 				char buffer[512]{};
 
 				sprintf_s(
 					buffer,
 					512,
-					"%-20s[%15llu]%4s%4s%4s%4sPos: %010.4f, %010.4f Vel: %010.4f, %010.4f LS: %010.4f, %010.4f RS %010.4f, %010.4f",
+					"%-20s[%15llu]%4s%4s%4s%4sPos: %010.4f, %010.4f Vel: %010.4f, %010.4f LS: %010.4f, %010.4f RS %010.4f, %010.4f WD: %6.0f B/s",
 					playerState->DisplayName.empty() ? "[NONAMEYET]" : playerState->DisplayName.c_str(),
 					playerState->PeerId,
 					playerState->InGame ? "GME" : "",
@@ -62,7 +62,8 @@ void DebugOverlayScreen::Draw(float totalTime, float elapsedTime)
 					ship ? ship->Input.LeftStick.x : 0.0f,
 					ship ? ship->Input.LeftStick.y : 0.0f,
 					ship ? ship->Input.RightStick.x : 0.0f,
-					ship ? ship->Input.RightStick.y : 0.0f
+					ship ? ship->Input.RightStick.y : 0.0f,
+					playerState->WorldDataBandwidth.BytesPerSecond()
 				);
 
 				renderContext->DrawString(
@@ -115,6 +116,20 @@ void DebugOverlayScreen::Draw(float totalTime, float elapsedTime)
 
 	count++;
 
+	const std::unique_ptr<World>& world = g_game->GetWorld();
+	msgStr = "WorldDataReceivedBytesPerSecond : " + std::to_string(world ? static_cast<int>(world->GetWorldDataBytesPerSecondReceived()) : 0);
+	scale = 0.50f * GetScaleMultiplierForViewport(viewportWidth, viewportHeight);
+	renderContext->DrawString(
+		spriteFont,
+		msgStr.c_str(),
+		XMFLOAT2(c_UserInfoLeft, c_UserInfoTop + (count * (XMVectorGetY(lineWidth) * scale))),
+		Colors::Yellow,
+		0,
+		XMFLOAT2(0.0f, spriteFont->GetLineSpacing() / 2.0f),
+		scale
+	);
+	count++;
+
 	msgStr = "DeathCount : " + std::to_string(Managers::Get<SteamOnlineManager>()->GetDeathCount());
 	scale = 0.50f * GetScaleMultiplierForViewport(viewportWidth, viewportHeight);
 	renderContext->DrawString(
@@ -154,6 +169,58 @@ void DebugOverlayScreen::Draw(float totalTime, float elapsedTime)
 	);
 	count++;
 
+	// Average CPU time per frame system, then the sections measured inside them
+	const FrameScheduler& scheduler = g_game->GetScheduler();
+	char timingBuffer[64]{};
+	sprintf_s(timingBuffer, "FrameUpdateMs : %5.2f", scheduler.GetLastFrameMilliseconds());
+	msgStr = timingBuffer;
+	std::string sectionStr = "SectionMs :";
+	for (const auto& timing : scheduler.GetTimings())
+	{
+		sprintf_s(timingBuffer, " %s%s %5.2f", std::string(static_cast<size_t>(std::max(timing.Depth - 1, 0)), '>').c_str(), timing.Name.c_str(), timing.AverageMilliseconds);
+		(timing.Depth == 0 ? msgStr : sectionStr) += timingBuffer;
+	}
+
+	for (const std::string& timingStr : { msgStr, sectionStr })
+	{
+		scale = 0.50f * GetScaleMultiplierForViewport(viewportWidth, viewportHeight);
+		renderContext->DrawString(
+			spriteFont,
+			timingStr.c_str(),
+			XMFLOAT2(c_UserInfoLeft, c_UserInfoTop + (count * (XMVectorGetY(lineWidth) * scale))),
+			Colors::Yellow,
+			0,
+			XMFLOAT2(0.0f, spriteFont->GetLineSpacing() / 2.0f),
+			scale
+		);
+		count++;
+	}
+
+	// How long server messages wait to be applied, and how steady the frame stays meanwhile
+	const SteamOnlineManager* onlineManager = Managers::Get<SteamOnlineManager>();
+	const ApplyLatency& applyLatency = onlineManager->GetApplyLatency();
+	char networkBuffer[128]{};
+	sprintf_s(
+		networkBuffer,
+		"NetworkThread : %s ApplyMs : %5.2f (max %5.2f) FrameMs : %5.2f +/- %5.2f",
+		onlineManager->IsNetworkThreadEnabled() ? "on" : "off",
+		applyLatency.AverageMilliseconds,
+		applyLatency.MaxMilliseconds,
+		scheduler.GetAverageFrameMilliseconds(),
+		scheduler.GetFrameDeviationMilliseconds());
+	msgStr = networkBuffer;
+	scale = 0.50f * GetScaleMultiplierForViewport(viewportWidth, viewportHeight);
+	renderContext->DrawString(
+		spriteFont,
+		msgStr.c_str(),
+		XMFLOAT2(c_UserInfoLeft, c_UserInfoTop + (count * (XMVectorGetY(lineWidth) * scale))),
+		Colors::Yellow,
+		0,
+		XMFLOAT2(0.0f, spriteFont->GetLineSpacing() / 2.0f),
+		scale
+	);
+	count++;
+
 	msgStr = "DebugLogMessage: " + g_game->m_OutputMessage;
 	scale = 0.50f * GetScaleMultiplierForViewport(viewportWidth, viewportHeight);
 	renderContext->DrawString(
@@ -12,7 +12,6 @@ using namespace DirectX::SimpleMath;
 
 GamePlayScreen::GamePlayScreen() :
 	GameScreen(),
-	m_frameTime(0),
 	m_isFailureEventReceived { false }
 {
 	m_playerFont = Managers::Get<ContentManager>()->LoadFont(L"Assets\\Fonts\\SegoeUI_64.spritefont");
@@ -34,34 +33,18 @@ void GamePlayScreen::HandleInput(float elapsedTime)
 	InputManager* inputManager = Managers::Get<InputManager>();
 
 	// Pass input along to the local ship
-	std::shared_ptr<PlayerState> localPlayerState = g_game->GetLocalPlayerState();
-	std::shared_ptr<Ship> localShip = localPlayerState->GetShip();
+	PlayerState* localPlayerState = g_game->GetLocalPlayer();
+	const std::shared_ptr<Ship>& localShip = localPlayerState->GetShip();
 	if (localShip->Active() && !g_game->IsGameWon())
 	{
-		localShip->Input = ShipInput(inputManager->CurrentGamePadState);
-		localShip->Input.Add(ShipInput(inputManager->CurrentKeyboardState()));
-
-		m_frameTime += elapsedTime;
-
-		// Send ShipInput Message when the status of the ship changed,
-		// and the send interval should be at least (elapsedTime * 2)
-		if (m_frameTime >= elapsedTime * 2 &&
-			(localShip->Input.LeftStick != SimpleMath::Vector2(0.0f, 0.0f) ||
-			localShip->Input.RightStick != SimpleMath::Vector2(0.0f, 0.0f) ||
-			localShip->Input.MineFired))
-		{
-			m_frameTime = 0.0f;
-			Managers::Get<OnlineManager>()->SendGameMessageWithSourceID(
-				GameMessage(
-					GameMessageType::ShipInput,
-					localShip->Serialize()
-				)
-			);
-		}
+		// The world's steps turn this into moves, one each, and send them to the host
+		ShipInput input(inputManager->CurrentGamePadState);
+		input.Add(ShipInput(inputManager->CurrentKeyboardState()));
+		localShip->HoldInput(input);
 	}
 	else
 	{
-		localShip->Input = ShipInput();
+		localShip->ClearHeldInput();
 	}
 
 	if (g_game->IsGameWon())
@@ -130,7 +113,7 @@ void GamePlayScreen::DrawHud(float elapsedTime)
 
 	renderContext->Begin();
 
-	std::vector<std::shared_ptr<PlayerState>> playerStates = g_game->GetAllPlayerStates();
+	PlayerRoster::View playerStates = g_game->GetPlayers();
 	std::vector<uint16_t> playerIds = std::vector<uint16_t>();
 	size_t count = playerStates.size();
 
@@ -145,7 +128,7 @@ void GamePlayScreen::DrawHud(float elapsedTime)
 	// Draw players 0 - 3 at the top of the screen
 	for (uint32_t i = 0; i < std::min<size_t>(static_cast<size_t>(4), count); ++i)
 	{
-		std::shared_ptr<PlayerState> playerState = playerStates[i];
+		PlayerState* playerState = playerStates[i];
 		if (playerState)
 		{
 			std::string memberName = DX::ChsToUtf8(playerState->DisplayName);
@@ -157,7 +140,7 @@ void GamePlayScreen::DrawHud(float elapsedTime)
 			renderContext->DrawString(m_playerFont, memberName, namePosition, memberColor, 0, fontOrigin, playerNameScale);
 			memberName = playerState->DisplayName;
 			// Draw score and respawn counter centered underneath each name
-			std::shared_ptr<Ship> ship = playerState->GetShip();
+			const std::shared_ptr<Ship>& ship = playerState->GetShip();
 			std::string memberData = std::to_string(ship->Score);
 
 			float scoreLen = (playerNameScale * Vector2(m_scoreFont->MeasureString(memberData.c_str())).x) / 2;
@@ -171,7 +154,7 @@ void GamePlayScreen::DrawHud(float elapsedTime)
 	{
 		memberPositions[i % 4].y = viewportHeight * 0.9f;
 
-		std::shared_ptr<PlayerState> playerState = playerStates[i];
+		PlayerState* playerState = playerStates[i];
 		if (playerState)
 		{
 			std::string memberName = playerState->DisplayName;
@@ -180,7 +163,7 @@ void GamePlayScreen::DrawHud(float elapsedTime)
 			renderContext->DrawString(m_playerFont, memberName, memberPositions[i % 4], memberColor, 0, fontOrigin, playerNameScale);
 			memberName = playerState->DisplayName;
 			// Draw score and respawn counter centered underneath each name
-			std::shared_ptr<Ship> ship = playerState->GetShip();
+			const std::shared_ptr<Ship>& ship = playerState->GetShip();
 			std::string memberData = std::to_string(ship->Score);
 			if (!ship->Active() && ship->RespawnTimer > 0.0f)
 			{
@@ -193,7 +176,7 @@ void GamePlayScreen::DrawHud(float elapsedTime)
 	}
 
 	// Draw a spawn countdown text message for the local user when appropriate
-	std::shared_ptr<Ship> localShip = g_game->GetLocalPlayerState()->GetShip();
+	const std::shared_ptr<Ship>& localShip = g_game->GetLocalPlayer()->GetShip();
 	if (!g_game->IsGameWon() && !localShip->Active() && localShip->RespawnTimer > 0.0f)
 	{
 		std::string respawnMessage = "Spawning in " + std::to_string(1 + static_cast<int>(localShip->RespawnTimer));
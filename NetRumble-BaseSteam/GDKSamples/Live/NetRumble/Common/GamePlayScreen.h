@@ -30,7 +30,6 @@ namespace NetRumble
 
 		bool m_isFailureEventReceived;
 		float m_countdownTimer;
-		float m_frameTime;
 
 		std::string m_connectFailInGameMessage;
 
@@ -6,6 +6,7 @@
 
 #pragma once
 #include "RenderContext.h"
+#include "BatchRemovalCollection.h"
 
 namespace NetRumble
 {
@@ -44,6 +45,45 @@ namespace NetRumble
 
 		inline bool Active() const { return m_active; }
 
+		// What a rollback saves of an object: the fields every object simulates, and room for
+		// the timer or flag a subclass's Update also reads
+		struct SavedState
+		{
+			DirectX::SimpleMath::Vector2 Position;
+			DirectX::SimpleMath::Vector2 Velocity;
+			float Rotation;
+			float Radius;
+			float Mass;
+			float Life;
+			float Timer;
+			bool Flag;
+			bool Active;
+			bool CollidedThisFrame;
+		};
+
+		virtual void SaveState(SavedState& state) const;
+
+		// Leaves the collision system alone; the world puts objects back into it in the order
+		// they were saved, which the simulation depends on
+		virtual void RestoreState(const SavedState& state);
+
+		// Rejoin the collision system behind whatever has rejoined so far
+		void RejoinCollision();
+
+		// Become inactive without queueing a removal, for when the whole collection is cleared
+		inline void LeaveCollision() { m_active = false; }
+
+		// Drawing between fixed steps. The world records where each step starts every object;
+		// BeginStepBlend moves it blend of the way from there to where the step left it, and
+		// EndStepBlend puts the simulated pose back before anything else can see the drawn one.
+		inline void RecordStepStart() { m_stepStartPosition = Position; m_stepStartRotation = Rotation; m_hasStepStart = true; }
+		void BeginStepBlend(float blend);
+		void EndStepBlend();
+
+		// An object that went further than this in one step was placed there, not flown, and is
+		// drawn where it is
+		static constexpr float c_MaximumStepBlendDistance = 100.0f;
+
 		DirectX::SimpleMath::Vector2 Position = DirectX::SimpleMath::Vector2::Zero;
 		float Rotation = 0.0f;
 		float Radius = 1.0f;
@@ -61,6 +101,17 @@ namespace NetRumble
 
 	private:
 		uint32_t m_uniqueID;
+
+		// Where this object sits in the collision system while it is active
+		BatchRemovalCollection<std::shared_ptr<GameplayObject>>::handle m_collisionHandle;
+
+		// Pose at the start of the current step, and the simulated one while a blended one is drawn
+		DirectX::SimpleMath::Vector2 m_stepStartPosition = DirectX::SimpleMath::Vector2::Zero;
+		float m_stepStartRotation = 0.0f;
+		bool m_hasStepStart = false;
+		DirectX::SimpleMath::Vector2 m_simulatedPosition = DirectX::SimpleMath::Vector2::Zero;
+		float m_simulatedRotation = 0.0f;
+
 		static std::atomic_uint32_t nextUniqueID;
 	};
 
@@ -6,14 +6,25 @@
 
 #include "pch.h"
 
-#include <vcruntime_typeinfo.h>
+#include <typeinfo>
 
 using namespace NetRumble;
 
-std::unordered_map<size_t, std::unique_ptr<Manager>> Managers::m_managersByType;
+Managers::Registry Managers::m_managersByType;
+#ifdef NETRUMBLE_HEADLESS
+thread_local Managers::Registry* Managers::m_boundRegistry = nullptr;
+#endif
 
 void Managers::Initialize()
 {
+#ifdef NETRUMBLE_HEADLESS
+	AddManager<AudioManager>();
+	AddManager<RenderManager>();
+	AddManager<ContentManager>();
+	AddManager<CollisionManager>();
+	AddManager<ParticleEffectManager>();
+	AddManager<OnlineManager>();
+#else
 	AddManager<AsyncTaskManager>();
 	AddManager<AudioManager>();
 	AddManager<RenderManager>();
@@ -28,4 +39,5 @@ void Managers::Initialize()
 	AddManager<OnlineManager>();
 
 	AddManager<GameEventManager>();
+#endif
 }
@@ -8,6 +8,16 @@
 
 #include "Manager.h"
 
+#ifdef NETRUMBLE_HEADLESS
+// A dedicated server only runs the simulation, so it carries no input, screens or Steam client
+#include "AudioManager.h"
+#include "CollisionManager.h"
+#include "ContentManager.h"
+#include "OnlineManager.h"
+#include "ParticleManager.h"
+#include "RenderManager.h"
+#include "HeadlessOnlineManager.h"
+#else
 #include "AsyncTaskManager.h"
 #include "AudioManager.h"
 #include "CollisionManager.h"
@@ -19,6 +29,7 @@
 #include "RenderManager.h"
 #include "ScreenManager.h"
 #include "SteamOnlineManager.h"
+#endif
 
 
 namespace NetRumble
@@ -28,19 +39,39 @@ namespace NetRumble
 	class Managers
 	{
 	public:
+		using Registry = std::unordered_map<size_t, std::unique_ptr<Manager>>;
+
 		static void Initialize();
 		static void Shutdown()
 		{
-			m_managersByType.clear();
+			Current().clear();
 		}
 
 		template<class T>
 		static T* Get()
 		{
-			return static_cast<T*>(m_managersByType[typeid(T).hash_code()].get());
+			return static_cast<T*>(Current()[typeid(T).hash_code()].get());
 		}
 
+#ifdef NETRUMBLE_HEADLESS
+		// A multi-match server gives every match its own managers. The thread about to run a
+		// match binds that match's registry; with none bound the process-wide registry is used.
+		static void Bind(Registry* registry)
+		{
+			m_boundRegistry = registry;
+		}
+#endif
+
 	private:
+		static Registry& Current()
+		{
+#ifdef NETRUMBLE_HEADLESS
+			return m_boundRegistry ? *m_boundRegistry : m_managersByType;
+#else
+			return m_managersByType;
+#endif
+		}
+
 
 		template<typename ManagerType>
 		static void AddManager()
@@ -56,10 +87,13 @@ namespace NetRumble
 			static_assert(std::is_base_of_v<Manager, ManagerType>, "Manager must be derived from Manager base class");
 
 			Manager* mgr = new ManagerType();
-			m_managersByType.emplace(typeid(InterfaceType).hash_code(), mgr);
+			Current().emplace(typeid(InterfaceType).hash_code(), mgr);
 		}
 
-		static std::unordered_map<size_t, std::unique_ptr<Manager>> m_managersByType;
+		static Registry m_managersByType;
+#ifdef NETRUMBLE_HEADLESS
+		static thread_local Registry* m_boundRegistry;
+#endif
 	};
 
 }
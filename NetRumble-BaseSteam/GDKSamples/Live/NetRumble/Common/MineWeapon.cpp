@@ -18,8 +18,9 @@ MineWeapon::MineWeapon(Ship* owner) : Weapon(owner)
 
 void MineWeapon::CreateProjectiles(const DirectX::SimpleMath::Vector2& direction)
 {
-	// Create the new projectile
-	std::shared_ptr<MineProjectile> projectile = std::make_shared<MineProjectile>(m_owner, direction);
+	// Launch the new projectile
+	std::shared_ptr<MineProjectile> projectile = m_owner->MineProjectiles.Acquire(m_owner);
+	projectile->Launch(direction);
 	projectile->Initialize();
 
 	m_owner->Projectiles.push_back(projectile);
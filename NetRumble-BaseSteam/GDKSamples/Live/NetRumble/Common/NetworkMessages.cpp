@@ -28,74 +28,102 @@ GameMessage::GameMessage(GameMessageType type, const std::vector<uint8_t>& data)
 {
 }
 
+GameMessage::GameMessage(GameMessageType type, std::vector<uint8_t>&& data) :
+	m_type{ type },
+	m_data{ std::move(data) }
+{
+}
+
 GameMessage::GameMessage(const std::vector<uint8_t>& data)
 {
-	if (data.size() < (MsgTypeSize + sizeof(uint8_t)))
+	GameMessageView view = GameMessageView::FromPacket(data);
+	if (view.MessageType() == GameMessageType::Unknown)
 	{
-		DEBUGLOG("Ill-formed game message\n");
 		return;
 	}
 
-	memcpy(&m_type, data.data(), MsgTypeSize);
-
-	m_data.resize(data.size() - MsgTypeSize);
-	memcpy(m_data.data(), data.data() + MsgTypeSize, m_data.size());
+	m_type = view.MessageType();
+	m_data.assign(view.RawData().begin(), view.RawData().end());
 }
 
 std::vector<uint8_t> GameMessage::Serialize() const
 {
-	if (m_type == GameMessageType::Unknown || m_data.empty())
+	std::vector<uint8_t> packet;
+	GameMessageView(*this).SerializeTo(packet);
+	return packet;
+}
+
+std::vector<uint8_t> GameMessage::SerializeWithSourceID() const
+{
+	std::vector<uint8_t> packet;
+	GameMessageView(*this).SerializeWithSourceIDTo(packet);
+	return packet;
+}
+
+std::string GameMessage::StringValue() const
+{
+	return GameMessageView(*this).StringValue();
+}
+
+uint32_t GameMessage::UnsignedValue() const
+{
+	return GameMessageView(*this).UnsignedValue();
+}
+
+GameMessageView GameMessageView::FromPacket(DataBufferView packet)
+{
+	if (packet.size() < (MsgTypeSize + sizeof(uint8_t)))
 	{
-		return std::vector<uint8_t>();
+		DEBUGLOG("Ill-formed game message\n");
+		return GameMessageView();
 	}
 
-	size_t length = MsgTypeSize + m_data.size();
-	uint8_t* buffer = new uint8_t[length];
+	GameMessageType type;
+	memcpy(&type, packet.data(), MsgTypeSize);
 
-	memcpy(buffer, &m_type, MsgTypeSize);
-	memcpy(buffer + MsgTypeSize, m_data.data(), m_data.size());
+	return GameMessageView(type, DataBufferView(packet.data() + MsgTypeSize, packet.size() - MsgTypeSize));
+}
 
-	std::vector<uint8_t> packet = std::vector<uint8_t>(buffer, buffer + length);
+void GameMessageView::SerializeTo(std::vector<uint8_t>& packet) const
+{
+	packet.clear();
 
-	delete[] buffer;
+	if (m_type == GameMessageType::Unknown || m_data.empty())
+	{
+		return;
+	}
 
-	return packet;
+	packet.resize(MsgTypeSize + m_data.size());
+	memcpy(packet.data(), &m_type, MsgTypeSize);
+	memcpy(packet.data() + MsgTypeSize, m_data.data(), m_data.size());
 }
 
-
-std::vector<uint8_t> GameMessage::SerializeWithSourceID() const
+void GameMessageView::SerializeWithSourceIDTo(std::vector<uint8_t>& packet) const
 {
+	packet.clear();
+
 	if (m_type == GameMessageType::Unknown || m_data.empty())
 	{
-		return std::vector<uint8_t>();
+		return;
 	}
 
-	if (g_game->GetLocalPlayerState() == nullptr)
+	if (g_game->GetLocalPlayer() == nullptr)
 	{
 		DEBUGLOG("Serialize GameMessage with source ID without having valid player state\n");
-		return std::vector<uint8_t>();
+		return;
 	}
 
-	uint64 sourceID = g_game->GetLocalPlayerState()->PeerId;
+	uint64 sourceID = g_game->GetLocalPlayer()->PeerId;
 	size_t sourceIDSize = sizeof(sourceID);
 
-	size_t length = MsgTypeSize + sourceIDSize + m_data.size();
-	uint8_t* buffer = new uint8_t[length];
-
 	// Serialized message data will be: GameMessageType|SourceID|MessagePayload
-	memcpy(buffer, &m_type, MsgTypeSize);	// GameMessageType
-	memcpy(buffer + MsgTypeSize, &sourceID, sizeof(sourceID)); // Source ID
-	memcpy(buffer + MsgTypeSize + sourceIDSize, m_data.data(), m_data.size()); // Data payload
-
-	std::vector<uint8_t> packet = std::vector<uint8_t>(buffer, buffer + length);
-
-	delete[] buffer;
-
-	return packet;
+	packet.resize(MsgTypeSize + sourceIDSize + m_data.size());
+	memcpy(packet.data(), &m_type, MsgTypeSize);	// GameMessageType
+	memcpy(packet.data() + MsgTypeSize, &sourceID, sourceIDSize); // Source ID
+	memcpy(packet.data() + MsgTypeSize + sourceIDSize, m_data.data(), m_data.size()); // Data payload
 }
 
-
-std::string GameMessage::StringValue() const
+std::string GameMessageView::StringValue() const
 {
 	if (!m_data.empty())
 	{
@@ -106,13 +134,13 @@ std::string GameMessage::StringValue() const
 	return "";
 }
 
-uint32_t GameMessage::UnsignedValue() const
+uint32_t GameMessageView::UnsignedValue() const
 {
-	if (!m_data.empty())
+	uint32_t value = 0;
+	if (m_data.size() >= sizeof(value))
 	{
-		return *(reinterpret_cast<const uint32_t*>(m_data.data()));
+		memcpy(&value, m_data.data(), sizeof(value));
 	}
 
-	return 0;
+	return value;
 }
-
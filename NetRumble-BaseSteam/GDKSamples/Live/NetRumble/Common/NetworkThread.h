@@ -0,0 +1,232 @@
+//--------------------------------------------------------------------------------------
+// NetworkThread.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "DataBuffer.h"
+#include "SpscQueue.h"
+
+namespace NetRumble
+{
+	// A transport message on its way between the network thread and the game thread
+	struct NetworkPacket
+	{
+		// Who sent a received message, or the connection a send goes out on
+		uint64_t Peer = 0;
+		// The transport's send flags; unused on receive
+		int Flags = 0;
+		// When the transport had a received message, for its receive-to-apply latency
+		std::chrono::steady_clock::time_point ReceivedAt;
+		std::vector<uint8_t> Data;
+	};
+
+	// How long received messages waited before the game applied them. The online manager
+	// keeps it the same way with the network thread or without, so the two can be compared.
+	struct ApplyLatency
+	{
+		// Weight of the newest message in the running average
+		static constexpr float c_smoothing = 0.05f;
+
+		uint64_t Messages = 0;
+		float AverageMilliseconds = 0.0f;
+		float MaxMilliseconds = 0.0f;
+
+		inline void Record(float milliseconds)
+		{
+			AverageMilliseconds = Messages == 0 ? milliseconds : AverageMilliseconds + (milliseconds - AverageMilliseconds) * c_smoothing;
+			MaxMilliseconds = std::max(MaxMilliseconds, milliseconds);
+			Messages++;
+		}
+
+		inline void Reset() { *this = ApplyLatency(); }
+	};
+
+	// Pumps a transport on its own thread so receiving never waits for the game's frame and
+	// a slow batch of transport work never stalls it. Received messages are copied into
+	// pooled buffers and handed to the game thread in arrival order through one SpscQueue;
+	// sends come back the other way through a second. Each buffer returns to its pool once
+	// the other side is done with it, so steady traffic allocates nothing after warm-up.
+	//
+	// The pump and send handlers run on the network thread and must only call transport
+	// APIs that are safe to use from it. Everything else, Apply and Send included, belongs
+	// to the game thread.
+	//
+	// The online manager leaves it off unless asked. The game still applies messages once a
+	// frame, so the thread cannot deliver them any sooner, and the hand-off adds a wait:
+	// NetRumbleNetworkThreadBenchmark put receive to apply at 9.6 ms p50 and 22.3 ms max
+	// with it, against 8.1 ms and 18.2 ms pumping inline, for a frame barely steadier.
+	class NetworkThread final
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		// Receives whatever the transport has ready and passes each message to Received
+		using PumpHandler = std::function<void(NetworkThread& thread)>;
+		// Puts one queued send on the transport
+		using SendHandler = std::function<void(const NetworkPacket& packet)>;
+
+		// Messages in flight each way; must be a power of two
+		static constexpr size_t c_queueCapacity = 1024;
+		// How long the thread rests after a pass that found nothing to receive or send
+		static constexpr auto c_idleWait = std::chrono::milliseconds(1);
+
+		NetworkThread(PumpHandler pump, SendHandler send) :
+			m_pump(std::move(pump)),
+			m_send(std::move(send)),
+			m_thread([this]() { Run(); })
+		{
+		}
+
+		// Sends anything still queued, then joins the thread
+		~NetworkThread()
+		{
+			m_running.store(false, std::memory_order_release);
+			m_thread.join();
+		}
+
+		NetworkThread(NetworkThread const&) = delete;
+		NetworkThread& operator= (NetworkThread const&) = delete;
+
+		// Network thread. Copies the message for Apply, waiting while the game thread is a
+		// whole queue behind rather than dropping what the transport already delivered.
+		void Received(uint64_t peer, Clock::time_point receivedAt, DataBufferView message)
+		{
+			NetworkPacket packet = TakeFree(m_receivedFree);
+			packet.Peer = peer;
+			packet.Flags = 0;
+			packet.ReceivedAt = receivedAt;
+			packet.Data.assign(message.begin(), message.end());
+
+			if (!m_received.TryPush(packet))
+			{
+				m_stalls.fetch_add(1, std::memory_order_relaxed);
+
+				// Sends keep going meanwhile, or a game thread waiting to send would never get to Apply
+				while (!m_received.TryPush(packet) && m_running.load(std::memory_order_acquire))
+				{
+					SendQueued();
+					std::this_thread::yield();
+				}
+			}
+
+			m_receivedThisPass++;
+		}
+
+		// Game thread. Hands every message received so far to handler(const NetworkPacket&)
+		// in arrival order, and returns how many there were.
+		template<typename Handler>
+		size_t Apply(Handler&& handler)
+		{
+			size_t count = 0;
+			NetworkPacket packet;
+			while (m_received.TryPop(packet))
+			{
+				handler(static_cast<const NetworkPacket&>(packet));
+				m_receivedFree.TryPush(packet);
+				count++;
+			}
+
+			return count;
+		}
+
+		// Game thread. Copies the message for the network thread to send.
+		void Send(uint64_t peer, int flags, DataBufferView message)
+		{
+			NetworkPacket packet = TakeFree(m_sendsFree);
+			packet.Peer = peer;
+			packet.Flags = flags;
+			packet.Data.assign(message.begin(), message.end());
+
+			if (!m_sends.TryPush(packet))
+			{
+				m_stalls.fetch_add(1, std::memory_order_relaxed);
+				while (!m_sends.TryPush(packet))
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		// Times either thread found its queue full and had to wait for the other
+		inline uint64_t GetStalls() const { return m_stalls.load(std::memory_order_relaxed); }
+
+	private:
+		void Run()
+		{
+			for (;;)
+			{
+				const bool running = m_running.load(std::memory_order_acquire);
+
+				// Sends first, so what the last frame queued doesn't wait behind a slow pump
+				const size_t sent = SendQueued();
+
+				if (!running)
+				{
+					return;
+				}
+
+				m_receivedThisPass = 0;
+				m_pump(*this);
+
+				if (sent == 0 && m_receivedThisPass == 0)
+				{
+					std::this_thread::sleep_for(c_idleWait);
+				}
+			}
+		}
+
+		size_t SendQueued()
+		{
+			size_t sent = 0;
+			NetworkPacket packet;
+			while (m_sends.TryPop(packet))
+			{
+				m_send(packet);
+				m_sendsFree.TryPush(packet);
+				sent++;
+			}
+
+			return sent;
+		}
+
+		// A pooled buffer when one has come back, or a new one while the pool fills up. A
+		// buffer that finds its pool full on the way back is simply freed.
+		static NetworkPacket TakeFree(SpscQueue<NetworkPacket>& pool)
+		{
+			NetworkPacket packet;
+			pool.TryPop(packet);
+			return packet;
+		}
+
+		PumpHandler m_pump;
+		SendHandler m_send;
+
+		// Received messages to the game thread, and their buffers back
+		SpscQueue<NetworkPacket> m_received{ c_queueCapacity };
+		SpscQueue<NetworkPacket> m_receivedFree{ c_queueCapacity };
+
+		// Sends to the network thread, and their buffers back
+		SpscQueue<NetworkPacket> m_sends{ c_queueCapacity };
+		SpscQueue<NetworkPacket> m_sendsFree{ c_queueCapacity };
+
+		// Network thread only
+		size_t m_receivedThisPass = 0;
+
+		std::atomic<uint64_t> m_stalls{ 0 };
+		std::atomic<bool> m_running{ true };
+
+		// Last, so it starts once everything it uses is constructed
+		std::thread m_thread;
+	};
+}
@@ -4,8 +4,8 @@
 
 namespace NetRumble
 {
-	class GameMessage;
-	using OnlineMessageHandler = std::function<void(uint64_t, GameMessage*)>;
+	class GameMessageView;
+	using OnlineMessageHandler = std::function<void(uint64_t, const GameMessageView&)>;
 
 	struct OnlineUser
 	{
@@ -52,7 +52,7 @@ namespace NetRumble
 
 		virtual void LeaveMultiplayerGame() = 0;
 
-		virtual bool SendGameMessage(const GameMessage&) = 0;
+		virtual bool SendGameMessage(const GameMessageView&) = 0;
 
 		virtual bool IsNetworkAvailable() const = 0;
 
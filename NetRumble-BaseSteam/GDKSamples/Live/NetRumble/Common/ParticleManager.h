@@ -27,11 +27,9 @@ namespace NetRumble
 		Additive
 	};
 
-	class Particle
+	// Initial state of a newly released particle
+	struct Particle
 	{
-	public:
-		void Update(float elapsedTime, float angularVelocity, float scaleDeltaPerSecond, float opacityDeltaPerSecond);
-
 		float TimeRemaining;
 		DirectX::SimpleMath::Vector2 Position;
 		DirectX::SimpleMath::Vector2 Velocity;
@@ -41,24 +39,43 @@ namespace NetRumble
 		float Opacity;
 	};
 
+	/// <summary>
+	/// Fixed-capacity particle store laid out as structure-of-arrays. Live particles are
+	/// packed into [0, UsedCount()); expired ones are swap-removed, so updates and draws
+	/// only ever walk contiguous memory.
+	/// </summary>
 	class ParticleCache
 	{
 	public:
 		ParticleCache(size_t count);
-		~ParticleCache();
 
 		void Reset();
-		std::shared_ptr<Particle> GetNextParticle();
-		void ReleaseParticle(std::shared_ptr<Particle> p);
-
-		inline int TotalCount() const { return static_cast<int>(Particles.size()); }
-		inline int FreeCount() const { return static_cast<int>(freeParticles.size()); }
-		inline int UsedCount() const { return static_cast<int>(Particles.size() - (int)freeParticles.size()); }
+		void AddParticle(const Particle& particle);
+		void Update(float elapsedTime, float angularVelocity, float scaleDeltaPerSecond, float opacityDeltaPerSecond);
 
-		std::vector<std::shared_ptr<Particle>> Particles;
+		inline int TotalCount() const { return static_cast<int>(m_capacity); }
+		inline int FreeCount() const { return static_cast<int>(m_capacity - m_count); }
+		inline int UsedCount() const { return static_cast<int>(m_count); }
+		inline bool IsFull() const { return m_count >= m_capacity; }
+
+		std::vector<float> PositionX;
+		std::vector<float> PositionY;
+		std::vector<float> VelocityX;
+		std::vector<float> VelocityY;
+		std::vector<float> AccelerationX;
+		std::vector<float> AccelerationY;
+		std::vector<float> Scale;
+		std::vector<float> Rotation;
+		std::vector<float> Opacity;
+		std::vector<float> TimeRemaining;
 
 	private:
-		std::queue<std::shared_ptr<Particle>> freeParticles;
+		void Integrate(float elapsedTime, float angularVelocity, float scaleDeltaPerSecond, float opacityDeltaPerSecond);
+		void RemoveExpired();
+		void MoveParticle(size_t from, size_t to);
+
+		size_t m_capacity;
+		size_t m_count;
 	};
 
 	class ParticleSystem
@@ -75,6 +92,7 @@ namespace NetRumble
 		void Stop(bool immediately);
 
 		inline bool IsActive() const { return active || TimeRemaining > 0.0f; }
+		inline int LiveParticleCount() const { return particles ? particles->UsedCount() : 0; }
 
 		std::wstring Name;
 		int ParticleCount;
@@ -115,7 +133,7 @@ namespace NetRumble
 	private:
 		void GenerateParticles(float elapsedTime);
 		void UpdateParticles(float elapsedTime);
-		void InitializeParticle(std::shared_ptr<Particle> particle);
+		void InitializeParticle(Particle& particle);
 
 		bool active;
 		TextureHandle texture;
@@ -51,8 +51,14 @@ void PlayerState::ReactivatePlayer()
 	m_isInactive = false;
 }
 
-void PlayerState::DeserializePlayerStateData(const std::vector<uint8_t>& data)
+void PlayerState::DeserializePlayerStateData(DataBufferView data)
 {
+	if (data.size() < sizeof(PlayerStateData))
+	{
+		DEBUGLOG("Ill-formed player state data\n");
+		return;
+	}
+
 	PlayerStateData rcvdPlayerStateData = PlayerStateData();
 	CopyMemory(&rcvdPlayerStateData, data.data(), sizeof(PlayerStateData));
 
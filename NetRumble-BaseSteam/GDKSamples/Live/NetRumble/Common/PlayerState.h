@@ -32,7 +32,7 @@ namespace NetRumble
 		void EnterLobby();
 		void ReactivatePlayer();
 
-		void DeserializePlayerStateData(const std::vector<uint8_t>& data);
+		void DeserializePlayerStateData(DataBufferView data);
 		std::vector<uint8_t> SerializePlayerStateData() const;
 
 		void SetRegionLatency(std::string_view region, uint64_t latency);
@@ -47,6 +47,10 @@ namespace NetRumble
 		bool IsReturnedToMainMenu;
 		uint64_t PeerId;
 
+		// Host-side bookkeeping for delta-compressed world snapshots
+		uint32_t LastAckedWorldData = 0;
+		BandwidthMeter WorldDataBandwidth;
+
 		byte ShipColor() const { return m_shipColor; }
 		void ShipColor(byte colorIndex)
 		{
@@ -77,7 +81,7 @@ namespace NetRumble
 
 		bool IsInactive() { return m_isInactive; }
 
-		std::shared_ptr<Ship> GetShip() const { return m_playerShip; }
+		const std::shared_ptr<Ship>& GetShip() const { return m_playerShip; }
 
 	private:
 		std::shared_ptr<Ship> m_playerShip;
@@ -15,12 +15,18 @@ namespace NetRumble
 	class Projectile : public GameplayObject
 	{
 	public:
-		Projectile(Ship* owner, DirectX::SimpleMath::Vector2 direction);
+		explicit Projectile(Ship* owner);
 		virtual ~Projectile() = default;
 
+		// Projectiles are pooled by their ship, so construction sets up what every shot of
+		// a kind shares and Launch resets everything a shot changes. Call it before Initialize.
+		virtual void Launch(DirectX::SimpleMath::Vector2 direction);
+
 		virtual void Update(float elapsedTime) override;
 		virtual bool OnTouch(GameplayObject* target) override;
 		virtual void Die(GameplayObject* source, bool cleanupOnly) override;
+		virtual void SaveState(SavedState& state) const override;
+		virtual void RestoreState(const SavedState& state) override;
 
 		virtual void Draw(float elapsedTime, RenderContext* renderContext) = 0;
 
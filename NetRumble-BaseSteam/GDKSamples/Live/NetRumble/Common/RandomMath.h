@@ -6,33 +6,49 @@
 
 #pragma once
 
+#include <random>
+
 namespace RandomMath
 {
+	// Each thread draws from its own generator, so a server hosting matches on several
+	// threads neither contends on nor reorders another match's sequence
+	inline std::minstd_rand& Generator()
+	{
+		thread_local std::minstd_rand generator{ std::random_device{}() };
+		return generator;
+	}
+
+	// Seeds the calling thread's generator
+	inline void Seed(uint32_t seed)
+	{
+		Generator().seed(seed);
+	}
+
 	inline int32_t RandomBetween(int32_t minimum, int32_t maximum)
 	{
-		return rand() % (maximum - minimum + 1) + minimum;
+		return static_cast<int32_t>(Generator()() % static_cast<uint32_t>(maximum - minimum + 1)) + minimum;
 	}
 
 	inline uint32_t RandomBetween(uint32_t minimum, uint32_t maximum)
 	{
-		return rand() % (maximum - minimum + 1) + minimum;
+		return static_cast<uint32_t>(Generator()()) % (maximum - minimum + 1) + minimum;
 	}
 
 	inline float RandomBetween(float minimum, float maximum)
 	{
-		float f = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+		float f = std::uniform_real_distribution<float>(0.0f, 1.0f)(Generator());
 		return minimum + f * (maximum - minimum);
 	}
 
 	inline DirectX::SimpleMath::Vector2 RandomDirection()
 	{
 		float angle = RandomBetween(0.0f, DirectX::XM_2PI);
-		return DirectX::SimpleMath::Vector2(std::cosf(angle), std::sinf(angle));
+		return DirectX::SimpleMath::Vector2(std::cos(angle), std::sin(angle));
 	}
 
 	inline DirectX::SimpleMath::Vector2 RandomDirection(float minimumAngleInDegrees, float maximumAngleInDegrees)
 	{
 		float angle = DirectX::XMConvertToRadians(RandomBetween(minimumAngleInDegrees, maximumAngleInDegrees));
-		return DirectX::SimpleMath::Vector2(std::cosf(angle), std::sinf(angle));
+		return DirectX::SimpleMath::Vector2(std::cos(angle), std::sin(angle));
 	}
 }
\ No newline at end of file
@@ -0,0 +1,21 @@
+//--------------------------------------------------------------------------------------
+// ContentManager.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+
+using namespace NetRumble;
+
+TextureHandle ContentManager::LoadTexture(const std::wstring& path)
+{
+	UNREFERENCED_PARAMETER(path);
+	return TextureHandle{};
+}
+
+std::shared_ptr<DirectX::SpriteFont> ContentManager::LoadFont(const std::wstring& path)
+{
+	UNREFERENCED_PARAMETER(path);
+	return nullptr;
+}
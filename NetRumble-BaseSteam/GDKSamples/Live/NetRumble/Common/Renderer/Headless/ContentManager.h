@@ -0,0 +1,30 @@
+//--------------------------------------------------------------------------------------
+// ContentManager.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+namespace DirectX
+{
+	class SpriteFont;
+}
+
+namespace NetRumble
+{
+	struct TextureHandle;
+
+	// Hands out empty texture handles so gameplay objects can be constructed without
+	// reading any asset from disk
+	class ContentManager : public Manager
+	{
+	public:
+		ContentManager() noexcept = default;
+
+		TextureHandle LoadTexture(const std::wstring& path);
+
+		std::shared_ptr<DirectX::SpriteFont> LoadFont(const std::wstring& path);
+	};
+
+}
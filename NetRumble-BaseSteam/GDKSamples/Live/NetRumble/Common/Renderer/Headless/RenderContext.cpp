@@ -0,0 +1,54 @@
+//--------------------------------------------------------------------------------------
+// RenderContext.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "RenderContext.h"
+
+namespace NetRumble
+{
+	void RenderContext::Begin(DirectX::FXMMATRIX transformMatrix, DirectX::SpriteSortMode sortMode)
+	{
+		UNREFERENCED_PARAMETER(transformMatrix);
+		UNREFERENCED_PARAMETER(sortMode);
+	}
+
+	void RenderContext::End()
+	{
+	}
+
+	void RenderContext::Draw(const TextureHandle& texture, const DirectX::XMFLOAT2& position, float rotation, float scale, DirectX::FXMVECTOR color, TexturePosition texturePosition)
+	{
+		UNREFERENCED_PARAMETER(texture);
+		UNREFERENCED_PARAMETER(position);
+		UNREFERENCED_PARAMETER(rotation);
+		UNREFERENCED_PARAMETER(scale);
+		UNREFERENCED_PARAMETER(color);
+		UNREFERENCED_PARAMETER(texturePosition);
+	}
+
+	void RenderContext::Draw(const TextureHandle& texture, const RECT& destinationRect, DirectX::FXMVECTOR color, float rotation, TexturePosition texturePosition)
+	{
+		UNREFERENCED_PARAMETER(texture);
+		UNREFERENCED_PARAMETER(destinationRect);
+		UNREFERENCED_PARAMETER(color);
+		UNREFERENCED_PARAMETER(rotation);
+		UNREFERENCED_PARAMETER(texturePosition);
+	}
+
+	void RenderContext::DrawString(std::shared_ptr<DirectX::SpriteFont> font, std::string_view message, const DirectX::XMFLOAT2& position, DirectX::FXMVECTOR color, float rotation, const DirectX::XMFLOAT2& origin, float scale)
+	{
+		UNREFERENCED_PARAMETER(font);
+		UNREFERENCED_PARAMETER(message);
+		UNREFERENCED_PARAMETER(position);
+		UNREFERENCED_PARAMETER(color);
+		UNREFERENCED_PARAMETER(rotation);
+		UNREFERENCED_PARAMETER(origin);
+		UNREFERENCED_PARAMETER(scale);
+	}
+
+	const DirectX::XMMATRIX RenderContext::MatrixIdentity = DirectX::XMMatrixIdentity();
+	const DirectX::XMFLOAT2 RenderContext::Float2Zero(0, 0);
+}
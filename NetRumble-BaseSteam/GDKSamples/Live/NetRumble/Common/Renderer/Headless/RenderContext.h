@@ -0,0 +1,61 @@
+//--------------------------------------------------------------------------------------
+// RenderContext.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+namespace DirectX
+{
+	class SpriteFont;
+
+	// Mirrors the DirectXTK sort modes so gameplay draw code compiles without SpriteBatch
+	enum SpriteSortMode
+	{
+		SpriteSortMode_Deferred,
+		SpriteSortMode_Immediate,
+		SpriteSortMode_Texture,
+		SpriteSortMode_BackToFront,
+		SpriteSortMode_FrontToBack,
+	};
+}
+
+namespace NetRumble
+{
+	enum class TexturePosition
+	{
+		None,
+		Centered
+	};
+
+	// Headless builds never touch a GPU, so a texture is only its path and nominal size
+	struct TextureHandle
+	{
+		TextureHandle() noexcept = default;
+
+		DirectX::XMUINT2 Size{ 0, 0 };
+
+		DirectX::XMUINT2 GetTextureSize() const { return Size; }
+	};
+
+	// Accepts the same calls as the DX12 render context and discards them
+	class RenderContext
+	{
+	public:
+		void Begin(DirectX::FXMMATRIX transformMatrix = MatrixIdentity, DirectX::SpriteSortMode sortMode = DirectX::SpriteSortMode::SpriteSortMode_Deferred);
+		void End();
+
+		void Draw(const TextureHandle& texture, const DirectX::XMFLOAT2& position, float rotation = 0.0f, float scale = 1.0f, DirectX::FXMVECTOR color = DirectX::Colors::White, TexturePosition texturePosition = TexturePosition::Centered);
+		void Draw(const TextureHandle& texture, const RECT& destinationRect, DirectX::FXMVECTOR color = DirectX::Colors::White, float rotations = 0.0f, TexturePosition texturePosition = TexturePosition::Centered);
+
+		void DrawString(std::shared_ptr<DirectX::SpriteFont> font, std::string_view message, const DirectX::XMFLOAT2& position, DirectX::FXMVECTOR color = DirectX::Colors::White, float rotation = 0, const DirectX::XMFLOAT2& origin = Float2Zero, float scale = 1);
+	private:
+		RenderContext() = default;
+
+		static const DirectX::XMMATRIX MatrixIdentity;
+		static const DirectX::XMFLOAT2 Float2Zero;
+
+		friend class RenderManager;
+	};
+}
@@ -0,0 +1,23 @@
+//--------------------------------------------------------------------------------------
+// RenderManager.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "RenderManager.h"
+#include "RenderContext.h"
+
+using namespace NetRumble;
+
+void RenderManager::Initialize(int width, int height)
+{
+	m_windowWidth = width;
+	m_windowHeight = height;
+}
+
+std::unique_ptr<RenderContext> RenderManager::GetRenderContext(BlendMode mode) const
+{
+	UNREFERENCED_PARAMETER(mode);
+	return std::unique_ptr<RenderContext>(new RenderContext());
+}
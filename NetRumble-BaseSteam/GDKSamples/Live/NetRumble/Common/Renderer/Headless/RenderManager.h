@@ -0,0 +1,36 @@
+//--------------------------------------------------------------------------------------
+// RenderManager.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "Manager.h"
+#include "RenderContext.h"
+
+namespace NetRumble
+{
+	enum class BlendMode
+	{
+		Default,
+		NonPremultiplied,
+		Additive
+	};
+
+	// Stands in for the DX12 render manager on a dedicated server: there is no device or
+	// window, and every render context it hands out draws nothing.
+	class RenderManager : public Manager
+	{
+	public:
+		RenderManager() noexcept = default;
+
+		void Initialize(int width, int height);
+
+		std::unique_ptr<RenderContext> GetRenderContext(BlendMode mode = BlendMode::Default) const;
+
+	private:
+		int m_windowWidth{ 0 };
+		int m_windowHeight{ 0 };
+	};
+}
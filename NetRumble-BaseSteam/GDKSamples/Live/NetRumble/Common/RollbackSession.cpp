@@ -0,0 +1,376 @@
+//--------------------------------------------------------------------------------------
+// RollbackSession.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "RollbackSession.h"
+
+#include <chrono>
+
+using namespace NetRumble;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	double SecondsSince(Clock::time_point begin)
+	{
+		return std::chrono::duration<double>(Clock::now() - begin).count();
+	}
+
+	// The input as it comes out of the input packet, so the local peer steers with exactly
+	// what every other peer will
+	ShipInput Quantize(const ShipInput& input)
+	{
+		BitBufferWriter dataWriter(8);
+		input.Serialize(dataWriter);
+
+		ShipInput quantized;
+		BitBufferReader dataReader(dataWriter.View());
+		quantized.Deserialize(dataReader);
+		return quantized;
+	}
+
+	bool SameInput(const ShipInput& first, const ShipInput& second)
+	{
+		return first.LeftStick == second.LeftStick &&
+			first.RightStick == second.RightStick &&
+			first.MineFired == second.MineFired;
+	}
+
+	// Swaps a match's random sequence in for the life of a scope
+	class RandomScope final
+	{
+	public:
+		explicit RandomScope(std::minstd_rand& random) :
+			m_random(random),
+			m_previous(RandomMath::Generator())
+		{
+			RandomMath::Generator() = m_random;
+		}
+
+		~RandomScope()
+		{
+			m_random = RandomMath::Generator();
+			RandomMath::Generator() = m_previous;
+		}
+
+		RandomScope(RandomScope const&) = delete;
+		RandomScope& operator= (RandomScope const&) = delete;
+
+	private:
+		std::minstd_rand& m_random;
+		std::minstd_rand m_previous;
+	};
+}
+
+void RollbackSession::Start(World& world, uint64_t localPeer, uint32_t seed, uint32_t ticksPerSecond)
+{
+	m_world = &world;
+	m_players.clear();
+	m_localPlayer = nullptr;
+	m_localInput = ShipInput();
+
+	for (const auto& playerState : g_game->GetAllPlayerStates())
+	{
+		Player player;
+		player.State = playerState;
+		m_players.push_back(std::move(player));
+	}
+
+	m_localPlayer = FindPlayer(localPeer);
+	if (!m_localPlayer)
+	{
+		throw std::runtime_error("Rollback session has no local player");
+	}
+
+	m_checksums.fill(TickChecksum());
+	m_nextTick = 1;
+	m_rollbackTick = UINT32_MAX;
+	m_tickSeconds = 1.0f / static_cast<float>(std::max<uint32_t>(ticksPerSecond, 1));
+	m_statistics = Statistics();
+
+	m_random.seed(seed);
+	RandomScope randomScope(m_random);
+
+	m_world->GenerateWorld();
+	m_world->SetGameInProgress(true);
+	m_world->SetRollbackMode(true);
+
+	for (const Player& player : m_players)
+	{
+		player.State->GetShip()->Lockstep = true;
+	}
+}
+
+void RollbackSession::Stop()
+{
+	if (!m_world)
+	{
+		return;
+	}
+
+	for (const Player& player : m_players)
+	{
+		player.State->GetShip()->Lockstep = false;
+	}
+
+	m_world->SetResimulating(false);
+	m_world->SetRollbackMode(false);
+	m_world = nullptr;
+	m_players.clear();
+	m_localPlayer = nullptr;
+}
+
+void RollbackSession::SetLocalInput(const ShipInput& input)
+{
+	m_localInput = Quantize(input);
+}
+
+bool RollbackSession::Advance()
+{
+	for (const Player& player : m_players)
+	{
+		if (&player != m_localPlayer && m_nextTick - player.ConfirmedTick > c_maximumRollback)
+		{
+			m_statistics.Stalls++;
+			return false;
+		}
+	}
+
+	ReceiveInput(*m_localPlayer, m_nextTick, m_localInput);
+
+	RandomScope randomScope(m_random);
+
+	if (m_rollbackTick < m_nextTick)
+	{
+		const uint32_t ticks = m_nextTick - m_rollbackTick;
+
+		Clock::time_point begin = Clock::now();
+		m_world->RestoreState(m_states[m_rollbackTick % c_stateHistory]);
+		m_statistics.RestoreSeconds += SecondsSince(begin);
+
+		begin = Clock::now();
+		m_world->SetResimulating(true);
+		for (uint32_t tick = m_rollbackTick; tick < m_nextTick; ++tick)
+		{
+			SimulateTick(tick);
+		}
+		m_world->SetResimulating(false);
+		m_statistics.ResimulateSeconds += SecondsSince(begin);
+
+		m_statistics.Rollbacks++;
+		m_statistics.ResimulatedTicks += ticks;
+		m_statistics.LongestRollback = std::max(m_statistics.LongestRollback, ticks);
+	}
+	m_rollbackTick = UINT32_MAX;
+
+	SimulateTick(m_nextTick);
+	m_nextTick++;
+	m_statistics.Ticks++;
+
+	return true;
+}
+
+void RollbackSession::SimulateTick(uint32_t tick)
+{
+	const Clock::time_point begin = Clock::now();
+	m_world->SaveState(m_states[tick % c_stateHistory]);
+	m_statistics.SaveSeconds += SecondsSince(begin);
+
+	for (Player& player : m_players)
+	{
+		player.State->GetShip()->Input = InputFor(player, tick);
+	}
+
+	m_world->Update(static_cast<float>(tick) * m_tickSeconds, m_tickSeconds);
+
+	if (m_checksumsEnabled)
+	{
+		m_checksums[tick % c_inputHistory] = TickChecksum{ tick, m_world->ComputeChecksum() };
+	}
+}
+
+// A confirmed input, or else the newest confirmed one before it: players tend to hold
+// the sticks where they were
+const ShipInput& RollbackSession::InputFor(Player& player, uint32_t tick)
+{
+	TickInput& entry = player.Inputs[tick % c_inputHistory];
+	if (entry.Tick == tick && entry.Confirmed)
+	{
+		return entry.Input;
+	}
+
+	ShipInput prediction;
+	for (uint32_t earlier = tick - 1; earlier > 0 && tick - earlier < c_inputHistory; --earlier)
+	{
+		const TickInput& earlierEntry = player.Inputs[earlier % c_inputHistory];
+		if (earlierEntry.Tick == earlier && earlierEntry.Confirmed)
+		{
+			prediction = earlierEntry.Input;
+			break;
+		}
+	}
+
+	entry = TickInput{ tick, prediction, false };
+	return entry.Input;
+}
+
+void RollbackSession::ReceiveInput(Player& player, uint32_t tick, const ShipInput& input)
+{
+	// Already known, or too far ahead to hold without losing one still needed
+	if (tick <= player.ConfirmedTick || tick >= player.ConfirmedTick + c_inputHistory)
+	{
+		return;
+	}
+
+	TickInput& entry = player.Inputs[tick % c_inputHistory];
+	if (entry.Tick == tick && entry.Confirmed)
+	{
+		return;
+	}
+
+	// The tick was simulated with a prediction; if it was wrong, everything since is too
+	if (tick < m_nextTick && entry.Tick == tick && !SameInput(entry.Input, input))
+	{
+		m_statistics.Mispredictions++;
+		m_rollbackTick = std::min(m_rollbackTick, tick);
+	}
+
+	entry = TickInput{ tick, input, true };
+
+	for (;;)
+	{
+		const uint32_t next = player.ConfirmedTick + 1;
+		const TickInput& nextEntry = player.Inputs[next % c_inputHistory];
+		if (nextEntry.Tick != next || !nextEntry.Confirmed)
+		{
+			break;
+		}
+		player.ConfirmedTick = next;
+	}
+}
+
+void RollbackSession::SerializeInputs(uint64_t peer, BitBufferWriter& dataWriter)
+{
+	Player* player = FindPlayer(peer);
+	if (!player || player == m_localPlayer)
+	{
+		throw std::runtime_error("Rollback input for a peer not in the session");
+	}
+
+	const uint32_t newest = m_localPlayer->ConfirmedTick;
+	const uint32_t oldest = std::max(player->AcknowledgedTick, newest - std::min(newest, c_maximumInputsPerPacket)) + 1;
+
+	dataWriter.WriteVarUInt32(player->ConfirmedTick);
+	dataWriter.WriteVarUInt32(newest);
+	dataWriter.WriteBits(newest + 1 - oldest, BitsRequired(c_maximumInputsPerPacket));
+	for (uint32_t tick = oldest; tick <= newest;)
+	{
+		const ShipInput& input = m_localPlayer->Inputs[tick % c_inputHistory].Input;
+		uint32_t repeats = 0;
+		while (tick + repeats < newest && SameInput(m_localPlayer->Inputs[(tick + repeats + 1) % c_inputHistory].Input, input))
+		{
+			repeats++;
+		}
+
+		input.Serialize(dataWriter);
+		dataWriter.WriteBits(repeats, BitsRequired(c_maximumInputsPerPacket));
+		tick += repeats + 1;
+	}
+}
+
+void RollbackSession::DeserializeInputs(uint64_t peer, DataBufferView data)
+{
+	Player* player = FindPlayer(peer);
+	if (!player || player == m_localPlayer)
+	{
+		throw std::runtime_error("Rollback input from a peer not in the session");
+	}
+
+	BitBufferReader dataReader(data);
+	const uint32_t acknowledged = dataReader.ReadVarUInt32();
+	const uint32_t newest = dataReader.ReadVarUInt32();
+	const uint32_t count = dataReader.ReadBits(BitsRequired(c_maximumInputsPerPacket));
+	if (count > c_maximumInputsPerPacket || count > newest || acknowledged > m_localPlayer->ConfirmedTick)
+	{
+		throw std::runtime_error("Rollback input packet out of range");
+	}
+
+	// Packets may arrive out of order; an older acknowledgement says nothing new
+	player->AcknowledgedTick = std::max(player->AcknowledgedTick, acknowledged);
+
+	for (uint32_t tick = newest + 1 - count; tick <= newest;)
+	{
+		ShipInput input;
+		input.Deserialize(dataReader);
+		const uint32_t repeats = dataReader.ReadBits(BitsRequired(c_maximumInputsPerPacket));
+		if (repeats > newest - tick)
+		{
+			throw std::runtime_error("Rollback input packet out of range");
+		}
+
+		for (uint32_t held = 0; held <= repeats; ++held)
+		{
+			ReceiveInput(*player, tick + held, input);
+		}
+		tick += repeats + 1;
+	}
+}
+
+void RollbackSession::AddRemoteInput(uint64_t peer, uint32_t tick, const ShipInput& input)
+{
+	Player* player = FindPlayer(peer);
+	if (!player || player == m_localPlayer)
+	{
+		throw std::runtime_error("Rollback input from a peer not in the session");
+	}
+
+	ReceiveInput(*player, tick, Quantize(input));
+}
+
+void RollbackSession::ForceRollback(uint32_t ticks)
+{
+	ticks = std::min({ ticks, c_maximumRollback, m_nextTick - 1 });
+	if (ticks > 0)
+	{
+		m_rollbackTick = std::min(m_rollbackTick, m_nextTick - ticks);
+	}
+}
+
+uint32_t RollbackSession::GetSettledTick() const
+{
+	uint32_t settled = m_nextTick - 1;
+	if (m_rollbackTick != UINT32_MAX)
+	{
+		settled = std::min(settled, m_rollbackTick - 1);
+	}
+
+	for (const Player& player : m_players)
+	{
+		settled = std::min(settled, player.ConfirmedTick);
+	}
+
+	return settled;
+}
+
+uint64_t RollbackSession::GetChecksum(uint32_t tick) const
+{
+	const TickChecksum& entry = m_checksums[tick % c_inputHistory];
+	return entry.Tick == tick ? entry.Checksum : 0;
+}
+
+RollbackSession::Player* RollbackSession::FindPlayer(uint64_t peer)
+{
+	for (Player& player : m_players)
+	{
+		if (player.State->PeerId == peer)
+		{
+			return &player;
+		}
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,150 @@
+//--------------------------------------------------------------------------------------
+// RollbackSession.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "ShipInput.h"
+#include "BitBuffer.h"
+#include "World.h"
+
+namespace NetRumble
+{
+	class PlayerState;
+
+	// Runs a World in rollback mode at a fixed tick rate. Each tick every ship is steered by
+	// its owner's input for that tick; a remote input that has not arrived yet is predicted
+	// to be the last one that did. The world is saved at the start of every tick, and when a
+	// remote input turns out to differ from its prediction, the world goes back to that tick
+	// and simulates forward again with what is now known.
+	//
+	// Only ShipInput is exchanged, a few bytes per player per tick. A peer never runs more
+	// than c_maximumRollback ticks past the oldest input it is still missing; Advance waits
+	// instead, which bounds both the cost of a rewind and how stale a remote ship can look.
+	//
+	// Peers stay in step only if they run the same binary on the same platform: the
+	// simulation is floating point, and nothing here makes it bit-exact across compilers.
+	class RollbackSession final
+	{
+	public:
+		static constexpr uint32_t c_maximumRollback = 8;
+
+		// An input packet carries every local input its receiver has not acknowledged. Neither
+		// peer runs more than c_maximumRollback past the other's inputs, so that is never more
+		// than this many, and a lost packet is made good by the next one. Players hold the
+		// sticks for many ticks at a time, so each input goes once with the ticks that repeat it.
+		static constexpr uint32_t c_maximumInputsPerPacket = 2 * c_maximumRollback;
+
+		struct Statistics
+		{
+			uint64_t Ticks = 0;
+			uint64_t Stalls = 0;
+			uint64_t Mispredictions = 0;
+			uint64_t Rollbacks = 0;
+			uint64_t ResimulatedTicks = 0;
+			uint32_t LongestRollback = 0;
+			double SaveSeconds = 0.0;
+			double RestoreSeconds = 0.0;
+			double ResimulateSeconds = 0.0;
+		};
+
+		RollbackSession() = default;
+
+		RollbackSession(RollbackSession const&) = delete;
+		RollbackSession& operator= (RollbackSession const&) = delete;
+
+		// Generate the world from the shared seed and take over its updates. Every peer passes
+		// the same seed and tick rate and has the same players, each in game with its ship.
+		void Start(World& world, uint64_t localPeer, uint32_t seed, uint32_t ticksPerSecond);
+		void Stop();
+
+		// The local player's input for the next tick, quantized as the other peers will decode it
+		void SetLocalInput(const ShipInput& input);
+
+		// Simulate the next tick, first rewinding to the oldest input that was mispredicted.
+		// Returns false without simulating if a remote input is too far behind.
+		bool Advance();
+
+		// Prepare the input packet for a peer: the local inputs it has not acknowledged, and
+		// the acknowledgement of its own
+		void SerializeInputs(uint64_t peer, BitBufferWriter& dataWriter);
+
+		// Take a peer's inputs and acknowledgement from its input packet
+		void DeserializeInputs(uint64_t peer, DataBufferView data);
+
+		// A peer's input for a tick, for callers with their own way of sending inputs
+		void AddRemoteInput(uint64_t peer, uint32_t tick, const ShipInput& input);
+
+		// Make the next Advance rewind this many ticks whatever the inputs, for benchmarking
+		void ForceRollback(uint32_t ticks);
+
+		// Checksums are kept for the last few ticks, for peers to compare the ticks they agree on
+		inline void SetChecksumsEnabled(bool checksumsEnabled) { m_checksumsEnabled = checksumsEnabled; }
+
+		// The newest tick every player's input is known for; its checksum will not change
+		uint32_t GetSettledTick() const;
+
+		// The checksum after the given tick, or zero if it is no longer kept
+		uint64_t GetChecksum(uint32_t tick) const;
+
+		// Ticks are numbered from 1; this is the last one simulated
+		inline uint32_t GetCurrentTick() const { return m_nextTick - 1; }
+		inline const Statistics& GetStatistics() const { return m_statistics; }
+
+	private:
+		// Inputs are kept this many ticks back, enough for a full rollback and a full input packet
+		static constexpr uint32_t c_inputHistory = 32;
+		static constexpr uint32_t c_stateHistory = c_maximumRollback;
+
+		struct TickInput
+		{
+			uint32_t Tick = 0;
+			ShipInput Input;
+			// False for a prediction, which is replaced when the real input arrives
+			bool Confirmed = false;
+		};
+
+		struct Player
+		{
+			std::shared_ptr<PlayerState> State;
+			std::array<TickInput, c_inputHistory> Inputs;
+			// Every input up to and including this tick has arrived
+			uint32_t ConfirmedTick = 0;
+			// The same, as this player last reported it for the local player's inputs
+			uint32_t AcknowledgedTick = 0;
+		};
+
+		struct TickChecksum
+		{
+			uint32_t Tick = 0;
+			uint64_t Checksum = 0;
+		};
+
+		Player* FindPlayer(uint64_t peer);
+		void ReceiveInput(Player& player, uint32_t tick, const ShipInput& input);
+		const ShipInput& InputFor(Player& player, uint32_t tick);
+		void SimulateTick(uint32_t tick);
+
+		World* m_world = nullptr;
+		std::vector<Player> m_players;
+		Player* m_localPlayer = nullptr;
+		ShipInput m_localInput;
+
+		std::array<WorldState, c_stateHistory> m_states;
+		std::array<TickChecksum, c_inputHistory> m_checksums;
+		bool m_checksumsEnabled = false;
+
+		uint32_t m_nextTick = 1;
+		// The oldest tick that has to be simulated again, or UINT32_MAX if none
+		uint32_t m_rollbackTick = UINT32_MAX;
+		float m_tickSeconds = 0.0f;
+
+		// The match's random sequence, swapped in for its ticks: every Game on a thread
+		// shares RandomMath's generator, and a rewind has to see only this match's draws
+		std::minstd_rand m_random;
+
+		Statistics m_statistics;
+	};
+}
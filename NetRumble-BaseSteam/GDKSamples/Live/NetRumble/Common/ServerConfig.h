@@ -32,8 +32,11 @@ namespace NetRumble
 	// How long to wait for a client to send an update before we drop its connection server side
 	static constexpr uint64 SERVER_TIMEOUT_MILLISECONDS{ 50000000 };
 
-	// Maximum number of players who can join a server and play simultaneously
-	static constexpr uint32 MAX_PLAYERS_PER_SERVER{ 4 };
+	// Players who can join a server and play simultaneously, unless the host sets otherwise
+	static constexpr uint32 DEFAULT_PLAYERS_PER_SERVER{ 4 };
+
+	// Most players a server can be set to hold; the relay keeps one bit per slot in a SlotMask
+	static constexpr uint32 MAX_SERVER_SLOTS{ 64 };
 
 	// Time to pause wait after a round ends before starting a new one
 	static constexpr uint32 MILLISECONDS_BETWEEN_ROUNDS{ 4000 };
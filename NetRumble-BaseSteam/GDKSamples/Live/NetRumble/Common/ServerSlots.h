@@ -0,0 +1,177 @@
+//--------------------------------------------------------------------------------------
+// ServerSlots.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace NetRumble
+{
+	// One bit per server slot, lowest slot in the lowest bit
+	using SlotMask = uint64_t;
+
+	// Which server slot each client connection holds. Connection handles are hashed into an
+	// open-addressed table at least twice the size of the server, so finding a sender's slot
+	// is a probe or two whatever the player count, and nothing allocates once the server is
+	// constructed. Held slots are also kept as a SlotMask, so sending to everyone but a few
+	// players walks set bits instead of every slot.
+	class ServerSlots final
+	{
+	public:
+		// Every slot needs a bit in a SlotMask
+		static constexpr uint32_t c_maximumSlots = 64;
+		static constexpr uint32_t c_noSlot = UINT32_MAX;
+
+		explicit ServerSlots(uint32_t slots) :
+			m_slots(slots),
+			m_connections(slots, 0)
+		{
+			uint32_t capacity = 1;
+			while (capacity < slots * 2)
+			{
+				capacity <<= 1;
+			}
+
+			m_table.resize(capacity);
+			m_tableMask = capacity - 1;
+		}
+
+		// Gives connection the slot, replacing whatever connection held it before. Handle 0 is
+		// never a live connection and just releases the slot.
+		void Assign(uint32_t slot, uint32_t connection)
+		{
+			Release(slot);
+			if (connection == 0)
+			{
+				return;
+			}
+
+			uint32_t index = Home(connection);
+			while (m_table[index].Connection != 0)
+			{
+				index = (index + 1) & m_tableMask;
+			}
+
+			m_table[index] = { connection, slot };
+			m_connections[slot] = connection;
+			m_held |= Bit(slot);
+		}
+
+		void Release(uint32_t slot)
+		{
+			const uint32_t connection = m_connections[slot];
+			if (connection == 0)
+			{
+				return;
+			}
+
+			uint32_t index = Home(connection);
+			while (m_table[index].Connection != connection)
+			{
+				index = (index + 1) & m_tableMask;
+			}
+
+			// Shifts back any entry after the hole that probed past it, so lookups never need
+			// tombstones and the table never degrades as players come and go
+			uint32_t next = (index + 1) & m_tableMask;
+			while (m_table[next].Connection != 0)
+			{
+				const uint32_t home = Home(m_table[next].Connection);
+				if (((next - home) & m_tableMask) >= ((next - index) & m_tableMask))
+				{
+					m_table[index] = m_table[next];
+					index = next;
+				}
+				next = (next + 1) & m_tableMask;
+			}
+
+			m_table[index] = Entry();
+			m_connections[slot] = 0;
+			m_held &= ~Bit(slot);
+		}
+
+		// The slot connection holds, or c_noSlot
+		uint32_t Find(uint32_t connection) const
+		{
+			if (connection == 0)
+			{
+				return c_noSlot;
+			}
+
+			for (uint32_t index = Home(connection);; index = (index + 1) & m_tableMask)
+			{
+				const Entry& entry = m_table[index];
+				if (entry.Connection == connection)
+				{
+					return entry.Slot;
+				}
+				if (entry.Connection == 0)
+				{
+					return c_noSlot;
+				}
+			}
+		}
+
+		// The bit of the slot connection holds, or no bits if it holds none
+		inline SlotMask MaskOf(uint32_t connection) const
+		{
+			const uint32_t slot = Find(connection);
+			return slot == c_noSlot ? 0 : Bit(slot);
+		}
+
+		inline uint32_t ConnectionAt(uint32_t slot) const { return m_connections[slot]; }
+		inline SlotMask Held() const { return m_held; }
+		inline uint32_t Size() const { return m_slots; }
+
+		static inline SlotMask Bit(uint32_t slot) { return SlotMask(1) << slot; }
+
+		// Calls handler(uint32_t slot) for each set bit in mask, lowest slot first
+		template<typename Handler>
+		static void ForEachSlot(SlotMask mask, Handler&& handler)
+		{
+			while (mask != 0)
+			{
+				handler(LowestSlot(mask));
+				mask &= mask - 1;
+			}
+		}
+
+	private:
+		struct Entry
+		{
+			uint32_t Connection = 0;
+			uint32_t Slot = 0;
+		};
+
+		static inline uint32_t LowestSlot(SlotMask mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward64(&index, mask);
+			return static_cast<uint32_t>(index);
+#else
+			return static_cast<uint32_t>(__builtin_ctzll(mask));
+#endif
+		}
+
+		// Handles are handed out close together, so mix them before masking
+		inline uint32_t Home(uint32_t connection) const
+		{
+			return ((connection * 0x9E3779B1u) >> 16) & m_tableMask;
+		}
+
+		uint32_t m_slots;
+		std::vector<uint32_t> m_connections;
+		std::vector<Entry> m_table;
+		uint32_t m_tableMask = 0;
+		SlotMask m_held = 0;
+	};
+}
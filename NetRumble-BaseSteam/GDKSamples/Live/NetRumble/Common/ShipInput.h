@@ -6,27 +6,36 @@
 
 #pragma once
 
+#ifndef NETRUMBLE_HEADLESS
 #include <GamePad.h>
 #include <Keyboard.h>
+#endif
 #include <DirectXMath.h>
 
+#include "BitBuffer.h"
+
 namespace NetRumble
 {
 
 	class ShipInput final
 	{
 	public:
+#ifdef NETRUMBLE_HEADLESS
+		ShipInput();
+#else
 		ShipInput(const DirectX::GamePad::State& gamePadState = DirectX::GamePad::State());
 		ShipInput(const DirectX::Keyboard::State& keyboardState);
+#endif
+		ShipInput(const DirectX::SimpleMath::Vector2& leftStick, const DirectX::SimpleMath::Vector2& rightStick, bool mineFired);
 
 		void Add(const ShipInput& moreInput);
 
 
-		// Prepare the ship input data for the ShipInput packet
-		std::vector<unsigned char> Serialize();
+		// Prepare the ship input data for the ShipInput packet, with each stick axis packed into a byte
+		void Serialize(BitBufferWriter& dataWriter) const;
 
 		// Get the latest ship input from the ShipInput packet
-		void Deserialize(const std::vector<unsigned char>& data);
+		void Deserialize(BitBufferReader& dataReader);
 
 		DirectX::SimpleMath::Vector2 LeftStick;
 		DirectX::SimpleMath::Vector2 RightStick;
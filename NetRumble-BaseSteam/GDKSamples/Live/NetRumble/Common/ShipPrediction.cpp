@@ -0,0 +1,78 @@
+//--------------------------------------------------------------------------------------
+// ShipPrediction.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "ShipPrediction.h"
+
+using namespace NetRumble;
+
+namespace
+{
+	// A frame longer than this is sent as this long; the host corrects whatever it costs
+	constexpr float c_moveTimeMaximum = 0.1f;
+	constexpr uint32_t c_moveTimeBits = 10;
+	constexpr float c_moveTimeCarryMaximum = 0.001f;
+}
+
+void ShipMove::Serialize(BitBufferWriter& dataWriter) const
+{
+	dataWriter.WriteQuantized(ElapsedTime, 0.0f, c_moveTimeMaximum, c_moveTimeBits);
+	Input.Serialize(dataWriter);
+}
+
+void ShipMove::Deserialize(BitBufferReader& dataReader)
+{
+	ElapsedTime = dataReader.ReadQuantized(0.0f, c_moveTimeMaximum, c_moveTimeBits);
+	Input.Deserialize(dataReader);
+}
+
+float ShipMove::QuantizeElapsedTime(float elapsedTime)
+{
+	return BitBufferWriter::Quantize(elapsedTime, 0.0f, c_moveTimeMaximum, c_moveTimeBits);
+}
+
+void ShipMoveHistory::Clear()
+{
+	m_oldestSequence = m_newestSequence + 1;
+}
+
+PredictedShipMove& ShipMoveHistory::Add(float elapsedTime, const ShipInput& input)
+{
+	m_newestSequence++;
+	if (m_newestSequence - m_oldestSequence >= c_capacity)
+	{
+		m_oldestSequence = m_newestSequence - c_capacity + 1;
+	}
+
+	PredictedShipMove& move = m_moves[m_newestSequence % c_capacity];
+	move.Move.Sequence = m_newestSequence;
+	move.Move.ElapsedTime = ShipMove::QuantizeElapsedTime(elapsedTime + m_elapsedTimeCarry);
+	m_elapsedTimeCarry = elapsedTime + m_elapsedTimeCarry - move.Move.ElapsedTime;
+
+	// A frame too long to send is the host's to correct, not something to spread over the next ones
+	if (std::abs(m_elapsedTimeCarry) > c_moveTimeCarryMaximum)
+	{
+		m_elapsedTimeCarry = 0.0f;
+	}
+	move.Move.Input = input;
+	move.HasPrediction = false;
+	return move;
+}
+
+PredictedShipMove* ShipMoveHistory::Find(uint32_t sequence)
+{
+	if (sequence < m_oldestSequence || sequence > m_newestSequence)
+	{
+		return nullptr;
+	}
+
+	return &m_moves[sequence % c_capacity];
+}
+
+const PredictedShipMove* ShipMoveHistory::Find(uint32_t sequence) const
+{
+	return const_cast<ShipMoveHistory*>(this)->Find(sequence);
+}
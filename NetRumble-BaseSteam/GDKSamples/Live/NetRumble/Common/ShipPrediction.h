@@ -0,0 +1,76 @@
+//--------------------------------------------------------------------------------------
+// ShipPrediction.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "ShipInput.h"
+#include "BitBuffer.h"
+
+namespace NetRumble
+{
+	// The part of a ship's state that its movement input drives.
+	struct ShipMotion
+	{
+		DirectX::SimpleMath::Vector2 Position;
+		DirectX::SimpleMath::Vector2 Velocity;
+		float Rotation = 0.0f;
+	};
+
+	// One frame of a ship's input, numbered by its owner so the host can report the last one it applied.
+	struct ShipMove
+	{
+		uint32_t Sequence = 0;
+		float ElapsedTime = 0.0f;
+		ShipInput Input;
+
+		// Prepare the move for the ShipInput packet; the sequence is implied by the packet header
+		void Serialize(BitBufferWriter& dataWriter) const;
+
+		// Get the move from the ShipInput packet
+		void Deserialize(BitBufferReader& dataReader);
+
+		// The elapsed time as the receivers will decode it
+		static float QuantizeElapsedTime(float elapsedTime);
+	};
+
+	// A move the local ship has made, with the motion the client predicted it would produce.
+	struct PredictedShipMove
+	{
+		ShipMove Move;
+		ShipMotion Predicted;
+		bool HasPrediction = false;
+	};
+
+	// Ring of the local ship's recent moves, looked up by sequence number. Moves are kept until
+	// they are overwritten so the ones the host has not yet applied can be replayed on top of
+	// its state. Sequence 0 is never stored, it means "no move applied yet" on the wire.
+	class ShipMoveHistory
+	{
+	public:
+		static constexpr uint32_t c_capacity = 128;
+
+		// Forget every move. Sequence numbers keep counting so the host, which remembers the
+		// last one it applied, never mistakes a new move for a repeat of an old one.
+		void Clear();
+
+		PredictedShipMove& Add(float elapsedTime, const ShipInput& input);
+		PredictedShipMove* Find(uint32_t sequence);
+		const PredictedShipMove* Find(uint32_t sequence) const;
+
+		inline uint32_t GetNewestSequence() const { return m_newestSequence; }
+		inline uint32_t GetOldestSequence() const { return m_oldestSequence; }
+		inline bool IsEmpty() const { return m_oldestSequence > m_newestSequence; }
+
+	private:
+		std::array<PredictedShipMove, c_capacity> m_moves;
+		uint32_t m_newestSequence = 0;
+		uint32_t m_oldestSequence = 1;
+
+		// What quantizing the elapsed times has left out so far, carried into the next move
+		// so the moves add up to the time that actually passed
+		float m_elapsedTimeCarry = 0.0f;
+	};
+}
@@ -14,7 +14,7 @@ namespace {
 
 void NetRumble::Lobby::CreateLobby()
 {
-	SteamAPICall_t hSteamAPICall = SteamMatchmaking()->CreateLobby(k_ELobbyTypePublic, MAX_PLAYERS_PER_SERVER);
+	SteamAPICall_t hSteamAPICall = SteamMatchmaking()->CreateLobby(k_ELobbyTypePublic, static_cast<int>(Managers::Get<OnlineManager>()->GetMaxPlayersPerServer()));
 	m_SteamCallResultLobbyCreated.Set(hSteamAPICall, this, &Lobby::OnLobbyCreated);
 }
 
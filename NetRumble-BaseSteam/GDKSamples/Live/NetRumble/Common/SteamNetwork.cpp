@@ -13,11 +13,14 @@ const char* NetRumble::MessageTypeString(GameMessageType type)
 	case GameMessageType::Unknown:            return STRINGIFY(GameMessageType::Unknown);
 	case GameMessageType::GameStart:          return STRINGIFY(GameMessageType::GameStart);
 	case GameMessageType::GameOver:           return STRINGIFY(GameMessageType::GameOver);
+	case GameMessageType::MessageBundle:      return STRINGIFY(GameMessageType::MessageBundle);
 	case GameMessageType::PlayerJoined:       return STRINGIFY(GameMessageType::PlayerJoined);
 	case GameMessageType::PlayerInfo:         return STRINGIFY(GameMessageType::PlayerInfo);
 	case GameMessageType::PowerUpSpawn:       return STRINGIFY(GameMessageType::PowerUpSpawn);
 	case GameMessageType::ServerWorldSetup:         return STRINGIFY(GameMessageType::ServerWorldSetup);
 	case GameMessageType::ServerUpdateWorldData:    return STRINGIFY(GameMessageType::ServerUpdateWorldData);
+	case GameMessageType::ServerUpdateShipData:     return STRINGIFY(GameMessageType::ServerUpdateShipData);
+	case GameMessageType::WorldDataAck:       return STRINGIFY(GameMessageType::WorldDataAck);
 	case GameMessageType::ShipSpawn:          return STRINGIFY(GameMessageType::ShipSpawn);
 	case GameMessageType::ShipInput:          return STRINGIFY(GameMessageType::ShipInput);
 	case GameMessageType::ShipData:           return STRINGIFY(GameMessageType::ShipData);
@@ -218,13 +221,18 @@ void SteamOnlineManager::CreateGameServer()
 		DisconnectFromServer();
 	}
 
-	g_game->GetGameServer() = std::make_unique<NetRumbleServer>();
+	g_game->GetGameServer() = std::make_unique<NetRumbleServer>(m_maxPlayersPerServer);
 
 	// We'll have to wait until the game server connects to the Steam server back-end 
 	// before telling all the lobby members to join (so that the NAT traversal code has a path to contact the game server)
 	DEBUGLOG("Game server being created; game will start soon.\n");
 }
 
+void SteamOnlineManager::SetMaxPlayersPerServer(uint32 players)
+{
+	m_maxPlayersPerServer = std::clamp<uint32>(players, 2, MAX_SERVER_SLOTS);
+}
+
 void SteamOnlineManager::DisconnectFromServer()
 {
 
@@ -250,6 +258,13 @@ void SteamOnlineManager::DisconnectFromServer()
 	{
 		SteamNetworkingSockets()->CloseConnection(m_connectedServerHandle, DisconnectReason::ClientDisconnect, nullptr, false);
 	}
+	m_bundler.Clear();
+
+	// What the network thread already took off the old connection goes with it
+	if (m_networkThread)
+	{
+		m_networkThread->Apply([](const NetworkPacket&) {});
+	}
 	m_serverSteamID = CSteamID();
 	m_connectedServerHandle = k_HSteamNetConnection_Invalid;
 
@@ -284,7 +299,7 @@ void SteamOnlineManager::OnReceiveServerFullResponse()
 
 bool SteamOnlineManager::SendGameMessage(const void* msg, const uint32 msgSize, int sendFlag)
 {
-	DEBUGLOG("Sending msg: %s\n", MessageTypeString(*(GameMessageType*)msg));
+	DEBUGLOG_PACKET("Sending msg: %s\n", MessageTypeString(*(GameMessageType*)msg));
 	const EResult resultCode = SteamNetworkingSockets()->SendMessageToConnection(GetConnectedServerHandle(), msg, msgSize, sendFlag, nullptr);
 
 #ifdef DEBUG_LOGGING
@@ -294,10 +309,11 @@ bool SteamOnlineManager::SendGameMessage(const void* msg, const uint32 msgSize,
 #endif
 }
 
-bool SteamOnlineManager::SendGameMessage(const GameMessage& message)
+bool SteamOnlineManager::SendGameMessage(const GameMessageView& message)
 {
-	DEBUGLOG("Sending msg: %s\n", MessageTypeString(message.MessageType()));
-	const std::vector<uint8_t>& msgData = message.Serialize();
+	DEBUGLOG_PACKET("Sending msg: %s\n", MessageTypeString(message.MessageType()));
+	message.SerializeTo(m_sendBuffer);
+	const std::vector<uint8_t>& msgData = m_sendBuffer;
 	const GameMessageType& messageType = message.MessageType();
 	int sendFlag = k_nSteamNetworkingSend_Reliable;
 	if (messageType == GameMessageType::ShipInput || messageType == GameMessageType::ShipData)
@@ -305,32 +321,53 @@ bool SteamOnlineManager::SendGameMessage(const GameMessage& message)
 		sendFlag = k_nSteamNetworkingSend_Unreliable;
 	}
 	HSteamNetConnection con = GetConnectedServerHandle();
-	DEBUGLOG("NetRumbleServer::SendMessageToAll m_connectionHandle == %llu\n", con);
-	const EResult resultCode = SteamNetworkingSockets()->SendMessageToConnection(GetConnectedServerHandle(), msgData.data(), static_cast<uint32>(msgData.size()), sendFlag, nullptr);
+	DEBUGLOG("SteamOnlineManager::SendGameMessage m_connectionHandle == %llu\n", con);
 
-#ifdef DEBUG_LOGGING
-	return GameMessageResultStateLog(resultCode);
-#else
-	return resultCode == k_EResultOK;
-#endif
+	// Goes out with the rest of this frame's messages in FlushGameMessages
+	m_bundler.Queue(con, sendFlag, msgData);
+	return con != k_HSteamNetConnection_Invalid;
 }
 
-bool SteamOnlineManager::SendGameMessageWithSourceID(const GameMessage& message)
+bool SteamOnlineManager::SendGameMessageWithSourceID(const GameMessageView& message)
 {
-	DEBUGLOG("Sending msg: %s\n", MessageTypeString(message.MessageType()));
-	const std::vector<uint8_t>& msgData = message.SerializeWithSourceID();
+	DEBUGLOG_PACKET("Sending msg: %s\n", MessageTypeString(message.MessageType()));
+	message.SerializeWithSourceIDTo(m_sendBuffer);
+	const std::vector<uint8_t>& msgData = m_sendBuffer;
 	const GameMessageType& messageType = message.MessageType();
 	int sendFlag = k_nSteamNetworkingSend_Reliable;
-	if (messageType == GameMessageType::ShipInput || messageType == GameMessageType::ShipData)
+	if (messageType == GameMessageType::ShipInput || messageType == GameMessageType::ShipData || messageType == GameMessageType::WorldDataAck)
 	{
 		sendFlag = k_nSteamNetworkingSend_Unreliable;
 	}
-	const EResult resultCode = SteamNetworkingSockets()->SendMessageToConnection(GetConnectedServerHandle(), msgData.data(), msgData.size(), sendFlag, nullptr);
+	m_bundler.Queue(GetConnectedServerHandle(), sendFlag, msgData);
+	return GetConnectedServerHandle() != k_HSteamNetConnection_Invalid;
+}
+
+void SteamOnlineManager::FlushGameMessages()
+{
+	m_bundler.Flush();
+}
+
+void SteamOnlineManager::SendBundledMessage(uint64_t connection, int sendFlags, DataBufferView message)
+{
+	if (m_networkThread)
+	{
+		m_networkThread->Send(connection, sendFlags, message);
+		return;
+	}
+
+	SendOnConnection(connection, sendFlags, message);
+}
+
+// Game thread, or the network thread when it runs
+void SteamOnlineManager::SendOnConnection(uint64_t connection, int sendFlags, DataBufferView message)
+{
+	const EResult resultCode = SteamNetworkingSockets()->SendMessageToConnection(static_cast<HSteamNetConnection>(connection), message.data(), static_cast<uint32>(message.size()), sendFlags, nullptr);
 
 #ifdef DEBUG_LOGGING
-	return GameMessageResultStateLog(resultCode);
+	GameMessageResultStateLog(resultCode);
 #else
-	return resultCode == k_EResultOK;
+	UNREFERENCED_PARAMETER(resultCode);
 #endif
 }
 
@@ -348,18 +385,19 @@ uint64_t SteamOnlineManager::GetNetworkId() const
 // Server msg process (current client is the host of the server)
 // Send the same msg to all clients, except the ignored connection if any
 // default value of hConnIgnore will not ignore any connections to the server 
-bool SteamOnlineManager::ServerSendMessageToAll(const GameMessage& message, bool serializeWithSourceID, int sendFlags) const
+bool SteamOnlineManager::ServerSendMessageToAll(const GameMessageView& message, bool serializeWithSourceID, int sendFlags) const
 {
 	if (!IsServer())
 	{
 		DEBUGLOG("Server msg should be processed by server host\n");
 		return false;
 	}
-	DEBUGLOG("Server sends msg: %s\n", MessageTypeString(message.MessageType()));
+	DEBUGLOG_PACKET("Server sends msg: %s\n", MessageTypeString(message.MessageType()));
 
 	if (serializeWithSourceID)
 	{
-		const std::vector<uint8_t>& data = message.SerializeWithSourceID();
+		message.SerializeWithSourceIDTo(m_sendBuffer);
+		const std::vector<uint8_t>& data = m_sendBuffer;
 		// uint64 is the size of message sender ID
 		if (data.size() < sizeof(GameMessageType) + sizeof(uint64))
 		{
@@ -370,7 +408,8 @@ bool SteamOnlineManager::ServerSendMessageToAll(const GameMessage& message, bool
 	}
 	else
 	{
-		const std::vector<uint8_t>& data = message.Serialize();
+		message.SerializeTo(m_sendBuffer);
+		const std::vector<uint8_t>& data = m_sendBuffer;
 		if (data.size() < sizeof(GameMessageType))
 		{
 			DEBUGLOG("Ill-formed GameMessage msg!\n Message size is smaller than an empty signal msg with only msg type in it.\n");
@@ -382,7 +421,7 @@ bool SteamOnlineManager::ServerSendMessageToAll(const GameMessage& message, bool
 	return true;
 }
 
-bool SteamOnlineManager::ServerSendMessageToAllIgnore(const GameMessage& message, std::set<HSteamNetConnection>& ignoreConnectionSet, bool serializeWithSourceID, int sendFlags) const
+bool SteamOnlineManager::ServerSendMessageToAllIgnore(const GameMessageView& message, SlotMask ignoreSlots, bool serializeWithSourceID, int sendFlags) const
 {
 	if (!IsServer())
 	{
@@ -390,27 +429,29 @@ bool SteamOnlineManager::ServerSendMessageToAllIgnore(const GameMessage& message
 		return false;
 	}
 
-	DEBUGLOG("Server sends msg: %s\n", MessageTypeString(message.MessageType()));
+	DEBUGLOG_PACKET("Server sends msg: %s\n", MessageTypeString(message.MessageType()));
 
 	if (serializeWithSourceID)
 	{
-		const std::vector<uint8_t>& data = message.SerializeWithSourceID();
+		message.SerializeWithSourceIDTo(m_sendBuffer);
+		const std::vector<uint8_t>& data = m_sendBuffer;
 		if (data.size() < sizeof(GameMessageType) + sizeof(uint64))
 		{
 			return false;
 		}
 
-		g_game->GetGameServer()->SendMessageToAllIgnore(data.data(), data.size(), ignoreConnectionSet, sendFlags);
+		g_game->GetGameServer()->SendMessageToAllIgnore(data.data(), static_cast<uint32>(data.size()), ignoreSlots, sendFlags);
 	}
 	else
 	{
-		const std::vector<uint8_t>& data = message.Serialize();
+		message.SerializeTo(m_sendBuffer);
+		const std::vector<uint8_t>& data = m_sendBuffer;
 		if (data.size() < sizeof(GameMessageType))
 		{
 			return false;
 		}
 
-		g_game->GetGameServer()->SendMessageToAllIgnore(data.data(), data.size(), ignoreConnectionSet, sendFlags);
+		g_game->GetGameServer()->SendMessageToAllIgnore(data.data(), static_cast<uint32>(data.size()), ignoreSlots, sendFlags);
 	}
 	return true;
 }
@@ -434,20 +475,27 @@ void SteamOnlineManager::ClientProcessNetworkMessage()
 		return;
 	}
 
-	const HSteamNetConnection connectedServerHandle = GetConnectedServerHandle();
-	if (connectedServerHandle == k_HSteamNetConnection_Invalid)
+	if (!g_game->GetWorld())
 	{
+		DEBUGLOG("The world is empty\n");
 		return;
 	}
 
-	std::unique_ptr<World>& world = g_game->GetWorld();
-	if (!world)
+	if (m_networkThread)
+	{
+		m_networkThread->Apply([this](const NetworkPacket& packet)
+			{
+				m_applyLatency.Record(std::chrono::duration<float, std::milli>(NetworkThread::Clock::now() - packet.ReceivedAt).count());
+				ClientProcessMessage(packet.Data, packet.Peer);
+			});
+		return;
+	}
+
+	const HSteamNetConnection connectedServerHandle = GetConnectedServerHandle();
+	if (connectedServerHandle == k_HSteamNetConnection_Invalid)
 	{
-		DEBUGLOG("The world is empty\n");
 		return;
 	}
-	const uint64 localUserID = GetLocalSteamID().ConvertToUint64();
-	const GameState gameState = Managers::Get<GameStateManager>()->GetState();
 
 	SteamNetworkingMessage_t* msgs[MAX_MESSAGE_NUM_FETCHED_FROM_CONNECTION];
 	// Fetch the next available msg(s) from the connection, if any.
@@ -457,326 +505,394 @@ void SteamOnlineManager::ClientProcessNetworkMessage()
 	for (int i = 0; i < msgNum; i++)
 	{
 		SteamNetworkingMessage_t* msg = msgs[i];
-		uint32 msgSize = msg->GetSize();
-		const GameMessageType msgType = (GameMessageType)(*(GameMessageType*)msg->GetData());
+		m_applyLatency.Record(static_cast<float>(SteamNetworkingUtils()->GetLocalTimestamp() - msg->m_usecTimeReceived) / 1000.0f);
+
+		ClientProcessMessage(DataBufferView(static_cast<const uint8_t*>(msg->GetData()), msg->GetSize()), msg->m_identityPeer.GetSteamID64());
+		msg->Release();
+	}
+}
+
+// Network thread. Each message is stamped with when Steam received it, so its latency
+// covers the wait on the connection as well as the wait in the queue.
+void SteamOnlineManager::ReceiveOnNetworkThread(NetworkThread& thread)
+{
+	ISteamNetworkingSockets* sockets = SteamNetworkingSockets();
+	const HSteamNetConnection connectedServerHandle = m_connectedServerHandle.load();
+	if (sockets == nullptr || connectedServerHandle == k_HSteamNetConnection_Invalid)
+	{
+		return;
+	}
+
+	SteamNetworkingMessage_t* msgs[MAX_MESSAGE_NUM_FETCHED_FROM_CONNECTION];
+	int msgNum = sockets->ReceiveMessagesOnConnection(connectedServerHandle, msgs, MAX_MESSAGE_NUM_FETCHED_FROM_CONNECTION);
+	if (msgNum <= 0)
+	{
+		return;
+	}
+
+	const NetworkThread::Clock::time_point now = NetworkThread::Clock::now();
+	const SteamNetworkingMicroseconds steamNow = SteamNetworkingUtils()->GetLocalTimestamp();
+	for (int i = 0; i < msgNum; i++)
+	{
+		SteamNetworkingMessage_t* msg = msgs[i];
+		const std::chrono::microseconds waited(steamNow - msg->m_usecTimeReceived);
+
+		thread.Received(
+			msg->m_identityPeer.GetSteamID64(),
+			now - std::chrono::duration_cast<NetworkThread::Clock::duration>(waited),
+			DataBufferView(static_cast<const uint8_t*>(msg->GetData()), msg->GetSize()));
+		msg->Release();
+	}
+}
+
+void SteamOnlineManager::SetNetworkThreadEnabled(bool enabled)
+{
+	if (!enabled)
+	{
+		m_networkThread.reset();
+	}
+	else if (!m_networkThread)
+	{
+		m_networkThread = std::make_unique<NetworkThread>(
+			[this](NetworkThread& thread) { ReceiveOnNetworkThread(thread); },
+			[this](const NetworkPacket& packet) { SendOnConnection(packet.Peer, packet.Flags, packet.Data); });
+	}
+
+	m_applyLatency.Reset();
+}
+
+// One transport message from the server: a bundle of packets, or a single packet
+void SteamOnlineManager::ClientProcessMessage(DataBufferView message, uint64 senderId)
+{
+	// Whatever the server sent in one frame arrives as one bundle; its packets are handled in order
+	if (!MessageBundler::ForEachPacket(message, [&](DataBufferView packet) { ClientProcessPacket(packet, senderId); }))
+	{
+		DEBUGLOG("Got a malformed message bundle on client socket\n");
+	}
+
+	// If we're hosting a server
+	if (Managers::Get<OnlineManager>()->IsServer())
+	{
+		Managers::Get<OnlineManager>()->ServerProcessNetworkMessage();
+	}
+}
+
+// One packet from the server, either sent on its own or unpacked from a bundle
+void SteamOnlineManager::ClientProcessPacket(DataBufferView packet, uint64 senderId)
+{
+	std::unique_ptr<World>& world = g_game->GetWorld();
+	const uint64 localUserID = GetLocalSteamID().ConvertToUint64();
+	const GameState gameState = Managers::Get<GameStateManager>()->GetState();
+
+	const uint32 msgSize = static_cast<uint32>(packet.size());
+	if (msgSize < sizeof(GameMessageType))
+	{
+		DEBUGLOG("Got garbage on client socket, too short\n");
+		return;
+	}
+
+	GameMessageType msgType;
+	memcpy(&msgType, packet.data(), sizeof(msgType));
+
+	//	Make sure we're connected
+	if (GetConnectedState() == ClientNotConnected && gameState != GameState::JoinGameFromLobby)
+	{
+		if (msgType != GameMessageType::ServerSendInfo)
+		{
+			return;
+		}
+	}
 
-		//	Make sure we're connected
-		if (GetConnectedState() == ClientNotConnected && gameState != GameState::JoinGameFromLobby)
+	if (msgType > GameMessageType::ServerMessageBegin)
+	{
+		const void* messageData = packet.data();
+		switch (msgType)
+		{
+		case GameMessageType::ServerSendInfo:
 		{
-			if (msgType != GameMessageType::ServerSendInfo)
+			if (msgSize != sizeof(MsgServerSendInfo_t))
 			{
-				msg->Release();
-				continue;
+				DEBUGLOG("Bad server info msg\n");
+				break;
 			}
+			const MsgServerSendInfo_t* message = static_cast<const MsgServerSendInfo_t*>(messageData);
+
+			// Pull the IP address of the user from the socket
+			OnReceiveServerInfo(CSteamID(message->GetSteamIDServer()), message->GetSecure(), message->GetServerName());
+			break;
 		}
+		case GameMessageType::ServerPassAuthentication:
+		{
+			if (msgSize != sizeof(MsgServerPassAuthentication_t))
+			{
+				DEBUGLOG("Bad accept connection msg\n");
+				break;
+			}
+			const MsgServerPassAuthentication_t* message = static_cast<const MsgServerPassAuthentication_t*>(messageData);
 
-		if (msgSize < sizeof(GameMessageType))
+			// Our game client doesn't really care about whether the server is secure, or what its 
+			// steamID is, but if it did we would pass them in here as they are part of the accept msg
+			OnReceiveServerAuthenticationResponse(true, message->GetPlayerPosition());
+			break;
+		}
+		case GameMessageType::ServerFailAuthentication:
 		{
-			DEBUGLOG("Got garbage on client socket, too short\n");
-			msg->Release();
-			continue;
+			OnReceiveServerAuthenticationResponse(false, 0);
+			break;
 		}
-
-		if (msgType > GameMessageType::ServerMessageBegin)
+		case GameMessageType::VoiceChatData:
 		{
-			auto messageData = msg->GetData();
+			// Here we just assume the message is the right size
+			const AudioManager* audioManager = Managers::Get<AudioManager>();
+			if (audioManager && audioManager->IsVoiceChatActive())
+			{
+				std::shared_ptr<SteamVoiceChat> voiceChat = OnlineVoiceChat::GetInstance().GetVoiceChat();
+				if (voiceChat)
+				{
+					voiceChat->HandleVoiceChatData(messageData);
+				}
+			}
+			break;
+		}
+		default:
+		{
+			DEBUGLOG("Unhandled message:[%s] from server\n", MessageTypeString(msgType));
+			break;
+		}
+		}
+	}
+	else
+	{
+		uint64 sourceId = senderId;
+		const size_t msgTypeSize = sizeof(GameMessageType);
+		uint32 payloadSize = msgSize - static_cast<uint32>(msgTypeSize);
+
+		if (msgType == GameMessageType::ShipInput ||
+			msgType == GameMessageType::ShipSpawn ||
+			msgType == GameMessageType::ShipDeath ||
+			msgType == GameMessageType::PlayerInfo ||
+			msgType == GameMessageType::PlayerJoined)
+		{
+			// These messages contain both message type and sourceId as appended header
+			// Please take a look at GameMessage::SerializeWithSourceID()
+			// This is because these messages dispatch from game server
+			// Therefore, the sender's identity will give game server's SteamId instead of the original source of the real message sender
+			if (msgSize < msgTypeSize + sizeof(sourceId))
+			{
+				DEBUGLOG("Got garbage on client socket, no source ID\n");
+				return;
+			}
+			memcpy(&sourceId, packet.data() + MsgTypeSize, sizeof(sourceId));
+			const size_t sourceIdSize = sizeof(sourceId);
+			// Size of the payload. 
+			payloadSize = msgSize - static_cast<uint32>(msgTypeSize + sourceIdSize);
+			const uint8_t* dataBegin = packet.data() + msgTypeSize + sourceIdSize;
+			// Message payload
+			const DataBufferView messageData(dataBegin, payloadSize);
+			std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(sourceId);
+
 			switch (msgType)
 			{
-			case GameMessageType::ServerSendInfo:
+			case GameMessageType::PlayerJoined:
 			{
-				if (msgSize != sizeof(MsgServerSendInfo_t))
+				DEBUGLOG("Received a PlayerJoined msg from %u\n", sourceId);
+				if (playerState == nullptr)
 				{
-					DEBUGLOG("Bad server info msg\n");
-					break;
+					playerState = std::make_shared<PlayerState>();
+					playerState->DeserializePlayerStateData(messageData);
+					playerState->PeerId = sourceId;
+					g_game->AddPlayerToLobbyPeers(playerState);
+				}
+				else
+				{
+					playerState->DeserializePlayerStateData(messageData);
 				}
-				MsgServerSendInfo_t* message = (MsgServerSendInfo_t*)messageData;
 
-				// Pull the IP address of the user from the socket
-				OnReceiveServerInfo(CSteamID(message->GetSteamIDServer()), message->GetSecure(), message->GetServerName());
+				if (sourceId != localUserID && playerState->InGame == true && playerState->InLobby == false)
+				{
+					AudioManager* audioManager = Managers::Get<AudioManager>();
+					if (audioManager)
+					{
+						audioManager->StartVoiceChat();
+						OnlineVoiceChat::GetInstance().GetVoiceChat()->MarkPlayerAsActive(sourceId);
+					}
+				}
 				break;
 			}
-			case GameMessageType::ServerPassAuthentication:
+			case GameMessageType::PlayerInfo:
 			{
-				if (msgSize != sizeof(MsgServerPassAuthentication_t))
+				if (sourceId == localUserID)
+				{
+					DEBUGLOG("Local players have all their own PlayerInfo %u\n", sourceId);
+					break;
+				}
+				const auto& peers = g_game->GetPeers();
+				const auto& itr = peers.find(sourceId);
+				// Player has joined already 
+				if (itr == peers.end())
 				{
-					DEBUGLOG("Bad accept connection msg\n");
+					DEBUGLOG("Received PlayerInfo for unknown peer %u\n", sourceId);
 					break;
 				}
-				MsgServerPassAuthentication_t* message = (MsgServerPassAuthentication_t*)messageData;
 
-				// Our game client doesn't really care about whether the server is secure, or what its 
-				// steamID is, but if it did we would pass them in here as they are part of the accept msg
-				OnReceiveServerAuthenticationResponse(true, message->GetPlayerPosition());
+				// Message comes from one of other player joins in same game
+				auto& newPlayerState = itr->second;
+				newPlayerState->DisplayName = GameMessageView::FromPacket(messageData).StringValue().c_str();
+				DEBUGLOG("Received PlayerInfo for: %ws\n", newPlayerState->DisplayName.c_str());
 				break;
 			}
-			case GameMessageType::ServerFailAuthentication:
+			case GameMessageType::ShipSpawn:
 			{
-				OnReceiveServerAuthenticationResponse(false, 0);
+				DEBUGLOG("Received a ShipSpawn msg\n");
+				if (world->IsInitialized())
+				{
+					world->DeserializeShipSpawn(messageData);
+				}
+				else
+				{
+					DEBUGLOG("ShipSpawn ...World not initialized!\n");
+				}
 				break;
 			}
-			case GameMessageType::VoiceChatData:
+			case GameMessageType::ShipDeath:
 			{
-				// Here we just assume the message is the right size
-				const AudioManager* audioManager = Managers::Get<AudioManager>();
-				if (audioManager && audioManager->IsVoiceChatActive())
+				DEBUGLOG("Received a ShipDeath msg from %u\n", sourceId);
+				if (world->IsInitialized())
 				{
-					std::shared_ptr<SteamVoiceChat> voiceChat = OnlineVoiceChat::GetInstance().GetVoiceChat();
-					if (voiceChat)
+					if (playerState != nullptr)
 					{
-						voiceChat->HandleVoiceChatData(messageData);
+						world->DeserializeShipDeath(sourceId, messageData);
 					}
+					else
+					{
+						DEBUGLOG("PlayerState not found for %u\n", sourceId);
+					}
+				}
+				else
+				{
+					DEBUGLOG("ShipDeath ...World not initialized!\n");
 				}
 				break;
 			}
-			default:
+			case GameMessageType::ShipInput:
 			{
-				DEBUGLOG("Unhandled message:[%s] from server\n", MessageTypeString(msgType));
+				if (world->IsInitialized())
+				{
+					if (playerState != nullptr)
+					{
+						playerState->GetShip()->DeserializeMoves(messageData);
+					}
+				}
+				else
+				{
+					DEBUGLOG("ShipInput ...World not initialized!\n");
+				}
 				break;
 			}
 			}
 		}
 		else
 		{
-			uint64 sourceId = msg->m_identityPeer.GetSteamID64();
-			const size_t msgTypeSize = sizeof(GameMessageType);
-			uint32 msgSize = msg->GetSize() - msgTypeSize;
-
-			if (msgType == GameMessageType::ShipInput ||
-				msgType == GameMessageType::ShipSpawn ||
-				msgType == GameMessageType::ShipData ||
-				msgType == GameMessageType::ShipDeath ||
-				msgType == GameMessageType::PlayerInfo ||
-				msgType == GameMessageType::PlayerJoined)
+			const uint8_t* dataBegin = packet.data() + msgTypeSize;
+			// Message payload
+			const DataBufferView messageData(dataBegin, payloadSize);
+
+			switch (msgType)
 			{
-				// These messages contain both message type and sourceId as appended header
-				// Please take a look at GameMessage::SerializeWithSourceID()
-				// This is because these messages dispatch from game server
-				// Therefore, msg->m_identityPeer.GetSteamID64() will give game server's SteamId instead of the original source of the real message sender 
-				sourceId = *(uint64_t*)((char*)msg->GetData() + MsgTypeSize);
-				const GameMessageType msgType = (GameMessageType)(*(GameMessageType*)msg->GetData());
-				const size_t sourceIdSize = sizeof(sourceId);
-				// Size of the payload. 
-				msgSize = msg->GetSize() - msgTypeSize - sourceIdSize;
-				const uint8_t* dataBegin = static_cast<const uint8_t*>(msg->GetData()) + msgTypeSize + sourceIdSize;
-				const uint8_t* dataEnd = dataBegin + msgSize;
-				// Message payload
-				const std::vector<uint8_t>& messageData = std::vector<uint8_t>(dataBegin, dataEnd);
-				std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(sourceId);
-
-				switch (msgType)
-				{
-				case GameMessageType::PlayerJoined:
+			case GameMessageType::GameStart:
+			{
+				DEBUGLOG("Received a GameStart msg\n");
+				std::shared_ptr<PlayerState> localPlayerState = g_game->GetPlayerState(localUserID);
+				if (!localPlayerState->InGame)
 				{
-					DEBUGLOG("Received a PlayerJoined msg from %u\n", sourceId);
-					if (playerState == nullptr)
-					{
-						playerState = std::make_shared<PlayerState>();
-						playerState->DeserializePlayerStateData(messageData);
-						playerState->PeerId = sourceId;
-						g_game->AddPlayerToLobbyPeers(playerState);
-					}
-					else
-					{
-						playerState->DeserializePlayerStateData(messageData);
-					}
-
-					if (sourceId != localUserID && playerState->InGame == true && playerState->InLobby == false)
-					{
-						AudioManager* audioManager = Managers::Get<AudioManager>();
-						if (audioManager)
-						{
-							audioManager->StartVoiceChat();
-							OnlineVoiceChat::GetInstance().GetVoiceChat()->MarkPlayerAsActive(sourceId);
-						}
-					}
-					break;
+					world->SetGameInProgress(true);
 				}
-				case GameMessageType::PlayerInfo:
+				break;
+			}
+			case GameMessageType::GameOver:
+			{
+				if (world->IsInitialized())
 				{
-					if (sourceId == localUserID)
-					{
-						DEBUGLOG("Local players have all their own PlayerInfo %u\n", sourceId);
-						break;
-					}
-					const auto& peers = g_game->GetPeers();
-					const auto& itr = peers.find(sourceId);
-					// Player has joined already 
-					if (itr == peers.end())
-					{
-						DEBUGLOG("Received PlayerInfo for unknown peer %u\n", sourceId);
-						break;
-					}
+					DEBUGLOG("Received a GameOver message\n");
 
-					// Message comes from one of other player joins in same game
-					auto& newPlayerState = itr->second;
-					newPlayerState->DisplayName = GameMessage(messageData).StringValue().c_str();
-					DEBUGLOG("Received PlayerInfo for: %ws\n", newPlayerState->DisplayName.c_str());
-					break;
-				}
-				case GameMessageType::ShipData:
-				{
-					if (world->IsInitialized())
+					std::shared_ptr<PlayerState> localPlayer = g_game->GetLocalPlayerState();
+					if (localPlayer->InGame)
 					{
-						if (playerState != nullptr)
-						{
-							playerState->GetShip()->Deserialize(messageData);
-						}
+						world->IsGameWon = true;
+						world->SetGameInProgress(false);
+						world->DeserializeGameOver(messageData);
 					}
 					else
 					{
-						DEBUGLOG("Received a ShipData msg\n...World not initialized!\n");
+						g_game->ResetGameplayData();
 					}
-					break;
 				}
-				case GameMessageType::ShipSpawn:
+				break;
+			}
+			case GameMessageType::PlayerLeft:
+			{
+				DEBUGLOG("Received a PlayerLeft msg from %u\n", sourceId);
+				CSteamID steamID = Managers::Get<OnlineManager>()->DeserializePlayerDisconnect(messageData);
+				if (steamID.ConvertToUint64() != localUserID)
 				{
-					DEBUGLOG("Received a ShipSpawn msg\n");
-					if (world->IsInitialized())
-					{
-						world->DeserializeShipSpawn(messageData);
-					}
-					else
-					{
-						DEBUGLOG("ShipSpawn ...World not initialized!\n");
-					}
-					break;
+					g_game->RemovePlayerFromGamePeers(steamID.ConvertToUint64());
 				}
-				case GameMessageType::ShipDeath:
+				break;
+			}
+			case GameMessageType::PowerUpSpawn:
+			{
+				DEBUGLOG("Received a PowerUpSpawn msg\n");
+				if (world->IsInitialized())
 				{
-					DEBUGLOG("Received a ShipDeath msg from %u\n", sourceId);
-					if (world->IsInitialized())
-					{
-						if (playerState != nullptr)
-						{
-							world->DeserializeShipDeath(sourceId, messageData);
-						}
-						else
-						{
-							DEBUGLOG("PlayerState not found for %u\n", sourceId);
-						}
-					}
-					else
-					{
-						DEBUGLOG("ShipDeath ...World not initialized!\n");
-					}
-					break;
+					world->DeserializePowerUpSpawn(messageData);
 				}
-				case GameMessageType::ShipInput:
+				else
 				{
-					if (world->IsInitialized())
-					{
-						if (playerState != nullptr)
-						{
-							playerState->GetShip()->Deserialize(messageData);
-						}
-					}
-					else
-					{
-						DEBUGLOG("ShipInput ...World not initialized!\n");
-					}
-					break;
-				}
+					DEBUGLOG("PowerUpSpawn ...World not initialized!\n");
 				}
+				break;
 			}
-			else
+			case GameMessageType::ServerUpdateWorldData:
 			{
-				const uint8_t* dataBegin = static_cast<const uint8_t*>(msg->GetData()) + msgTypeSize;
-				const uint8_t* dataEnd = dataBegin + msgSize;
-				// Message payload
-				const std::vector<uint8_t>& messageData = std::vector<uint8_t>(dataBegin, dataEnd);
-
-				switch (msgType)
-				{
-				case GameMessageType::GameStart:
+				if (world->IsInitialized())
 				{
-					DEBUGLOG("Received a GameStart msg\n");
-					std::shared_ptr<PlayerState> localPlayerState = g_game->GetPlayerState(localUserID);
-					if (!localPlayerState->InGame)
-					{
-						world->SetGameInProgress(true);
-					}
-					break;
+					world->DeserializeWorldData(messageData);
 				}
-				case GameMessageType::GameOver:
+				else
 				{
-					if (world->IsInitialized())
-					{
-						DEBUGLOG("Received a GameOver message\n");
-
-						std::shared_ptr<PlayerState> localPlayer = g_game->GetLocalPlayerState();
-						if (localPlayer->InGame)
-						{
-							world->IsGameWon = true;
-							world->SetGameInProgress(false);
-							world->DeserializeGameOver(messageData);
-						}
-						else
-						{
-							g_game->ResetGameplayData();
-						}
-					}
-					break;
+					DEBUGLOG("ServerUpdateWorldData ...World not initialized!\n");
 				}
-				case GameMessageType::PlayerLeft:
+				break;
+			}
+			case GameMessageType::ServerUpdateShipData:
+			{
+				if (world->IsInitialized())
 				{
-					DEBUGLOG("Received a PlayerLeft msg from %u\n", sourceId);
-					CSteamID steamID = Managers::Get<OnlineManager>()->DeserializePlayerDisconnect(messageData);
-					if (steamID.ConvertToUint64() != localUserID)
-					{
-						g_game->RemovePlayerFromGamePeers(steamID.ConvertToUint64());
-					}
-					break;
+					world->DeserializeShipData(messageData);
 				}
-				case GameMessageType::PowerUpSpawn:
+				else
 				{
-					DEBUGLOG("Received a PowerUpSpawn msg\n");
-					if (world->IsInitialized())
-					{
-						world->DeserializePowerUpSpawn(messageData);
-					}
-					else
-					{
-						DEBUGLOG("PowerUpSpawn ...World not initialized!\n");
-					}
-					break;
+					DEBUGLOG("ServerUpdateShipData ...World not initialized!\n");
 				}
-				case GameMessageType::ServerUpdateWorldData:
+				break;
+			}
+			case GameMessageType::ServerWorldSetup:
+			{
+				DEBUGLOG("Received a WorldSetup msg\n");
+				if (!world->IsInitialized())
 				{
-					if (world->IsInitialized())
-					{
-						world->DeserializeWorldData(messageData);
-					}
-					else
-					{
-						DEBUGLOG("ServerUpdateWorldData ...World not initialized!\n");
-					}
-					break;
+					world->DeserializeWorldSetup(messageData);
 				}
-				case GameMessageType::ServerWorldSetup:
+				else
 				{
-					DEBUGLOG("Received a WorldSetup msg\n");
-					if (!world->IsInitialized())
-					{
-						world->DeserializeWorldSetup(messageData);
-					}
-					else
-					{
-						DEBUGLOG("...World is already initialized!\n");
-					}
-					break;
-				}
-				default:
-					DEBUGLOG("Unhandled msg from server\n");
-					break;
+					DEBUGLOG("...World is already initialized!\n");
 				}
+				break;
+			}
+			default:
+				DEBUGLOG("Unhandled msg from server\n");
+				break;
 			}
-			msg->Release();
-		}
-
-		// If we're hosting a server
-		if (Managers::Get<OnlineManager>()->IsServer())
-		{
-			Managers::Get<OnlineManager>()->ServerProcessNetworkMessage();
 		}
 	}
 }
@@ -902,9 +1018,14 @@ std::vector<uint8_t> SteamOnlineManager::SerializePlayerDisconnect(CSteamID stea
 	return data;
 }
 
-CSteamID NetRumble::SteamOnlineManager::DeserializePlayerDisconnect(const std::vector<uint8_t>& data)
+CSteamID NetRumble::SteamOnlineManager::DeserializePlayerDisconnect(DataBufferView data)
 {
 	CSteamID rcvdsteamID = CSteamID();
+	if (data.size() < sizeof(CSteamID))
+	{
+		return rcvdsteamID;
+	}
+
 	CopyMemory(&rcvdsteamID, data.data(), sizeof(CSteamID));
 	return rcvdsteamID;
 }
@@ -2,7 +2,8 @@
 
 using namespace NetRumble;
 
-NetRumble::SteamOnlineManager::SteamOnlineManager()
+NetRumble::SteamOnlineManager::SteamOnlineManager() :
+	m_bundler([this](uint64_t connection, int sendFlags, DataBufferView message) { SendBundledMessage(connection, sendFlags, message); })
 {
 	// Initialize the peer to peer connection process
 	SteamNetworkingUtils()->InitRelayNetworkAccess();
@@ -10,6 +11,7 @@ NetRumble::SteamOnlineManager::SteamOnlineManager()
 
 NetRumble::SteamOnlineManager::~SteamOnlineManager()
 {
+	m_networkThread.reset();
 }
 
 void NetRumble::SteamOnlineManager::CreateLobby()
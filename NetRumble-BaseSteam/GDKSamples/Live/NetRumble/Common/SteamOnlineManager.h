@@ -2,7 +2,9 @@
 
 #include "pch.h"
 #include "NetRumbleServer.h"
+#include "MessageBundle.h"
 #include "NetworkMessages.h"
+#include "NetworkThread.h"
 #include "StatsAndAchievements.h"
 #include "SteamLobby.h"
 #include "SteamInventory.h"
@@ -25,19 +27,32 @@ namespace NetRumble
 		virtual void LeaveMultiplayerGame() override;
 
 		// Client message
-		// All the game play message will be send this way
-		virtual bool SendGameMessage(const GameMessage& message) override;
+		// All the game play message will be send this way, queued until FlushGameMessages
+		virtual bool SendGameMessage(const GameMessageView& message) override;
 		// This is used for client message that will be dispatched by game server
-		virtual bool SendGameMessageWithSourceID(const GameMessage& message);
+		virtual bool SendGameMessageWithSourceID(const GameMessageView& message);
 		// Steam login and authentication message will be sent this way, most of these type of message should be reliable
 		bool SendGameMessage(const void* msg, const uint32 msgSize, int sendFlag);
+		// Sends the game messages queued this frame, one bundle per delivery class
+		void FlushGameMessages();
+		// Applies the messages from the server: those the network thread has received, or
+		// with it off, whatever the connection has ready now
 		void ClientProcessNetworkMessage();
 
+		// The network thread receives and sends game traffic off the game thread when this
+		// turns it on; off, the default, does both inline in Tick and FlushGameMessages. Call
+		// before connecting: switching drops messages in flight.
+		void SetNetworkThreadEnabled(bool enabled);
+		inline bool IsNetworkThreadEnabled() const { return m_networkThread != nullptr; }
+		// How long messages from the server waited between Steam receiving them and the game applying them
+		inline const ApplyLatency& GetApplyLatency() const { return m_applyLatency; }
+		inline void ResetApplyLatency() { m_applyLatency.Reset(); }
+
 		// Server message (local player is the host of the game server)
-		// Send the same message to all clients, except the ignored connection if any
+		// Send the same message to all clients, except those in the ignored slots if any
 		// Some dispatched message from client will require the original sender ID, in such case the last bool should be set to true
-		bool ServerSendMessageToAll(const GameMessage& message, bool serializeWithSourceID = false, int sendFlags = k_nSteamNetworkingSend_UnreliableNoDelay) const;
-		bool ServerSendMessageToAllIgnore(const GameMessage& message, std::set<HSteamNetConnection>& ingoreConnectionSet, bool serializeWithSourceID = false, int sendFlags = k_nSteamNetworkingSend_UnreliableNoDelay) const;
+		bool ServerSendMessageToAll(const GameMessageView& message, bool serializeWithSourceID = false, int sendFlags = k_nSteamNetworkingSend_UnreliableNoDelay) const;
+		bool ServerSendMessageToAllIgnore(const GameMessageView& message, SlotMask ignoreSlots, bool serializeWithSourceID = false, int sendFlags = k_nSteamNetworkingSend_UnreliableNoDelay) const;
 		void ServerProcessNetworkMessage();
 
 		virtual bool IsConnected() const override;
@@ -70,6 +85,11 @@ namespace NetRumble
 
 		void CreateGameServer();
 
+		// Players a game server from CreateGameServer holds and its lobby admits, clamped to
+		// [2, MAX_SERVER_SLOTS]. Takes effect at the next CreateLobby and CreateGameServer.
+		void SetMaxPlayersPerServer(uint32 players);
+		inline uint32 GetMaxPlayersPerServer() const { return m_maxPlayersPerServer; }
+
 		// Received a response that the server is full
 		void OnReceiveServerFullResponse();
 
@@ -86,7 +106,7 @@ namespace NetRumble
 		void DispatchMessageInLobby(std::string& message);
 
 		std::vector<uint8_t> SerializePlayerDisconnect(CSteamID steamID ) const;
-		CSteamID DeserializePlayerDisconnect(const std::vector<uint8_t>& data);
+		CSteamID DeserializePlayerDisconnect(DataBufferView data);
 
 		// StatsAndAchievements
 		void InitializeStatsAndAchievements();
@@ -131,7 +151,8 @@ namespace NetRumble
 		// Steam
 		CSteamID m_localPlayerSteamID;
 
-		HSteamNetConnection m_connectedServerHandle{ k_HSteamNetConnection_Invalid };
+		// Also read by the network thread
+		std::atomic<HSteamNetConnection> m_connectedServerHandle{ k_HSteamNetConnection_Invalid };
 
 		// Track whether we are connected to a server (and what specific state that connection is in)
 		ClientConnectionState m_connectedState;
@@ -151,6 +172,8 @@ namespace NetRumble
 		// Our ship position in the array below
 		uint32 m_playerShipIndex;
 
+		uint32 m_maxPlayersPerServer{ DEFAULT_PLAYERS_PER_SERVER };
+
 		// Callbacks for Steam connection state
 		STEAM_CALLBACK(SteamOnlineManager, OnSteamServersConnected, SteamServersConnected_t);
 		STEAM_CALLBACK(SteamOnlineManager, OnSteamServersDisconnected, SteamServersDisconnected_t);
@@ -162,11 +185,30 @@ namespace NetRumble
 		
 		bool GameMessageResultStateLog(const EResult result);
 
+		void ClientProcessMessage(DataBufferView message, uint64 senderId);
+		void ClientProcessPacket(DataBufferView packet, uint64 senderId);
+		void SendBundledMessage(uint64_t connection, int sendFlags, DataBufferView message);
+		void SendOnConnection(uint64_t connection, int sendFlags, DataBufferView message);
+
+		// Network thread
+		void ReceiveOnNetworkThread(NetworkThread& thread);
+
 		StatsAndAchievements m_statsAndAchievements;
 		Lobby m_lobby;
 		Inventory m_inventory;
 		Matchmaking m_matchmaking;
 		Leaderboard m_leaderboard;
+
+		// Every send serializes into this one buffer; the bundler or Steam copies it before returning
+		mutable std::vector<uint8_t> m_sendBuffer;
+
+		// Game messages to the server, held until the end of the frame
+		MessageBundler m_bundler;
+
+		ApplyLatency m_applyLatency;
+
+		// Last, so the thread is joined before anything it uses is destroyed
+		std::unique_ptr<NetworkThread> m_networkThread;
 	};
 
 	extern const char* MessageTypeString(GameMessageType type);
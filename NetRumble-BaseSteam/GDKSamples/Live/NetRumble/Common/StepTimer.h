@@ -6,7 +6,7 @@
 
 #include <cmath>
 #include <cstdint>
-#include <exception>
+#include <stdexcept>
 
 namespace DX
 {
@@ -27,12 +27,12 @@ namespace DX
 		{
 			if (!QueryPerformanceFrequency(&m_qpcFrequency))
 			{
-				throw std::exception("QueryPerformanceFrequency");
+				throw std::runtime_error("QueryPerformanceFrequency");
 			}
 
 			if (!QueryPerformanceCounter(&m_qpcLastTime))
 			{
-				throw std::exception("QueryPerformanceCounter");
+				throw std::runtime_error("QueryPerformanceCounter");
 			}
 
 			// Initialize max delta to 1/10 of a second.
@@ -74,7 +74,7 @@ namespace DX
 		{
 			if (!QueryPerformanceCounter(&m_qpcLastTime))
 			{
-				throw std::exception("QueryPerformanceCounter");
+				throw std::runtime_error("QueryPerformanceCounter");
 			}
 
 			m_leftOverTicks = 0;
@@ -92,7 +92,7 @@ namespace DX
 
 			if (!QueryPerformanceCounter(&currentTime))
 			{
-				throw std::exception("QueryPerformanceCounter");
+				throw std::runtime_error("QueryPerformanceCounter");
 			}
 
 			uint64_t timeDelta = static_cast<uint64_t>(currentTime.QuadPart - m_qpcLastTime.QuadPart);
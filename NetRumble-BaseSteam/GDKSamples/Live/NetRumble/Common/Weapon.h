@@ -31,6 +31,10 @@ namespace NetRumble
 		virtual void CreateProjectiles(const DirectX::SimpleMath::Vector2& direction) = 0;
 		virtual WeaponType GetWeaponType() const { return WeaponType::Unknown; }
 
+		// The only state a weapon simulates, saved and restored by a rollback
+		inline float GetTimeToNextFire() const { return m_timeToNextFire; }
+		inline void SetTimeToNextFire(float seconds) { m_timeToNextFire = seconds; }
+
 	protected:
 		Ship* m_owner;
 		float m_timeToNextFire = 0.0f;
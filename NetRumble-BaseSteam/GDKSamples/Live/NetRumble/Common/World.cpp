@@ -9,6 +9,23 @@
 using namespace NetRumble;
 using namespace DirectX;
 
+// Field mask bits for each asteroid in a ServerUpdateWorldData packet
+constexpr uint8_t c_worldDataPositionField = 0x1;
+constexpr uint8_t c_worldDataVelocityField = 0x2;
+constexpr uint32_t c_worldDataFieldBits = 2;
+
+// Quantization of the asteroid fields in a ServerUpdateWorldData packet
+constexpr uint32_t c_worldDataPositionBits = 16;
+constexpr uint32_t c_worldDataVelocityBits = 16;
+constexpr float c_worldDataVelocityRange = 512.0f;
+
+static SimpleMath::Vector2 QuantizeWorldDataVelocity(const SimpleMath::Vector2& velocity)
+{
+	return SimpleMath::Vector2(
+		BitBufferWriter::SignedQuantize(velocity.x, c_worldDataVelocityRange, c_worldDataVelocityBits),
+		BitBufferWriter::SignedQuantize(velocity.y, c_worldDataVelocityRange, c_worldDataVelocityBits));
+}
+
 World::World()
 {
 	m_isGameInProgress = false;
@@ -16,6 +33,9 @@ World::World()
 
 	ResetDefaults();
 
+	m_sentSnapshots.Reserve(c_Asteroids);
+	m_receivedSnapshots.Reserve(c_Asteroids);
+
 	m_starfield = std::make_unique<Starfield>(SimpleMath::Vector2());
 
 	// Set outer barrier and world dimensions
@@ -78,6 +98,22 @@ void World::ResetDefaults()
 
 	m_isInitialized = false;
 	m_updatesSinceWorldDataSent = 0;
+	m_updatesSinceShipDataSent = 0;
+	m_updatesSinceShipInputSent = 0;
+	m_shipDataSequence = 0;
+	m_lastShipDataReceived = 0;
+	m_worldDataSequence = 0;
+	m_lastWorldDataReceived = 0;
+	m_worldDataTime = 0.0f;
+	m_worldDataLogTimer = 0.0f;
+	m_sentSnapshots.Clear();
+	m_receivedSnapshots.Clear();
+	m_hostClock.Reset();
+	for (SnapshotBuffer& asteroidSnapshots : m_asteroidSnapshots)
+	{
+		asteroidSnapshots.Clear();
+	}
+	m_worldDataReceived.Reset();
 	m_powerUp = nullptr;
 	m_powerUpTimer = c_MaximumPowerUpTimer;
 
@@ -88,10 +124,21 @@ void World::ResetDefaults()
 	if (g_game)
 	{
 		g_game->ClearPlayerScores();
+
+		// Nobody holds a snapshot of the new world yet
+		for (PlayerState* playerState : g_game->GetPlayers())
+		{
+			if (playerState)
+			{
+				playerState->LastAckedWorldData = 0;
+				playerState->WorldDataBandwidth.Reset();
+			}
+		}
 	}
 
 	Managers::Get<CollisionManager>()->Collection().ApplyPendingRemovals();
 	Managers::Get<CollisionManager>()->Collection().clear();
+	Managers::Get<CollisionManager>()->CancelExplosions();
 }
 
 // Generate the world, placing asteroids and all ships
@@ -104,11 +151,11 @@ void World::GenerateWorld()
 	CollisionManager* collisionMgr = Managers::Get<CollisionManager>();
 
 	// Initialize the ships, finding spawn points and resetting score
-	for (const auto& playerState : g_game->GetAllPlayerStates())
+	for (PlayerState* playerState : g_game->GetPlayers())
 	{
 		if (playerState && playerState->LobbyReady)
 		{
-			std::shared_ptr<Ship> ship = playerState->GetShip();
+			const std::shared_ptr<Ship>& ship = playerState->GetShip();
 			ship->Initialize(playerState->IsLocalPlayer);
 			ship->Position = collisionMgr->FindSpawnPoint(ship.get(), ship->Radius);
 		}
@@ -141,7 +188,7 @@ void World::GenerateWorld()
 
 	}
 
-	std::shared_ptr<PlayerState> localPlayerState = g_game->GetLocalPlayerState();
+	PlayerState* localPlayerState = g_game->GetLocalPlayer();
 	if (localPlayerState)
 	{
 		m_starfield->Reset(localPlayerState->GetShip()->Position);
@@ -155,7 +202,7 @@ std::vector<uint8_t> World::SerializeShipSpawn(uint64_t peerid) const
 	std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(peerid);
 	if (playerState != nullptr)
 	{
-		std::shared_ptr<Ship> ship = playerState->GetShip();
+		const std::shared_ptr<Ship>& ship = playerState->GetShip();
 		if (ship != nullptr)
 		{
 			SimpleMath::Vector2 spawnPt = Managers::Get<CollisionManager>()->FindSpawnPoint(ship.get(), ship->Radius);
@@ -171,7 +218,7 @@ std::vector<uint8_t> World::SerializeShipSpawn(uint64_t peerid) const
 	return std::vector<uint8_t>();
 }
 
-void World::DeserializeShipSpawn(const std::vector<uint8_t>& data)
+void World::DeserializeShipSpawn(DataBufferView data)
 {
 	DataBufferReader dataReader(data);
 
@@ -185,7 +232,7 @@ void World::DeserializeShipSpawn(const std::vector<uint8_t>& data)
 	std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(peerid);
 	if (playerState != nullptr)
 	{
-		std::shared_ptr<Ship> ship = playerState->GetShip();
+		const std::shared_ptr<Ship>& ship = playerState->GetShip();
 		if (ship != nullptr)
 		{
 			ship->Position = position;
@@ -206,7 +253,7 @@ std::vector<unsigned char> World::SerializePowerUpSpawn() const
 	return dataWriter.GetBuffer();
 }
 
-void World::DeserializePowerUpSpawn(const std::vector<uint8_t>& data)
+void World::DeserializePowerUpSpawn(DataBufferView data)
 {
 	DataBufferReader dataReader(data);
 
@@ -217,29 +264,362 @@ void World::DeserializePowerUpSpawn(const std::vector<uint8_t>& data)
 }
 
 // Prepare the world data for the ServerUpdateWorldData packet
-std::vector<unsigned char> World::SerializeWorldData() const
+//
+// Layout: sequence, distance back to the baseline sequence (0 for absolute), snapshot time,
+// changed asteroid count, then per changed asteroid its index, a field mask and the fields
+// that changed, quantized. Anything not sent is dead-reckoned by the receiver from the baseline.
+void World::SerializeWorldData(BitBufferWriter& dataWriter)
 {
-	DataBufferWriter dataWriter;
+	constexpr uint32_t c_countBits = BitsRequired(c_Asteroids);
+	constexpr uint32_t c_indexBits = BitsRequired(c_Asteroids - 1);
 
-	// Write the asteroid data
+	const WorldSnapshot* baseline = FindWorldDataBaseline();
+	WorldSnapshot& snapshot = m_sentSnapshots.Add(++m_worldDataSequence, m_worldDataTime);
+
+	std::array<uint8_t, c_Asteroids> changedFields{};
+	uint32_t changedCount = 0;
+
+	// Record the quantized state the receivers will rebuild so later deltas stay in step with them
 	for (size_t i = 0; i < c_Asteroids; ++i)
 	{
-		dataWriter.WriteStruct(m_asteroids[i]->Position);
-		dataWriter.WriteStruct(m_asteroids[i]->Velocity);
+		AsteroidSnapshot actual{ m_asteroids[i]->Position, m_asteroids[i]->Velocity };
+		AsteroidSnapshot predicted = baseline ? baseline->Predict(i, snapshot.Time) : actual;
+		if (baseline == nullptr || SimpleMath::Vector2::DistanceSquared(actual.Position, predicted.Position) > c_SnapshotPositionTolerance * c_SnapshotPositionTolerance)
+		{
+			changedFields[i] = static_cast<uint8_t>(changedFields[i] | c_worldDataPositionField);
+			predicted.Position = BitBufferWriter::QuantizePosition(actual.Position, m_worldDimensions, c_worldDataPositionBits);
+		}
+		if (baseline == nullptr || SimpleMath::Vector2::DistanceSquared(actual.Velocity, predicted.Velocity) > c_SnapshotVelocityTolerance * c_SnapshotVelocityTolerance)
+		{
+			changedFields[i] = static_cast<uint8_t>(changedFields[i] | c_worldDataVelocityField);
+			predicted.Velocity = QuantizeWorldDataVelocity(actual.Velocity);
+		}
+		snapshot.Asteroids.push_back(predicted);
+
+		if (changedFields[i] != 0)
+		{
+			changedCount++;
+		}
 	}
 
-	return dataWriter.GetBuffer();
+	dataWriter.WriteVarUInt32(snapshot.Sequence);
+	dataWriter.WriteVarUInt32(baseline ? snapshot.Sequence - baseline->Sequence : 0);
+	dataWriter.WriteSingle(snapshot.Time);
+	dataWriter.WriteBits(changedCount, c_countBits);
+
+	// Write the asteroids that changed
+	for (size_t i = 0; i < c_Asteroids; ++i)
+	{
+		if (changedFields[i] == 0)
+		{
+			continue;
+		}
+
+		dataWriter.WriteBits(static_cast<uint32_t>(i), c_indexBits);
+		dataWriter.WriteBits(changedFields[i], c_worldDataFieldBits);
+		if (changedFields[i] & c_worldDataPositionField)
+		{
+			dataWriter.WritePosition(snapshot.Asteroids[i].Position, m_worldDimensions, c_worldDataPositionBits);
+		}
+		if (changedFields[i] & c_worldDataVelocityField)
+		{
+			dataWriter.WriteSignedQuantized(snapshot.Asteroids[i].Velocity.x, c_worldDataVelocityRange, c_worldDataVelocityBits);
+			dataWriter.WriteSignedQuantized(snapshot.Asteroids[i].Velocity.y, c_worldDataVelocityRange, c_worldDataVelocityBits);
+		}
+	}
 }
 
-void World::DeserializeWorldData(const std::vector<uint8_t>& data)
+void World::DeserializeWorldData(DataBufferView data)
 {
-	DataBufferReader dataReader(data);
+	constexpr uint32_t c_countBits = BitsRequired(c_Asteroids);
+	constexpr uint32_t c_indexBits = BitsRequired(c_Asteroids - 1);
+
+	m_worldDataReceived.AddBytes(data.size() + MsgTypeSize);
+
+	BitBufferReader dataReader(data);
 
-	// Update the asteroid data
+	uint32_t sequence = dataReader.ReadVarUInt32();
+	uint32_t baselineDistance = dataReader.ReadVarUInt32();
+	float time = dataReader.ReadSingle();
+
+	// A late packet from the last game can leave the count ahead of this one's
+	if (IsSnapshotSequenceRestart(sequence, m_lastWorldDataReceived))
+	{
+		DEBUGLOG("World data %u restarts the count from %u\n", sequence, m_lastWorldDataReceived);
+		m_receivedSnapshots.Clear();
+		m_lastWorldDataReceived = 0;
+	}
+
+	// Ignore anything older than what has already been applied
+	if (sequence <= m_lastWorldDataReceived)
+	{
+		return;
+	}
+
+	const WorldSnapshot* baseline = nullptr;
+	if (baselineDistance != 0)
+	{
+		uint32_t baselineSequence = sequence - baselineDistance;
+		baseline = m_receivedSnapshots.Find(baselineSequence);
+		if (baseline == nullptr)
+		{
+			// Keep acknowledging the last snapshot we have, the host will fall back to it
+			DEBUGLOG("World data %u references unknown baseline %u, dropping\n", sequence, baselineSequence);
+			return;
+		}
+	}
+
+	WorldSnapshot& snapshot = m_receivedSnapshots.Add(sequence, time);
 	for (size_t i = 0; i < c_Asteroids; ++i)
 	{
-		dataReader.ReadStruct(m_asteroids[i]->Position);
-		dataReader.ReadStruct(m_asteroids[i]->Velocity);
+		snapshot.Asteroids.push_back(baseline ? baseline->Predict(i, time) : AsteroidSnapshot{});
+	}
+
+	// Read the asteroids that changed
+	uint32_t changedCount = dataReader.ReadBits(c_countBits);
+	for (uint32_t n = 0; n < changedCount; ++n)
+	{
+		size_t i = dataReader.ReadBits(c_indexBits);
+		uint32_t changedFields = dataReader.ReadBits(c_worldDataFieldBits);
+		if (i >= c_Asteroids)
+		{
+			// Forget the half-built snapshot so nothing is ever predicted from it
+			snapshot.Sequence = 0;
+			DEBUGLOG("Ill-formed world data %u: asteroid index %zu out of range\n", sequence, i);
+			return;
+		}
+		if (changedFields & c_worldDataPositionField)
+		{
+			snapshot.Asteroids[i].Position = dataReader.ReadPosition(m_worldDimensions, c_worldDataPositionBits);
+		}
+		if (changedFields & c_worldDataVelocityField)
+		{
+			snapshot.Asteroids[i].Velocity.x = dataReader.ReadSignedQuantized(c_worldDataVelocityRange, c_worldDataVelocityBits);
+			snapshot.Asteroids[i].Velocity.y = dataReader.ReadSignedQuantized(c_worldDataVelocityRange, c_worldDataVelocityBits);
+		}
+	}
+
+	// The host's asteroids are the authority; everyone else shows them a little behind,
+	// between the snapshots either side
+	if (Managers::Get<OnlineManager>()->IsServer())
+	{
+		for (size_t i = 0; i < c_Asteroids; ++i)
+		{
+			m_asteroids[i]->Position = snapshot.Asteroids[i].Position;
+			m_asteroids[i]->Velocity = snapshot.Asteroids[i].Velocity;
+		}
+	}
+	else
+	{
+		m_hostClock.Observe(time);
+		for (size_t i = 0; i < c_Asteroids; ++i)
+		{
+			m_asteroidSnapshots[i].Add(MotionSnapshot{ sequence, time, snapshot.Asteroids[i].Position, snapshot.Asteroids[i].Velocity, 0.0f });
+		}
+	}
+
+	m_lastWorldDataReceived = sequence;
+
+	// The server host applies its own broadcast and has nothing to acknowledge
+	if (!Managers::Get<OnlineManager>()->IsServer())
+	{
+		Managers::Get<OnlineManager>()->SendGameMessageWithSourceID(GameMessageView(
+			GameMessageType::WorldDataAck,
+			DataBufferView(reinterpret_cast<const uint8_t*>(&sequence), sizeof(sequence))
+		));
+	}
+}
+
+void World::AcknowledgeWorldData(PlayerState& playerState, uint32_t sequence)
+{
+	if (sequence > playerState.LastAckedWorldData && sequence <= m_worldDataSequence)
+	{
+		playerState.LastAckedWorldData = sequence;
+	}
+}
+
+// The newest snapshot every remote player in the game is known to hold, or nullptr to send absolute
+// state. The one broadcast has to suit them all, so a lagging player holds everyone to its baseline.
+const WorldSnapshot* World::FindWorldDataBaseline() const
+{
+	uint32_t baselineSequence = UINT32_MAX;
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState && playerState->InGame && !playerState->IsLocalPlayer)
+		{
+			baselineSequence = std::min(baselineSequence, playerState->LastAckedWorldData);
+		}
+	}
+
+	// The slot for the next sequence must not be the baseline's
+	if (baselineSequence == UINT32_MAX || m_worldDataSequence + 1 - baselineSequence >= WorldSnapshotHistory::c_capacity)
+	{
+		return nullptr;
+	}
+
+	return m_sentSnapshots.Find(baselineSequence);
+}
+
+void World::SendWorldData()
+{
+	m_worldDataWriter.Reset();
+	SerializeWorldData(m_worldDataWriter);
+	size_t packetSize = m_worldDataWriter.TotalBytes() + MsgTypeSize;
+
+	Managers::Get<OnlineManager>()->ServerSendMessageToAll(
+		GameMessageView(
+			GameMessageType::ServerUpdateWorldData,
+			m_worldDataWriter.View()
+		),
+		false,
+		k_nSteamNetworkingSend_Reliable
+	);
+
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState && playerState->InGame && !playerState->IsLocalPlayer)
+		{
+			playerState->WorldDataBandwidth.AddBytes(packetSize);
+		}
+	}
+}
+
+// Layout: sequence, host time and ship count, then per active ship its owner's peer id and the ship as Ship::Serialize writes it
+void World::SerializeShipData(BitBufferWriter& dataWriter)
+{
+	m_shipDataShips.clear();
+	m_shipDataOwners.clear();
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState && playerState->InGame && playerState->GetShip() && playerState->GetShip()->Active())
+		{
+			m_shipDataShips.push_back(playerState->GetShip().get());
+			m_shipDataOwners.push_back(playerState->PeerId);
+		}
+	}
+
+	dataWriter.WriteVarUInt32(++m_shipDataSequence);
+	dataWriter.WriteSingle(m_worldDataTime);
+	dataWriter.WriteVarUInt32(static_cast<uint32_t>(m_shipDataShips.size()));
+	for (size_t i = 0; i < m_shipDataShips.size(); ++i)
+	{
+		dataWriter.WriteBits(static_cast<uint32_t>(m_shipDataOwners[i]), 32);
+		dataWriter.WriteBits(static_cast<uint32_t>(m_shipDataOwners[i] >> 32), 32);
+		m_shipDataShips[i]->Serialize(dataWriter, m_worldDimensions);
+	}
+}
+
+void World::DeserializeShipData(DataBufferView data)
+{
+	// The server host's ships are the authority, it has nothing to apply
+	if (Managers::Get<OnlineManager>()->IsServer())
+	{
+		return;
+	}
+
+	BitBufferReader dataReader(data);
+
+	uint32_t sequence = dataReader.ReadVarUInt32();
+	float time = dataReader.ReadSingle();
+
+	// Ignore anything older than what has already been applied, unless it starts a new game
+	if (sequence <= m_lastShipDataReceived && !IsSnapshotSequenceRestart(sequence, m_lastShipDataReceived))
+	{
+		return;
+	}
+	m_lastShipDataReceived = sequence;
+	m_hostClock.Observe(time);
+
+	uint32_t count = dataReader.ReadVarUInt32();
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint64_t peerId = dataReader.ReadBits(32);
+		peerId |= static_cast<uint64_t>(dataReader.ReadBits(32)) << 32;
+
+		std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(peerId);
+		if (playerState == nullptr || playerState->GetShip() == nullptr)
+		{
+			// Entries have no length, the rest of the packet can't be found
+			DEBUGLOG("Ship data for unknown peer %llu\n", peerId);
+			return;
+		}
+
+		playerState->GetShip()->Deserialize(dataReader, m_worldDimensions, sequence, time);
+	}
+}
+
+void World::SendShipData()
+{
+	m_shipDataWriter.Reset();
+	SerializeShipData(m_shipDataWriter);
+
+	Managers::Get<OnlineManager>()->ServerSendMessageToAll(
+		GameMessageView(
+			GameMessageType::ServerUpdateShipData,
+			m_shipDataWriter.View()
+		),
+		false,
+		k_nSteamNetworkingSend_Unreliable
+	);
+}
+
+// Show every remote ship and asteroid where the host had it the interpolation delay ago
+void World::ApplySnapshots()
+{
+	if (!m_hostClock.IsValid())
+	{
+		return;
+	}
+
+	float time = m_hostClock.GetTime() - m_interpolationDelay;
+
+	for (size_t i = 0; i < m_asteroids.size() && i < m_asteroidSnapshots.size(); ++i)
+	{
+		MotionSnapshot motion;
+		if (m_asteroidSnapshots[i].Sample(time, c_MaximumExtrapolation, motion))
+		{
+			m_asteroids[i]->Position = motion.Position;
+			m_asteroids[i]->Velocity = motion.Velocity;
+		}
+	}
+
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState == nullptr)
+		{
+			continue;
+		}
+
+		const auto& ship = playerState->GetShip();
+		if (ship && !ship->IsLocal && ship->Active())
+		{
+			ship->Interpolate(time, c_MaximumExtrapolation);
+		}
+	}
+}
+
+void World::UpdateWorldDataBandwidth(float elapsedTime)
+{
+	m_worldDataReceived.Update(elapsedTime);
+
+	bool logBandwidth = false;
+	m_worldDataLogTimer += elapsedTime;
+	if (m_worldDataLogTimer >= 1.0f)
+	{
+		m_worldDataLogTimer = 0.0f;
+		logBandwidth = true;
+	}
+
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState && !playerState->IsLocalPlayer)
+		{
+			playerState->WorldDataBandwidth.Update(elapsedTime);
+			if (logBandwidth && playerState->InGame && Managers::Get<OnlineManager>()->IsServer())
+			{
+				DEBUGLOG("World data to %s: %.0f bytes/sec, acked snapshot %u of %u\n", playerState->DisplayName.c_str(), playerState->WorldDataBandwidth.BytesPerSecond(), playerState->LastAckedWorldData, m_worldDataSequence);
+			}
+		}
 	}
 }
 
@@ -253,7 +633,7 @@ std::vector<uint8_t> World::SerializeWorldSetup(std::map<uint64_t, std::shared_p
 	for (auto& activeShipPair : ships)
 	{
 		uint64_t peerid = activeShipPair.first;
-		std::shared_ptr<Ship> ship = activeShipPair.second;
+		const auto& ship = activeShipPair.second;
 
 		dataWriter.WriteUInt64(peerid);
 		dataWriter.WriteStruct(ship->Position);
@@ -293,7 +673,7 @@ std::vector<uint8_t> World::SerializeWorldSetup(std::map<uint64_t, std::shared_p
 	return dataWriter.GetBuffer();
 }
 
-void World::DeserializeWorldSetup(const std::vector<uint8_t>& data)
+void World::DeserializeWorldSetup(DataBufferView data)
 {
 	DataBufferReader dataReader(data);
 
@@ -316,7 +696,7 @@ void World::DeserializeWorldSetup(const std::vector<uint8_t>& data)
 		std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(peerid);
 		if (playerState != nullptr)
 		{
-			std::shared_ptr<Ship> ship = playerState->GetShip();
+			const std::shared_ptr<Ship>& ship = playerState->GetShip();
 
 			ship->Initialize(playerState->IsLocalPlayer);
 			ship->Position = position;
@@ -365,7 +745,7 @@ void World::DeserializeWorldSetup(const std::vector<uint8_t>& data)
 	// Read the game mode and winning score
 	WinningScore = dataReader.ReadInt32();
 
-	std::shared_ptr<PlayerState> localPlayerState = g_game->GetLocalPlayerState();
+	PlayerState* localPlayerState = g_game->GetLocalPlayer();
 	if (localPlayerState && localPlayerState->GetShip())
 	{
 		m_starfield->Reset(localPlayerState->GetShip()->Position);
@@ -387,11 +767,11 @@ std::vector<uint8_t> World::SerializeShipDeath(std::shared_ptr<Ship> localShip)
 		{
 			uint64_t killer = 0;
 
-			for (const auto& playerState : g_game->GetAllPlayerStates())
+			for (PlayerState* playerState : g_game->GetPlayers())
 			{
 				if (playerState && playerState->InGame)
 				{
-					std::shared_ptr<Ship> ship = playerState->GetShip();
+					const std::shared_ptr<Ship>& ship = playerState->GetShip();
 					if (ship && ship.get() == lastDamagedBy)
 					{
 						killer = playerState->PeerId;
@@ -413,7 +793,7 @@ std::vector<uint8_t> World::SerializeShipDeath(std::shared_ptr<Ship> localShip)
 	return std::vector<unsigned char>();
 }
 
-void World::DeserializeShipDeath(uint64_t peerid, const std::vector<uint8_t>& data)
+void World::DeserializeShipDeath(uint64_t peerid, DataBufferView data)
 {
 	DEBUGLOG("DeserializeShipDeath() received for peer %u\n", peerid);
 
@@ -455,7 +835,7 @@ std::vector<unsigned char> World::SerializeGameOver() const
 	return dataWriter.GetBuffer();
 }
 
-void World::DeserializeGameOver(const std::vector<uint8_t>& data)
+void World::DeserializeGameOver(DataBufferView data)
 {
 	DataBufferReader dataReader(data);
 
@@ -465,7 +845,7 @@ void World::DeserializeGameOver(const std::vector<uint8_t>& data)
 
 	if (WinnerName == g_game->GetLocalPlayerName())
 	{
-		std::shared_ptr<PlayerState> localPlayerState = g_game->GetLocalPlayerState();
+		PlayerState* localPlayerState = g_game->GetLocalPlayer();
 		if (localPlayerState)
 		{
 			// TODO
@@ -484,13 +864,21 @@ void World::Update(float totalTime, float elapsedTime)
 {
 	UNREFERENCED_PARAMETER(totalTime);
 
-	if (!IsGameWon && Managers::Get<OnlineManager>()->IsServer())
+	for (const std::shared_ptr<GameplayObject>& object : Managers::Get<CollisionManager>()->Collection())
+	{
+		object->RecordStepStart();
+	}
+
+	// In rollback mode every peer is its own host
+	const bool isAuthority = m_rollbackMode || Managers::Get<OnlineManager>()->IsServer();
+
+	if (!IsGameWon && isAuthority)
 	{
 		int highScore = MININT;
 		std::string highScoreName = "";
 		DirectX::XMVECTORF32 highScoreColor = Colors::White;
 
-		std::vector<std::shared_ptr<PlayerState>> playerStates = g_game->GetAllPlayerStates();
+		PlayerRoster::View playerStates = g_game->GetPlayers();
 
 		if (playerStates.size() < 0)
 		{
@@ -500,11 +888,11 @@ void World::Update(float totalTime, float elapsedTime)
 		}
 		else
 		{
-			for (const auto& playerState : playerStates)
+			for (PlayerState* playerState : playerStates)
 			{
 				if (playerState && playerState->InGame)
 				{
-					std::shared_ptr<Ship> ship = playerState->GetShip();
+					const std::shared_ptr<Ship>& ship = playerState->GetShip();
 					if (!ship)
 					{
 						continue;
@@ -523,7 +911,10 @@ void World::Update(float totalTime, float elapsedTime)
 					{
 						// Send ship spawn message and immediately process locally
 						std::vector<uint8_t> messageData = SerializeShipSpawn(playerState->PeerId);
-						Managers::Get<OnlineManager>()->SendGameMessageWithSourceID(GameMessage(GameMessageType::ShipSpawn, messageData));
+						if (!m_rollbackMode)
+						{
+							Managers::Get<OnlineManager>()->SendGameMessageWithSourceID(GameMessage(GameMessageType::ShipSpawn, messageData));
+						}
 						DeserializeShipSpawn(messageData);
 					}
 				}
@@ -538,14 +929,17 @@ void World::Update(float totalTime, float elapsedTime)
 			{
 				// Send the power-up-spawn packet and immediately process locally
 				std::vector<uint8_t> messageData = SerializePowerUpSpawn();
-				Managers::Get<OnlineManager>()->ServerSendMessageToAll(
-					GameMessage(
-						GameMessageType::PowerUpSpawn,
-						messageData
-					),
-					false,
-					k_nSteamNetworkingSend_Reliable
-				);
+				if (!m_rollbackMode)
+				{
+					Managers::Get<OnlineManager>()->ServerSendMessageToAll(
+						GameMessage(
+							GameMessageType::PowerUpSpawn,
+							messageData
+						),
+						false,
+						k_nSteamNetworkingSend_Reliable
+					);
+				}
 				DeserializePowerUpSpawn(messageData);
 			}
 		}
@@ -557,51 +951,67 @@ void World::Update(float totalTime, float elapsedTime)
 		// Check if game has been won
 		if (highScore >= WinningScore)
 		{
-			DEBUGLOG("GAME OVER\n");
-
 			WinnerName = highScoreName;
 			WinningColor = highScoreColor;
 
-			Managers::Get<OnlineManager>()->ServerSendMessageToAll(
-				GameMessage(
-					GameMessageType::GameOver,
-					SerializeGameOver()
-				)
-			);
+			if (!m_rollbackMode)
+			{
+				Managers::Get<OnlineManager>()->ServerSendMessageToAll(
+					GameMessage(
+						GameMessageType::GameOver,
+						SerializeGameOver()
+					)
+				);
+			}
 
 			SetGameInProgress(false);
 			IsGameWon = true;
 
-			Managers::Get<OnlineManager>()->CheckForItemDrops();
+			if (!m_resimulating)
+			{
+				DEBUGLOG("GAME OVER\n");
+				Managers::Get<OnlineManager>()->CheckForItemDrops();
+			}
 		}
 	}
 	// End Host
 
 	// Update all player ships based on last input
-	for (const auto& playerState : g_game->GetAllPlayerStates())
+	for (PlayerState* playerState : g_game->GetPlayers())
 	{
 		if (playerState && playerState->InGame)
 		{
-			std::shared_ptr<Ship> ship = playerState->GetShip();
+			const std::shared_ptr<Ship>& ship = playerState->GetShip();
 			if (ship)
 			{
 				if (ship->Active())
 				{
+					// The local ship steps on the input held for it, one move per step
+					if (playerState->IsLocalPlayer && !m_rollbackMode && !IsGameWon)
+					{
+						ship->RecordMove(elapsedTime);
+					}
 					ship->Update(elapsedTime);
 
 					// Check for ship death
-					// Server is authority on death of own ship
-					if (playerState->IsLocalPlayer && ship->Life < 0 && !IsGameWon)
+					// Server is authority on death of own ship, every peer on every ship in rollback mode
+					if ((playerState->IsLocalPlayer || m_rollbackMode) && ship->Life < 0 && !IsGameWon)
 					{
 						// Send local ship death message and immediately process locally
 						std::vector<uint8_t> messageData = SerializeShipDeath(ship);
-						Managers::Get<OnlineManager>()->SendGameMessageWithSourceID(
-							GameMessage(
-								GameMessageType::ShipDeath,
-								messageData
-							)
-						);
-						Managers::Get<OnlineManager>()->SetDeathCount();
+						if (!m_rollbackMode)
+						{
+							Managers::Get<OnlineManager>()->SendGameMessageWithSourceID(
+								GameMessage(
+									GameMessageType::ShipDeath,
+									messageData
+								)
+							);
+						}
+						if (playerState->IsLocalPlayer && !m_resimulating)
+						{
+							Managers::Get<OnlineManager>()->SetDeathCount();
+						}
 						DeserializeShipDeath(playerState->PeerId, messageData);
 					}
 				}
@@ -637,34 +1047,68 @@ void World::Update(float totalTime, float elapsedTime)
 	}
 
 	// Update collision manager to apply all physics
-	Managers::Get<CollisionManager>()->Update(elapsedTime);
+	{
+		FrameScheduler::Section section = g_game->GetScheduler().Measure("Collision");
+		Managers::Get<CollisionManager>()->Update(elapsedTime);
+	}
+
+	// Physics has moved the remote objects on from their snapshots, put them back on the host's track
+	if (!isAuthority)
+	{
+		m_hostClock.Update(elapsedTime);
+		ApplySnapshots();
+	}
+
+	// Remember where this step left the local ship, to compare with the host's view of it later
+	PlayerState* localPlayerState = m_rollbackMode ? nullptr : g_game->GetLocalPlayer();
+	if (localPlayerState)
+	{
+		const std::shared_ptr<Ship>& localShip = localPlayerState->GetShip();
+		if (localShip && localShip->Active())
+		{
+			localShip->RecordPredictedMotion();
+
+			// Send the moves made since the last ShipInput packet, along with the ones before
+			// them in case that packet was lost. The host answers with its own view of the ship.
+			if (!IsGameWon && ++m_updatesSinceShipInputSent >= c_UpdatesBetweenShipInputPackets)
+			{
+				m_updatesSinceShipInputSent = 0;
+				m_shipInputWriter.Reset();
+				localShip->SerializeMoves(m_shipInputWriter);
+				Managers::Get<OnlineManager>()->SendGameMessageWithSourceID(
+					GameMessageView(
+						GameMessageType::ShipInput,
+						m_shipInputWriter.View()
+					)
+				);
+			}
+		}
+	}
 
-	// Update the particle-effect manager
-	Managers::Get<ParticleEffectManager>()->Update(elapsedTime);
+	// Particle effects are advanced once per frame by the game's frame scheduler
 
 	// Final host duties
 	// Send everyone an update on the latest state of the world
-	if (Managers::Get<OnlineManager>()->IsServer())
+	if (Managers::Get<OnlineManager>()->IsServer() && !m_rollbackMode)
 	{
-		if (m_updatesSinceWorldDataSent >= c_UpdatesBetweenWorldDataPackets)
+		m_worldDataTime += elapsedTime;
+
+		if (++m_updatesSinceShipDataSent >= c_UpdatesBetweenShipDataPackets)
+		{
+			SendShipData();
+			m_updatesSinceShipDataSent = 0;
+		}
+
+		if (m_updatesSinceWorldDataSent >= m_updatesBetweenWorldDataPackets)
 		{
 			// Limit the rate at which we update, even if our internal frame rate is higher
-			if (IsUpdateRateNotLimited())
+			if (!IsUpdateRateNotLimited())
 			{
-				return;
-			}
-
-			Managers::Get<OnlineManager>()->SetLastServerUpdateTick(g_game->GetGameTickCount());
+				Managers::Get<OnlineManager>()->SetLastServerUpdateTick(g_game->GetGameTickCount());
 
-			Managers::Get<OnlineManager>()->ServerSendMessageToAll(
-				GameMessage(
-					GameMessageType::ServerUpdateWorldData,
-					SerializeWorldData()
-				),
-				false,
-				k_nSteamNetworkingSend_Reliable
-			);
-			m_updatesSinceWorldDataSent = 0;
+				SendWorldData();
+				m_updatesSinceWorldDataSent = 0;
+			}
 		}
 		else
 		{
@@ -672,13 +1116,195 @@ void World::Update(float totalTime, float elapsedTime)
 		}
 	}
 
+	UpdateWorldDataBandwidth(elapsedTime);
+}
+
+void World::SetResimulating(bool resimulating)
+{
+	if (resimulating == m_resimulating)
+	{
+		return;
+	}
+
+	m_resimulating = resimulating;
+
+	AudioManager* audioManager = Managers::Get<AudioManager>();
+	if (resimulating)
+	{
+		m_soundEffectsBeforeResimulating = audioManager->PlaySoundEffects;
+		audioManager->PlaySoundEffects = false;
+	}
+	else
+	{
+		audioManager->PlaySoundEffects = m_soundEffectsBeforeResimulating;
+	}
+}
+
+void World::SaveState(WorldState& state)
+{
+	// Removals queued by the last update are flushed first so the saved order is the order
+	// the next update will simulate in
+	BatchRemovalCollection<std::shared_ptr<GameplayObject>>& collection = Managers::Get<CollisionManager>()->Collection();
+	collection.ApplyPendingRemovals();
+
+	state.Collision.resize(collection.size());
+	std::copy(collection.begin(), collection.end(), state.Collision.begin());
+
+	size_t shipCount = 0;
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState == nullptr)
+		{
+			continue;
+		}
+
+		const auto& ship = playerState->GetShip();
+		if (ship)
+		{
+			if (state.Ships.size() <= shipCount)
+			{
+				state.Ships.emplace_back();
+			}
+			state.Ships[shipCount].first = ship;
+			ship->SaveShipState(state.Ships[shipCount].second);
+			shipCount++;
+		}
+	}
+	state.Ships.resize(shipCount);
+
+	state.Asteroids.resize(m_asteroids.size());
+	for (size_t i = 0; i < m_asteroids.size(); i++)
+	{
+		m_asteroids[i]->SaveState(state.Asteroids[i]);
+	}
+
+	state.CurrentPowerUp = m_powerUp;
+	if (m_powerUp)
+	{
+		m_powerUp->SaveState(state.PowerUpState);
+	}
+	state.PowerUpTimer = m_powerUpTimer;
+
+	state.IsGameInProgress = m_isGameInProgress;
+	state.IsGameWon = IsGameWon;
+	state.WinnerName = WinnerName;
+	state.WinningColor = WinningColor;
+	state.Random = RandomMath::Generator();
+}
+
+void World::RestoreState(const WorldState& state)
+{
+	// Everything leaves the collision system, and only what the save had is restored and
+	// rejoins it below. Objects spawned since the save stay inactive, so when a ship's pool
+	// hands one out again it joins the collision system like a new one.
+	BatchRemovalCollection<std::shared_ptr<GameplayObject>>& collection = Managers::Get<CollisionManager>()->Collection();
+	collection.ApplyPendingRemovals();
+	for (const std::shared_ptr<GameplayObject>& object : collection)
+	{
+		object->LeaveCollision();
+	}
+	collection.clear();
+
+	for (const auto& [ship, shipState] : state.Ships)
+	{
+		ship->RestoreShipState(shipState);
+	}
+
+	for (size_t i = 0; i < m_asteroids.size() && i < state.Asteroids.size(); i++)
+	{
+		m_asteroids[i]->RestoreState(state.Asteroids[i]);
+	}
+
+	m_powerUp = state.CurrentPowerUp;
+	if (m_powerUp)
+	{
+		m_powerUp->RestoreState(state.PowerUpState);
+	}
+	m_powerUpTimer = state.PowerUpTimer;
+
+	m_isGameInProgress = state.IsGameInProgress;
+	IsGameWon = state.IsGameWon;
+	WinnerName = state.WinnerName;
+	WinningColor = state.WinningColor;
+	RandomMath::Generator() = state.Random;
+
+	// Objects that died since the save come back, in the order they were saved
+	for (const std::shared_ptr<GameplayObject>& object : state.Collision)
+	{
+		object->RejoinCollision();
+	}
+	collection.ApplyPendingRemovals();
+}
+
+uint64_t World::ComputeChecksum() const
+{
+	// FNV-1a over the bytes of each simulated field
+	uint64_t hash = 14695981039346656037ull;
+	auto mix = [&hash](const void* data, size_t size)
+	{
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		for (size_t i = 0; i < size; i++)
+		{
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+	};
+	auto mixObject = [&mix](const GameplayObject& object)
+	{
+		bool active = object.Active();
+		mix(&active, sizeof(active));
+		mix(&object.Position, sizeof(object.Position));
+		mix(&object.Velocity, sizeof(object.Velocity));
+		mix(&object.Rotation, sizeof(object.Rotation));
+		mix(&object.Life, sizeof(object.Life));
+	};
+
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState == nullptr)
+		{
+			continue;
+		}
+
+		const auto& ship = playerState->GetShip();
+		if (ship)
+		{
+			mixObject(*ship);
+			mix(&ship->Score, sizeof(ship->Score));
+			mix(&ship->Shield, sizeof(ship->Shield));
+			for (const auto& projectile : ship->Projectiles)
+			{
+				mixObject(*projectile);
+			}
+		}
+	}
+
+	for (const auto& asteroid : m_asteroids)
+	{
+		mixObject(*asteroid);
+	}
+
+	if (m_powerUp)
+	{
+		mixObject(*m_powerUp);
+	}
+
+	mix(&IsGameWon, sizeof(IsGameWon));
+	return hash;
 }
 
 void World::Draw(float elapsedTime) const
 {
 	float viewportWidth = static_cast<float>(g_game->GetWindowWidth());
 	float viewportHeight = static_cast<float>(g_game->GetWindowHeight());
-	std::shared_ptr<Ship> localShip = g_game->GetLocalPlayerState()->GetShip();
+	const std::shared_ptr<Ship>& localShip = g_game->GetLocalPlayer()->GetShip();
+
+	// Everything, the camera's ship included, is drawn part way through the step; the
+	// simulated poses go back once the sprites are queued
+	BatchRemovalCollection<std::shared_ptr<GameplayObject>>& collection = Managers::Get<CollisionManager>()->Collection();
+	for (const std::shared_ptr<GameplayObject>& object : collection)
+	{
+		object->BeginStepBlend(m_drawBlend);
+	}
 
 	XMFLOAT2 center = XMFLOAT2(localShip->Position.x - viewportWidth / 2.0f, localShip->Position.y - viewportHeight / 2.0f);
 
@@ -722,11 +1348,11 @@ void World::Draw(float elapsedTime) const
 		}
 
 		// Draw each ship
-		for (const auto& playerState : g_game->GetAllPlayerStates())
+		for (PlayerState* playerState : g_game->GetPlayers())
 		{
 			if (playerState && playerState->InGame)
 			{
-				std::shared_ptr<Ship> ship = playerState->GetShip();
+				const std::shared_ptr<Ship>& ship = playerState->GetShip();
 				if (ship && ship->Active())
 				{
 					ship->Draw(elapsedTime, renderContext.get(), false);
@@ -748,6 +1374,11 @@ void World::Draw(float elapsedTime) const
 
 		renderContext->End();
 	}
+
+	for (const std::shared_ptr<GameplayObject>& object : collection)
+	{
+		object->EndStepBlend();
+	}
 }
 
 void World::SpawnPowerUp(PowerUpType type, const DirectX::SimpleMath::Vector2& position)
@@ -7,9 +7,14 @@
 #pragma once
 
 #include "pch.h"
+#include "WorldSnapshot.h"
+#include "SnapshotBuffer.h"
+#include "BitBuffer.h"
+#include "SimulationClock.h"
 
 namespace NetRumble
 {
+	class PlayerState;
 
 	struct ShipSerialization
 	{
@@ -35,6 +40,27 @@ namespace NetRumble
 		float yPos;
 	};
 
+	// What a rollback saves of the world. One is kept per tick of history and overwritten in
+	// turn, so after the first few saves nothing is allocated.
+	struct WorldState
+	{
+		std::vector<std::pair<std::shared_ptr<Ship>, ShipState>> Ships;
+		std::vector<GameplayObject::SavedState> Asteroids;
+		std::shared_ptr<PowerUp> CurrentPowerUp;
+		GameplayObject::SavedState PowerUpState;
+		float PowerUpTimer;
+		bool IsGameInProgress;
+		bool IsGameWon;
+		std::string WinnerName;
+		DirectX::XMVECTORF32 WinningColor;
+
+		// Everything in the collision system, in the order it is simulated
+		std::vector<std::shared_ptr<GameplayObject>> Collision;
+
+		// The shared random sequence spawn points and power-ups are drawn from
+		std::minstd_rand Random;
+	};
+
 	class World final
 	{
 	public:
@@ -50,47 +76,91 @@ namespace NetRumble
 		std::vector<uint8_t> SerializeWorldSetup(std::map<uint64_t, std::shared_ptr<Ship>>& ships) const;
 
 		// Initialize the member ships and world with the data from the ServerWorldSetup packet
-		void DeserializeWorldSetup(const std::vector<uint8_t>& data);
+		void DeserializeWorldSetup(DataBufferView data);
+
+		// Prepare the world data for the ServerUpdateWorldData packet, delta-encoded against the snapshot every peer has acknowledged
+		void SerializeWorldData(BitBufferWriter& dataWriter);
+
+		// Update the world with the data from the ServerUpdateWorldData packet and acknowledge it
+		void DeserializeWorldData(DataBufferView data);
+
+		// Record that a peer has applied the given ServerUpdateWorldData snapshot
+		void AcknowledgeWorldData(PlayerState& playerState, uint32_t sequence);
+
+		// Prepare the host's view of every active ship, with the last move it applied from each owner, for the ServerUpdateShipData packet
+		void SerializeShipData(BitBufferWriter& dataWriter);
+
+		// Update the ships with the data from the ServerUpdateShipData packet; the local ship reconciles its prediction
+		void DeserializeShipData(DataBufferView data);
 
-		// Prepare the world data for the ServerUpdateWorldData packet
-		std::vector<uint8_t> SerializeWorldData() const;
+		// Number of simulation updates between ServerUpdateWorldData packets
+		inline int GetWorldDataSendInterval() const { return m_updatesBetweenWorldDataPackets; }
+		inline void SetWorldDataSendInterval(int updates) { m_updatesBetweenWorldDataPackets = std::max(1, updates); }
 
-		// Update the world with the data from the ServerUpdateWorldData packet
-		void DeserializeWorldData(const std::vector<uint8_t>& data);
+		// Seconds behind the host's clock that remote ships and asteroids are shown
+		inline float GetInterpolationDelay() const { return m_interpolationDelay; }
+		inline void SetInterpolationDelay(float seconds) { m_interpolationDelay = std::max(0.0f, seconds); }
+
+		// Bytes per second of ServerUpdateWorldData received by this client
+		inline float GetWorldDataBytesPerSecondReceived() const { return m_worldDataReceived.BytesPerSecond(); }
 
 		// Serialize powerUp spawn packet
 		std::vector<uint8_t> SerializePowerUpSpawn() const;
 
 		// Handle powerUp spawn packet
-		void DeserializePowerUpSpawn(const std::vector<uint8_t>& data);
+		void DeserializePowerUpSpawn(DataBufferView data);
 
 		// Serialize a suitable ship spawn point for the indicated player
 		std::vector<uint8_t> SerializeShipSpawn(uint64_t peerid) const;
 
 		// Spawn ship for indicated player
-		void DeserializeShipSpawn(const std::vector<uint8_t>& data);
+		void DeserializeShipSpawn(DataBufferView data);
 
 		// Prepare local ship death packet
 		std::vector<uint8_t> SerializeShipDeath(std::shared_ptr<Ship> localShip) const;
 
 		// Handle ship death packet
-		void DeserializeShipDeath(uint64_t senderId, const std::vector<uint8_t>& data);
+		void DeserializeShipDeath(uint64_t senderId, DataBufferView data);
 
 		// Serialize game over packet
 		std::vector<uint8_t> SerializeGameOver() const;
 
 		// Handle game over packet
-		void DeserializeGameOver(const std::vector<uint8_t>& data);
+		void DeserializeGameOver(DataBufferView data);
 		bool IsUpdateRateNotLimited();
 
 		inline bool IsGameInProgress() const { return m_isGameInProgress; }
 		inline bool IsInitialized() const { return m_isInitialized; }
+		inline const RECT& GetDimensions() const { return m_worldDimensions; }
 		inline void SetGameInProgress(bool isGameInProgress) { m_isGameInProgress = isGameInProgress; }
 		inline void SetInitialized(bool isInitialized) { m_isInitialized = isInitialized; }
 
+		// Rollback mode: every peer runs the same deterministic update from the same inputs.
+		// Each one respawns ships, spawns power-ups and decides deaths and the game's end
+		// for itself, so nothing but input is sent, and no ship or world data either.
+		inline bool IsRollbackMode() const { return m_rollbackMode; }
+		inline void SetRollbackMode(bool rollbackMode) { m_rollbackMode = rollbackMode; }
+
+		// Set while a rollback replays ticks already shown once: their sounds, score-keeping
+		// and log lines are not repeated
+		inline bool IsResimulating() const { return m_resimulating; }
+		void SetResimulating(bool resimulating);
+
+		// Copy out everything Update changes, and put it back
+		void SaveState(WorldState& state);
+		void RestoreState(const WorldState& state);
+
+		// Hash of the simulated state, for peers to compare after the same ticks
+		uint64_t ComputeChecksum() const;
+
 		void Update(float totalTime, float elapsedTime);
 		void Draw(float elapsedTime) const;
 
+		// How far the frame being drawn is between the last update and the next, from the
+		// game's SimulationClock; objects are drawn that far from where the last update began
+		inline float GetDrawBlend() const { return m_drawBlend; }
+		inline void SetDrawBlend(float blend) { m_drawBlend = std::min(std::max(blend, 0.0f), 1.0f); }
+
 		bool IsGameWon;
 		std::string WinnerName;
 		DirectX::XMVECTORF32 WinningColor;
@@ -104,15 +174,81 @@ namespace NetRumble
 		// The length of time it takes for another power-up to spawn.
 		static constexpr float c_MaximumPowerUpTimer = 10.0f;
 
-		static constexpr int c_UpdatesBetweenWorldDataPackets = 5;
+		// Receivers interpolate between snapshots and asteroids fly straight, so a few a second is plenty
+		static constexpr int c_UpdatesBetweenWorldDataPackets = 10;
+
+		// Owners predict their own ships, so the host's view of them is only needed to correct drift
+		static constexpr int c_UpdatesBetweenShipDataPackets = 6;
+
+		// Each step's move is sent, but a few steps' worth to a ShipInput packet
+		static constexpr int c_UpdatesBetweenShipInputPackets = 3;
+
+		// Remote objects are shown this far behind the host, in ship data intervals: one, and
+		// half again to ride out a late packet
+		static constexpr float c_InterpolationDelayIntervals = 1.5f;
+		static constexpr float c_DefaultInterpolationDelay =
+			c_InterpolationDelayIntervals * c_UpdatesBetweenShipDataPackets / SimulationClock::c_defaultStepsPerSecond;
+
+		// The same delay for a world updated at another rate
+		static constexpr float InterpolationDelay(uint32_t updatesPerSecond)
+		{
+			return c_InterpolationDelayIntervals * c_UpdatesBetweenShipDataPackets / updatesPerSecond;
+		}
+
+		// A remote object whose snapshots stop coming is dead-reckoned at most this far
+		static constexpr float c_MaximumExtrapolation = 0.25f;
 
 	private:
 		void SpawnPowerUp(PowerUpType type, const DirectX::SimpleMath::Vector2& position);
+		const WorldSnapshot* FindWorldDataBaseline() const;
+		void SendWorldData();
+		void SendShipData();
+		void ApplySnapshots();
+		void UpdateWorldDataBandwidth(float elapsedTime);
+
+		// Snapshot drift below these is left to the receivers' dead reckoning
+		static constexpr float c_SnapshotPositionTolerance = 0.5f;
+		static constexpr float c_SnapshotVelocityTolerance = 0.01f;
 
 		bool m_isGameInProgress;
 		bool m_isInitialized;
+		bool m_rollbackMode = false;
+		bool m_resimulating = false;
+		bool m_soundEffectsBeforeResimulating = true;
+		float m_drawBlend = 1.0f;
 		float m_powerUpTimer;
 		int m_updatesSinceWorldDataSent;
+		int m_updatesBetweenWorldDataPackets = c_UpdatesBetweenWorldDataPackets;
+
+		// World snapshot replication
+		uint32_t m_worldDataSequence;
+		uint32_t m_lastWorldDataReceived;
+		float m_worldDataTime;
+		float m_worldDataLogTimer;
+		WorldSnapshotHistory m_sentSnapshots;
+		WorldSnapshotHistory m_receivedSnapshots;
+		BandwidthMeter m_worldDataReceived;
+		BitBufferWriter m_worldDataWriter;
+
+		// Ship state replication
+		int m_updatesSinceShipDataSent;
+		uint32_t m_shipDataSequence;
+		uint32_t m_lastShipDataReceived;
+		BitBufferWriter m_shipDataWriter;
+
+		// Local ship moves
+		int m_updatesSinceShipInputSent;
+		BitBufferWriter m_shipInputWriter;
+
+		// The ships SerializeShipData writes and their owners, kept so a send reuses the
+		// space the last one grew; only valid during the call
+		std::vector<Ship*> m_shipDataShips;
+		std::vector<uint64_t> m_shipDataOwners;
+
+		// Interpolation of remote objects
+		HostClock m_hostClock;
+		float m_interpolationDelay = c_DefaultInterpolationDelay;
+		std::array<SnapshotBuffer, c_Asteroids> m_asteroidSnapshots;
 
 		// World contents
 		RECT m_worldDimensions;
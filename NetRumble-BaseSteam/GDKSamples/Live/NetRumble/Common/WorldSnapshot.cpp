@@ -0,0 +1,65 @@
+//--------------------------------------------------------------------------------------
+// WorldSnapshot.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "WorldSnapshot.h"
+
+using namespace NetRumble;
+
+void WorldSnapshotHistory::Clear()
+{
+	for (auto& snapshot : m_snapshots)
+	{
+		snapshot.Sequence = 0;
+		snapshot.Asteroids.clear();
+	}
+}
+
+void WorldSnapshotHistory::Reserve(size_t asteroids)
+{
+	for (auto& snapshot : m_snapshots)
+	{
+		snapshot.Asteroids.reserve(asteroids);
+	}
+}
+
+WorldSnapshot& WorldSnapshotHistory::Add(uint32_t sequence, float time)
+{
+	WorldSnapshot& snapshot = m_snapshots[sequence % c_capacity];
+	snapshot.Sequence = sequence;
+	snapshot.Time = time;
+	snapshot.Asteroids.clear();
+	return snapshot;
+}
+
+const WorldSnapshot* WorldSnapshotHistory::Find(uint32_t sequence) const
+{
+	if (sequence == 0)
+	{
+		return nullptr;
+	}
+
+	const WorldSnapshot& snapshot = m_snapshots[sequence % c_capacity];
+	return snapshot.Sequence == sequence ? &snapshot : nullptr;
+}
+
+void BandwidthMeter::Update(float elapsedTime)
+{
+	m_windowTime += elapsedTime;
+	if (m_windowTime >= 1.0f)
+	{
+		m_bytesPerSecond = static_cast<float>(m_bytesThisWindow) / m_windowTime;
+		m_bytesThisWindow = 0;
+		m_windowTime = 0.0f;
+	}
+}
+
+void BandwidthMeter::Reset()
+{
+	m_bytesThisWindow = 0;
+	m_windowTime = 0.0f;
+	m_bytesPerSecond = 0.0f;
+}
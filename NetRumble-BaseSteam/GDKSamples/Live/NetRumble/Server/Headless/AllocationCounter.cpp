@@ -0,0 +1,81 @@
+//--------------------------------------------------------------------------------------
+// AllocationCounter.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	// Per thread, so the hosted matches' workers never share the line the count lives on
+	thread_local uint64_t t_allocations = 0;
+
+	void* Allocate(std::size_t size)
+	{
+		t_allocations++;
+
+		if (void* memory = std::malloc(size > 0 ? size : 1))
+		{
+			return memory;
+		}
+
+		throw std::bad_alloc();
+	}
+}
+
+uint64_t NetRumble::AllocationCounter::ThisThread()
+{
+	return t_allocations;
+}
+
+void* operator new(std::size_t size)
+{
+	return Allocate(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return Allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	try
+	{
+		return Allocate(size);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return operator new(size, std::nothrow);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
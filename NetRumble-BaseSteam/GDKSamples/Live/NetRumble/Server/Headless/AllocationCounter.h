@@ -0,0 +1,21 @@
+//--------------------------------------------------------------------------------------
+// AllocationCounter.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+namespace NetRumble
+{
+	// Heap allocations made so far on the calling thread. The headless server replaces the
+	// global operator new to keep the count, so it covers make_shared and the standard
+	// containers as well as plain new; read it before and after the code being measured.
+	// Over-aligned allocations have their own operator and are not counted.
+	namespace AllocationCounter
+	{
+		uint64_t ThisThread();
+	}
+}
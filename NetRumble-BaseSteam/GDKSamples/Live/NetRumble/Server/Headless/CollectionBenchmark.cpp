@@ -0,0 +1,159 @@
+//--------------------------------------------------------------------------------------
+// CollectionBenchmark.cpp
+//
+// Micro-benchmark for BatchRemovalCollection under projectile churn.
+//
+//   NetRumbleCollectionBenchmark [--frames N]
+//
+// Every frame each ship fires a triple-laser volley (three projectiles), and every
+// projectile lives for a random number of frames before it is queued for removal, which
+// is the Ship::Update pattern. The same workload runs against the previous linear-find
+// removal for comparison.
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "BatchRemovalCollection.h"
+
+namespace
+{
+	struct Projectile
+	{
+		uint32_t FramesLeft = 0;
+	};
+
+	// The find-and-erase removal BatchRemovalCollection used to do, kept as the baseline
+	template<class T>
+	class LinearRemovalCollection
+	{
+	public:
+		inline void QueuePendingRemoval(const T& item) { pendingRemovals.push_back(item); }
+
+		void ApplyPendingRemovals()
+		{
+			activeObjects.insert(activeObjects.end(), pendingAdds.begin(), pendingAdds.end());
+			pendingAdds.clear();
+
+			for (size_t i = 0; i < pendingRemovals.size(); i++)
+			{
+				auto itr = std::find(std::begin(activeObjects), std::end(activeObjects), pendingRemovals[i]);
+				activeObjects.erase(itr);
+			}
+			pendingRemovals.clear();
+		}
+
+		inline void push_back(const T& item) { pendingAdds.push_back(item); }
+		inline size_t size() const { return activeObjects.size(); }
+		inline T& operator[](size_t index) { return activeObjects[index]; }
+
+	private:
+		std::vector<T> pendingAdds;
+		std::vector<T> pendingRemovals;
+		std::vector<T> activeObjects;
+	};
+
+	struct Workload
+	{
+		const char* Name;
+		uint32_t Ships;
+		uint32_t MinimumLifetime;
+		uint32_t MaximumLifetime;
+	};
+
+	struct Result
+	{
+		double NanosecondsPerFrame;
+		size_t PeakActive;
+	};
+
+	template<class Collection, class QueueRemoval>
+	Result Run(const Workload& workload, uint32_t frames, QueueRemoval&& queueRemoval)
+	{
+		std::minstd_rand random(1);
+		std::uniform_int_distribution<uint32_t> lifetime(workload.MinimumLifetime, workload.MaximumLifetime);
+
+		Collection projectiles;
+		size_t peakActive = 0;
+
+		auto start = std::chrono::steady_clock::now();
+
+		for (uint32_t frame = 0; frame < frames; ++frame)
+		{
+			for (uint32_t ship = 0; ship < workload.Ships; ++ship)
+			{
+				for (int shot = 0; shot < 3; ++shot)
+				{
+					auto projectile = std::make_shared<Projectile>();
+					projectile->FramesLeft = lifetime(random);
+					projectiles.push_back(projectile);
+				}
+			}
+
+			for (size_t i = 0; i < projectiles.size(); ++i)
+			{
+				if (--projectiles[i]->FramesLeft == 0)
+				{
+					queueRemoval(projectiles, i);
+				}
+			}
+
+			projectiles.ApplyPendingRemovals();
+			peakActive = std::max(peakActive, projectiles.size());
+		}
+
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		return Result{ elapsed.count() / frames, peakActive };
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t frames = 20000;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--frames") == 0)
+		{
+			frames = static_cast<uint32_t>(strtoul(argv[i + 1], nullptr, 10));
+		}
+	}
+
+	// Lifetimes in 60 Hz frames; a laser crosses the arena in about three seconds
+	const Workload workloads[] =
+	{
+		{ "4 ships, short-lived", 4, 10, 60 },
+		{ "4 ships, arena-crossing", 4, 60, 240 },
+		{ "16 ships, arena-crossing", 16, 60, 240 },
+		{ "64 ships, arena-crossing", 64, 60, 240 },
+	};
+
+	using Pointer = std::shared_ptr<Projectile>;
+
+	printf("%-28s %10s %14s %14s %8s\n", "workload", "peak live", "linear ns/fr", "handle ns/fr", "speedup");
+	for (const Workload& workload : workloads)
+	{
+		Result linear = Run<LinearRemovalCollection<Pointer>>(workload, frames,
+			[](LinearRemovalCollection<Pointer>& collection, size_t index) { collection.QueuePendingRemoval(collection[index]); });
+
+		Result handle = Run<BatchRemovalCollection<Pointer>>(workload, frames,
+			[](BatchRemovalCollection<Pointer>& collection, size_t index) { collection.QueuePendingRemoval(collection.handle_at(index)); });
+
+		printf("%-28s %10zu %14.0f %14.0f %7.1fx\n",
+			workload.Name,
+			handle.PeakActive,
+			linear.NanosecondsPerFrame,
+			handle.NanosecondsPerFrame,
+			handle.NanosecondsPerFrame > 0.0 ? linear.NanosecondsPerFrame / handle.NanosecondsPerFrame : 0.0);
+	}
+
+	return EXIT_SUCCESS;
+}
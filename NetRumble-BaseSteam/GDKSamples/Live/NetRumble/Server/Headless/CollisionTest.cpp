@@ -0,0 +1,207 @@
+//--------------------------------------------------------------------------------------
+// CollisionTest.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "CollisionTest.h"
+#include "CollisionMath.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace NetRumble;
+using namespace DirectX;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// From the default tick rate down to a sixth of it
+	constexpr uint32_t c_tickRates[] = { 60, 30, 20, 15, 10 };
+
+	// A rocket, the fastest projectile, with a laser bolt's radius, the smallest
+	constexpr float c_projectileSpeed = 650.0f;
+	constexpr float c_projectileRadius = 4.0f;
+
+	// From another laser bolt up to the largest asteroid
+	constexpr float c_targetRadiusMinimum = 4.0f;
+	constexpr float c_targetRadiusMaximum = 48.0f;
+
+	// Most shots are aimed near their target, so hits and near misses both come up often
+	constexpr float c_aimSpread = 0.8f;
+
+	// Points along the step the reference tests; it's right unless the path comes within
+	// c_grazeTolerance of just touching the target
+	constexpr uint32_t c_referenceSamples = 4096;
+	constexpr float c_grazeTolerance = 0.05f;
+
+	// Allowed difference between a placed case's time of impact and the expected one
+	constexpr float c_caseTolerance = 1e-4f;
+
+	struct PlacedCase
+	{
+		const char* Name;
+		SimpleMath::Vector2 Center;
+		float Radius;
+		SimpleMath::Vector2 Movement;
+		SimpleMath::Vector2 Target;
+		float TargetRadius;
+		bool Hit;
+		float TimeOfImpact;
+	};
+
+	// A projectile of radius 4 moving 100 along x from the origin, unless the case says otherwise
+	const PlacedCase c_placedCases[] =
+	{
+		{ "head on", { 0, 0 }, 4, { 100, 0 }, { 50, 0 }, 20, true, 0.26f },
+		{ "through a thin target", { 0, 0 }, 1, { 100, 0 }, { 50, 0 }, 2, true, 0.47f },
+		{ "diagonal", { 0, 0 }, 4, { 60, 80 }, { 60, 80 }, 6, true, 0.9f },
+		{ "both moving ends clear", { 0, 0 }, 4, { 100, 0 }, { 50, 10 }, 12, true, 0.5f - std::sqrt(16.0f * 16.0f - 10.0f * 10.0f) / 100.0f },
+		{ "graze", { 0, 0 }, 4, { 100, 0 }, { 50, 24 }, 20, true, 0.5f },
+		{ "passes wide", { 0, 0 }, 4, { 100, 0 }, { 50, 30 }, 20, false, 0.0f },
+		{ "touches at the end", { 0, 0 }, 4, { 100, 0 }, { 124, 0 }, 20, true, 1.0f },
+		{ "falls short", { 0, 0 }, 4, { 100, 0 }, { 150, 0 }, 20, false, 0.0f },
+		{ "moving away", { 0, 0 }, 4, { 100, 0 }, { -50, 0 }, 20, false, 0.0f },
+		{ "overlapping and closing", { 0, 0 }, 4, { 100, 0 }, { 10, 0 }, 20, true, 0.0f },
+		{ "overlapping and parting", { 0, 0 }, 4, { 100, 0 }, { -10, 0 }, 20, false, 0.0f },
+		{ "not moving", { 0, 0 }, 4, { 0, 0 }, { 20, 0 }, 20, false, 0.0f },
+	};
+
+	// Closest the path from center to center + movement comes to target
+	float ClosestApproach(const SimpleMath::Vector2& center, const SimpleMath::Vector2& movement, const SimpleMath::Vector2& target)
+	{
+		const float lengthSquared = movement.LengthSquared();
+		const float t = lengthSquared > 0.0f ? std::clamp((target - center).Dot(movement) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+		return SimpleMath::Vector2::Distance(center + movement * t, target);
+	}
+}
+
+CollisionTest::CollisionTest(const Settings& settings) :
+	m_settings(settings),
+	m_random(settings.Seed)
+{
+	m_settings.Cases = std::max<uint32_t>(m_settings.Cases, 1);
+}
+
+CollisionTest::Report CollisionTest::Run()
+{
+	Report report;
+
+	RunCases(report);
+
+	for (uint32_t ticksPerSecond : c_tickRates)
+	{
+		report.Rates.push_back(RunRate(ticksPerSecond));
+	}
+
+	return report;
+}
+
+void CollisionTest::RunCases(Report& report) const
+{
+	for (const PlacedCase& placed : c_placedCases)
+	{
+		float timeOfImpact = 0.0f;
+		const bool hit = CollisionMath::SweptCircleCircle(placed.Center, placed.Radius, placed.Movement, placed.Target, placed.TargetRadius, timeOfImpact);
+
+		const bool passed = hit == placed.Hit && (!hit || std::abs(timeOfImpact - placed.TimeOfImpact) <= c_caseTolerance);
+		report.Cases.push_back(CaseResult{ placed.Name, passed });
+	}
+}
+
+CollisionTest::RateResult CollisionTest::RunRate(uint32_t ticksPerSecond)
+{
+	RateResult result;
+	result.TicksPerSecond = ticksPerSecond;
+	result.StepLength = c_projectileSpeed / ticksPerSecond;
+
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	// Targets anywhere from just clear of the projectile to a little beyond its reach
+	std::vector<Sweep> sweeps(m_settings.Cases);
+	for (Sweep& sweep : sweeps)
+	{
+		sweep.Center = SimpleMath::Vector2::Zero;
+		sweep.Radius = c_projectileRadius;
+		sweep.TargetRadius = c_targetRadiusMinimum + unit(m_random) * (c_targetRadiusMaximum - c_targetRadiusMinimum);
+
+		const float combinedRadius = sweep.Radius + sweep.TargetRadius;
+		const float distance = combinedRadius + 0.5f + unit(m_random) * (result.StepLength + 16.0f);
+		const float bearing = unit(m_random) * XM_2PI;
+		sweep.Target = SimpleMath::Vector2(std::cos(bearing), std::sin(bearing)) * distance;
+
+		const float heading = bearing + (unit(m_random) * 2.0f - 1.0f) * c_aimSpread;
+		sweep.Movement = SimpleMath::Vector2(std::cos(heading), std::sin(heading)) * result.StepLength;
+	}
+
+	const float sampleSpacing = result.StepLength / c_referenceSamples;
+	for (const Sweep& sweep : sweeps)
+	{
+		const float combinedRadius = sweep.Radius + sweep.TargetRadius;
+		if (std::abs(ClosestApproach(sweep.Center, sweep.Movement, sweep.Target) - combinedRadius) < c_grazeTolerance)
+		{
+			result.Grazes++;
+			continue;
+		}
+
+		// The first sample that touches
+		uint32_t firstTouch = UINT32_MAX;
+		for (uint32_t sample = 0; sample <= c_referenceSamples; ++sample)
+		{
+			const SimpleMath::Vector2 position = sweep.Center + sweep.Movement * (static_cast<float>(sample) / c_referenceSamples);
+			if (SimpleMath::Vector2::DistanceSquared(position, sweep.Target) <= combinedRadius * combinedRadius)
+			{
+				firstTouch = sample;
+				break;
+			}
+		}
+
+		const bool hit = firstTouch != UINT32_MAX;
+		result.Hits += hit ? 1 : 0;
+
+		float distance = 0.0f;
+		const bool reached = CollisionMath::CircleMovementReachesCircle(sweep.Center, sweep.Radius, sweep.Movement, sweep.Target, sweep.TargetRadius, distance);
+		result.ReachMissed += (hit && !reached) ? 1 : 0;
+		result.ReachFalse += (!hit && reached) ? 1 : 0;
+
+		float timeOfImpact = 0.0f;
+		const bool swept = CollisionMath::SweptCircleCircle(sweep.Center, sweep.Radius, sweep.Movement, sweep.Target, sweep.TargetRadius, timeOfImpact);
+		result.SweptMissed += (hit && !swept) ? 1 : 0;
+		result.SweptFalse += (!hit && swept) ? 1 : 0;
+
+		if (hit && swept)
+		{
+			// The reference is at most one sample late
+			const float error = std::abs(static_cast<float>(firstTouch) / c_referenceSamples - timeOfImpact) * result.StepLength;
+			result.SweptWorstImpactError = std::max(result.SweptWorstImpactError, error - sampleSpacing);
+		}
+	}
+
+	// Kept so the timed calls can't be optimized away
+	uint32_t touches = 0;
+
+	Clock::time_point begin = Clock::now();
+	for (const Sweep& sweep : sweeps)
+	{
+		float distance;
+		touches += CollisionMath::CircleMovementReachesCircle(sweep.Center, sweep.Radius, sweep.Movement, sweep.Target, sweep.TargetRadius, distance) ? 1 : 0;
+	}
+	result.ReachNanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / sweeps.size();
+
+	begin = Clock::now();
+	for (const Sweep& sweep : sweeps)
+	{
+		float timeOfImpact;
+		touches += CollisionMath::SweptCircleCircle(sweep.Center, sweep.Radius, sweep.Movement, sweep.Target, sweep.TargetRadius, timeOfImpact) ? 1 : 0;
+	}
+	result.SweptNanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / sweeps.size();
+
+	if (touches == UINT32_MAX)
+	{
+		printf(" ");
+	}
+
+	return result;
+}
@@ -0,0 +1,191 @@
+//--------------------------------------------------------------------------------------
+// Game.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "Game.h"
+
+using namespace NetRumble;
+using namespace DirectX;
+
+namespace
+{
+	// Simulated players only shoot at ships this close
+	constexpr float c_simulatedFireRange = 600.0f;
+
+	// How long a simulated player holds a heading before picking another, in seconds
+	constexpr float c_simulatedHeadingMinimum = 0.5f;
+	constexpr float c_simulatedHeadingMaximum = 2.0f;
+
+	// Chance per second that a simulated player drops a mine
+	constexpr float c_simulatedMineRate = 0.1f;
+}
+
+thread_local Game* g_game = nullptr;
+
+Game::~Game()
+{
+	MakeCurrent();
+
+	m_simulatedPlayers.clear();
+	m_peers.clear();
+	m_roster.Rebuild(m_peers);
+	m_world.reset();
+	Managers::Shutdown();
+
+	g_game = nullptr;
+	Managers::Bind(nullptr);
+}
+
+void Game::Initialize(uint32_t ticksPerSecond)
+{
+	m_ticksPerStep = DX::StepTimer::TicksPerSecond / std::max<uint32_t>(ticksPerSecond, 1);
+
+	MakeCurrent();
+	Managers::Initialize();
+	m_world = std::make_unique<World>();
+	m_world->SetInterpolationDelay(World::InterpolationDelay(std::max<uint32_t>(ticksPerSecond, 1)));
+}
+
+void Game::MakeCurrent()
+{
+	g_game = this;
+	Managers::Bind(&m_managers);
+}
+
+void Game::AddSimulatedPlayer(std::string_view name)
+{
+	uint64_t peerId = m_peers.size() + 1;
+
+	std::shared_ptr<PlayerState> playerState = std::make_shared<PlayerState>(name);
+	playerState->PeerId = peerId;
+	playerState->IsLocalPlayer = true;
+	playerState->InLobby = false;
+	playerState->LobbyReady = true;
+	playerState->InGame = true;
+	playerState->ShipColor(static_cast<byte>(peerId % Ship::Colors.size()));
+	playerState->ShipVariation(static_cast<byte>(peerId % Ship::MaxVariations));
+
+	m_peers[peerId] = playerState;
+	m_roster.Rebuild(m_peers);
+	m_simulatedPlayers.push_back(SimulatedPlayer{ playerState, SimpleMath::Vector2::Zero, 0.0f });
+}
+
+void Game::StartMatch()
+{
+	m_world->GenerateWorld();
+	m_world->SetGameInProgress(true);
+	m_matchTickCount = 0;
+}
+
+void Game::Tick()
+{
+	Step(m_ticksPerStep);
+}
+
+void Game::Step(uint64_t ticks)
+{
+	m_totalTicks += ticks;
+	m_matchTickCount++;
+
+	float elapsedTime = static_cast<float>(DX::StepTimer::TicksToSeconds(ticks));
+	float totalTime = static_cast<float>(DX::StepTimer::TicksToSeconds(m_totalTicks));
+
+	UpdateSimulatedPlayers(elapsedTime);
+
+	{
+		FrameScheduler::Section section = m_scheduler.Measure("World");
+		m_world->Update(totalTime, elapsedTime);
+	}
+
+	// Effects the world spawned finish and go back to their caches, as the client's
+	// Particles system has them do
+	{
+		FrameScheduler::Section section = m_scheduler.Measure("Particles");
+		Managers::Get<ParticleEffectManager>()->Update(elapsedTime);
+	}
+
+	// Everything the tick broadcast goes out together, as the client's Send system does it
+	Managers::Get<OnlineManager>()->FlushGameMessages();
+}
+
+// Each simulated player wanders on a random heading, fires at the nearest ship in range
+// and occasionally drops a mine, which keeps every weapon and collision path busy
+void Game::UpdateSimulatedPlayers(float elapsedTime)
+{
+	for (SimulatedPlayer& player : m_simulatedPlayers)
+	{
+		std::shared_ptr<Ship> ship = player.State->GetShip();
+		if (!ship || !ship->Active())
+		{
+			continue;
+		}
+
+		player.HeadingTimer -= elapsedTime;
+		if (player.HeadingTimer <= 0.0f)
+		{
+			player.Heading = RandomMath::RandomDirection();
+			player.HeadingTimer = RandomMath::RandomBetween(c_simulatedHeadingMinimum, c_simulatedHeadingMaximum);
+		}
+
+		SimpleMath::Vector2 aim = SimpleMath::Vector2::Zero;
+		float nearestDistanceSquared = c_simulatedFireRange * c_simulatedFireRange;
+		for (const SimulatedPlayer& other : m_simulatedPlayers)
+		{
+			std::shared_ptr<Ship> target = other.State->GetShip();
+			if (target == ship || !target || !target->Active())
+			{
+				continue;
+			}
+
+			SimpleMath::Vector2 toTarget = target->Position - ship->Position;
+			float distanceSquared = toTarget.LengthSquared();
+			if (distanceSquared < nearestDistanceSquared && distanceSquared > 0.0f)
+			{
+				nearestDistanceSquared = distanceSquared;
+				aim = toTarget / std::sqrt(distanceSquared);
+			}
+		}
+
+		bool mineFired = RandomMath::RandomBetween(0.0f, 1.0f) < c_simulatedMineRate * elapsedTime;
+
+		// Sticks are in screen space with up positive; Ship::Update flips Y back into world space
+		ship->HoldInput(ShipInput(
+			SimpleMath::Vector2(player.Heading.x, -player.Heading.y),
+			SimpleMath::Vector2(aim.x, -aim.y),
+			mineFired));
+	}
+}
+
+std::shared_ptr<PlayerState> Game::GetPlayerState(uint64_t peer)
+{
+	auto itr = m_peers.find(peer);
+	if (itr != m_peers.end())
+	{
+		return (*itr).second;
+	}
+
+	return nullptr;
+}
+
+std::vector<std::shared_ptr<PlayerState>> Game::GetAllPlayerStates()
+{
+	std::vector<std::shared_ptr<PlayerState>> players;
+
+	for (auto& [id, peer] : m_peers)
+	{
+		players.push_back(peer);
+	}
+
+	return players;
+}
+
+void Game::ClearPlayerScores()
+{
+	for (auto& pair : m_peers)
+	{
+		pair.second->GetShip()->Score = 0;
+	}
+}
@@ -0,0 +1,106 @@
+//--------------------------------------------------------------------------------------
+// Game.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "pch.h"
+#include "FrameScheduler.h"
+#include "PlayerRoster.h"
+
+namespace NetRumble
+{
+	// Hosts one authoritative match with no window, device or transport. Players are
+	// simulated, each steering its own ship with generated ShipInput, and the world is
+	// advanced in fixed steps so results do not depend on how fast the host runs.
+	class Game final
+	{
+	public:
+		Game() noexcept = default;
+		~Game();
+
+		Game(Game&&) = delete;
+		Game& operator= (Game&&) = delete;
+
+		Game(Game const&) = delete;
+		Game& operator= (Game const&) = delete;
+
+		void Initialize(uint32_t ticksPerSecond);
+
+		// Point g_game and Managers at this match for the calling thread. Shared code reaches
+		// the game through both, so a thread must do this before touching another match.
+		void MakeCurrent();
+
+		void AddSimulatedPlayer(std::string_view name);
+
+		// Generate a fresh world with every simulated player in it
+		void StartMatch();
+
+		// Advance the match by one fixed step
+		void Tick();
+
+		// Advance the match by a step of any length, the way a loop that updates once per
+		// rendered frame would; for comparing against fixed steps only
+		void Step(uint64_t ticks);
+
+		inline bool IsMatchOver() const { return m_world->IsGameWon; }
+		inline uint64_t GetMatchTickCount() const { return m_matchTickCount; }
+		inline double GetTickSeconds() const { return DX::StepTimer::TicksToSeconds(m_ticksPerStep); }
+
+		// Interface the shared simulation code expects from the game
+		std::shared_ptr<PlayerState> GetPlayerState(uint64_t peer);
+		inline std::shared_ptr<PlayerState> GetLocalPlayerState() { return nullptr; }
+		// A copy for callers that keep players; per-frame code walks GetPlayers instead
+		std::vector<std::shared_ptr<PlayerState>> GetAllPlayerStates();
+		void ClearPlayerScores();
+
+		inline bool IsGameWon() const { return m_world->IsGameWon; }
+		inline std::unique_ptr<World>& GetWorld() { return m_world; }
+		inline FrameScheduler& GetScheduler() { return m_scheduler; }
+		inline std::string_view GetWinnerName() const { return m_world->WinnerName; }
+		inline std::string_view GetLocalPlayerName() const { return {}; }
+		inline const std::map<uint64_t, std::shared_ptr<PlayerState>>& GetPeers() const { return m_peers; }
+
+		// Every player without allocating; see PlayerRoster. No player here is the local one.
+		inline PlayerRoster::View GetPlayers() const { return m_roster.Players(); }
+		inline PlayerState* GetLocalPlayer() const { return nullptr; }
+
+		inline int GetWindowWidth() const { return 0; }
+		inline int GetWindowHeight() const { return 0; }
+
+		const uint64 GetGameTickCount() const { return m_totalTicks; }
+
+	private:
+		struct SimulatedPlayer
+		{
+			std::shared_ptr<PlayerState> State;
+			DirectX::SimpleMath::Vector2 Heading;
+			float HeadingTimer = 0.0f;
+		};
+
+		void UpdateSimulatedPlayers(float elapsedTime);
+
+		// Declared before the world so the managers outlive it
+		Managers::Registry m_managers;
+
+		std::unique_ptr<World> m_world;
+
+		// Players
+		std::map<uint64_t, std::shared_ptr<PlayerState>> m_peers;
+		PlayerRoster m_roster;
+		std::vector<SimulatedPlayer> m_simulatedPlayers;
+
+		// Simulation clock, in StepTimer ticks so World's send-rate limit works unchanged
+		uint64_t m_ticksPerStep = 0;
+		uint64_t m_totalTicks = 0;
+		uint64_t m_matchTickCount = 0;
+
+		// Per-tick section timings (world, collision)
+		FrameScheduler m_scheduler;
+	};
+}
+
+// The match the calling thread is running; see Game::MakeCurrent
+extern thread_local NetRumble::Game* g_game;
@@ -0,0 +1,159 @@
+//--------------------------------------------------------------------------------------
+// HeadlessDebug.cpp
+//
+// DebugWrite for the headless server. There is no debugger output window, so log lines go
+// to stderr, and only when enabled: soak runs would otherwise spend their time in I/O.
+// Lines are queued and written by a background thread, as in the client.
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "Debug.h"
+#include "LogRingBuffer.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+	constexpr size_t c_debugLogCapacity = 4096;
+	constexpr auto c_debugFlushInterval = std::chrono::milliseconds(10);
+
+	std::atomic<bool> s_debugEnabled{ false };
+
+	class HeadlessLogWriter
+	{
+	public:
+		HeadlessLogWriter() :
+			m_lines(c_debugLogCapacity)
+		{
+		}
+
+		~HeadlessLogWriter()
+		{
+			Stop();
+		}
+
+		void Start()
+		{
+			std::lock_guard<std::mutex> lock(m_controlMutex);
+			if (!m_thread.joinable())
+			{
+				m_running = true;
+				m_thread = std::thread([this]() { Run(); });
+			}
+		}
+
+		void Stop()
+		{
+			std::lock_guard<std::mutex> lock(m_controlMutex);
+			if (m_thread.joinable())
+			{
+				m_running = false;
+				m_thread.join();
+			}
+		}
+
+		inline void Write(const char* format, va_list args)
+		{
+			thread_local uint32_t threadId = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+			uint64_t timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+			m_lines.Write(threadId, timestamp, format, args);
+		}
+
+	private:
+		void Run()
+		{
+			std::string batch;
+			uint64_t reportedDrops = 0;
+
+			for (;;)
+			{
+				// Read the flag first so lines queued before Stop are still written
+				bool running = m_running;
+
+				batch.clear();
+				m_lines.Drain([&](const LogRingBuffer::Line& line)
+				{
+					char prefix[64];
+					snprintf(prefix, sizeof(prefix), "%08x %llu.%03llu " DEBUG_LOG_ENTRY_PREFIX,
+						line.ThreadId,
+						static_cast<unsigned long long>(line.Timestamp / 1000),
+						static_cast<unsigned long long>(line.Timestamp % 1000));
+
+					batch += prefix;
+					batch.append(line.Text, line.Length);
+				});
+
+				uint64_t dropped = m_lines.Dropped();
+				if (dropped != reportedDrops)
+				{
+					batch += std::to_string(dropped - reportedDrops);
+					batch += " log lines dropped: the log queue was full\n";
+					reportedDrops = dropped;
+				}
+
+				if (!batch.empty())
+				{
+					fwrite(batch.data(), sizeof(char), batch.size(), stderr);
+					fflush(stderr);
+				}
+				else if (!running)
+				{
+					break;
+				}
+				else
+				{
+					std::this_thread::sleep_for(c_debugFlushInterval);
+				}
+			}
+		}
+
+		LogRingBuffer m_lines;
+		std::atomic<bool> m_running{ false };
+		std::mutex m_controlMutex;
+		std::thread m_thread;
+	};
+
+	HeadlessLogWriter s_debugLogWriter;
+}
+
+void DebugInit()
+{
+}
+
+void DebugShutdown()
+{
+	s_debugLogWriter.Stop();
+}
+
+void DebugSetEnabled(bool enabled)
+{
+	s_debugEnabled = enabled;
+
+	if (enabled)
+	{
+		s_debugLogWriter.Start();
+	}
+	else
+	{
+		s_debugLogWriter.Stop();
+	}
+}
+
+void DebugWrite(const char* format, ...)
+{
+	if (!s_debugEnabled.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	va_list args;
+	va_start(args, format);
+	s_debugLogWriter.Write(format, args);
+	va_end(args);
+}
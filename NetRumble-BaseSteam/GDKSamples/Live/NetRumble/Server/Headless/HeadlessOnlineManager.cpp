@@ -0,0 +1,109 @@
+//--------------------------------------------------------------------------------------
+// HeadlessOnlineManager.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "HeadlessOnlineManager.h"
+
+using namespace NetRumble;
+
+namespace
+{
+	// As SteamOnlineManager picks them for a client's messages
+	int SendFlagsFor(GameMessageType type)
+	{
+		if (type == GameMessageType::ShipInput || type == GameMessageType::ShipData || type == GameMessageType::WorldDataAck)
+		{
+			return k_nSteamNetworkingSend_Unreliable;
+		}
+
+		return k_nSteamNetworkingSend_Reliable;
+	}
+}
+
+HeadlessOnlineManager::HeadlessOnlineManager() :
+	m_bundler([](uint64_t, int, DataBufferView) {})
+{
+}
+
+bool HeadlessOnlineManager::SendGameMessage(const GameMessageView& message)
+{
+	CountMessage(message, false, SendFlagsFor(message.MessageType()));
+	return true;
+}
+
+bool HeadlessOnlineManager::SendGameMessageWithSourceID(const GameMessageView& message)
+{
+	CountMessage(message, true, SendFlagsFor(message.MessageType()));
+	return true;
+}
+
+bool HeadlessOnlineManager::ServerSendMessageToAll(const GameMessageView& message, bool serializeWithSourceID, int sendFlags)
+{
+	CountMessage(message, serializeWithSourceID, sendFlags);
+	return true;
+}
+
+void HeadlessOnlineManager::RelayGameMessage(uint64_t sourceID, const GameMessageView& message)
+{
+	LayOutPacket(message, MsgTypeSize + sizeof(uint64), sourceID);
+
+	const int sendFlags = SendFlagsFor(message.MessageType());
+	for (const auto& [id, peer] : g_game->GetPeers())
+	{
+		if (id != sourceID)
+		{
+			m_bundler.Queue(id, sendFlags, m_packet);
+		}
+	}
+}
+
+void HeadlessOnlineManager::FlushGameMessages()
+{
+	m_bundler.Flush();
+}
+
+uint64_t HeadlessOnlineManager::GetMessagesSent(GameMessageType type) const
+{
+	auto found = m_messagesSentByType.find(type);
+	return found == m_messagesSentByType.end() ? 0 : found->second;
+}
+
+void HeadlessOnlineManager::ResetCounters()
+{
+	m_messagesSent = 0;
+	m_bytesSent = 0;
+	m_messagesSentByType.clear();
+	m_bundler.ResetCounters();
+}
+
+void HeadlessOnlineManager::CountMessage(const GameMessageView& message, bool withSourceID, int sendFlags)
+{
+	const size_t headerSize = MsgTypeSize + (withSourceID ? sizeof(uint64) : 0);
+
+	m_messagesSent++;
+	m_messagesSentByType[message.MessageType()]++;
+	m_bytesSent += headerSize + message.RawData().size();
+
+	// There is no local player to take a source ID from, so the packet is laid out here
+	LayOutPacket(message, headerSize, 0);
+
+	for (const auto& [id, peer] : g_game->GetPeers())
+	{
+		m_bundler.Queue(id, sendFlags, m_packet);
+	}
+}
+
+void HeadlessOnlineManager::LayOutPacket(const GameMessageView& message, size_t headerSize, uint64_t sourceID)
+{
+	const GameMessageType type = message.MessageType();
+	m_packet.assign(headerSize, 0);
+	memcpy(m_packet.data(), &type, MsgTypeSize);
+	if (headerSize > MsgTypeSize)
+	{
+		memcpy(m_packet.data() + MsgTypeSize, &sourceID, sizeof(sourceID));
+	}
+	m_packet.insert(m_packet.end(), message.RawData().begin(), message.RawData().end());
+}
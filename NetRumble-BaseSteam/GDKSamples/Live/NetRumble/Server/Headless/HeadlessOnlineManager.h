@@ -0,0 +1,81 @@
+//--------------------------------------------------------------------------------------
+// HeadlessOnlineManager.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "OnlineManager.h"
+#include "MessageBundle.h"
+#include "NetworkMessages.h"
+
+namespace NetRumble
+{
+	// The authoritative side of a match with no transport attached, unless a test makes it a
+	// client to apply another match's messages. Everything the world
+	// would broadcast is counted instead of sent, so soak runs report the bandwidth a match
+	// would have produced. Broadcasts are also queued for every player as the Steam server
+	// queues them for each client, and bundled the same way at the end of the tick.
+	class HeadlessOnlineManager final : public IOnlineManager
+	{
+	public:
+		HeadlessOnlineManager();
+
+		virtual void StartMatchmaking() override {}
+		virtual bool IsMatchmaking() override { return false; }
+		virtual void CancelMatchmaking() override {}
+
+		virtual void LeaveMultiplayerGame() override {}
+
+		virtual bool SendGameMessage(const GameMessageView& message) override;
+		bool SendGameMessageWithSourceID(const GameMessageView& message);
+		bool ServerSendMessageToAll(const GameMessageView& message, bool serializeWithSourceID = false, int sendFlags = k_nSteamNetworkingSend_UnreliableNoDelay);
+
+		virtual bool IsNetworkAvailable() const override { return false; }
+
+		virtual bool IsServer() const override { return m_isServer; }
+		// A match can stand in for a client instead, applying what another match's host sends
+		inline void SetServer(bool isServer) { m_isServer = isServer; }
+		virtual bool IsConnected() const override { return false; }
+
+		virtual void Tick(float delta) override { UNREFERENCED_PARAMETER(delta); }
+
+		virtual uint64_t GetNetworkId() const override { return 0; }
+
+		inline uint64 GetLastServerUpdateTick() const { return m_lastServerUpdateTick; }
+		inline void SetLastServerUpdateTick(uint64 newTick) { m_lastServerUpdateTick = newTick; }
+
+		// Stats and inventory live with the Steam client
+		void CheckForItemDrops() {}
+		void SetDeathCount() {}
+
+		// Queues a client's message as the Steam server relays it: to every other player,
+		// behind the sender's ID, bundled with the tick's broadcasts
+		void RelayGameMessage(uint64_t sourceID, const GameMessageView& message);
+
+		// Sends this tick's bundles, which here only counts them
+		void FlushGameMessages();
+
+		inline uint64_t GetMessagesSent() const { return m_messagesSent; }
+		inline uint64_t GetBytesSent() const { return m_bytesSent; }
+		uint64_t GetMessagesSent(GameMessageType type) const;
+		inline const MessageBundler::Counters& GetBundleCounters() const { return m_bundler.GetCounters(); }
+		void ResetCounters();
+
+	private:
+		void CountMessage(const GameMessageView& message, bool withSourceID, int sendFlags);
+		void LayOutPacket(const GameMessageView& message, size_t headerSize, uint64_t sourceID);
+
+		bool m_isServer = true;
+		uint64 m_lastServerUpdateTick = 0;
+		uint64_t m_messagesSent = 0;
+		uint64_t m_bytesSent = 0;
+		std::map<GameMessageType, uint64_t> m_messagesSentByType;
+
+		std::vector<uint8_t> m_packet;
+		MessageBundler m_bundler;
+	};
+
+	using OnlineManager = HeadlessOnlineManager;
+}
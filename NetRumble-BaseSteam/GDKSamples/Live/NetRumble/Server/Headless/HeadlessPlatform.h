@@ -0,0 +1,101 @@
+//--------------------------------------------------------------------------------------
+// HeadlessPlatform.h
+//
+// The few Win32 types and CRT helpers the simulation code uses, for building the
+// headless server on platforms without the Windows SDK.
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#ifndef _WIN32
+
+#include <chrono>
+#include <climits>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+
+typedef unsigned char byte;
+typedef unsigned long DWORD;
+typedef unsigned int UINT;
+typedef long HRESULT;
+
+typedef struct tagRECT
+{
+	long left;
+	long top;
+	long right;
+	long bottom;
+} RECT;
+
+typedef union _LARGE_INTEGER
+{
+	struct
+	{
+		uint32_t LowPart;
+		int32_t HighPart;
+	} u;
+	int64_t QuadPart;
+} LARGE_INTEGER;
+
+#define MININT INT_MIN
+#define MAXINT INT_MAX
+#define UNREFERENCED_PARAMETER(P) (void)(P)
+#define __cdecl
+#define CopyMemory(Destination, Source, Length) memcpy((Destination), (Source), (Length))
+
+// StepTimer.h is written against the performance counter; a steady clock stands in for it
+inline bool QueryPerformanceFrequency(LARGE_INTEGER* frequency)
+{
+	frequency->QuadPart = std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num;
+	return true;
+}
+
+inline bool QueryPerformanceCounter(LARGE_INTEGER* counter)
+{
+	counter->QuadPart = std::chrono::steady_clock::now().time_since_epoch().count();
+	return true;
+}
+
+template <size_t Size>
+inline int sprintf_s(char(&buffer)[Size], const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int result = vsnprintf(buffer, Size, format, args);
+	va_end(args);
+	return result;
+}
+
+inline int sprintf_s(char* buffer, size_t size, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int result = vsnprintf(buffer, size, format, args);
+	va_end(args);
+	return result;
+}
+
+template <size_t Size>
+inline int swprintf_s(wchar_t(&buffer)[Size], const wchar_t* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	int result = vswprintf(buffer, Size, format, args);
+	va_end(args);
+	return result;
+}
+
+template <size_t Size>
+inline int strncpy_s(char(&destination)[Size], const char* source, size_t count)
+{
+	size_t length = std::min(Size - 1, std::min(count, strlen(source)));
+	memcpy(destination, source, length);
+	destination[length] = '\0';
+	return 0;
+}
+
+#endif
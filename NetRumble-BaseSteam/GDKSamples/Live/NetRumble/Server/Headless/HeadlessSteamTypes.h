@@ -0,0 +1,58 @@
+//--------------------------------------------------------------------------------------
+// HeadlessSteamTypes.h
+//
+// The Steam integer types, send flags and connection end reasons that the shared
+// message formats are written against, so the headless server builds without the
+// Steamworks SDK. The values match steamtypes.h and steamnetworkingtypes.h; the
+// headless server never calls into Steam.
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+
+typedef uint8_t uint8;
+typedef int8_t int8;
+typedef uint16_t uint16;
+typedef int16_t int16;
+typedef uint32_t uint32;
+typedef int32_t int32;
+typedef uint64_t uint64;
+typedef int64_t int64;
+
+const int k_nSteamNetworkingSend_Unreliable = 0;
+const int k_nSteamNetworkingSend_NoNagle = 1;
+const int k_nSteamNetworkingSend_UnreliableNoNagle = k_nSteamNetworkingSend_Unreliable | k_nSteamNetworkingSend_NoNagle;
+const int k_nSteamNetworkingSend_NoDelay = 4;
+const int k_nSteamNetworkingSend_UnreliableNoDelay = k_nSteamNetworkingSend_Unreliable | k_nSteamNetworkingSend_NoDelay | k_nSteamNetworkingSend_NoNagle;
+const int k_nSteamNetworkingSend_Reliable = 8;
+const int k_nSteamNetworkingSend_ReliableNoNagle = k_nSteamNetworkingSend_Reliable | k_nSteamNetworkingSend_NoNagle;
+
+enum ESteamNetConnectionEnd
+{
+	k_ESteamNetConnectionEnd_Invalid = 0,
+	k_ESteamNetConnectionEnd_App_Min = 1000,
+	k_ESteamNetConnectionEnd_App_Max = 1999,
+	k_ESteamNetConnectionEnd_Remote_Timeout = 4001,
+	k_ESteamNetConnectionEnd_Misc_Generic = 5001,
+	k_ESteamNetConnectionEnd_Misc_P2P_Rendezvous = 5008,
+	k_ESteamNetConnectionEnd_Misc_PeerSentNoConnection = 5010,
+};
+
+// Only carried in messages; the 64-bit value is all the headless server ever needs
+class CSteamID
+{
+public:
+	CSteamID() = default;
+	explicit CSteamID(uint64 steamID) : m_steamID(steamID) {}
+
+	inline uint64 ConvertToUint64() const { return m_steamID; }
+
+	inline bool operator==(const CSteamID& other) const { return m_steamID == other.m_steamID; }
+	inline bool operator!=(const CSteamID& other) const { return m_steamID != other.m_steamID; }
+
+private:
+	uint64 m_steamID = 0;
+};
@@ -0,0 +1,173 @@
+//--------------------------------------------------------------------------------------
+// InterpolationTest.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "InterpolationTest.h"
+
+using namespace NetRumble;
+using namespace DirectX;
+
+namespace
+{
+	// The test pilot flies as PredictionTest's does, in a world of the usual size
+	constexpr float c_headingMinimum = 0.25f;
+	constexpr float c_headingMaximum = 1.5f;
+	constexpr float c_worldSize = 2400.0f;
+	constexpr float c_edgeMargin = 300.0f;
+
+	// Steps shorter than this are a ship at rest, whichever way they point
+	constexpr float c_minimumStepSquared = 0.01f * 0.01f;
+}
+
+InterpolationTest::InterpolationTest(const Settings& settings) :
+	m_settings(settings)
+{
+	m_settings.TicksPerSecond = std::max<uint32_t>(m_settings.TicksPerSecond, 1);
+	m_settings.UpdatesBetweenPackets = std::max<uint32_t>(m_settings.UpdatesBetweenPackets, 1);
+	m_settings.LossPercent = std::clamp(m_settings.LossPercent, 0.0f, 100.0f);
+}
+
+InterpolationTest::Report InterpolationTest::Run()
+{
+	struct InFlight
+	{
+		double DeliverAt;
+		MotionSnapshot Snapshot;
+	};
+
+	Report report;
+
+	const float elapsedTime = 1.0f / m_settings.TicksPerSecond;
+	const uint64_t ticks = static_cast<uint64_t>(m_settings.DurationSeconds * m_settings.TicksPerSecond);
+	const SimpleMath::Vector2 center(c_worldSize * 0.5f, c_worldSize * 0.5f);
+	const double oneWay = m_settings.LatencyMilliseconds * 0.0005;
+	const double jitter = m_settings.JitterMilliseconds * 0.001;
+
+	std::minstd_rand random(m_settings.Seed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	ShipMotion host{ center, SimpleMath::Vector2::Zero, 0.0f };
+	SimpleMath::Vector2 heading = SimpleMath::Vector2::Zero;
+	float headingTimer = 0.0f;
+	uint32_t updatesSincePacket = 0;
+	uint32_t sequence = 0;
+
+	std::vector<InFlight> inFlight;
+	std::vector<InFlight> arrived;
+	SnapshotBuffer snapshots;
+	HostClock hostClock;
+	uint32_t newestApplied = 0;
+
+	MotionSnapshot shown;
+	uint32_t shownFrames = 0;
+	SimpleMath::Vector2 previousPosition;
+	SimpleMath::Vector2 previousStep;
+
+	report.Jitter.reserve(static_cast<size_t>(ticks));
+
+	for (uint64_t tick = 0; tick < ticks; ++tick)
+	{
+		const double now = static_cast<double>(tick) * elapsedTime;
+
+		// Host: fly the ship and send its state every few updates
+		headingTimer -= elapsedTime;
+		if (headingTimer <= 0.0f)
+		{
+			float angle = unit(random) * XM_2PI;
+			heading = SimpleMath::Vector2(std::sin(angle), -std::cos(angle));
+			headingTimer = c_headingMinimum + unit(random) * (c_headingMaximum - c_headingMinimum);
+
+			if (host.Position.x < c_edgeMargin || host.Position.x > c_worldSize - c_edgeMargin ||
+				host.Position.y < c_edgeMargin || host.Position.y > c_worldSize - c_edgeMargin)
+			{
+				heading = center - host.Position;
+				heading.Normalize();
+			}
+		}
+
+		// Sticks are in screen space with up positive; Steer flips Y back into world space
+		Ship::Steer(host, SimpleMath::Vector2(heading.x, -heading.y), elapsedTime);
+		host.Position += host.Velocity * elapsedTime;
+
+		if (++updatesSincePacket >= m_settings.UpdatesBetweenPackets)
+		{
+			updatesSincePacket = 0;
+			report.PacketsSent++;
+
+			MotionSnapshot snapshot{ ++sequence, static_cast<float>(now), host.Position, host.Velocity, host.Rotation };
+			if (unit(random) * 100.0f >= m_settings.LossPercent)
+			{
+				double delay = std::max(0.0, oneWay + (unit(random) * 2.0 - 1.0) * jitter);
+				inFlight.push_back(InFlight{ now + delay, snapshot });
+			}
+		}
+
+		// Receiver: take whatever has arrived, in the order it arrived
+		auto firstPending = std::stable_partition(inFlight.begin(), inFlight.end(), [now](const InFlight& packet) { return packet.DeliverAt <= now; });
+		arrived.assign(inFlight.begin(), firstPending);
+		inFlight.erase(inFlight.begin(), firstPending);
+		std::stable_sort(arrived.begin(), arrived.end(), [](const InFlight& a, const InFlight& b) { return a.DeliverAt < b.DeliverAt; });
+
+		hostClock.Update(elapsedTime);
+		for (const InFlight& packet : arrived)
+		{
+			if (m_settings.Buffered)
+			{
+				hostClock.Observe(packet.Snapshot.Time);
+				if (!snapshots.Add(packet.Snapshot))
+				{
+					report.PacketsStale++;
+				}
+			}
+			else
+			{
+				// Applied regardless, as it used to be
+				if (packet.Snapshot.Sequence <= newestApplied)
+				{
+					report.PacketsStale++;
+				}
+				newestApplied = std::max(newestApplied, packet.Snapshot.Sequence);
+				shown = packet.Snapshot;
+			}
+		}
+
+		bool visible = false;
+		if (m_settings.Buffered)
+		{
+			visible = hostClock.IsValid() && snapshots.Sample(hostClock.GetTime() - m_settings.InterpolationDelay, World::c_MaximumExtrapolation, shown);
+		}
+		else if (newestApplied > 0)
+		{
+			// The collision manager moves the ship on between packets
+			shown.Position += shown.Velocity * elapsedTime;
+			visible = true;
+		}
+
+		if (!visible)
+		{
+			continue;
+		}
+
+		// Score the frame
+		if (shownFrames > 0)
+		{
+			SimpleMath::Vector2 step = shown.Position - previousPosition;
+			if (shownFrames > 1)
+			{
+				report.Jitter.push_back(SimpleMath::Vector2::Distance(step, previousStep));
+				if (step.Dot(previousStep) < 0.0f && step.LengthSquared() > c_minimumStepSquared && previousStep.LengthSquared() > c_minimumStepSquared)
+				{
+					report.Reversals++;
+				}
+			}
+			previousStep = step;
+		}
+		previousPosition = shown.Position;
+		shownFrames++;
+	}
+
+	return report;
+}
@@ -0,0 +1,54 @@
+//--------------------------------------------------------------------------------------
+// InterpolationTest.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "pch.h"
+
+namespace NetRumble
+{
+	// Measures how smoothly a receiver shows a remote ship whose state arrives over a lossy,
+	// jittery link. The host flies the ship with Ship::Steer and sends its state at a fixed
+	// rate; packets are delayed by a random amount each, so they can arrive out of order.
+	// The receiver either applies each packet as it arrives and dead-reckons in between, as
+	// clients did before snapshot buffering, or shows the ship through a SnapshotBuffer.
+	class InterpolationTest final
+	{
+	public:
+		struct Settings
+		{
+			// Round trip, split evenly between the two directions
+			uint32_t LatencyMilliseconds = 150;
+			// Each packet's one-way delay varies by up to this much either way
+			uint32_t JitterMilliseconds = 20;
+			float LossPercent = 5.0f;
+			uint32_t TicksPerSecond = 60;
+			uint32_t UpdatesBetweenPackets = World::c_UpdatesBetweenShipDataPackets;
+			float InterpolationDelay = World::c_DefaultInterpolationDelay;
+			bool Buffered = true;
+			double DurationSeconds = 60.0;
+			uint32_t Seed = 1;
+		};
+
+		// Jitter is, per frame, how much the shown ship's step differs from its step the frame
+		// before, in pixels; a ship flying smoothly scores close to zero. Reversals count the
+		// frames where the ship was shown moving back against its previous step.
+		struct Report
+		{
+			std::vector<float> Jitter;
+			uint32_t Reversals = 0;
+			uint32_t PacketsSent = 0;
+			uint32_t PacketsStale = 0;
+		};
+
+		explicit InterpolationTest(const Settings& settings);
+
+		Report Run();
+
+	private:
+		Settings m_settings;
+	};
+}
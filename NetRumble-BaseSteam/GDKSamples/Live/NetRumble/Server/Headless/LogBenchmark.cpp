@@ -0,0 +1,205 @@
+//--------------------------------------------------------------------------------------
+// LogBenchmark.cpp
+//
+// Measures what one log call costs the thread that makes it.
+//
+//   NetRumbleLogBenchmark [--calls N]
+//
+// The baseline is the previous DebugWrite: take a lock, format, then open, append to,
+// flush and close the log file on every call. It is compared with queueing the line to
+// LogRingBuffer while a writer thread drains it to the file, and with the per-packet
+// category both sampled and switched off.
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "Debug.h"
+#include "LogRingBuffer.h"
+
+namespace
+{
+	constexpr const char* c_benchmarkLogFile = "NetRumbleLogBenchmark.txt";
+
+	std::mutex s_logMutex;
+
+	void FileEveryCall(const char* format, ...)
+	{
+		std::lock_guard<std::mutex> lock(s_logMutex);
+		static char message[8192];
+
+		va_list args;
+		va_start(args, format);
+		vsnprintf(message, sizeof(message), format, args);
+		va_end(args);
+
+		FILE* file = fopen(c_benchmarkLogFile, "at+");
+		if (file != nullptr)
+		{
+			std::string line("0 \t00:00:00.000 ");
+			line += message;
+			fwrite(line.data(), sizeof(char), line.size(), file);
+			fflush(file);
+			fclose(file);
+		}
+	}
+
+	// Stands in for the debug log writer thread
+	class Drainer
+	{
+	public:
+		explicit Drainer(LogRingBuffer& lines) :
+			m_lines(lines),
+			m_file(fopen(c_benchmarkLogFile, "at+")),
+			m_thread([this]() { Run(); })
+		{
+		}
+
+		~Drainer()
+		{
+			m_running = false;
+			m_thread.join();
+			if (m_file != nullptr)
+			{
+				fclose(m_file);
+			}
+		}
+
+	private:
+		void Run()
+		{
+			std::string batch;
+			for (;;)
+			{
+				bool running = m_running;
+
+				batch.clear();
+				m_lines.Drain([&](const LogRingBuffer::Line& line) { batch.append(line.Text, line.Length); });
+
+				if (!batch.empty())
+				{
+					if (m_file != nullptr)
+					{
+						fwrite(batch.data(), sizeof(char), batch.size(), m_file);
+						fflush(m_file);
+					}
+				}
+				else if (!running)
+				{
+					break;
+				}
+				else
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				}
+			}
+		}
+
+		LogRingBuffer& m_lines;
+		FILE* m_file;
+		std::atomic<bool> m_running{ true };
+		std::thread m_thread;
+	};
+
+	LogRingBuffer* s_lines = nullptr;
+
+	void Queued(const char* format, ...)
+	{
+		va_list args;
+		va_start(args, format);
+		s_lines->Write(0, 0, format, args);
+		va_end(args);
+	}
+
+	// Calls come in bursts, like the messages handled in one frame, with an untimed pause
+	// between them so the writer thread can keep up as it would in a game
+	constexpr uint32_t c_callsPerBurst = 64;
+	constexpr auto c_pauseBetweenBursts = std::chrono::milliseconds(2);
+
+	template<typename Func>
+	double NanosecondsPerCall(uint32_t calls, Func&& func)
+	{
+		std::chrono::duration<double, std::nano> elapsed{ 0 };
+		for (uint32_t i = 0; i < calls; )
+		{
+			auto start = std::chrono::steady_clock::now();
+			for (uint32_t burst = 0; burst < c_callsPerBurst && i < calls; ++burst, ++i)
+			{
+				func(i);
+			}
+			elapsed += std::chrono::steady_clock::now() - start;
+
+			std::this_thread::sleep_for(c_pauseBetweenBursts);
+		}
+
+		return elapsed.count() / calls;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t calls = 20000;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--calls") == 0)
+		{
+			calls = static_cast<uint32_t>(strtoul(argv[i + 1], nullptr, 10));
+		}
+	}
+
+	remove(c_benchmarkLogFile);
+
+	double fileEveryCall = NanosecondsPerCall(calls, [](uint32_t i) { FileEveryCall("Received message: %s %u\n", "ShipData", i); });
+
+	LogRingBuffer lines(4096);
+	s_lines = &lines;
+
+	double queued = 0.0;
+	double sampled = 0.0;
+	double filtered = 0.0;
+	uint64_t dropped = 0;
+	{
+		Drainer drainer(lines);
+
+		queued = NanosecondsPerCall(calls, [](uint32_t i) { Queued("Received message: %s %u\n", "ShipData", i); });
+
+		DebugSetLevel(LogCategory::Packet, LogLevel::Verbose);
+		DebugSetSampleRate(LogCategory::Packet, DEBUG_LOG_PACKET_SAMPLE_RATE);
+		sampled = NanosecondsPerCall(calls, [](uint32_t i)
+		{
+			if (DebugShouldLog(LogCategory::Packet, LogLevel::Verbose))
+			{
+				Queued("Received message: %s %u\n", "ShipData", i);
+			}
+		});
+
+		DebugSetLevel(LogCategory::Packet, LogLevel::Off);
+		filtered = NanosecondsPerCall(calls, [](uint32_t i)
+		{
+			if (DebugShouldLog(LogCategory::Packet, LogLevel::Verbose))
+			{
+				Queued("Received message: %s %u\n", "ShipData", i);
+			}
+		});
+
+		dropped = lines.Dropped();
+	}
+
+	remove(c_benchmarkLogFile);
+
+	printf("%u calls, ns per call on the logging thread\n", calls);
+	printf("%-36s %10.0f\n", "fopen/fwrite/fclose per call", fileEveryCall);
+	printf("%-36s %10.0f   (%llu dropped)\n", "queued to writer thread", queued, static_cast<unsigned long long>(dropped));
+	printf("packet category, 1 in %-14d %10.0f\n", DEBUG_LOG_PACKET_SAMPLE_RATE, sampled);
+	printf("%-36s %10.1f\n", "packet category switched off", filtered);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+//--------------------------------------------------------------------------------------
+// LoopbackNetwork.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "LoopbackNetwork.h"
+
+using namespace NetRumble;
+
+namespace
+{
+	// A link further behind than this drops unreliable messages rather than queue them,
+	// as a router's buffer would
+	constexpr double c_maximumQueueDelay = 0.2;
+
+	// Reliable messages are resent a round trip after each lost attempt; a link that loses
+	// this many in a row would have been dropped by a real transport
+	constexpr uint32_t c_maximumReliableSends = 10;
+}
+
+LoopbackNetwork::LoopbackNetwork(const Settings& settings) :
+	m_settings(settings),
+	m_random(settings.Seed)
+{
+	m_settings.LossPercent = std::clamp(m_settings.LossPercent, 0.0f, 100.0f);
+	m_settings.ReorderPercent = std::clamp(m_settings.ReorderPercent, 0.0f, 100.0f);
+}
+
+uint64_t LoopbackNetwork::Connect()
+{
+	uint64_t endpoint = m_nextEndpoint++;
+	m_endpoints.push_back(endpoint);
+	m_inboxes[endpoint];
+	return endpoint;
+}
+
+void LoopbackNetwork::Disconnect(uint64_t endpoint)
+{
+	m_endpoints.erase(std::remove(m_endpoints.begin(), m_endpoints.end(), endpoint), m_endpoints.end());
+	m_inboxes.erase(endpoint);
+
+	for (auto itr = m_links.begin(); itr != m_links.end();)
+	{
+		if (itr->first.first == endpoint || itr->first.second == endpoint)
+		{
+			itr = m_links.erase(itr);
+		}
+		else
+		{
+			++itr;
+		}
+	}
+}
+
+void LoopbackNetwork::Advance(double seconds)
+{
+	m_now += std::max(seconds, 0.0);
+}
+
+void LoopbackNetwork::Send(uint64_t from, uint64_t to, Delivery delivery, DataBufferView message)
+{
+	auto inbox = m_inboxes.find(to);
+	if (inbox == m_inboxes.end() || from == to)
+	{
+		return;
+	}
+
+	m_counters.Sent++;
+	m_counters.BytesSent += message.size();
+
+	Link& link = m_links[{ from, to }];
+	const uint64_t sequence = link.NextSequence++;
+	const double wireSeconds = m_settings.BandwidthBytesPerSecond > 0
+		? static_cast<double>(message.size() + c_datagramHeaderBytes) / m_settings.BandwidthBytesPerSecond
+		: 0.0;
+
+	double leaveAt = std::max(m_now, link.BusyUntil);
+	double arriveAt = 0.0;
+
+	if (delivery == Delivery::Unreliable)
+	{
+		if (leaveAt - m_now > c_maximumQueueDelay)
+		{
+			m_counters.Dropped++;
+			return;
+		}
+
+		// A lost message still took its turn on the wire
+		link.BusyUntil = leaveAt + wireSeconds;
+		if (Roll(m_settings.LossPercent))
+		{
+			m_counters.Lost++;
+			return;
+		}
+
+		arriveAt = link.BusyUntil + OneWayDelay();
+		if (Roll(m_settings.ReorderPercent))
+		{
+			arriveAt += std::uniform_real_distribution<double>(0.5, 1.0)(m_random) * m_settings.LatencyMilliseconds * 0.001;
+		}
+	}
+	else
+	{
+		const double resendDelay = m_settings.LatencyMilliseconds * 0.001;
+
+		uint32_t sends = 1;
+		link.BusyUntil = leaveAt + wireSeconds;
+		double sentAt = link.BusyUntil;
+		while (Roll(m_settings.LossPercent))
+		{
+			if (sends == c_maximumReliableSends)
+			{
+				m_counters.Lost++;
+				return;
+			}
+
+			// Each resend takes its share of the link, though it goes out later
+			sends++;
+			m_counters.Resends++;
+			link.BusyUntil += wireSeconds;
+			sentAt += resendDelay + wireSeconds;
+		}
+
+		// Held back behind anything reliable sent before it on this link
+		arriveAt = std::max(sentAt + OneWayDelay(), link.LastReliableArrival);
+		link.LastReliableArrival = arriveAt;
+	}
+
+	Message queued;
+	queued.ArriveAt = arriveAt;
+	queued.Order = m_nextOrder++;
+	queued.From = from;
+	queued.LinkSequence = sequence;
+	queued.Reliable = delivery == Delivery::Reliable;
+	queued.Data.assign(message.begin(), message.end());
+	inbox->second.push(std::move(queued));
+}
+
+void LoopbackNetwork::Receive(uint64_t endpoint, const std::function<void(uint64_t, DataBufferView)>& handler)
+{
+	auto inbox = m_inboxes.find(endpoint);
+	if (inbox == m_inboxes.end())
+	{
+		return;
+	}
+
+	auto& queue = inbox->second;
+	while (!queue.empty() && queue.top().ArriveAt <= m_now)
+	{
+		// The top of a priority queue can't be moved from, so it's handed over in place
+		const Message& message = queue.top();
+
+		if (!message.Reliable)
+		{
+			Link& link = m_links[{ message.From, endpoint }];
+			if (message.LinkSequence < link.LastUnreliableDelivered)
+			{
+				m_counters.Reordered++;
+			}
+			else
+			{
+				link.LastUnreliableDelivered = message.LinkSequence;
+			}
+		}
+
+		m_counters.Delivered++;
+		m_counters.BytesDelivered += message.Data.size();
+		handler(message.From, DataBufferView(message.Data.data(), message.Data.size()));
+
+		queue.pop();
+	}
+}
+
+double LoopbackNetwork::OneWayDelay()
+{
+	double delay = m_settings.LatencyMilliseconds * 0.0005;
+	if (m_settings.JitterMilliseconds > 0)
+	{
+		double jitter = m_settings.JitterMilliseconds * 0.001;
+		delay += std::uniform_real_distribution<double>(-jitter, jitter)(m_random);
+	}
+
+	return std::max(delay, 0.0);
+}
+
+bool LoopbackNetwork::Roll(float percent)
+{
+	return percent > 0.0f && std::uniform_real_distribution<float>(0.0f, 100.0f)(m_random) < percent;
+}
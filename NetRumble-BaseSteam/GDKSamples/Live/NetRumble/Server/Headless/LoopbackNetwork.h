@@ -0,0 +1,133 @@
+//--------------------------------------------------------------------------------------
+// LoopbackNetwork.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "pch.h"
+
+namespace NetRumble
+{
+	// A simulated network joining endpoints in this process, so netcode can be measured with
+	// no transport and no network. Every pair of endpoints shares one link with the same
+	// settings. The network keeps its own clock, which the owner advances once a frame;
+	// messages sent now arrive once the clock passes their delivery time.
+	//
+	// Not thread-safe: every endpoint on one network must run on the same thread.
+	class LoopbackNetwork final
+	{
+	public:
+		struct Settings
+		{
+			// Round trip, split evenly between the two directions
+			uint32_t LatencyMilliseconds = 100;
+			// Each message's one-way delay varies by up to this much either way
+			uint32_t JitterMilliseconds = 0;
+			float LossPercent = 0.0f;
+			// Chance an unreliable message is held back long enough for later ones to overtake it
+			float ReorderPercent = 0.0f;
+			// Per direction of each link, counting the datagram headers; 0 is unlimited
+			uint32_t BandwidthBytesPerSecond = 0;
+			uint32_t Seed = 1;
+		};
+
+		enum class Delivery
+		{
+			// May be lost, and may arrive out of order
+			Unreliable,
+			// Resent until it arrives, and never handed over before anything sent ahead of it
+			Reliable
+		};
+
+		struct Counters
+		{
+			uint64_t Sent = 0;
+			uint64_t Delivered = 0;
+			// Unreliable messages the link lost, and reliable ones that ran out of resends
+			uint64_t Lost = 0;
+			// Unreliable messages dropped because the link was too far behind to carry them
+			uint64_t Dropped = 0;
+			// Unreliable messages that arrived after one sent later on the same link
+			uint64_t Reordered = 0;
+			uint64_t Resends = 0;
+			uint64_t BytesSent = 0;
+			uint64_t BytesDelivered = 0;
+		};
+
+		// IPv4 and UDP headers, charged against the bandwidth for every message
+		static constexpr uint32_t c_datagramHeaderBytes = 28;
+
+		explicit LoopbackNetwork(const Settings& settings);
+
+		LoopbackNetwork(LoopbackNetwork const&) = delete;
+		LoopbackNetwork& operator= (LoopbackNetwork const&) = delete;
+
+		// Endpoint IDs start at 1 and are never reused
+		uint64_t Connect();
+		// Anything still on its way to the endpoint is thrown away
+		void Disconnect(uint64_t endpoint);
+		inline const std::vector<uint64_t>& GetEndpoints() const { return m_endpoints; }
+
+		void Advance(double seconds);
+		inline double Now() const { return m_now; }
+
+		void Send(uint64_t from, uint64_t to, Delivery delivery, DataBufferView message);
+
+		// Calls handler(from, message) for every message that has arrived at the endpoint, in
+		// arrival order. The bytes are only valid for the call.
+		void Receive(uint64_t endpoint, const std::function<void(uint64_t, DataBufferView)>& handler);
+
+		inline const Settings& GetSettings() const { return m_settings; }
+		inline const Counters& GetCounters() const { return m_counters; }
+		inline void ResetCounters() { m_counters = Counters(); }
+
+	private:
+		struct Message
+		{
+			double ArriveAt;
+			// Send order across the network, so messages arriving at the same moment keep it
+			uint64_t Order;
+			uint64_t From;
+			// Send order on the message's link, to spot reordering
+			uint64_t LinkSequence;
+			bool Reliable;
+			std::vector<uint8_t> Data;
+		};
+
+		struct ArrivesLater
+		{
+			inline bool operator()(const Message& a, const Message& b) const
+			{
+				return a.ArriveAt != b.ArriveAt ? a.ArriveAt > b.ArriveAt : a.Order > b.Order;
+			}
+		};
+
+		// One direction between two endpoints
+		struct Link
+		{
+			// When the link finishes putting the last queued message on the wire
+			double BusyUntil = 0.0;
+			double LastReliableArrival = 0.0;
+			uint64_t NextSequence = 1;
+			// Highest sequence of an unreliable message handed over, 0 before the first
+			uint64_t LastUnreliableDelivered = 0;
+		};
+
+		double OneWayDelay();
+		bool Roll(float percent);
+
+		Settings m_settings;
+		std::minstd_rand m_random;
+		double m_now = 0.0;
+		uint64_t m_nextEndpoint = 1;
+		uint64_t m_nextOrder = 0;
+
+		std::vector<uint64_t> m_endpoints;
+		std::map<uint64_t, std::priority_queue<Message, std::vector<Message>, ArrivesLater>> m_inboxes;
+		std::map<std::pair<uint64_t, uint64_t>, Link> m_links;
+
+		Counters m_counters;
+	};
+}
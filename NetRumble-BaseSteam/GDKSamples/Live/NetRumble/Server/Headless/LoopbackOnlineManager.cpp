@@ -0,0 +1,102 @@
+//--------------------------------------------------------------------------------------
+// LoopbackOnlineManager.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "LoopbackOnlineManager.h"
+
+using namespace NetRumble;
+
+LoopbackOnlineManager::LoopbackOnlineManager(LoopbackNetwork& network, bool isHost) :
+	m_network(network),
+	m_endpoint(network.Connect()),
+	m_isHost(isHost)
+{
+}
+
+LoopbackOnlineManager::~LoopbackOnlineManager()
+{
+	LeaveMultiplayerGame();
+}
+
+void LoopbackOnlineManager::LeaveMultiplayerGame()
+{
+	if (m_endpoint != 0)
+	{
+		m_network.Disconnect(m_endpoint);
+		m_endpoint = 0;
+	}
+}
+
+bool LoopbackOnlineManager::SendGameMessage(const GameMessageView& message)
+{
+	if (m_endpoint == 0)
+	{
+		return false;
+	}
+
+	message.SerializeTo(m_sendBuffer);
+
+	const LoopbackNetwork::Delivery delivery = DeliveryFor(message.MessageType());
+	for (uint64_t endpoint : m_network.GetEndpoints())
+	{
+		if (endpoint != m_endpoint)
+		{
+			m_network.Send(m_endpoint, endpoint, delivery, m_sendBuffer);
+		}
+	}
+
+	return true;
+}
+
+bool LoopbackOnlineManager::SendGameMessageTo(uint64_t endpoint, const GameMessageView& message, LoopbackNetwork::Delivery delivery)
+{
+	if (m_endpoint == 0)
+	{
+		return false;
+	}
+
+	message.SerializeTo(m_sendBuffer);
+	m_network.Send(m_endpoint, endpoint, delivery, m_sendBuffer);
+	return true;
+}
+
+bool LoopbackOnlineManager::IsConnected() const
+{
+	return m_endpoint != 0 && m_network.GetEndpoints().size() > 1;
+}
+
+void LoopbackOnlineManager::Tick(float delta)
+{
+	UNREFERENCED_PARAMETER(delta);
+
+	if (m_endpoint == 0)
+	{
+		return;
+	}
+
+	m_network.Receive(m_endpoint, [this](uint64_t from, DataBufferView packet)
+		{
+			if (m_messageHandler)
+			{
+				m_messageHandler(from, GameMessageView::FromPacket(packet));
+			}
+		});
+}
+
+// As PlayFabParty::SendGameMessage picks its send options
+LoopbackNetwork::Delivery LoopbackOnlineManager::DeliveryFor(GameMessageType type)
+{
+	switch (type)
+	{
+	case GameMessageType::ShipInput:
+	case GameMessageType::ShipData:
+	case GameMessageType::WorldDataAck:
+		return LoopbackNetwork::Delivery::Unreliable;
+
+	default:
+		return LoopbackNetwork::Delivery::Reliable;
+	}
+}
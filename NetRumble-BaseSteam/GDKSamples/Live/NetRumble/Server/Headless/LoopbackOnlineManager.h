@@ -0,0 +1,62 @@
+//--------------------------------------------------------------------------------------
+// LoopbackOnlineManager.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "OnlineManager.h"
+#include "LoopbackNetwork.h"
+#include "NetworkMessages.h"
+
+namespace NetRumble
+{
+	// One game instance's connection to a LoopbackNetwork. Game messages are broadcast to
+	// every other endpoint on the network, as PlayFab Party broadcasts them, with the same
+	// split: ShipInput, ShipData and WorldDataAck go unreliably, everything else reliably
+	// and in order. Messages are handed to the registered handler from Tick.
+	class LoopbackOnlineManager final : public IOnlineManager
+	{
+	public:
+		LoopbackOnlineManager(LoopbackNetwork& network, bool isHost);
+		virtual ~LoopbackOnlineManager();
+
+		LoopbackOnlineManager(LoopbackOnlineManager const&) = delete;
+		LoopbackOnlineManager& operator= (LoopbackOnlineManager const&) = delete;
+
+		virtual void StartMatchmaking() override {}
+		virtual bool IsMatchmaking() override { return false; }
+		virtual void CancelMatchmaking() override {}
+
+		// Leaves the network; nothing more is sent or received
+		virtual void LeaveMultiplayerGame() override;
+
+		virtual bool SendGameMessage(const GameMessageView& message) override;
+		// To one endpoint rather than all of them, with the delivery picked by the caller
+		bool SendGameMessageTo(uint64_t endpoint, const GameMessageView& message, LoopbackNetwork::Delivery delivery);
+
+		inline void RegisterOnlineMessageHandler(OnlineMessageHandler handler) { m_messageHandler = std::move(handler); }
+
+		virtual bool IsNetworkAvailable() const override { return m_endpoint != 0; }
+
+		virtual bool IsServer() const override { return m_isHost; }
+		virtual bool IsConnected() const override;
+
+		// Hands over everything that has arrived by the network's current time
+		virtual void Tick(float delta) override;
+
+		// This instance's endpoint on the network
+		virtual uint64_t GetNetworkId() const override { return m_endpoint; }
+
+		static LoopbackNetwork::Delivery DeliveryFor(GameMessageType type);
+
+	private:
+		LoopbackNetwork& m_network;
+		uint64_t m_endpoint;
+		bool m_isHost;
+
+		OnlineMessageHandler m_messageHandler;
+		std::vector<uint8_t> m_sendBuffer;
+	};
+}
@@ -0,0 +1,2490 @@
+//--------------------------------------------------------------------------------------
+// Main.cpp
+//
+// Entry point for the headless NetRumble server.
+//
+//   NetRumbleHeadless [--matches N] [--players N] [--tickrate HZ] [--max-ticks N]
+//                     [--seed N] [--realtime] [--verbose]
+//   NetRumbleHeadless --host [--matches N] [--workers N] [--duration SECONDS] [--no-pin] ...
+//   NetRumbleHeadless --load-test [--matches N] [--workers N] [--duration SECONDS] ...
+//   NetRumbleHeadless --prediction-test [--latency MS] [--loss PERCENT] [--duration SECONDS]
+//   NetRumbleHeadless --interpolation-test [--latency MS] [--jitter MS] [--loss PERCENT] [--delay MS] ...
+//   NetRumbleHeadless --bundle-test [--players N] [--duration SECONDS]
+//   NetRumbleHeadless --loopback-test [--players N] [--latency MS] [--jitter MS] [--loss PERCENT]
+//                     [--reorder PERCENT] [--bandwidth BYTES/S] [--duration SECONDS]
+//   NetRumbleHeadless --rollback-test [--players N] [--latency MS] [--jitter MS] [--loss PERCENT]
+//                     [--rewind TICKS] [--duration SECONDS]
+//   NetRumbleHeadless --roster-benchmark [--players N] [--duration SECONDS]
+//   NetRumbleHeadless --timestep-benchmark [--players N] [--tickrate HZ] [--duration SECONDS]
+//   NetRumbleHeadless --collision-test [--seed N]
+//   NetRumbleHeadless --body-benchmark [--tickrate HZ] [--duration SECONDS] [--seed N]
+//   NetRumbleHeadless --firing-benchmark [--players N] [--tickrate HZ] [--duration SECONDS] [--seed N]
+//   NetRumbleHeadless --explosion-benchmark [--seed N]
+//   NetRumbleHeadless --broadphase-benchmark [--tickrate HZ] [--seed N]
+//   NetRumbleHeadless --ship-data-test [--players N] [--tickrate HZ] [--duration SECONDS] [--seed N]
+//   NetRumbleHeadless --bitbuffer-test
+//   NetRumbleHeadless --particle-benchmark [--tickrate HZ] [--seed N]
+//   NetRumbleHeadless --body-order-test
+//
+// By default every match is stepped as fast as the host allows, one after another, and
+// the run reports simulated ticks per second: a soak test of the authoritative world.
+// With --realtime each tick waits for its slot at the fixed tick rate, as a dedicated
+// server would run.
+//
+// --host runs all the matches at once in real time, sharded across one worker thread
+// per core, and reports how late their ticks started. --load-test repeats that for 1, 2,
+// 4, ... matches up to --matches, showing how tick jitter grows with the match count.
+//
+// --prediction-test flies one predicted ship between a client and a host over a link with
+// the given round trip latency and loss, and compares how far the prediction was off with
+// how far the ship would have jumped without it. It fails if prediction is not the better.
+//
+// --interpolation-test sends a remote ship's state over a link that also delays each packet
+// by a random amount, and measures how smoothly the receiver shows it: applying packets as
+// they arrive, then through the snapshot buffer at the ship data rate and at half of it. It
+// fails if the buffer at the full rate is not the smoother.
+//
+// --bundle-test plays one match for the given simulated duration and counts what the Steam
+// server would send its clients, relayed ShipInputs included, and what the clients would
+// send it: one transport message per game message, as it used to, against one bundle per
+// connection and delivery class per tick. It fails if bundling saves less than a datagram a
+// second per client either way.
+//
+// --loopback-test joins a host and its clients through a simulated LoopbackNetwork and
+// sends them a match's worth of traffic: ShipInput and ShipData unreliably, events reliably.
+// It reports what each kind of message lost and how late it arrived, and fails if any
+// reliable message went missing, arrived twice or arrived out of order.
+//
+// --rollback-test plays a match in rollback mode with every player its own peer, sending
+// only inputs over a LoopbackNetwork, and checks that all of them agree on every tick. It
+// then times rewinding and resimulating --rewind ticks before every tick of a second match,
+// and fails if any peer, or the rewound match, ends a tick in a different state, or if an
+// input packet averaged more than 16 bytes.
+//
+// --roster-benchmark times World::Update in a match of 16 simulated players unless --players
+// says otherwise, then times walking the players the way a frame does, through the game's
+// cached roster, against building the copy GetAllPlayerStates returns.
+//
+// --timestep-benchmark plays the same match at render rates from 30 to 240 frames a second,
+// first updating the world once per frame by the frame's length, then in fixed steps at
+// the tick rate through the client's SimulationClock. It reports how often and how far the
+// world stepped and what that cost per second of play, and fails if the fixed-step matches
+// did not all end in the same state.
+//
+// --collision-test checks the swept circle test projectiles collide with against placed
+// cases with known answers, then against a finely sampled reference for random shots at
+// tick rates from 60 Hz down to 10 Hz. It counts the hits the sweep and the older distance
+// test each miss or invent, times both, and fails if the sweep is ever wrong.
+//
+// --body-benchmark fills fields of 100, 1,000 and 10,000 drifting asteroids, each with the
+// same room, and times CollisionManager::Update on every tick: first walking the objects
+// themselves, then in passes over the BodyStore's arrays. It fails if either way lets an
+// asteroid out of its field.
+//
+// --firing-benchmark plays a minute of a match unless --duration says otherwise, in which
+// every ship fires its triple laser or, on every other ship, its rockets, and lays a mine as
+// often as the weapons allow. It counts
+// the heap allocations made while firing, first as the ships' projectile pools fill and then
+// once they have, and fails if firing still allocates for every shot after that or if no
+// rocket ever went back to its pool to be launched again.
+//
+// --explosion-benchmark lays 200 mines among asteroids and sets them off, all at once and
+// then one mine setting off the rest in a chain, and times the tick it happens in: with each
+// explosion blasting its surroundings as it goes off, then with CollisionManager resolving
+// them together a wave at a time. It fails if setting them all off left any mine standing.
+//
+// --broadphase-benchmark flies 10,000 laser bolts from four ships through a field of
+// asteroids and times CollisionManager::Update on every tick, first testing every pair of
+// objects and then only the pairs the spatial hash puts near each other. It fails if the
+// two ever differ in which objects touched on a tick or where anything ended up.
+//
+// --ship-data-test plays a match on a host and on a client beside it, and puts each kind
+// of per-tick message through a full round: ship data and world data from the host to
+// the client, and the first player's ShipInput from the client to the host. Each round
+// is written, laid out as a packet, read back with GameMessageView::FromPacket and
+// applied, counting the heap allocations on each side. It fails if any round allocated
+// after the first second of a match.
+//
+// --bitbuffer-test writes each kind of value the bit-packed messages carry and compares
+// the bytes with a golden encoding worked out by hand, then reads them back. It fails if
+// any encoding changed, any value reads back wrong, or reading past the end does not throw.
+//
+// --particle-benchmark builds each of the six particle effects with ten times its usual
+// particle counts and release rates, sets each off 20 times, and times every update until
+// it burns out. It reports the most particles each had alive at once, and fails if an
+// effect released none or was still going after being stopped.
+//
+// --body-order-test runs CollisionManager::Update over a few placed objects, once moving
+// them through the BodyStore's arrays and once walking the objects themselves. It fails
+// unless, in the BodyStore's update, a touch is found against where the objects started
+// the tick whatever their order in the collection, an object a touch adds during the
+// update only moves from the next one, and a rebound between unequal masses comes out as
+// the walk's does. What the walk did is shown alongside.
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "AllocationCounter.h"
+#include "CollisionTest.h"
+#include "InterpolationTest.h"
+#include "LaserProjectile.h"
+#include "LoopbackOnlineManager.h"
+#include "MatchHost.h"
+#include "MineProjectile.h"
+#include "PredictionTest.h"
+#include "RollbackTest.h"
+#include "SimulationClock.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <tuple>
+
+using namespace NetRumble;
+
+namespace
+{
+	enum class RunMode
+	{
+		Soak,
+		Host,
+		LoadTest,
+		PredictionTest,
+		InterpolationTest,
+		BundleTest,
+		LoopbackTest,
+		RollbackTest,
+		RosterBenchmark,
+		TimestepBenchmark,
+		CollisionTest,
+		BodyBenchmark,
+		FiringBenchmark,
+		ExplosionBenchmark,
+		BroadphaseBenchmark,
+		ShipDataTest,
+		BitBufferTest,
+		ParticleBenchmark,
+		BodyOrderTest
+	};
+
+	// Two ticks of header and each run of held input once; a packet resending every
+	// unacknowledged input whole would take several times this at a normal round trip
+	constexpr double c_rollbackTestInputBytesPerPacket = 16.0;
+
+	// More than a lobby holds, so the per-player work shows in the frame
+	constexpr uint32_t c_rosterBenchmarkPlayers = 16;
+
+	// Roster walks timed each way
+	constexpr uint32_t c_rosterWalks = 1000000;
+
+	// From a 30 Hz console up to a 240 Hz monitor
+	constexpr uint32_t c_timestepRenderRates[] = { 30, 60, 120, 144, 240 };
+
+	constexpr uint32_t c_bodyBenchmarkCounts[] = { 100, 1000, 10000 };
+
+	// Room each asteroid gets, so 100 of them fill a field about the size of a match's
+	constexpr float c_bodyBenchmarkAreaPerObject = 200.0f * 200.0f;
+
+	// Smaller than the game's asteroids, so a crowded field still has room to drift
+	constexpr float c_bodyBenchmarkRadiusMinimum = 8.0f;
+	constexpr float c_bodyBenchmarkRadiusMaximum = 24.0f;
+
+	constexpr double c_firingBenchmarkSeconds = 60.0;
+
+	// How long world data takes to reach a client, which acknowledges it on arrival
+	constexpr uint32_t c_bundleTestClientLatencyTicks = 2;
+	// Datagrams per second per client, in each direction
+	constexpr double c_bundleTestMinimumSaving = 1.0;
+
+	// As long as a mine lasts, the longest lived projectile, so every pool has seen its
+	// busiest moment by the end of it
+	constexpr double c_firingWarmupSeconds = 20.0;
+
+	constexpr uint32_t c_explosionBenchmarkMines = 200;
+	constexpr uint32_t c_explosionBenchmarkAsteroids = 100;
+	constexpr uint32_t c_explosionBenchmarkTrials = 50;
+
+	// Room each mine gets. A mine's blast finishes off another within about 75 units, so
+	// at this spacing most of a chain reaction reaches most of the field.
+	constexpr float c_explosionBenchmarkAreaPerMine = 60.0f * 60.0f;
+
+	constexpr uint32_t c_broadphaseBenchmarkProjectiles = 10000;
+	constexpr uint32_t c_broadphaseBenchmarkShips = 4;
+	constexpr uint32_t c_broadphaseBenchmarkAsteroids = 1000;
+
+	// Half a second at 60 Hz; testing every pair of 11,000 objects is slow
+	constexpr uint32_t c_broadphaseBenchmarkTicks = 30;
+
+	// Bounds for the position case, a different size each way
+	constexpr RECT c_bitBufferTestBounds = { 0, 0, 100, 50 };
+
+
+	// Each effect is set off this many times, and followed for long enough to burn out
+	constexpr uint32_t c_particleBenchmarkRuns = 20;
+	constexpr double c_particleBenchmarkSeconds = 8.0;
+	constexpr int c_particleBenchmarkScale = 10;
+
+
+	// --body-order-test: a field with room for what it places, and a tick at the default rate
+	constexpr RECT c_bodyOrderTestField = { 0, 0, 1000, 1000 };
+	constexpr float c_bodyOrderTestStep = 1.0f / 60.0f;
+
+
+	struct HeadlessSettings
+	{
+		RunMode Mode = RunMode::Soak;
+		uint32_t Matches = 8;
+		uint32_t Players = DEFAULT_PLAYERS_PER_SERVER;
+		uint32_t TicksPerSecond = 60;
+		uint64_t MaxTicksPerMatch = 60 * 60 * 5;
+		uint32_t Workers = std::max(std::thread::hardware_concurrency(), 1u);
+		double DurationSeconds = 10.0;
+		uint32_t LatencyMilliseconds = 150;
+		float LossPercent = 0.0f;
+		uint32_t JitterMilliseconds = 20;
+		float ReorderPercent = 0.0f;
+		uint32_t BandwidthBytesPerSecond = 0;
+		float InterpolationDelay = World::c_DefaultInterpolationDelay;
+		uint32_t RewindTicks = RollbackSession::c_maximumRollback;
+		uint32_t Seed = 1;
+		bool PinWorkers = true;
+		bool Realtime = false;
+		bool Verbose = false;
+	};
+
+	bool ParseCommandLine(int argc, char* argv[], HeadlessSettings& settings)
+	{
+		bool playersGiven = false;
+		bool durationGiven = false;
+		bool delayGiven = false;
+
+		for (int i = 1; i < argc; ++i)
+		{
+			const char* arg = argv[i];
+			const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+			if (strcmp(arg, "--host") == 0)
+			{
+				settings.Mode = RunMode::Host;
+			}
+			else if (strcmp(arg, "--load-test") == 0)
+			{
+				settings.Mode = RunMode::LoadTest;
+			}
+			else if (strcmp(arg, "--prediction-test") == 0)
+			{
+				settings.Mode = RunMode::PredictionTest;
+			}
+			else if (strcmp(arg, "--interpolation-test") == 0)
+			{
+				settings.Mode = RunMode::InterpolationTest;
+			}
+			else if (strcmp(arg, "--bundle-test") == 0)
+			{
+				settings.Mode = RunMode::BundleTest;
+			}
+			else if (strcmp(arg, "--loopback-test") == 0)
+			{
+				settings.Mode = RunMode::LoopbackTest;
+			}
+			else if (strcmp(arg, "--rollback-test") == 0)
+			{
+				settings.Mode = RunMode::RollbackTest;
+			}
+			else if (strcmp(arg, "--roster-benchmark") == 0)
+			{
+				settings.Mode = RunMode::RosterBenchmark;
+			}
+			else if (strcmp(arg, "--timestep-benchmark") == 0)
+			{
+				settings.Mode = RunMode::TimestepBenchmark;
+			}
+			else if (strcmp(arg, "--collision-test") == 0)
+			{
+				settings.Mode = RunMode::CollisionTest;
+			}
+			else if (strcmp(arg, "--body-benchmark") == 0)
+			{
+				settings.Mode = RunMode::BodyBenchmark;
+			}
+			else if (strcmp(arg, "--firing-benchmark") == 0)
+			{
+				settings.Mode = RunMode::FiringBenchmark;
+			}
+			else if (strcmp(arg, "--explosion-benchmark") == 0)
+			{
+				settings.Mode = RunMode::ExplosionBenchmark;
+			}
+			else if (strcmp(arg, "--broadphase-benchmark") == 0)
+			{
+				settings.Mode = RunMode::BroadphaseBenchmark;
+			}
+			else if (strcmp(arg, "--ship-data-test") == 0)
+			{
+				settings.Mode = RunMode::ShipDataTest;
+			}
+			else if (strcmp(arg, "--bitbuffer-test") == 0)
+			{
+				settings.Mode = RunMode::BitBufferTest;
+			}
+			else if (strcmp(arg, "--particle-benchmark") == 0)
+			{
+				settings.Mode = RunMode::ParticleBenchmark;
+			}
+			else if (strcmp(arg, "--body-order-test") == 0)
+			{
+				settings.Mode = RunMode::BodyOrderTest;
+			}
+			else if (strcmp(arg, "--realtime") == 0)
+			{
+				settings.Realtime = true;
+			}
+			else if (strcmp(arg, "--no-pin") == 0)
+			{
+				settings.PinWorkers = false;
+			}
+			else if (strcmp(arg, "--verbose") == 0)
+			{
+				settings.Verbose = true;
+			}
+			else if (value && strcmp(arg, "--matches") == 0)
+			{
+				settings.Matches = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				++i;
+			}
+			else if (value && strcmp(arg, "--players") == 0)
+			{
+				settings.Players = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				playersGiven = true;
+				++i;
+			}
+			else if (value && strcmp(arg, "--tickrate") == 0)
+			{
+				settings.TicksPerSecond = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				++i;
+			}
+			else if (value && strcmp(arg, "--max-ticks") == 0)
+			{
+				settings.MaxTicksPerMatch = strtoull(value, nullptr, 10);
+				++i;
+			}
+			else if (value && strcmp(arg, "--workers") == 0)
+			{
+				settings.Workers = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				++i;
+			}
+			else if (value && strcmp(arg, "--duration") == 0)
+			{
+				settings.DurationSeconds = strtod(value, nullptr);
+				durationGiven = true;
+				++i;
+			}
+			else if (value && strcmp(arg, "--latency") == 0)
+			{
+				settings.LatencyMilliseconds = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				++i;
+			}
+			else if (value && strcmp(arg, "--loss") == 0)
+			{
+				settings.LossPercent = strtof(value, nullptr);
+				++i;
+			}
+			else if (value && strcmp(arg, "--jitter") == 0)
+			{
+				settings.JitterMilliseconds = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				++i;
+			}
+			else if (value && strcmp(arg, "--reorder") == 0)
+			{
+				settings.ReorderPercent = strtof(value, nullptr);
+				++i;
+			}
+			else if (value && strcmp(arg, "--bandwidth") == 0)
+			{
+				settings.BandwidthBytesPerSecond = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				++i;
+			}
+			else if (value && strcmp(arg, "--delay") == 0)
+			{
+				settings.InterpolationDelay = strtof(value, nullptr) * 0.001f;
+				delayGiven = true;
+				++i;
+			}
+			else if (value && strcmp(arg, "--rewind") == 0)
+			{
+				settings.RewindTicks = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				++i;
+			}
+			else if (value && strcmp(arg, "--seed") == 0)
+			{
+				settings.Seed = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+				++i;
+			}
+			else
+			{
+				fprintf(stderr, "Unknown or incomplete argument: %s\n", arg);
+				return false;
+			}
+		}
+
+		if (settings.Mode == RunMode::RosterBenchmark && !playersGiven)
+		{
+			settings.Players = c_rosterBenchmarkPlayers;
+		}
+
+		if (settings.Mode == RunMode::FiringBenchmark && !durationGiven)
+		{
+			settings.DurationSeconds = c_firingBenchmarkSeconds;
+		}
+
+		if (settings.Players < 2 || settings.Players > MAX_SERVER_SLOTS || settings.TicksPerSecond == 0 || settings.MaxTicksPerMatch == 0)
+		{
+			fprintf(stderr, "Need two to %u players, a tick rate and a tick limit\n", MAX_SERVER_SLOTS);
+			return false;
+		}
+
+		if (settings.Matches == 0 || settings.Workers == 0 || settings.DurationSeconds <= 0.0)
+		{
+			fprintf(stderr, "Need at least one match, one worker and a duration\n");
+			return false;
+		}
+
+		if (!delayGiven)
+		{
+			settings.InterpolationDelay = World::InterpolationDelay(settings.TicksPerSecond);
+		}
+
+		return true;
+	}
+
+	float AverageMilliseconds(const FrameScheduler& scheduler, std::string_view name)
+	{
+		for (const auto& timing : scheduler.GetTimings())
+		{
+			if (timing.Name == name)
+			{
+				return timing.AverageMilliseconds;
+			}
+		}
+
+		return 0.0f;
+	}
+
+	// Sorts the samples in place
+	float Percentile(std::vector<float>& samples, float fraction)
+	{
+		if (samples.empty())
+		{
+			return 0.0f;
+		}
+
+		size_t index = std::min(samples.size() - 1, static_cast<size_t>(fraction * samples.size()));
+		std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+		return samples[index];
+	}
+
+	// Matches one after another on this thread, as fast as possible unless --realtime
+	void RunSoak(const HeadlessSettings& settings)
+	{
+		RandomMath::Seed(settings.Seed);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		for (uint32_t i = 0; i < settings.Players; ++i)
+		{
+			game->AddSimulatedPlayer("Bot " + std::to_string(i + 1));
+		}
+
+		HeadlessOnlineManager* onlineManager = Managers::Get<OnlineManager>();
+		auto tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(game->GetTickSeconds()));
+
+		uint64_t totalTicks = 0;
+		uint64_t totalBytes = 0;
+		auto runStart = std::chrono::steady_clock::now();
+
+		for (uint32_t match = 0; match < settings.Matches; ++match)
+		{
+			onlineManager->ResetCounters();
+			game->StartMatch();
+
+			auto matchStart = std::chrono::steady_clock::now();
+			auto nextTick = matchStart;
+
+			while (!game->IsMatchOver() && game->GetMatchTickCount() < settings.MaxTicksPerMatch)
+			{
+				if (settings.Realtime)
+				{
+					nextTick += tickDuration;
+					std::this_thread::sleep_until(nextTick);
+				}
+
+				game->Tick();
+			}
+
+			std::chrono::duration<double> matchTime = std::chrono::steady_clock::now() - matchStart;
+			uint64_t matchTicks = game->GetMatchTickCount();
+			totalTicks += matchTicks;
+			totalBytes += onlineManager->GetBytesSent();
+
+			printf("match %u: %llu ticks (%.1f s simulated) in %.3f s, %.0f ticks/s, %s, %llu messages, %llu bytes\n",
+				match + 1,
+				static_cast<unsigned long long>(matchTicks),
+				static_cast<double>(matchTicks) * game->GetTickSeconds(),
+				matchTime.count(),
+				matchTime.count() > 0.0 ? static_cast<double>(matchTicks) / matchTime.count() : 0.0,
+				game->IsMatchOver() ? ("won by " + std::string(game->GetWinnerName())).c_str() : "tick limit reached",
+				static_cast<unsigned long long>(onlineManager->GetMessagesSent()),
+				static_cast<unsigned long long>(onlineManager->GetBytesSent()));
+		}
+
+		std::chrono::duration<double> runTime = std::chrono::steady_clock::now() - runStart;
+		double ticksPerSecond = runTime.count() > 0.0 ? static_cast<double>(totalTicks) / runTime.count() : 0.0;
+
+		printf("%u matches, %u players, %u Hz: %llu ticks in %.3f s = %.0f ticks/s (%.1fx realtime per match)\n",
+			settings.Matches,
+			settings.Players,
+			settings.TicksPerSecond,
+			static_cast<unsigned long long>(totalTicks),
+			runTime.count(),
+			ticksPerSecond,
+			ticksPerSecond / settings.TicksPerSecond);
+		printf("average tick: world %.3f ms, collision %.3f ms; %.0f bytes/s of match traffic\n",
+			AverageMilliseconds(game->GetScheduler(), "World"),
+			AverageMilliseconds(game->GetScheduler(), "Collision"),
+			totalTicks > 0 ? static_cast<double>(totalBytes) / (static_cast<double>(totalTicks) * game->GetTickSeconds()) : 0.0);
+	}
+
+	// All matches at once in real time; prints one row of the jitter table
+	void RunHosted(const HeadlessSettings& settings, uint32_t matches)
+	{
+		MatchHost::Settings hostSettings;
+		hostSettings.Matches = matches;
+		hostSettings.PlayersPerMatch = settings.Players;
+		hostSettings.TicksPerSecond = settings.TicksPerSecond;
+		hostSettings.Workers = settings.Workers;
+		hostSettings.Seed = settings.Seed;
+		hostSettings.PinWorkers = settings.PinWorkers;
+
+		MatchHost host(hostSettings);
+		host.Run(std::chrono::duration<double>(settings.DurationSeconds));
+
+		std::vector<float> allJitter;
+		std::vector<float> matchJitter;
+		float worstMatchP99 = 0.0f;
+		double tickMilliseconds = 0.0;
+		uint64_t ticks = 0;
+		uint32_t completed = 0;
+
+		for (const MatchHost::MatchReport& report : host.GetReports())
+		{
+			allJitter.insert(allJitter.end(), report.JitterMilliseconds.begin(), report.JitterMilliseconds.end());
+
+			matchJitter = report.JitterMilliseconds;
+			worstMatchP99 = std::max(worstMatchP99, Percentile(matchJitter, 0.99f));
+
+			tickMilliseconds += report.AverageTickMilliseconds;
+			ticks += report.Ticks;
+			completed += report.MatchesCompleted;
+		}
+
+		float maxJitter = allJitter.empty() ? 0.0f : *std::max_element(allJitter.begin(), allJitter.end());
+		uint64_t expectedTicks = static_cast<uint64_t>(settings.DurationSeconds * settings.TicksPerSecond) * matches;
+
+		printf("%7u %7u %9.3f %9.3f %9.3f %9.3f %9.3f %8.1f%% %8llu %6u\n",
+			matches,
+			host.GetSettings().Workers,
+			tickMilliseconds / matches,
+			Percentile(allJitter, 0.5f),
+			Percentile(allJitter, 0.99f),
+			maxJitter,
+			worstMatchP99,
+			expectedTicks > 0 ? 100.0 * static_cast<double>(ticks) / static_cast<double>(expectedTicks) : 0.0,
+			static_cast<unsigned long long>(host.GetOverruns()),
+			completed);
+	}
+
+	void PrintDistances(const char* name, std::vector<float>& distances)
+	{
+		double total = 0.0;
+		for (float distance : distances)
+		{
+			total += distance;
+		}
+
+		float maxDistance = distances.empty() ? 0.0f : *std::max_element(distances.begin(), distances.end());
+
+		printf("%-24s %9.2f %9.2f %9.2f %9.2f\n",
+			name,
+			distances.empty() ? 0.0 : total / distances.size(),
+			Percentile(distances, 0.5f),
+			Percentile(distances, 0.99f),
+			maxDistance);
+	}
+
+	// Returns false if predicting the ship did not beat taking the host's state as it arrives
+	bool RunPredictionTest(const HeadlessSettings& settings)
+	{
+		PredictionTest::Settings testSettings;
+		testSettings.LatencyMilliseconds = settings.LatencyMilliseconds;
+		testSettings.LossPercent = settings.LossPercent;
+		testSettings.TicksPerSecond = settings.TicksPerSecond;
+		testSettings.DurationSeconds = settings.DurationSeconds;
+		testSettings.Seed = settings.Seed;
+
+		PredictionTest test(testSettings);
+		PredictionTest::Report report = test.Run();
+
+		printf("%u ms round trip, %.1f%% loss, %u Hz, %.0f s: %u corrections\n",
+			settings.LatencyMilliseconds,
+			settings.LossPercent,
+			settings.TicksPerSecond,
+			settings.DurationSeconds,
+			report.Corrections);
+		printf("distance in pixels            mean       p50       p99       max\n");
+		PrintDistances("predicted vs host", report.PredictionErrors);
+		PrintDistances("unpredicted (snap)", report.SnapDistances);
+		printf("ShipInput %.0f bytes/s, ServerUpdateShipData %.0f bytes/s\n",
+			static_cast<double>(report.BytesUp) / settings.DurationSeconds,
+			static_cast<double>(report.BytesDown) / settings.DurationSeconds);
+
+		return report.Corrections > 0 && Percentile(report.PredictionErrors, 0.99f) < Percentile(report.SnapDistances, 0.99f);
+	}
+
+	// Returns false if the snapshot buffer did not show the ship more smoothly than applying packets as they arrive
+	bool RunInterpolationTest(const HeadlessSettings& settings)
+	{
+		struct Configuration
+		{
+			const char* Name;
+			bool Buffered;
+			uint32_t UpdatesBetweenPackets;
+		};
+
+		const Configuration configurations[] =
+		{
+			{ "as they arrive", false, World::c_UpdatesBetweenShipDataPackets },
+			{ "snapshot buffer", true, World::c_UpdatesBetweenShipDataPackets },
+			{ "snapshot buffer", true, World::c_UpdatesBetweenShipDataPackets * 2 },
+		};
+
+		printf("%u ms round trip, +/-%u ms jitter, %.1f%% loss, %.0f ms interpolation delay, %u Hz, %.0f s\n",
+			settings.LatencyMilliseconds,
+			settings.JitterMilliseconds,
+			settings.LossPercent,
+			settings.InterpolationDelay * 1000.0f,
+			settings.TicksPerSecond,
+			settings.DurationSeconds);
+		printf("jitter is the change in the shown ship's step from one frame to the next, in pixels\n");
+		printf("receiver          send Hz  jitter mean   p50       p99       max  reversals  stale\n");
+
+		float p99[std::size(configurations)] = {};
+		for (size_t i = 0; i < std::size(configurations); ++i)
+		{
+			InterpolationTest::Settings testSettings;
+			testSettings.LatencyMilliseconds = settings.LatencyMilliseconds;
+			testSettings.JitterMilliseconds = settings.JitterMilliseconds;
+			testSettings.LossPercent = settings.LossPercent;
+			testSettings.TicksPerSecond = settings.TicksPerSecond;
+			testSettings.UpdatesBetweenPackets = configurations[i].UpdatesBetweenPackets;
+			testSettings.InterpolationDelay = settings.InterpolationDelay;
+			testSettings.Buffered = configurations[i].Buffered;
+			testSettings.DurationSeconds = settings.DurationSeconds;
+			testSettings.Seed = settings.Seed;
+
+			InterpolationTest test(testSettings);
+			InterpolationTest::Report report = test.Run();
+
+			double total = 0.0;
+			for (float jitter : report.Jitter)
+			{
+				total += jitter;
+			}
+			float maxJitter = report.Jitter.empty() ? 0.0f : *std::max_element(report.Jitter.begin(), report.Jitter.end());
+			p99[i] = Percentile(report.Jitter, 0.99f);
+
+			printf("%-16s %8.1f %11.3f %9.3f %9.3f %9.3f %10u %6u\n",
+				configurations[i].Name,
+				static_cast<double>(settings.TicksPerSecond) / configurations[i].UpdatesBetweenPackets,
+				report.Jitter.empty() ? 0.0 : total / report.Jitter.size(),
+				Percentile(report.Jitter, 0.5f),
+				p99[i],
+				maxJitter,
+				report.Reversals,
+				report.PacketsStale);
+		}
+
+		return p99[1] < p99[0];
+	}
+
+	// Returns false if bundling did not save datagrams every second, to the clients or from them
+	bool RunBundleTest(const HeadlessSettings& settings)
+	{
+		// IPv4 and UDP headers on every datagram; the transport's own header comes on top,
+		// so the saving printed is a lower bound
+		constexpr uint64_t c_datagramHeaderBytes = 28;
+		constexpr uint32_t c_inputInterval = World::c_UpdatesBetweenShipInputPackets;
+
+		RandomMath::Seed(settings.Seed);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		for (uint32_t i = 0; i < settings.Players; ++i)
+		{
+			game->AddSimulatedPlayer("Bot " + std::to_string(i + 1));
+		}
+
+		HeadlessOnlineManager* onlineManager = Managers::Get<OnlineManager>();
+		onlineManager->ResetCounters();
+
+		// What the clients send the server, one bundle per client connection and delivery class
+		MessageBundler clientBundler([](uint64_t, int, DataBufferView) {});
+		std::vector<uint8_t> packet;
+		BitBufferWriter inputWriter;
+		// Ticks on which world data reaches the clients, each of which acknowledges it
+		std::deque<uint64_t> worldDataArrivals;
+		uint32_t worldDataSequence = 0;
+
+		// Lays out a client's packet as SerializeWithSourceIDTo does for its own player
+		auto ClientPacket = [&](uint64_t sourceID, const GameMessageView& message)
+		{
+			const GameMessageType type = message.MessageType();
+			packet.assign(MsgTypeSize + sizeof(sourceID), 0);
+			memcpy(packet.data(), &type, MsgTypeSize);
+			memcpy(packet.data() + MsgTypeSize, &sourceID, sizeof(sourceID));
+			packet.insert(packet.end(), message.RawData().begin(), message.RawData().end());
+			return DataBufferView(packet);
+		};
+
+		const uint64_t ticks = static_cast<uint64_t>(settings.DurationSeconds * settings.TicksPerSecond);
+		game->StartMatch();
+		for (uint64_t tick = 0; tick < ticks; ++tick)
+		{
+			if (game->IsMatchOver())
+			{
+				game->StartMatch();
+			}
+
+			const bool worldDataArrived = !worldDataArrivals.empty() && worldDataArrivals.front() == tick;
+			if (worldDataArrived)
+			{
+				worldDataArrivals.pop_front();
+				worldDataSequence++;
+			}
+
+			// Each client's sends land on the server before the host's tick, which relays its
+			// ShipInput to everyone else. The clients take turns through the input interval, as
+			// evenly as there are steps for them, so inputs share a bundle only where they must.
+			uint32_t client = 0;
+			for (PlayerState* playerState : game->GetPlayers())
+			{
+				const int sendFlags = k_nSteamNetworkingSend_Unreliable;
+				const std::shared_ptr<Ship>& ship = playerState->GetShip();
+				if ((tick + client++) % c_inputInterval == 0 && ship && ship->Active())
+				{
+					inputWriter.Reset();
+					ship->SerializeMoves(inputWriter);
+					GameMessageView input(GameMessageType::ShipInput, inputWriter.View());
+					clientBundler.Queue(playerState->PeerId, sendFlags, ClientPacket(playerState->PeerId, input));
+					onlineManager->RelayGameMessage(playerState->PeerId, input);
+				}
+
+				if (worldDataArrived)
+				{
+					GameMessageView ack(
+						GameMessageType::WorldDataAck,
+						DataBufferView(reinterpret_cast<const uint8_t*>(&worldDataSequence), sizeof(worldDataSequence)));
+					clientBundler.Queue(playerState->PeerId, sendFlags, ClientPacket(playerState->PeerId, ack));
+				}
+			}
+			clientBundler.Flush();
+
+			const uint64_t worldDataSent = onlineManager->GetMessagesSent(GameMessageType::ServerUpdateWorldData);
+			game->Tick();
+			if (onlineManager->GetMessagesSent(GameMessageType::ServerUpdateWorldData) != worldDataSent)
+			{
+				worldDataArrivals.push_back(tick + c_bundleTestClientLatencyTicks);
+			}
+		}
+
+		const double seconds = static_cast<double>(ticks) / settings.TicksPerSecond;
+		printf("%u players, %u Hz, %.0f s simulated, %llu header bytes per datagram\n",
+			settings.Players,
+			settings.TicksPerSecond,
+			seconds,
+			static_cast<unsigned long long>(c_datagramHeaderBytes));
+		printf("%-18s %-18s %10s %11s %14s\n", "direction", "sending", "packets/s", "per client", "bytes saved/s");
+
+		// Datagrams saved per second per client
+		auto Report = [&](const char* direction, const MessageBundler::Counters& counters)
+		{
+			const double datagramBytesSaved = static_cast<double>((counters.Packets - counters.Sends) * c_datagramHeaderBytes);
+			const double bytesSaved = (datagramBytesSaved - static_cast<double>(counters.FramingBytes)) / seconds;
+			const double packetsPerSecond = static_cast<double>(counters.Packets) / seconds;
+			const double sendsPerSecond = static_cast<double>(counters.Sends) / seconds;
+
+			printf("%-18s %-18s %10.1f %11.1f\n", direction, "one per message", packetsPerSecond, packetsPerSecond / settings.Players);
+			printf("%-18s %-18s %10.1f %11.1f %14.0f\n", direction, "bundled per tick", sendsPerSecond, sendsPerSecond / settings.Players, bytesSaved);
+			return (packetsPerSecond - sendsPerSecond) / settings.Players;
+		};
+
+		const double toClients = Report("server to clients", onlineManager->GetBundleCounters());
+		const double toServer = Report("clients to server", clientBundler.GetCounters());
+		printf("datagrams saved per client per second: %.1f to the clients, %.1f to the server, at least %.1f needed\n",
+			toClients,
+			toServer,
+			c_bundleTestMinimumSaving);
+
+		return toClients >= c_bundleTestMinimumSaving && toServer >= c_bundleTestMinimumSaving;
+	}
+
+	// Returns false if a reliable message went missing, arrived twice or arrived out of order
+	bool RunLoopbackTest(const HeadlessSettings& settings)
+	{
+		// Ship deaths, power-up spawns and the like, per second across the match
+		constexpr float c_eventsPerSecond = 2.0f;
+		// Long enough for the last resends to land
+		constexpr double c_drainSeconds = 5.0;
+
+		// Every message starts with its place in its sender's stream and when it was sent
+		struct Probe
+		{
+			uint32_t Sequence;
+			double SentAt;
+		};
+
+		struct Traffic
+		{
+			const char* Name;
+			GameMessageType Type;
+			// Payload after the probe
+			size_t PaddingBytes;
+			uint64_t Sent = 0;
+			uint64_t Delivered = 0;
+			std::vector<float> LatencyMilliseconds = {};
+		};
+
+		Traffic traffic[] =
+		{
+			{ "ShipInput", GameMessageType::ShipInput, 8 },
+			{ "ShipData", GameMessageType::ShipData, 24 * settings.Players },
+			{ "events", GameMessageType::ShipDeath, 16 },
+		};
+
+		LoopbackNetwork::Settings networkSettings;
+		networkSettings.LatencyMilliseconds = settings.LatencyMilliseconds;
+		networkSettings.JitterMilliseconds = settings.JitterMilliseconds;
+		networkSettings.LossPercent = settings.LossPercent;
+		networkSettings.ReorderPercent = settings.ReorderPercent;
+		networkSettings.BandwidthBytesPerSecond = settings.BandwidthBytesPerSecond;
+		networkSettings.Seed = settings.Seed;
+
+		LoopbackNetwork network(networkSettings);
+		std::vector<std::unique_ptr<LoopbackOnlineManager>> instances;
+		for (uint32_t i = 0; i < settings.Players; ++i)
+		{
+			instances.push_back(std::make_unique<LoopbackOnlineManager>(network, i == 0));
+		}
+
+		// Keyed by sender and message type, and for receiving by the receiver as well
+		std::map<std::pair<uint64_t, GameMessageType>, uint32_t> nextToSend;
+		std::map<std::tuple<uint64_t, uint64_t, GameMessageType>, uint32_t> nextReliable;
+		uint64_t reliableFaults = 0;
+
+		for (auto& instance : instances)
+		{
+			const uint64_t receiver = instance->GetNetworkId();
+			instance->RegisterOnlineMessageHandler([&, receiver](uint64_t sender, const GameMessageView& message)
+				{
+					Probe probe = {};
+					if (message.RawData().size() < sizeof(probe))
+					{
+						reliableFaults++;
+						return;
+					}
+					memcpy(&probe, message.RawData().data(), sizeof(probe));
+
+					for (Traffic& kind : traffic)
+					{
+						if (kind.Type == message.MessageType())
+						{
+							kind.Delivered++;
+							kind.LatencyMilliseconds.push_back(static_cast<float>((network.Now() - probe.SentAt) * 1000.0));
+						}
+					}
+
+					if (LoopbackOnlineManager::DeliveryFor(message.MessageType()) == LoopbackNetwork::Delivery::Reliable)
+					{
+						uint32_t& expected = nextReliable[{ receiver, sender, message.MessageType() }];
+						if (probe.Sequence != expected)
+						{
+							reliableFaults++;
+						}
+						expected = probe.Sequence + 1;
+					}
+				});
+		}
+
+		std::vector<uint8_t> payload;
+		auto send = [&](LoopbackOnlineManager& instance, Traffic& kind)
+			{
+				Probe probe = { nextToSend[{ instance.GetNetworkId(), kind.Type }]++, network.Now() };
+				payload.assign(sizeof(probe) + kind.PaddingBytes, 0);
+				memcpy(payload.data(), &probe, sizeof(probe));
+
+				instance.SendGameMessage(GameMessageView(kind.Type, payload));
+				kind.Sent += settings.Players - 1;
+			};
+
+		std::minstd_rand random(settings.Seed);
+		std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+		const double tickSeconds = 1.0 / settings.TicksPerSecond;
+		const uint64_t ticks = static_cast<uint64_t>(settings.DurationSeconds * settings.TicksPerSecond);
+		const uint64_t drainTicks = static_cast<uint64_t>(c_drainSeconds * settings.TicksPerSecond);
+		// As World sends ShipInput
+		const uint32_t inputTicks = World::c_UpdatesBetweenShipInputPackets;
+
+		auto runStart = std::chrono::steady_clock::now();
+
+		for (uint64_t tick = 0; tick < ticks + drainTicks; ++tick)
+		{
+			network.Advance(tickSeconds);
+
+			for (auto& instance : instances)
+			{
+				instance->Tick(static_cast<float>(tickSeconds));
+			}
+
+			if (tick >= ticks)
+			{
+				continue;
+			}
+
+			for (size_t i = 1; i < instances.size(); ++i)
+			{
+				if (tick % inputTicks == 0)
+				{
+					send(*instances[i], traffic[0]);
+				}
+			}
+
+			if (tick % World::c_UpdatesBetweenShipDataPackets == 0)
+			{
+				send(*instances[0], traffic[1]);
+			}
+
+			if (unit(random) < c_eventsPerSecond * tickSeconds)
+			{
+				send(*instances[0], traffic[2]);
+			}
+		}
+
+		std::chrono::duration<double> runTime = std::chrono::steady_clock::now() - runStart;
+		const LoopbackNetwork::Counters& counters = network.GetCounters();
+
+		printf("%u endpoints, %u ms round trip, +/-%u ms jitter, %.1f%% loss, %.1f%% reorder, %s, %.0f s\n",
+			settings.Players,
+			settings.LatencyMilliseconds,
+			settings.JitterMilliseconds,
+			settings.LossPercent,
+			settings.ReorderPercent,
+			settings.BandwidthBytesPerSecond > 0 ? (std::to_string(settings.BandwidthBytesPerSecond) + " bytes/s per link").c_str() : "unlimited bandwidth",
+			settings.DurationSeconds);
+		printf("message             sent  delivered   lost%%  latency ms p50       p99       max\n");
+		for (Traffic& kind : traffic)
+		{
+			float maxLatency = kind.LatencyMilliseconds.empty() ? 0.0f : *std::max_element(kind.LatencyMilliseconds.begin(), kind.LatencyMilliseconds.end());
+
+			printf("%-12s %11llu %10llu %7.2f %20.1f %9.1f %9.1f\n",
+				kind.Name,
+				static_cast<unsigned long long>(kind.Sent),
+				static_cast<unsigned long long>(kind.Delivered),
+				kind.Sent > 0 ? 100.0 * static_cast<double>(kind.Sent - std::min(kind.Delivered, kind.Sent)) / static_cast<double>(kind.Sent) : 0.0,
+				Percentile(kind.LatencyMilliseconds, 0.5f),
+				Percentile(kind.LatencyMilliseconds, 0.99f),
+				maxLatency);
+		}
+		printf("network: %llu lost, %llu dropped by the bandwidth cap, %llu reordered, %llu resends; %.0f bytes/s per endpoint\n",
+			static_cast<unsigned long long>(counters.Lost),
+			static_cast<unsigned long long>(counters.Dropped),
+			static_cast<unsigned long long>(counters.Reordered),
+			static_cast<unsigned long long>(counters.Resends),
+			static_cast<double>(counters.BytesDelivered) / settings.DurationSeconds / settings.Players);
+		printf("simulated in %.3f s, %.0f messages/s; %llu reliable faults\n",
+			runTime.count(),
+			runTime.count() > 0.0 ? static_cast<double>(counters.Sent) / runTime.count() : 0.0,
+			static_cast<unsigned long long>(reliableFaults));
+
+		return reliableFaults == 0 && traffic[2].Delivered == traffic[2].Sent;
+	}
+
+	void PrintMicroseconds(const char* name, std::vector<float>& samples)
+	{
+		double total = 0.0;
+		for (float sample : samples)
+		{
+			total += sample;
+		}
+		float maxSample = samples.empty() ? 0.0f : *std::max_element(samples.begin(), samples.end());
+
+		printf("%-24s %9.1f %9.1f %9.1f %9.1f\n",
+			name,
+			samples.empty() ? 0.0 : total / samples.size(),
+			Percentile(samples, 0.5f),
+			Percentile(samples, 0.99f),
+			maxSample);
+	}
+
+	// Returns false if the peers, or the rewound match and the straight one, disagreed on any tick
+	bool RunRollbackTest(const HeadlessSettings& settings)
+	{
+		RollbackTest::Settings testSettings;
+		testSettings.Players = settings.Players;
+		testSettings.LatencyMilliseconds = settings.LatencyMilliseconds;
+		testSettings.JitterMilliseconds = settings.JitterMilliseconds;
+		testSettings.LossPercent = settings.LossPercent;
+		testSettings.TicksPerSecond = settings.TicksPerSecond;
+		testSettings.DurationSeconds = settings.DurationSeconds;
+		testSettings.RewindTicks = settings.RewindTicks;
+		testSettings.Seed = settings.Seed;
+
+		RollbackTest test(testSettings);
+		RollbackTest::Report report = test.Run();
+
+		const RollbackSession::Statistics& sessions = report.Sessions;
+		const double ticks = static_cast<double>(std::max<uint64_t>(sessions.Ticks, 1));
+
+		printf("%u peers, %u ms round trip, +/-%u ms jitter, %.1f%% loss, %u Hz, %.0f s\n",
+			settings.Players,
+			settings.LatencyMilliseconds,
+			settings.JitterMilliseconds,
+			settings.LossPercent,
+			settings.TicksPerSecond,
+			settings.DurationSeconds);
+		printf("%llu ticks: %llu stalls, %llu mispredictions, %llu rollbacks of %.1f ticks on average, longest %u\n",
+			static_cast<unsigned long long>(sessions.Ticks),
+			static_cast<unsigned long long>(sessions.Stalls),
+			static_cast<unsigned long long>(sessions.Mispredictions),
+			static_cast<unsigned long long>(sessions.Rollbacks),
+			sessions.Rollbacks > 0 ? static_cast<double>(sessions.ResimulatedTicks) / sessions.Rollbacks : 0.0,
+			sessions.LongestRollback);
+		printf("per tick: save %.1f us, restore %.1f us, resimulate %.1f us\n",
+			sessions.SaveSeconds * 1.0e6 / ticks,
+			sessions.RestoreSeconds * 1.0e6 / ticks,
+			sessions.ResimulateSeconds * 1.0e6 / ticks);
+		const double inputBytesPerPacket = report.InputPackets > 0 ? static_cast<double>(report.InputBytes) / report.InputPackets : 0.0;
+		printf("input: %.1f bytes per packet, at most %.1f, %.1f bytes per player per tick sent to each peer\n",
+			inputBytesPerPacket,
+			c_rollbackTestInputBytesPerPacket,
+			static_cast<double>(report.InputBytes) / ticks / std::max<uint32_t>(settings.Players - 1, 1));
+		printf("%llu settled ticks compared, %llu desyncs\n",
+			static_cast<unsigned long long>(report.ComparedTicks),
+			static_cast<unsigned long long>(report.Desyncs));
+
+		printf("rewinding %u ticks before every tick:\n", settings.RewindTicks);
+		printf("microseconds                  mean       p50       p99       max\n");
+		PrintMicroseconds("tick without a rewind", report.TickMicroseconds);
+		PrintMicroseconds("save", report.SaveMicroseconds);
+		PrintMicroseconds("restore", report.RestoreMicroseconds);
+		PrintMicroseconds("resimulate", report.ResimulateMicroseconds);
+		printf("%llu ticks differed from the match that was never rewound\n",
+			static_cast<unsigned long long>(report.RewindDesyncs));
+
+		return report.ComparedTicks > 0 && report.Desyncs == 0 && report.RewindDesyncs == 0 &&
+			inputBytesPerPacket <= c_rollbackTestInputBytesPerPacket;
+	}
+
+	// Returns false if the two ways of walking the players disagreed on who is in game
+	bool RunRosterBenchmark(const HeadlessSettings& settings)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		RandomMath::Seed(settings.Seed);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		for (uint32_t i = 0; i < settings.Players; ++i)
+		{
+			game->AddSimulatedPlayer("Bot " + std::to_string(i + 1));
+		}
+
+		const uint64_t ticks = static_cast<uint64_t>(settings.DurationSeconds * settings.TicksPerSecond);
+		std::vector<float> tickMicroseconds;
+		tickMicroseconds.reserve(static_cast<size_t>(ticks));
+
+		game->StartMatch();
+		for (uint64_t tick = 0; tick < ticks; ++tick)
+		{
+			if (game->IsMatchOver())
+			{
+				game->StartMatch();
+			}
+
+			const Clock::time_point begin = Clock::now();
+			game->Tick();
+			tickMicroseconds.push_back(std::chrono::duration<float, std::micro>(Clock::now() - begin).count());
+		}
+
+		// Both walks count the players in game, as most of World::Update's walks test InGame first
+		uint64_t copiedInGame = 0;
+		Clock::time_point begin = Clock::now();
+		for (uint32_t walk = 0; walk < c_rosterWalks; ++walk)
+		{
+			for (const auto& playerState : game->GetAllPlayerStates())
+			{
+				copiedInGame += playerState->InGame ? 1 : 0;
+			}
+		}
+		const double copyNanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / c_rosterWalks;
+
+		uint64_t viewedInGame = 0;
+		begin = Clock::now();
+		for (uint32_t walk = 0; walk < c_rosterWalks; ++walk)
+		{
+			for (PlayerState* playerState : game->GetPlayers())
+			{
+				viewedInGame += playerState->InGame ? 1 : 0;
+			}
+		}
+		const double viewNanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / c_rosterWalks;
+
+		printf("%u players, %u Hz, %llu ticks, World::Update %.3f ms and collision %.3f ms on average\n",
+			settings.Players,
+			settings.TicksPerSecond,
+			static_cast<unsigned long long>(ticks),
+			AverageMilliseconds(game->GetScheduler(), "World"),
+			AverageMilliseconds(game->GetScheduler(), "Collision"));
+		printf("microseconds                  mean       p50       p99       max\n");
+		PrintMicroseconds("tick", tickMicroseconds);
+		printf("walking %u players: %.1f ns through a copy, %.1f ns through the roster\n",
+			settings.Players,
+			copyNanoseconds,
+			viewNanoseconds);
+
+		return copiedInGame == viewedInGame;
+	}
+
+	struct TimestepRun
+	{
+		uint64_t Updates = 0;
+		double Seconds = 0.0;
+		double LongestStepMilliseconds = 0.0;
+		uint64_t Checksum = 0;
+	};
+
+	// Plays settings.DurationSeconds of one match, drawn renderRate times a second. With a
+	// fixed step the world moves at the tick rate whatever the frame rate, so every such run
+	// covers the same ticks; otherwise it updates once per frame, by however long that was.
+	TimestepRun RunTimestep(const HeadlessSettings& settings, uint32_t renderRate, bool fixedStep)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		RandomMath::Seed(settings.Seed);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		for (uint32_t i = 0; i < settings.Players; ++i)
+		{
+			game->AddSimulatedPlayer("Bot " + std::to_string(i + 1));
+		}
+
+		game->StartMatch();
+
+		SimulationClock simulationClock(settings.TicksPerSecond);
+		const uint64_t fixedSteps = static_cast<uint64_t>(settings.DurationSeconds * settings.TicksPerSecond);
+		const uint64_t frames = static_cast<uint64_t>(settings.DurationSeconds * renderRate);
+
+		TimestepRun run;
+		uint64_t longestStepTicks = 0;
+
+		auto Update = [&](uint64_t ticks)
+		{
+			if (game->IsMatchOver())
+			{
+				game->StartMatch();
+			}
+
+			game->Step(ticks);
+			run.Updates++;
+			longestStepTicks = std::max(longestStepTicks, ticks);
+		};
+
+		const Clock::time_point begin = Clock::now();
+		for (uint64_t frame = 0; fixedStep ? run.Updates < fixedSteps : frame < frames; ++frame)
+		{
+			// Frame lengths are rounded to whole ticks without drifting from the render rate
+			const uint64_t frameTicks = (frame + 1) * DX::StepTimer::TicksPerSecond / renderRate - frame * DX::StepTimer::TicksPerSecond / renderRate;
+
+			if (fixedStep)
+			{
+				// Steps past the end of the last frame are left for the frame after, which never comes
+				simulationClock.Advance(frameTicks, [&]()
+					{
+						if (run.Updates < fixedSteps)
+						{
+							Update(simulationClock.GetStepTicks());
+						}
+					});
+			}
+			else
+			{
+				Update(frameTicks);
+			}
+		}
+
+		run.Seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+		run.LongestStepMilliseconds = DX::StepTimer::TicksToSeconds(longestStepTicks) * 1000.0;
+		run.Checksum = game->GetWorld()->ComputeChecksum();
+		return run;
+	}
+
+	// Returns false if the fixed-step runs ended in different states
+	bool RunTimestepBenchmark(const HeadlessSettings& settings)
+	{
+		printf("%u players, %.0f s of play, fixed step at %u Hz\n",
+			settings.Players,
+			settings.DurationSeconds,
+			settings.TicksPerSecond);
+		printf("render Hz  step       updates/s  step ms  update ms/s  checksum\n");
+
+		bool fixedStateMatches = true;
+		uint64_t fixedChecksum = 0;
+		for (uint32_t renderRate : c_timestepRenderRates)
+		{
+			for (bool fixedStep : { false, true })
+			{
+				const TimestepRun run = RunTimestep(settings, renderRate, fixedStep);
+
+				printf("%9u  %-9s %10.1f %8.2f %12.2f  %016llx\n",
+					renderRate,
+					fixedStep ? "fixed" : "per frame",
+					run.Updates / settings.DurationSeconds,
+					run.LongestStepMilliseconds,
+					run.Seconds * 1000.0 / settings.DurationSeconds,
+					static_cast<unsigned long long>(run.Checksum));
+
+				if (fixedStep)
+				{
+					if (renderRate == c_timestepRenderRates[0])
+					{
+						fixedChecksum = run.Checksum;
+					}
+					fixedStateMatches = fixedStateMatches && run.Checksum == fixedChecksum;
+				}
+			}
+		}
+
+		if (!fixedStateMatches)
+		{
+			printf("Fixed-step matches ended in different states at different render rates\n");
+		}
+
+		return fixedStateMatches;
+	}
+
+	// Returns false if the swept test got a placed case or a random shot wrong
+	bool RunCollisionTest(const HeadlessSettings& settings)
+	{
+		CollisionTest::Settings testSettings;
+		testSettings.Seed = settings.Seed;
+
+		CollisionTest test(testSettings);
+		CollisionTest::Report report = test.Run();
+
+		bool passed = true;
+		for (const CollisionTest::CaseResult& result : report.Cases)
+		{
+			printf("%-28s %s\n", result.Name, result.Passed ? "ok" : "FAILED");
+			passed = passed && result.Passed;
+		}
+
+		printf("\n%u random shots per tick rate; hits are the sampled reference's\n", testSettings.Cases);
+		printf("               step                    distance test            swept test\n");
+		printf("     Hz      length     hits  grazes  missed   false     ns  missed   false  error     ns\n");
+		for (const CollisionTest::RateResult& rate : report.Rates)
+		{
+			printf("%7u %11.1f %8u %7u %7u %7u %6.1f %7u %7u %6.3f %6.1f\n",
+				rate.TicksPerSecond,
+				rate.StepLength,
+				rate.Hits,
+				rate.Grazes,
+				rate.ReachMissed,
+				rate.ReachFalse,
+				rate.ReachNanoseconds,
+				rate.SweptMissed,
+				rate.SweptFalse,
+				rate.SweptWorstImpactError,
+				rate.SweptNanoseconds);
+
+			passed = passed && rate.SweptMissed == 0 && rate.SweptFalse == 0 && rate.SweptWorstImpactError <= CollisionTest::c_impactTolerance;
+		}
+
+		return passed;
+	}
+
+	// Times CollisionManager::Update over settings.DurationSeconds of a field of asteroids,
+	// and returns false if any got out of it
+	bool RunBodyField(const HeadlessSettings& settings, uint32_t objects, bool useBodyStore, std::vector<float>& updateMicroseconds)
+	{
+		RandomMath::Seed(settings.Seed);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		const long side = static_cast<long>(std::sqrt(objects * c_bodyBenchmarkAreaPerObject));
+		const RECT field = { 0, 0, side, side };
+
+		CollisionManager* collisionManager = Managers::Get<CollisionManager>();
+		collisionManager->SetDimensions(field);
+		collisionManager->SetUseBodyStore(useBodyStore);
+
+		std::vector<std::shared_ptr<Asteroid>> asteroids;
+		asteroids.reserve(objects);
+		for (uint32_t i = 0; i < objects; ++i)
+		{
+			const float radius = RandomMath::RandomBetween(c_bodyBenchmarkRadiusMinimum, c_bodyBenchmarkRadiusMaximum);
+			auto asteroid = std::make_shared<Asteroid>(radius, RandomMath::RandomBetween(0, Asteroid::c_Variations - 1));
+			asteroid->Initialize();
+			asteroid->Position = DirectX::SimpleMath::Vector2(
+				RandomMath::RandomBetween(radius, side - radius),
+				RandomMath::RandomBetween(radius, side - radius));
+			asteroids.push_back(asteroid);
+		}
+
+		const float elapsedTime = 1.0f / settings.TicksPerSecond;
+		const uint64_t ticks = static_cast<uint64_t>(settings.DurationSeconds * settings.TicksPerSecond);
+		updateMicroseconds.clear();
+		updateMicroseconds.reserve(static_cast<size_t>(ticks));
+
+		for (uint64_t tick = 0; tick < ticks; ++tick)
+		{
+			for (auto& asteroid : asteroids)
+			{
+				asteroid->Update(elapsedTime);
+			}
+
+			collisionManager->Update(elapsedTime);
+			updateMicroseconds.push_back(collisionManager->LastUpdateMilliseconds() * 1000.0f);
+		}
+
+		bool contained = true;
+		for (auto& asteroid : asteroids)
+		{
+			contained = contained && asteroid->Active() &&
+				asteroid->Position.x >= field.left && asteroid->Position.x <= field.right &&
+				asteroid->Position.y >= field.top && asteroid->Position.y <= field.bottom;
+		}
+
+		return contained;
+	}
+
+	// Returns false if an asteroid got out of its field
+	bool RunBodyBenchmark(const HeadlessSettings& settings)
+	{
+		printf("%u Hz, %.0f s per field, CollisionManager::Update\n",
+			settings.TicksPerSecond,
+			settings.DurationSeconds);
+		printf("microseconds                  mean       p50       p99       max\n");
+
+		bool contained = true;
+		std::vector<float> updateMicroseconds;
+		for (uint32_t objects : c_bodyBenchmarkCounts)
+		{
+			for (bool useBodyStore : { false, true })
+			{
+				const bool fieldContained = RunBodyField(settings, objects, useBodyStore, updateMicroseconds);
+
+				const std::string name = std::to_string(objects) + (useBodyStore ? " as bodies" : " as objects");
+				PrintMicroseconds(name.c_str(), updateMicroseconds);
+
+				if (!fieldContained)
+				{
+					printf("An asteroid got out of the field of %u %s\n", objects, useBodyStore ? "bodies" : "objects");
+				}
+				contained = contained && fieldContained;
+			}
+		}
+
+		return contained;
+	}
+
+	// Returns false if, once the projectile pools had filled, firing still allocated for every
+	// shot, or if the rocket pools never reused a rocket
+	bool RunFiringBenchmark(const HeadlessSettings& settings)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		RandomMath::Seed(settings.Seed);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		for (uint32_t i = 0; i < settings.Players; ++i)
+		{
+			game->AddSimulatedPlayer("Bot " + std::to_string(i + 1));
+		}
+
+		// Projectiles every ship's pools have handed out, and how many they had to make
+		auto CountProjectiles = [&game](uint64_t& acquired, uint64_t& constructed)
+		{
+			acquired = 0;
+			constructed = 0;
+			for (PlayerState* playerState : game->GetPlayers())
+			{
+				const Ship& ship = *playerState->GetShip();
+				acquired += ship.LaserProjectiles.Acquired() + ship.RocketProjectiles.Acquired() + ship.MineProjectiles.Acquired();
+				constructed += ship.LaserProjectiles.Size() + ship.RocketProjectiles.Size() + ship.MineProjectiles.Size();
+			}
+		};
+
+		const uint64_t ticks = static_cast<uint64_t>(settings.DurationSeconds * settings.TicksPerSecond);
+		const uint64_t warmupTicks = std::min(static_cast<uint64_t>(c_firingWarmupSeconds * settings.TicksPerSecond), ticks / 2);
+
+		// Shots and allocations while firing, warming up and after
+		uint64_t shots[2] = {};
+		uint64_t firingAllocations[2] = {};
+		uint64_t tickAllocations = 0;
+		std::vector<float> tickMicroseconds;
+		tickMicroseconds.reserve(static_cast<size_t>(ticks));
+
+		game->StartMatch();
+		for (uint64_t tick = 0; tick < ticks; ++tick)
+		{
+			if (game->IsMatchOver())
+			{
+				game->StartMatch();
+			}
+
+			const size_t phase = tick < warmupTicks ? 0 : 1;
+
+			// A ship respawns with its plain laser
+			for (PlayerState* playerState : game->GetPlayers())
+			{
+				Ship* ship = playerState->GetShip().get();
+				const WeaponType weaponType = playerState->PeerId % 2 == 0 ? WeaponType::Rocket : WeaponType::TripleLaser;
+				if (ship->Active() && ship->PrimaryWeapon->GetWeaponType() != weaponType)
+				{
+					if (weaponType == WeaponType::Rocket)
+					{
+						ship->PrimaryWeapon = std::make_shared<RocketWeapon>(ship);
+					}
+					else
+					{
+						ship->PrimaryWeapon = std::make_shared<TripleLaserWeapon>(ship);
+					}
+				}
+			}
+
+			uint64_t acquiredBefore;
+			uint64_t constructed;
+			CountProjectiles(acquiredBefore, constructed);
+
+			const uint64_t allocationsBefore = AllocationCounter::ThisThread();
+			for (PlayerState* playerState : game->GetPlayers())
+			{
+				Ship* ship = playerState->GetShip().get();
+				if (ship->Active())
+				{
+					const DirectX::SimpleMath::Vector2 aim = RandomMath::RandomDirection();
+					ship->PrimaryWeapon->Fire(aim);
+					ship->DroppedWeapon->Fire(-aim);
+				}
+			}
+			firingAllocations[phase] += AllocationCounter::ThisThread() - allocationsBefore;
+
+			uint64_t acquiredAfter;
+			CountProjectiles(acquiredAfter, constructed);
+			shots[phase] += acquiredAfter - acquiredBefore;
+
+			const uint64_t tickAllocationsBefore = AllocationCounter::ThisThread();
+			const Clock::time_point begin = Clock::now();
+			game->Tick();
+			tickMicroseconds.push_back(std::chrono::duration<float, std::micro>(Clock::now() - begin).count());
+			if (phase == 1)
+			{
+				tickAllocations += AllocationCounter::ThisThread() - tickAllocationsBefore;
+			}
+		}
+
+		uint64_t acquired;
+		uint64_t constructed;
+		CountProjectiles(acquired, constructed);
+
+		uint64_t rocketsAcquired = 0;
+		uint64_t rocketsConstructed = 0;
+		for (PlayerState* playerState : game->GetPlayers())
+		{
+			rocketsAcquired += playerState->GetShip()->RocketProjectiles.Acquired();
+			rocketsConstructed += playerState->GetShip()->RocketProjectiles.Size();
+		}
+
+		printf("%u ships with triple lasers or rockets and mines, %u Hz, %.0f s, the first %.0f s to fill the pools\n",
+			settings.Players,
+			settings.TicksPerSecond,
+			static_cast<double>(ticks) / settings.TicksPerSecond,
+			static_cast<double>(warmupTicks) / settings.TicksPerSecond);
+		printf("%llu projectiles launched from %llu constructed, %.1f%% of them reused\n",
+			static_cast<unsigned long long>(acquired),
+			static_cast<unsigned long long>(constructed),
+			acquired > 0 ? 100.0 * static_cast<double>(acquired - constructed) / acquired : 0.0);
+		printf("%llu rockets launched from %llu constructed, %.1f%% of them reused\n",
+			static_cast<unsigned long long>(rocketsAcquired),
+			static_cast<unsigned long long>(rocketsConstructed),
+			rocketsAcquired > 0 ? 100.0 * static_cast<double>(rocketsAcquired - rocketsConstructed) / rocketsAcquired : 0.0);
+		printf("heap allocations while firing: %llu for %llu shots warming up, %llu for %llu shots after (%.3f per shot)\n",
+			static_cast<unsigned long long>(firingAllocations[0]),
+			static_cast<unsigned long long>(shots[0]),
+			static_cast<unsigned long long>(firingAllocations[1]),
+			static_cast<unsigned long long>(shots[1]),
+			shots[1] > 0 ? static_cast<double>(firingAllocations[1]) / shots[1] : 0.0);
+		printf("heap allocations per tick after warming up: %.1f\n",
+			ticks > warmupTicks ? static_cast<double>(tickAllocations) / (ticks - warmupTicks) : 0.0);
+		printf("microseconds                  mean       p50       p99       max\n");
+		PrintMicroseconds("tick", tickMicroseconds);
+
+		return shots[1] > 0 && firingAllocations[1] < shots[1] && rocketsAcquired > rocketsConstructed;
+	}
+
+	// Lays the mines among the asteroids, sets off all of them or just the first, and times
+	// that along with the collision update it happens in. Returns how many mines went off.
+	uint32_t RunExplosionField(const HeadlessSettings& settings, uint32_t trial, bool batched, bool chain, std::vector<float>& microseconds)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		RandomMath::Seed(settings.Seed + trial);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		const long side = static_cast<long>(std::sqrt(c_explosionBenchmarkMines * c_explosionBenchmarkAreaPerMine));
+		const RECT field = { 0, 0, side, side };
+
+		CollisionManager* collisionManager = Managers::Get<CollisionManager>();
+		collisionManager->SetDimensions(field);
+		collisionManager->SetBatchExplosions(batched);
+
+		// Held still, so nothing touches a mine before they go off
+		for (uint32_t i = 0; i < c_explosionBenchmarkAsteroids; ++i)
+		{
+			const float radius = RandomMath::RandomBetween(c_bodyBenchmarkRadiusMinimum, c_bodyBenchmarkRadiusMaximum);
+			auto asteroid = std::make_shared<Asteroid>(radius, RandomMath::RandomBetween(0, Asteroid::c_Variations - 1));
+			asteroid->Initialize();
+			asteroid->Position = DirectX::SimpleMath::Vector2(
+				RandomMath::RandomBetween(radius, side - radius),
+				RandomMath::RandomBetween(radius, side - radius));
+			asteroid->Velocity = DirectX::SimpleMath::Vector2::Zero;
+		}
+
+		// The mines' owner stays out of the collision system; it only launches them
+		auto owner = std::make_shared<Ship>();
+		std::vector<std::shared_ptr<MineProjectile>> mines;
+		mines.reserve(c_explosionBenchmarkMines);
+		for (uint32_t i = 0; i < c_explosionBenchmarkMines; ++i)
+		{
+			auto mine = owner->MineProjectiles.Acquire(owner.get());
+			mine->Launch(RandomMath::RandomDirection());
+			mine->Initialize();
+
+			// Clear of the edges, where a projectile dies
+			const float margin = 2.0f * mine->Radius;
+			mine->Position = DirectX::SimpleMath::Vector2(
+				RandomMath::RandomBetween(margin, side - margin),
+				RandomMath::RandomBetween(margin, side - margin));
+			mine->Velocity = DirectX::SimpleMath::Vector2::Zero;
+			mines.push_back(mine);
+		}
+
+		// Settle everything into the collision system before the timed tick
+		const float elapsedTime = 1.0f / settings.TicksPerSecond;
+		collisionManager->Update(elapsedTime);
+
+		const Clock::time_point begin = Clock::now();
+		for (auto& mine : mines)
+		{
+			mine->Die(nullptr, false);
+			if (chain)
+			{
+				break;
+			}
+		}
+		collisionManager->Update(elapsedTime);
+		microseconds.push_back(std::chrono::duration<float, std::micro>(Clock::now() - begin).count());
+
+		uint32_t exploded = 0;
+		for (auto& mine : mines)
+		{
+			exploded += mine->Active() ? 0 : 1;
+		}
+
+		return exploded;
+	}
+
+	// Returns false if setting off every mine left any standing
+	bool RunExplosionBenchmark(const HeadlessSettings& settings)
+	{
+		const long side = static_cast<long>(std::sqrt(c_explosionBenchmarkMines * c_explosionBenchmarkAreaPerMine));
+		printf("%u mines and %u asteroids in a field %ld on a side, %u trials; the tick they go off in\n",
+			c_explosionBenchmarkMines,
+			c_explosionBenchmarkAsteroids,
+			side,
+			c_explosionBenchmarkTrials);
+		printf("microseconds                  mean       p50       p99       max   exploded\n");
+
+		bool allExploded = true;
+		std::vector<float> microseconds;
+		for (bool chain : { false, true })
+		{
+			for (bool batched : { false, true })
+			{
+				microseconds.clear();
+				uint64_t exploded = 0;
+				for (uint32_t trial = 0; trial < c_explosionBenchmarkTrials; ++trial)
+				{
+					const uint32_t trialExploded = RunExplosionField(settings, trial, batched, chain, microseconds);
+					exploded += trialExploded;
+					allExploded = allExploded && (chain || trialExploded == c_explosionBenchmarkMines);
+				}
+
+				const std::string name = std::string(chain ? "chain" : "all at once") + (batched ? ", batched" : ", one by one");
+				double total = 0.0;
+				for (float sample : microseconds)
+				{
+					total += sample;
+				}
+				const float maxSample = *std::max_element(microseconds.begin(), microseconds.end());
+
+				printf("%-24s %9.1f %9.1f %9.1f %9.1f %10.1f\n",
+					name.c_str(),
+					total / microseconds.size(),
+					Percentile(microseconds, 0.5f),
+					Percentile(microseconds, 0.99f),
+					maxSample,
+					static_cast<double>(exploded) / c_explosionBenchmarkTrials);
+			}
+		}
+
+		return allExploded;
+	}
+
+	// What one tick of a broadphase field left behind: every object that touched another,
+	// by the order it was made in, and a hash of where everything is and how it moves
+	struct BroadphaseTick
+	{
+		std::vector<uint32_t> Touched;
+		uint64_t State = 0;
+
+		bool operator==(const BroadphaseTick& other) const { return Touched == other.Touched && State == other.State; }
+	};
+
+	// Flies the laser bolts through the asteroids, with or without the spatial hash, and times
+	// CollisionManager::Update on every tick
+	std::vector<BroadphaseTick> RunBroadphaseField(const HeadlessSettings& settings, bool useBroadphase, std::vector<float>& updateMicroseconds)
+	{
+		RandomMath::Seed(settings.Seed);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		const long side = static_cast<long>(std::sqrt(c_broadphaseBenchmarkAsteroids * c_bodyBenchmarkAreaPerObject));
+		const RECT field = { 0, 0, side, side };
+
+		CollisionManager* collisionManager = Managers::Get<CollisionManager>();
+		collisionManager->SetDimensions(field);
+		collisionManager->SetUseBroadphase(useBroadphase);
+
+		std::vector<std::shared_ptr<GameplayObject>> objects;
+		objects.reserve(c_broadphaseBenchmarkAsteroids + c_broadphaseBenchmarkProjectiles);
+		for (uint32_t i = 0; i < c_broadphaseBenchmarkAsteroids; ++i)
+		{
+			const float radius = RandomMath::RandomBetween(c_bodyBenchmarkRadiusMinimum, c_bodyBenchmarkRadiusMaximum);
+			auto asteroid = std::make_shared<Asteroid>(radius, RandomMath::RandomBetween(0, Asteroid::c_Variations - 1));
+			asteroid->Initialize();
+			asteroid->Position = DirectX::SimpleMath::Vector2(
+				RandomMath::RandomBetween(radius, side - radius),
+				RandomMath::RandomBetween(radius, side - radius));
+			objects.push_back(asteroid);
+		}
+
+		// The ships stay out of the collision system; bolts from different ships hit each other
+		std::vector<std::shared_ptr<Ship>> ships;
+		for (uint32_t i = 0; i < c_broadphaseBenchmarkShips; ++i)
+		{
+			ships.push_back(std::make_shared<Ship>());
+		}
+
+		for (uint32_t i = 0; i < c_broadphaseBenchmarkProjectiles; ++i)
+		{
+			Ship* owner = ships[i % c_broadphaseBenchmarkShips].get();
+			auto laser = owner->LaserProjectiles.Acquire(owner);
+			laser->Launch(RandomMath::RandomDirection());
+			laser->Initialize();
+			laser->Position = DirectX::SimpleMath::Vector2(
+				RandomMath::RandomBetween(laser->Radius, side - laser->Radius),
+				RandomMath::RandomBetween(laser->Radius, side - laser->Radius));
+			objects.push_back(laser);
+		}
+
+		const float elapsedTime = 1.0f / settings.TicksPerSecond;
+		std::vector<BroadphaseTick> ticks(c_broadphaseBenchmarkTicks);
+		updateMicroseconds.clear();
+
+		for (BroadphaseTick& tick : ticks)
+		{
+			// Dead objects too, so none of them is still marked as touching from a tick before
+			for (auto& object : objects)
+			{
+				object->Update(elapsedTime);
+			}
+
+			collisionManager->Update(elapsedTime);
+			updateMicroseconds.push_back(collisionManager->LastUpdateMilliseconds() * 1000.0f);
+
+			// FNV-1a, as World::ComputeChecksum
+			uint64_t hash = 14695981039346656037ull;
+			auto mix = [&hash](const void* data, size_t size)
+			{
+				const uint8_t* bytes = static_cast<const uint8_t*>(data);
+				for (size_t i = 0; i < size; i++)
+				{
+					hash = (hash ^ bytes[i]) * 1099511628211ull;
+				}
+			};
+
+			for (uint32_t i = 0; i < objects.size(); ++i)
+			{
+				const GameplayObject& object = *objects[i];
+				if (object.CollidedThisFrame)
+				{
+					tick.Touched.push_back(i);
+				}
+
+				const bool active = object.Active();
+				mix(&active, sizeof(active));
+				mix(&object.Position, sizeof(object.Position));
+				mix(&object.Velocity, sizeof(object.Velocity));
+			}
+			tick.State = hash;
+		}
+
+		return ticks;
+	}
+
+	// Returns false if the spatial hash changed which objects touched or where they went
+	bool RunBroadphaseBenchmark(const HeadlessSettings& settings)
+	{
+		const long side = static_cast<long>(std::sqrt(c_broadphaseBenchmarkAsteroids * c_bodyBenchmarkAreaPerObject));
+		printf("%u laser bolts from %u ships and %u asteroids in a field %ld on a side, %u Hz, %u ticks\n",
+			c_broadphaseBenchmarkProjectiles,
+			c_broadphaseBenchmarkShips,
+			c_broadphaseBenchmarkAsteroids,
+			side,
+			settings.TicksPerSecond,
+			c_broadphaseBenchmarkTicks);
+		printf("microseconds                  mean       p50       p99       max\n");
+
+		std::vector<float> updateMicroseconds;
+		const std::vector<BroadphaseTick> allPairs = RunBroadphaseField(settings, false, updateMicroseconds);
+		PrintMicroseconds("every pair", updateMicroseconds);
+		const std::vector<BroadphaseTick> hashed = RunBroadphaseField(settings, true, updateMicroseconds);
+		PrintMicroseconds("spatial hash", updateMicroseconds);
+
+		size_t touches = 0;
+		size_t firstDifference = allPairs.size();
+		for (size_t i = 0; i < allPairs.size(); ++i)
+		{
+			touches += allPairs[i].Touched.size();
+			if (firstDifference == allPairs.size() && !(allPairs[i] == hashed[i]))
+			{
+				firstDifference = i;
+			}
+		}
+
+		if (firstDifference < allPairs.size())
+		{
+			printf("the two differ from tick %zu on\n", firstDifference + 1);
+			return false;
+		}
+
+		printf("%zu touches, the same objects on the same ticks either way, and the same state after every tick\n", touches);
+		return touches > 0;
+	}
+
+	// Returns false if sending or receiving a per-tick message allocated once a match was warm
+	bool RunShipDataTest(const HeadlessSettings& settings)
+	{
+		// The client's first player is the host's remote one; the rest play on the host and
+		// are remote to the client
+		constexpr uint64_t c_remotePeer = 1;
+
+		auto CreateMatch = [&settings](bool isServer)
+		{
+			auto game = std::make_unique<Game>();
+			game->Initialize(settings.TicksPerSecond);
+			Managers::Get<OnlineManager>()->SetServer(isServer);
+
+			for (uint32_t i = 0; i < settings.Players; ++i)
+			{
+				game->AddSimulatedPlayer("Bot " + std::to_string(i + 1));
+				game->GetPlayerState(i + 1)->IsLocalPlayer = (i + 1 == c_remotePeer) != isServer;
+			}
+
+			// The test sends world data itself, so it can measure the send
+			game->GetWorld()->SetWorldDataSendInterval(INT_MAX);
+			return game;
+		};
+
+		RandomMath::Seed(settings.Seed);
+		std::unique_ptr<Game> host = CreateMatch(true);
+		std::unique_ptr<Game> client = CreateMatch(false);
+
+		struct Round
+		{
+			const char* Name;
+			uint64_t Count = 0;
+			uint64_t SendAllocations = 0;
+			uint64_t ReceiveAllocations = 0;
+			uint64_t WarmupAllocations = 0;
+		};
+		Round shipData{ "ship data" };
+		Round worldData{ "world data" };
+		Round shipInput{ "ShipInput" };
+
+		// Sized once up front, as the online managers' buffers are after their first few sends
+		BitBufferWriter dataWriter(1024);
+		std::vector<uint8_t> packet;
+		packet.reserve(MessageBundler::c_maximumBundleSize);
+
+		// Writes a message on one match and applies it on the other, as the transport would
+		// deliver it, counting the allocations each side makes
+		auto Exchange = [&](Round& round, bool warm, Game& sender, GameMessageType type, auto&& write, Game& receiver, auto&& apply)
+		{
+			sender.MakeCurrent();
+			uint64_t allocationsBefore = AllocationCounter::ThisThread();
+			dataWriter.Reset();
+			write();
+			GameMessageView(type, dataWriter.View()).SerializeTo(packet);
+			const uint64_t sendAllocations = AllocationCounter::ThisThread() - allocationsBefore;
+
+			receiver.MakeCurrent();
+			allocationsBefore = AllocationCounter::ThisThread();
+			const GameMessageView message = GameMessageView::FromPacket(packet);
+			if (message.MessageType() == type)
+			{
+				apply(message.RawData());
+			}
+			const uint64_t receiveAllocations = AllocationCounter::ThisThread() - allocationsBefore;
+
+			if (warm)
+			{
+				round.SendAllocations += sendAllocations;
+				round.ReceiveAllocations += receiveAllocations;
+			}
+			else
+			{
+				round.WarmupAllocations += sendAllocations + receiveAllocations;
+			}
+			round.Count++;
+		};
+
+		auto StartMatch = [&]()
+		{
+			host->MakeCurrent();
+			host->StartMatch();
+			client->MakeCurrent();
+			client->StartMatch();
+		};
+
+		const uint64_t ticks = static_cast<uint64_t>(settings.DurationSeconds * settings.TicksPerSecond);
+		uint64_t matchTicks = 0;
+		StartMatch();
+		for (uint64_t tick = 0; tick < ticks; ++tick, ++matchTicks)
+		{
+			host->MakeCurrent();
+			if (host->IsMatchOver())
+			{
+				StartMatch();
+				matchTicks = 0;
+			}
+
+			host->MakeCurrent();
+			host->Tick();
+			client->MakeCurrent();
+			client->Tick();
+
+			World& hostWorld = *host->GetWorld();
+			World& clientWorld = *client->GetWorld();
+			const bool warm = matchTicks >= settings.TicksPerSecond;
+
+			if (matchTicks % World::c_UpdatesBetweenShipDataPackets == 0)
+			{
+				Exchange(shipData, warm,
+					*host, GameMessageType::ServerUpdateShipData, [&]() { hostWorld.SerializeShipData(dataWriter); },
+					*client, [&](DataBufferView data) { clientWorld.DeserializeShipData(data); });
+			}
+
+			// The client's acknowledgement goes back at once, so the host deltas against it
+			if (matchTicks % World::c_UpdatesBetweenWorldDataPackets == 0)
+			{
+				Exchange(worldData, warm,
+					*host, GameMessageType::ServerUpdateWorldData, [&]() { hostWorld.SerializeWorldData(dataWriter); },
+					*client, [&](DataBufferView data) { clientWorld.DeserializeWorldData(data); });
+
+				host->MakeCurrent();
+				BitBufferReader dataReader(dataWriter.View());
+				hostWorld.AcknowledgeWorldData(*host->GetPlayerState(c_remotePeer), dataReader.ReadVarUInt32());
+			}
+
+			const std::shared_ptr<Ship>& clientShip = client->GetPlayerState(c_remotePeer)->GetShip();
+			const std::shared_ptr<Ship>& hostShip = host->GetPlayerState(c_remotePeer)->GetShip();
+			if (matchTicks % World::c_UpdatesBetweenShipInputPackets == 0 && clientShip && hostShip)
+			{
+				Exchange(shipInput, warm,
+					*client, GameMessageType::ShipInput, [&]() { clientShip->SerializeMoves(dataWriter); },
+					*host, [&](DataBufferView data) { hostShip->DeserializeMoves(data); });
+			}
+		}
+
+		printf("%u players, one of them on the client, %.0f s simulated\n", settings.Players, settings.DurationSeconds);
+		printf("heap allocations  %8s %14s %10s %10s\n", "rounds", "warming up", "send", "receive");
+		bool allocated = false;
+		for (const Round* round : { &shipData, &worldData, &shipInput })
+		{
+			printf("%-16s %9llu %14llu %10llu %10llu\n",
+				round->Name,
+				static_cast<unsigned long long>(round->Count),
+				static_cast<unsigned long long>(round->WarmupAllocations),
+				static_cast<unsigned long long>(round->SendAllocations),
+				static_cast<unsigned long long>(round->ReceiveAllocations));
+			allocated = allocated || round->SendAllocations != 0 || round->ReceiveAllocations != 0 || round->Count == 0;
+		}
+
+		return !allocated;
+	}
+
+	// Writes that must put exactly these bytes on the wire, and a check that a reader gets
+	// back what was written
+	struct BitBufferCase
+	{
+		const char* Name;
+		std::function<void(BitBufferWriter&)> Write;
+		std::vector<uint8_t> Bytes;
+		std::function<bool(BitBufferReader&)> Read;
+	};
+
+	// Returns false if any encoding differs from its golden bytes or fails to read back
+	bool RunBitBufferTest(const HeadlessSettings&)
+	{
+		// A quantized value reads back as the writer's Quantize helpers say, within half a step
+		auto Near = [](float value, float expected, float step)
+		{
+			return std::abs(value - expected) <= step * 0.5f;
+		};
+
+		const BitBufferCase cases[] =
+		{
+			{
+				"bits across byte boundaries",
+				[](BitBufferWriter& writer) { writer.WriteBits(5, 3); writer.WriteBool(true); writer.WriteBits(0x1234, 13); writer.WriteBits(0xdeadbeef, 32); },
+				{ 0x4d, 0x23, 0xdf, 0x7d, 0x5b, 0xbd, 0x01 },
+				[](BitBufferReader& reader) { return reader.ReadBits(3) == 5 && reader.ReadBool() && reader.ReadBits(13) == 0x1234 && reader.ReadBits(32) == 0xdeadbeef; }
+			},
+			{
+				"variable length integers",
+				[](BitBufferWriter& writer) { for (uint32_t value : { 0u, 127u, 128u, 300u, UINT32_MAX }) { writer.WriteVarUInt32(value); } },
+				{ 0x00, 0x7f, 0x80, 0x01, 0xac, 0x02, 0xff, 0xff, 0xff, 0xff, 0x0f },
+				[](BitBufferReader& reader) { return reader.ReadVarUInt32() == 0 && reader.ReadVarUInt32() == 127 && reader.ReadVarUInt32() == 128 && reader.ReadVarUInt32() == 300 && reader.ReadVarUInt32() == UINT32_MAX; }
+			},
+			{
+				"single",
+				[](BitBufferWriter& writer) { writer.WriteSingle(-2.5f); },
+				{ 0x00, 0x00, 0x20, 0xc0 },
+				[](BitBufferReader& reader) { return reader.ReadSingle() == -2.5f; }
+			},
+			{
+				"quantized, both ends exact",
+				[](BitBufferWriter& writer) { writer.WriteQuantized(0.25f, 0.0f, 1.0f, 8); writer.WriteQuantized(-1.0f, 0.0f, 1.0f, 8); writer.WriteQuantized(2.0f, 0.0f, 1.0f, 8); },
+				{ 0x40, 0x00, 0xff },
+				[&Near](BitBufferReader& reader)
+				{
+					const float quarter = reader.ReadQuantized(0.0f, 1.0f, 8);
+					return quarter == BitBufferWriter::Quantize(0.25f, 0.0f, 1.0f, 8) && Near(quarter, 0.25f, 1.0f / 255.0f)
+						&& reader.ReadQuantized(0.0f, 1.0f, 8) == 0.0f && reader.ReadQuantized(0.0f, 1.0f, 8) == 1.0f;
+				}
+			},
+			{
+				"signed quantized, zero exact",
+				[](BitBufferWriter& writer) { writer.WriteSignedQuantized(-300.0f, 300.0f, 10); writer.WriteSignedQuantized(0.0f, 300.0f, 10); writer.WriteSignedQuantized(300.0f, 300.0f, 10); },
+				{ 0x00, 0xfc, 0xe7, 0x3f },
+				[](BitBufferReader& reader) { return reader.ReadSignedQuantized(300.0f, 10) == -300.0f && reader.ReadSignedQuantized(300.0f, 10) == 0.0f && reader.ReadSignedQuantized(300.0f, 10) == 300.0f; }
+			},
+			{
+				"angles, wrapped",
+				[](BitBufferWriter& writer) { writer.WriteAngle(DirectX::XM_PI, 12); writer.WriteAngle(-DirectX::XM_PIDIV2, 12); writer.WriteAngle(DirectX::XM_2PI, 12); },
+				{ 0x00, 0x08, 0xc0, 0x00, 0x00 },
+				[](BitBufferReader& reader) { return reader.ReadAngle(12) == DirectX::XM_PI && reader.ReadAngle(12) == 3.0f * DirectX::XM_PIDIV2 && reader.ReadAngle(12) == 0.0f; }
+			},
+			{
+				"position",
+				[](BitBufferWriter& writer) { writer.WritePosition(DirectX::SimpleMath::Vector2(50.0f, 25.0f), c_bitBufferTestBounds, 16); },
+				{ 0x00, 0x80, 0x00, 0x80 },
+				[&Near](BitBufferReader& reader)
+				{
+					const DirectX::SimpleMath::Vector2 position = reader.ReadPosition(c_bitBufferTestBounds, 16);
+					return position == BitBufferWriter::QuantizePosition(DirectX::SimpleMath::Vector2(50.0f, 25.0f), c_bitBufferTestBounds, 16)
+						&& Near(position.x, 50.0f, 100.0f / 65535.0f) && Near(position.y, 25.0f, 50.0f / 65535.0f);
+				}
+			},
+			{
+				"string, then a bit in a fresh byte",
+				[](BitBufferWriter& writer) { writer.WriteString("Hi"); writer.WriteBool(true); },
+				{ 0x02, 0x48, 0x69, 0x01 },
+				[](BitBufferReader& reader) { return reader.ReadString() == "Hi" && reader.ReadBool(); }
+			},
+		};
+
+		bool passed = true;
+		for (const BitBufferCase& testCase : cases)
+		{
+			BitBufferWriter writer;
+			testCase.Write(writer);
+			const DataBufferView view = writer.View();
+			const bool encoded = std::equal(view.begin(), view.end(), testCase.Bytes.begin(), testCase.Bytes.end());
+
+			BitBufferReader reader(testCase.Bytes);
+			const bool decoded = testCase.Read(reader) && reader.RemainingBits() < 8;
+
+			// Only the padding is left, so another byte is past the end
+			bool overrun = false;
+			try
+			{
+				reader.ReadBits(8);
+			}
+			catch (const std::runtime_error&)
+			{
+				overrun = true;
+			}
+
+			printf("%-36s %s\n", testCase.Name, encoded && decoded && overrun ? "ok" : "FAILED");
+			if (!encoded)
+			{
+				printf("  wrote");
+				for (uint8_t byte : view)
+				{
+					printf(" %02x", byte);
+				}
+				printf("\n");
+			}
+			passed = passed && encoded && decoded && overrun;
+		}
+
+		return passed;
+	}
+
+	// Returns false if any effect released no particles or was still going at the end
+	bool RunParticleBenchmark(const HeadlessSettings& settings)
+	{
+		RandomMath::Seed(settings.Seed);
+
+		auto game = std::make_unique<Game>();
+		game->Initialize(settings.TicksPerSecond);
+
+		const std::pair<const char*, std::function<std::shared_ptr<ParticleEffect>()>> effects[] =
+		{
+			{ "ship spawn", ParticleEffectManager::CreateShipSpawnEffect },
+			{ "ship explosion", ParticleEffectManager::CreateShipExplosionEffect },
+			{ "rocket trail", ParticleEffectManager::CreateRocketTrailEffect },
+			{ "rocket explosion", ParticleEffectManager::CreateRocketExplosionEffect },
+			{ "mine explosion", ParticleEffectManager::CreateMineExplosionEffect },
+			{ "laser explosion", ParticleEffectManager::CreateLaserExplosionEffect },
+		};
+
+		const float elapsedTime = 1.0f / settings.TicksPerSecond;
+		const uint32_t frames = static_cast<uint32_t>(c_particleBenchmarkSeconds * settings.TicksPerSecond);
+
+		printf("each effect at %dx its particle counts, set off %u times and followed for %.0f s at %u Hz\n",
+			c_particleBenchmarkScale,
+			c_particleBenchmarkRuns,
+			c_particleBenchmarkSeconds,
+			settings.TicksPerSecond);
+		printf("microseconds        peak      mean       p50       p99       max\n");
+
+		bool passed = true;
+		for (const auto& [name, Create] : effects)
+		{
+			// Built once and reused, as the manager's cache does
+			std::shared_ptr<ParticleEffect> effect = Create();
+			for (auto& system : effect->ParticleSystems)
+			{
+				system->ParticleCount *= c_particleBenchmarkScale;
+				system->ParticlesPerSecond *= c_particleBenchmarkScale;
+			}
+			effect->Initialize();
+
+			std::vector<float> updateMicroseconds;
+			updateMicroseconds.reserve(static_cast<size_t>(frames) * c_particleBenchmarkRuns);
+			int peakParticles = 0;
+			bool burnedOut = true;
+
+			for (uint32_t run = 0; run < c_particleBenchmarkRuns; ++run)
+			{
+				effect->Reset();
+				effect->SetPosition(DirectX::SimpleMath::Vector2(400.0f, 300.0f));
+
+				for (uint32_t frame = 0; frame < frames && effect->IsActive(); ++frame)
+				{
+					const auto begin = std::chrono::steady_clock::now();
+					effect->Update(elapsedTime);
+					updateMicroseconds.push_back(std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - begin).count());
+
+					int particles = 0;
+					for (auto& system : effect->ParticleSystems)
+					{
+						particles += system->LiveParticleCount();
+					}
+					peakParticles = std::max(peakParticles, particles);
+				}
+
+				// A trail runs for as long as its rocket flies; stop it the way a rocket's death does
+				effect->Stop(false);
+				for (uint32_t frame = 0; frame < frames && effect->IsActive(); ++frame)
+				{
+					effect->Update(elapsedTime);
+				}
+				burnedOut = burnedOut && !effect->IsActive();
+			}
+
+			char label[64];
+			snprintf(label, sizeof(label), "%-16s%8d", name, peakParticles);
+			PrintMicroseconds(label, updateMicroseconds);
+
+			if (peakParticles == 0 || !burnedOut)
+			{
+				printf("  %s\n", peakParticles == 0 ? "released no particles" : "never burned out");
+				passed = false;
+			}
+		}
+
+		return passed;
+	}
+
+	// An object that, the first time it is touched, puts another in the collection well clear
+	// of everything, then flushes the collection's pending adds as a ship dying mid-update does
+	class SpawningObject final : public GameplayObject
+	{
+	public:
+		virtual bool OnTouch(GameplayObject* target) override
+		{
+			if (!Spawned)
+			{
+				Spawned = std::make_shared<GameplayObject>();
+				Spawned->Position = DirectX::SimpleMath::Vector2(500.0f, 900.0f);
+				Spawned->Velocity = DirectX::SimpleMath::Vector2(600.0f, 0.0f);
+				Spawned->Initialize();
+				Managers::Get<CollisionManager>()->Collection().ApplyPendingRemovals();
+			}
+			return GameplayObject::OnTouch(target);
+		}
+
+		std::shared_ptr<GameplayObject> Spawned;
+	};
+
+	// Places the objects in the collection in the order given, in a match of their own, and
+	// runs one CollisionManager::Update over them, then as many more as asked
+	void RunBodyOrderTicks(bool useBodyStore, const std::vector<std::shared_ptr<GameplayObject>>& objects, int ticks = 1)
+	{
+		auto game = std::make_unique<Game>();
+		game->Initialize(60);
+
+		CollisionManager* collisionManager = Managers::Get<CollisionManager>();
+		collisionManager->SetDimensions(c_bodyOrderTestField);
+		collisionManager->SetUseBodyStore(useBodyStore);
+
+		for (const auto& object : objects)
+		{
+			object->Initialize();
+		}
+		for (int tick = 0; tick < ticks; ++tick)
+		{
+			collisionManager->Update(c_bodyOrderTestStep);
+		}
+
+		collisionManager->Collection().clear();
+	}
+
+	// Two objects of radius 20 five apart, moving the same way along x at ten a tick: the one
+	// behind reaches where the one ahead starts the tick, but not where it ends it
+	std::vector<std::shared_ptr<GameplayObject>> MakeBodyOrderPair()
+	{
+		std::vector<std::shared_ptr<GameplayObject>> pair;
+		for (float x : { 100.0f, 145.0f })
+		{
+			auto object = std::make_shared<GameplayObject>();
+			object->Position = DirectX::SimpleMath::Vector2(x, 500.0f);
+			object->Velocity = DirectX::SimpleMath::Vector2(600.0f, 0.0f);
+			object->Radius = 20.0f;
+			pair.push_back(object);
+		}
+		return pair;
+	}
+
+	// Returns false if the BodyStore's update finds a touch that depends on the order of the
+	// collection, moves an object added mid-update before the next update, or rebounds a
+	// pair of unequal masses other than the way the walk over the objects does
+	bool RunBodyOrderTest(const HeadlessSettings&)
+	{
+		bool passed = true;
+		printf("                               body store         object walk\n");
+
+		// The one behind touches the one ahead whichever is first in the collection
+		{
+			int touched[2] = {};
+			bool sameOutcome = true;
+			for (bool useBodyStore : { true, false })
+			{
+				std::vector<DirectX::SimpleMath::Vector2> outcome;
+				for (bool behindFirst : { true, false })
+				{
+					auto pair = MakeBodyOrderPair();
+					RunBodyOrderTicks(useBodyStore, behindFirst ? pair : decltype(pair){ pair[1], pair[0] });
+					touched[useBodyStore ? 0 : 1] += pair[0]->CollidedThisFrame ? 1 : 0;
+
+					std::vector<DirectX::SimpleMath::Vector2> result = { pair[0]->Position, pair[1]->Position, pair[0]->Velocity, pair[1]->Velocity };
+					if (useBodyStore && !outcome.empty())
+					{
+						sameOutcome = sameOutcome && result == outcome;
+					}
+					outcome = result;
+				}
+			}
+
+			const bool orderFree = touched[0] == 2 && sameOutcome;
+			printf("%-30s %-18s touched in %d of 2 orders\n", "touch at the tick's start", orderFree ? "ok" : "FAILED", touched[1]);
+			passed = passed && orderFree;
+		}
+
+		// An object spawned by a touch moves from the next update on
+		{
+			DirectX::SimpleMath::Vector2 moved[2][2];
+			for (bool useBodyStore : { true, false })
+			{
+				for (int ticks : { 1, 2 })
+				{
+					auto pair = MakeBodyOrderPair();
+					auto spawner = std::make_shared<SpawningObject>();
+					spawner->Position = pair[1]->Position;
+					spawner->Velocity = pair[1]->Velocity;
+					spawner->Radius = pair[1]->Radius;
+					RunBodyOrderTicks(useBodyStore, { pair[0], spawner }, ticks);
+
+					moved[useBodyStore ? 0 : 1][ticks - 1] = spawner->Spawned ? spawner->Spawned->Position - DirectX::SimpleMath::Vector2(500.0f, 900.0f) : DirectX::SimpleMath::Vector2(-1.0f, -1.0f);
+				}
+			}
+
+			const DirectX::SimpleMath::Vector2 oneTick(600.0f * c_bodyOrderTestStep, 0.0f);
+			const bool waited = moved[0][0] == DirectX::SimpleMath::Vector2::Zero && DirectX::SimpleMath::Vector2::Distance(moved[0][1], oneTick) < 1e-3f;
+			printf("%-30s %-18s moved %.1f, then %.1f\n", "spawned mid-update waits", waited ? "ok" : "FAILED", moved[1][0].x, moved[1][1].x);
+			passed = passed && waited;
+		}
+
+		// A light object running head on into a heavy one rebounds as it would in the walk
+		{
+			DirectX::SimpleMath::Vector2 velocities[2][2];
+			for (bool useBodyStore : { true, false })
+			{
+				auto light = std::make_shared<GameplayObject>();
+				light->Position = DirectX::SimpleMath::Vector2(100.0f, 500.0f);
+				light->Velocity = DirectX::SimpleMath::Vector2(600.0f, 0.0f);
+				light->Radius = 20.0f;
+				auto heavy = std::make_shared<GameplayObject>();
+				heavy->Position = DirectX::SimpleMath::Vector2(145.0f, 500.0f);
+				heavy->Velocity = DirectX::SimpleMath::Vector2(-60.0f, 0.0f);
+				heavy->Radius = 20.0f;
+				heavy->Mass = 3.0f;
+				RunBodyOrderTicks(useBodyStore, { light, heavy });
+
+				velocities[useBodyStore ? 0 : 1][0] = light->Velocity;
+				velocities[useBodyStore ? 0 : 1][1] = heavy->Velocity;
+			}
+
+			// An elastic collision of masses 1 and 3, closing at 660
+			const bool rebounded =
+				DirectX::SimpleMath::Vector2::Distance(velocities[0][0], DirectX::SimpleMath::Vector2(-390.0f, 0.0f)) < 1e-3f &&
+				DirectX::SimpleMath::Vector2::Distance(velocities[0][1], DirectX::SimpleMath::Vector2(270.0f, 0.0f)) < 1e-3f &&
+				velocities[0][0] == velocities[1][0] && velocities[0][1] == velocities[1][1];
+			printf("%-30s %-18s %.1f and %.1f\n", "rebound by mass", rebounded ? "ok" : "FAILED", velocities[1][0].x, velocities[1][1].x);
+			passed = passed && rebounded;
+		}
+
+		return passed;
+	}
+
+	void PrintHostedHeader(const HeadlessSettings& settings)
+	{
+		printf("%u players per match, %u Hz, %.0f s per run; jitter is tick start lateness in ms\n",
+			settings.Players,
+			settings.TicksPerSecond,
+			settings.DurationSeconds);
+		printf("matches workers   tick ms  jitter50  jitter99 jitterMax worst99/m  on-time  overruns   wins\n");
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	HeadlessSettings settings;
+	if (!ParseCommandLine(argc, argv, settings))
+	{
+		return EXIT_FAILURE;
+	}
+
+	DebugSetEnabled(settings.Verbose);
+
+	int result = EXIT_SUCCESS;
+
+	switch (settings.Mode)
+	{
+	case RunMode::Soak:
+		RunSoak(settings);
+		break;
+
+	case RunMode::Host:
+		PrintHostedHeader(settings);
+		RunHosted(settings, settings.Matches);
+		break;
+
+	case RunMode::LoadTest:
+		PrintHostedHeader(settings);
+		for (uint32_t matches = 1; ; matches *= 2)
+		{
+			matches = std::min(matches, settings.Matches);
+			RunHosted(settings, matches);
+			if (matches == settings.Matches)
+			{
+				break;
+			}
+		}
+		break;
+
+	case RunMode::PredictionTest:
+		if (!RunPredictionTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::InterpolationTest:
+		if (!RunInterpolationTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::BundleTest:
+		if (!RunBundleTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::LoopbackTest:
+		if (!RunLoopbackTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::RollbackTest:
+		if (!RunRollbackTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::RosterBenchmark:
+		if (!RunRosterBenchmark(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::TimestepBenchmark:
+		if (!RunTimestepBenchmark(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::CollisionTest:
+		if (!RunCollisionTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::BodyBenchmark:
+		if (!RunBodyBenchmark(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::FiringBenchmark:
+		if (!RunFiringBenchmark(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::ExplosionBenchmark:
+		if (!RunExplosionBenchmark(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::BroadphaseBenchmark:
+		if (!RunBroadphaseBenchmark(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::ShipDataTest:
+		if (!RunShipDataTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::BitBufferTest:
+		if (!RunBitBufferTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::ParticleBenchmark:
+		if (!RunParticleBenchmark(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+
+	case RunMode::BodyOrderTest:
+		if (!RunBodyOrderTest(settings))
+		{
+			result = EXIT_FAILURE;
+		}
+		break;
+	}
+
+	DebugShutdown();
+
+	return result;
+}
@@ -0,0 +1,159 @@
+//--------------------------------------------------------------------------------------
+// MatchHost.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "MatchHost.h"
+
+#include <thread>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace NetRumble;
+
+MatchHost::MatchHost(const Settings& settings) :
+	m_settings(settings)
+{
+	m_settings.TicksPerSecond = std::max<uint32_t>(m_settings.TicksPerSecond, 1);
+	m_settings.Workers = std::clamp<uint32_t>(m_settings.Workers, 1, std::max<uint32_t>(m_settings.Matches, 1));
+}
+
+void MatchHost::Run(std::chrono::duration<double> duration)
+{
+	m_reports.assign(m_settings.Matches, MatchReport{});
+	m_overruns.assign(m_settings.Workers, 0);
+	m_workersReady = 0;
+
+	std::vector<std::thread> workers;
+	workers.reserve(m_settings.Workers);
+	for (uint32_t worker = 0; worker < m_settings.Workers; ++worker)
+	{
+		workers.emplace_back(&MatchHost::RunWorker, this, worker, duration);
+	}
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+uint64_t MatchHost::GetOverruns() const
+{
+	uint64_t overruns = 0;
+	for (uint64_t workerOverruns : m_overruns)
+	{
+		overruns += workerOverruns;
+	}
+
+	return overruns;
+}
+
+void MatchHost::RunWorker(uint32_t worker, std::chrono::duration<double> duration)
+{
+	using Clock = std::chrono::steady_clock;
+
+	if (m_settings.PinWorkers && !PinToCore(worker % std::max(std::thread::hardware_concurrency(), 1u)))
+	{
+		DEBUGLOG("MatchHost: could not pin worker %u\n", worker);
+	}
+
+	RandomMath::Seed(m_settings.Seed + worker);
+
+	struct HostedMatch
+	{
+		std::unique_ptr<Game> Match;
+		MatchReport* Report;
+		double TotalTickMilliseconds;
+	};
+
+	// Build the shard on this thread so its worlds are allocated where they will run
+	size_t expectedTicks = static_cast<size_t>(duration.count() * m_settings.TicksPerSecond) + 1;
+	std::vector<HostedMatch> shard;
+	for (uint32_t match = worker; match < m_settings.Matches; match += m_settings.Workers)
+	{
+		auto game = std::make_unique<Game>();
+		game->Initialize(m_settings.TicksPerSecond);
+		for (uint32_t player = 0; player < m_settings.PlayersPerMatch; ++player)
+		{
+			game->AddSimulatedPlayer("Bot " + std::to_string(player + 1));
+		}
+		game->StartMatch();
+
+		MatchReport& report = m_reports[match];
+		report.Worker = worker;
+		report.JitterMilliseconds.reserve(expectedTicks);
+
+		shard.push_back(HostedMatch{ std::move(game), &report, 0.0 });
+	}
+
+	// Start together so every worker's schedule covers the same stretch of wall time
+	m_workersReady.fetch_add(1);
+	while (m_workersReady.load() < m_settings.Workers)
+	{
+		std::this_thread::yield();
+	}
+
+	const auto tickPeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_settings.TicksPerSecond));
+	const auto stop = Clock::now() + std::chrono::duration_cast<Clock::duration>(duration);
+	auto nextTick = Clock::now();
+
+	while (nextTick < stop)
+	{
+		nextTick += tickPeriod;
+		std::this_thread::sleep_until(nextTick);
+
+		for (HostedMatch& hosted : shard)
+		{
+			auto tickStart = Clock::now();
+			hosted.Report->JitterMilliseconds.push_back(std::chrono::duration<float, std::milli>(tickStart - nextTick).count());
+
+			hosted.Match->MakeCurrent();
+			hosted.Match->Tick();
+			if (hosted.Match->IsMatchOver())
+			{
+				hosted.Report->MatchesCompleted++;
+				hosted.Match->StartMatch();
+			}
+
+			hosted.TotalTickMilliseconds += std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count();
+			hosted.Report->Ticks++;
+		}
+
+		// A shard that cannot finish a round inside one period drops the ticks it missed
+		// rather than bursting to catch up
+		auto now = Clock::now();
+		if (now - nextTick >= tickPeriod)
+		{
+			m_overruns[worker]++;
+			nextTick = now;
+		}
+	}
+
+	for (HostedMatch& hosted : shard)
+	{
+		if (hosted.Report->Ticks > 0)
+		{
+			hosted.Report->AverageTickMilliseconds = static_cast<float>(hosted.TotalTickMilliseconds / hosted.Report->Ticks);
+		}
+	}
+
+	// Each Game binds itself while it is destroyed
+	shard.clear();
+}
+
+bool MatchHost::PinToCore(uint32_t core)
+{
+#ifdef _WIN32
+	return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (core % 64)) != 0;
+#else
+	cpu_set_t cpus;
+	CPU_ZERO(&cpus);
+	CPU_SET(core % CPU_SETSIZE, &cpus);
+	return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#endif
+}
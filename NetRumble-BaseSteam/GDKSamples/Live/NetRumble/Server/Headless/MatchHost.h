@@ -0,0 +1,67 @@
+//--------------------------------------------------------------------------------------
+// MatchHost.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "pch.h"
+
+#include <chrono>
+
+namespace NetRumble
+{
+	// Runs many independent matches in one process. Matches are dealt round-robin to worker
+	// threads, one pinned per core, and each worker creates, ticks and destroys only its own
+	// shard. A match's Game, World and managers never leave that thread, so workers share
+	// nothing mutable beyond the report slots they each fill in.
+	class MatchHost final
+	{
+	public:
+		struct Settings
+		{
+			uint32_t Matches = 1;
+			uint32_t PlayersPerMatch = DEFAULT_PLAYERS_PER_SERVER;
+			uint32_t TicksPerSecond = 60;
+			uint32_t Workers = 1;
+			uint32_t Seed = 1;
+			bool PinWorkers = true;
+		};
+
+		// What one match saw over a run. Jitter is how late each tick started against the
+		// fixed schedule, so a match deep in a busy shard waits on the ones ahead of it.
+		struct MatchReport
+		{
+			uint32_t Worker = 0;
+			uint64_t Ticks = 0;
+			uint32_t MatchesCompleted = 0;
+			float AverageTickMilliseconds = 0.0f;
+			std::vector<float> JitterMilliseconds;
+		};
+
+		explicit MatchHost(const Settings& settings);
+
+		MatchHost(MatchHost const&) = delete;
+		MatchHost& operator= (MatchHost const&) = delete;
+
+		// Ticks every match in real time for the given duration, then tears them all down
+		void Run(std::chrono::duration<double> duration);
+
+		inline const Settings& GetSettings() const { return m_settings; }
+		inline const std::vector<MatchReport>& GetReports() const { return m_reports; }
+
+		// Rounds where a worker could not tick its whole shard within one period
+		uint64_t GetOverruns() const;
+
+	private:
+		void RunWorker(uint32_t worker, std::chrono::duration<double> duration);
+
+		static bool PinToCore(uint32_t core);
+
+		Settings m_settings;
+		std::vector<MatchReport> m_reports;
+		std::vector<uint64_t> m_overruns;
+		std::atomic_uint32_t m_workersReady{ 0 };
+	};
+}
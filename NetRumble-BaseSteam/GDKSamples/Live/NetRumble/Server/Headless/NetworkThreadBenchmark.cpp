@@ -0,0 +1,298 @@
+//--------------------------------------------------------------------------------------
+// NetworkThreadBenchmark.cpp
+//
+// Measures what pumping the transport on the game thread costs the frame, against
+// pumping it on NetworkThread.
+//
+//   NetRumbleNetworkThreadBenchmark [--frames N] [--rate MESSAGES_PER_SECOND]
+//
+// A sender thread stands in for the transport: it delivers game messages into a locked
+// inbox at a steady rate, stamped with when they arrived. Each pump takes whatever is in
+// the inbox, and every so often also does a slow batch of transport work, the way a
+// burst of state changes makes a Party or Steam pump run long. The game runs a 60 Hz
+// loop that pumps (inline only), applies the messages, simulates and sends one message.
+//
+// Reported for each mode: how long messages waited between arriving and being applied,
+// and the mean and spread of the game thread's busy time per frame.
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "NetworkThread.h"
+
+using namespace NetRumble;
+
+namespace
+{
+	using Clock = NetworkThread::Clock;
+
+	constexpr auto c_frameInterval = std::chrono::microseconds(16667);
+	// Game work per frame, apart from applying messages
+	constexpr auto c_simulateWork = std::chrono::milliseconds(4);
+	// Every this many pumps, the transport has a slow batch of work to do as well
+	constexpr uint32_t c_slowPumpInterval = 20;
+	constexpr auto c_slowPumpWork = std::chrono::milliseconds(3);
+	constexpr size_t c_messageBytes = 256;
+
+	// Busy, rather than asleep, the way real work keeps a thread
+	void Work(Clock::duration duration)
+	{
+		const Clock::time_point end = Clock::now() + duration;
+		while (Clock::now() < end)
+		{
+		}
+	}
+
+	// Stands in for the transport's own receive queue, filled from its socket thread
+	class Transport
+	{
+	public:
+		struct Message
+		{
+			Clock::time_point ReceivedAt;
+			std::vector<uint8_t> Data;
+		};
+
+		explicit Transport(uint32_t messagesPerSecond) :
+			m_interval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / std::max<uint32_t>(messagesPerSecond, 1)))),
+			m_thread([this]() { Run(); })
+		{
+		}
+
+		~Transport()
+		{
+			m_running = false;
+			m_thread.join();
+		}
+
+		// Takes everything delivered so far, doing the slow batch of work when one is due
+		template<typename Handler>
+		size_t Pump(Handler&& handler)
+		{
+			if (++m_pumps % c_slowPumpInterval == 0)
+			{
+				Work(c_slowPumpWork);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_taken.swap(m_inbox);
+			}
+
+			for (const Message& message : m_taken)
+			{
+				handler(message);
+			}
+
+			const size_t count = m_taken.size();
+			m_taken.clear();
+			return count;
+		}
+
+		void Send(DataBufferView message)
+		{
+			m_sentBytes.fetch_add(message.size(), std::memory_order_relaxed);
+		}
+
+		inline uint64_t GetSentBytes() const { return m_sentBytes.load(std::memory_order_relaxed); }
+
+	private:
+		void Run()
+		{
+			uint8_t sequence = 0;
+			Clock::time_point next = Clock::now();
+			while (m_running)
+			{
+				next += m_interval;
+				std::this_thread::sleep_until(next);
+
+				Message message;
+				message.ReceivedAt = Clock::now();
+				message.Data.assign(c_messageBytes, sequence++);
+
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_inbox.push_back(std::move(message));
+			}
+		}
+
+		Clock::duration m_interval;
+		std::mutex m_mutex;
+		std::vector<Message> m_inbox;
+		// Pumping thread only
+		std::vector<Message> m_taken;
+		uint32_t m_pumps = 0;
+		std::atomic<uint64_t> m_sentBytes{ 0 };
+		std::atomic<bool> m_running{ true };
+		std::thread m_thread;
+	};
+
+	struct Result
+	{
+		std::vector<float> LatencyMilliseconds;
+		std::vector<float> FrameMilliseconds;
+		uint64_t Stalls = 0;
+	};
+
+	// Stands in for decoding a message and applying it to the world
+	uint32_t ApplyMessage(DataBufferView message)
+	{
+		uint32_t checksum = 0;
+		for (uint8_t value : message)
+		{
+			checksum = checksum * 31 + value;
+		}
+
+		return checksum;
+	}
+
+	Result RunGame(uint32_t frames, uint32_t messagesPerSecond, bool networkThread)
+	{
+		Result result;
+		result.FrameMilliseconds.reserve(frames);
+
+		Transport transport(messagesPerSecond);
+		uint32_t checksum = 0;
+		const std::vector<uint8_t> outgoing(c_messageBytes, 0);
+
+		auto Apply = [&](Clock::time_point receivedAt, DataBufferView message)
+		{
+			checksum += ApplyMessage(message);
+			result.LatencyMilliseconds.push_back(std::chrono::duration<float, std::milli>(Clock::now() - receivedAt).count());
+		};
+
+		std::unique_ptr<NetworkThread> thread;
+		if (networkThread)
+		{
+			thread = std::make_unique<NetworkThread>(
+				[&transport](NetworkThread& network)
+				{
+					transport.Pump([&network](const Transport::Message& message) { network.Received(0, message.ReceivedAt, message.Data); });
+				},
+				[&transport](const NetworkPacket& packet) { transport.Send(packet.Data); });
+		}
+
+		Clock::time_point nextFrame = Clock::now();
+		for (uint32_t frame = 0; frame < frames; ++frame)
+		{
+			nextFrame += std::chrono::duration_cast<Clock::duration>(c_frameInterval);
+			const Clock::time_point frameStart = Clock::now();
+
+			if (thread)
+			{
+				thread->Apply([&](const NetworkPacket& packet) { Apply(packet.ReceivedAt, packet.Data); });
+			}
+			else
+			{
+				transport.Pump([&](const Transport::Message& message) { Apply(message.ReceivedAt, message.Data); });
+			}
+
+			Work(c_simulateWork);
+
+			if (thread)
+			{
+				thread->Send(0, 0, outgoing);
+			}
+			else
+			{
+				transport.Send(outgoing);
+			}
+
+			result.FrameMilliseconds.push_back(std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count());
+			std::this_thread::sleep_until(nextFrame);
+		}
+
+		if (thread)
+		{
+			result.Stalls = thread->GetStalls();
+		}
+
+		// Kept so the applies can't be optimized away
+		if (checksum == 1)
+		{
+			printf(" ");
+		}
+
+		return result;
+	}
+
+	float Percentile(std::vector<float> values, double percentile)
+	{
+		if (values.empty())
+		{
+			return 0.0f;
+		}
+
+		const size_t index = std::min(values.size() - 1, static_cast<size_t>(percentile * (values.size() - 1)));
+		std::nth_element(values.begin(), values.begin() + static_cast<ptrdiff_t>(index), values.end());
+		return values[index];
+	}
+
+	void Print(const char* name, const Result& result)
+	{
+		double mean = 0.0;
+		for (float frame : result.FrameMilliseconds)
+		{
+			mean += frame;
+		}
+		mean /= std::max<size_t>(result.FrameMilliseconds.size(), 1);
+
+		double variance = 0.0;
+		for (float frame : result.FrameMilliseconds)
+		{
+			variance += (frame - mean) * (frame - mean);
+		}
+		variance /= std::max<size_t>(result.FrameMilliseconds.size(), 1);
+
+		printf("%-16s %8zu %8.2f %8.2f %8.2f %10.2f %8.2f %8.2f %8llu\n",
+			name,
+			result.LatencyMilliseconds.size(),
+			Percentile(result.LatencyMilliseconds, 0.5),
+			Percentile(result.LatencyMilliseconds, 0.99),
+			Percentile(result.LatencyMilliseconds, 1.0),
+			mean,
+			std::sqrt(variance),
+			Percentile(result.FrameMilliseconds, 1.0),
+			static_cast<unsigned long long>(result.Stalls));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t frames = 600;
+	uint32_t messagesPerSecond = 600;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--frames") == 0)
+		{
+			frames = static_cast<uint32_t>(strtoul(argv[i + 1], nullptr, 10));
+		}
+		else if (strcmp(argv[i], "--rate") == 0)
+		{
+			messagesPerSecond = static_cast<uint32_t>(strtoul(argv[i + 1], nullptr, 10));
+		}
+	}
+
+	const Result inlineResult = RunGame(frames, messagesPerSecond, false);
+	const Result threadResult = RunGame(frames, messagesPerSecond, true);
+
+	printf("%u frames at 60 Hz, %u messages per second\n", frames, messagesPerSecond);
+	printf("%-16s %8s %26s %28s %8s\n", "", "", "receive to apply, ms", "game thread per frame, ms", "");
+	printf("%-16s %8s %8s %8s %8s %10s %8s %8s %8s\n", "pump", "messages", "p50", "p99", "max", "mean", "stddev", "max", "stalls");
+	Print("game thread", inlineResult);
+	Print("network thread", threadResult);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+//--------------------------------------------------------------------------------------
+// PredictionTest.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "PredictionTest.h"
+
+using namespace NetRumble;
+using namespace DirectX;
+
+namespace
+{
+	// The test pilot holds a heading for a while, then picks another; near the edge of the
+	// world it turns back towards the middle so the run isn't spent bouncing off the walls
+	constexpr float c_headingMinimum = 0.25f;
+	constexpr float c_headingMaximum = 1.5f;
+	constexpr float c_edgeMargin = 300.0f;
+}
+
+PredictionTest::PredictionTest(const Settings& settings) :
+	m_settings(settings),
+	m_random(settings.Seed)
+{
+	m_settings.TicksPerSecond = std::max<uint32_t>(m_settings.TicksPerSecond, 1);
+	m_settings.LossPercent = std::clamp(m_settings.LossPercent, 0.0f, 100.0f);
+}
+
+PredictionTest::Report PredictionTest::Run()
+{
+	Report report;
+
+	const float elapsedTime = 1.0f / m_settings.TicksPerSecond;
+	const uint64_t ticks = static_cast<uint64_t>(m_settings.DurationSeconds * m_settings.TicksPerSecond);
+
+	auto host = std::make_unique<Game>();
+	host->Initialize(m_settings.TicksPerSecond);
+	auto client = std::make_unique<Game>();
+	client->Initialize(m_settings.TicksPerSecond);
+
+	const RECT bounds = client->GetWorld()->GetDimensions();
+	const SimpleMath::Vector2 center(
+		static_cast<float>(bounds.left + bounds.right) * 0.5f,
+		static_cast<float>(bounds.top + bounds.bottom) * 0.5f);
+
+	// Each ship belongs to its own match; the client's is the one it predicts
+	host->MakeCurrent();
+	auto hostShip = std::make_shared<Ship>();
+	hostShip->Position = center;
+	hostShip->Initialize(false, false);
+
+	client->MakeCurrent();
+	auto clientShip = std::make_shared<Ship>();
+	clientShip->Position = center;
+	clientShip->Initialize(true, false);
+
+	std::deque<Packet> up;
+	std::deque<Packet> down;
+	BitBufferWriter dataWriter;
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	SimpleMath::Vector2 heading = SimpleMath::Vector2::Zero;
+	float headingTimer = 0.0f;
+	int updatesSinceShipInput = 0;
+	int updatesSinceShipData = 0;
+	uint32_t shipDataSequence = 0;
+
+	for (uint64_t tick = 0; tick < ticks; ++tick)
+	{
+		const double now = static_cast<double>(tick) * elapsedTime;
+
+		// Client: apply what the host has said, then make and predict this step's move
+		client->MakeCurrent();
+
+		while (!down.empty() && down.front().DeliverAt <= now)
+		{
+			const Packet& packet = down.front();
+			float snapDistance = SimpleMath::Vector2::Distance(packet.SentPosition, clientShip->Position);
+
+			uint32_t corrections = clientShip->GetPredictionCorrections();
+			BitBufferReader dataReader(DataBufferView(packet.Data.data(), packet.Data.size()));
+			clientShip->Deserialize(dataReader, bounds, packet.Sequence, packet.HostTime);
+
+			if (clientShip->GetPredictionCorrections() != corrections)
+			{
+				report.Corrections++;
+				report.PredictionErrors.push_back(clientShip->GetLastPredictionError());
+				report.SnapDistances.push_back(snapDistance);
+			}
+			down.pop_front();
+		}
+
+		headingTimer -= elapsedTime;
+		if (headingTimer <= 0.0f)
+		{
+			float angle = unit(m_random) * XM_2PI;
+			heading = SimpleMath::Vector2(std::sin(angle), -std::cos(angle));
+			headingTimer = c_headingMinimum + unit(m_random) * (c_headingMaximum - c_headingMinimum);
+
+			if (clientShip->Position.x < bounds.left + c_edgeMargin || clientShip->Position.x > bounds.right - c_edgeMargin ||
+				clientShip->Position.y < bounds.top + c_edgeMargin || clientShip->Position.y > bounds.bottom - c_edgeMargin)
+			{
+				heading = center - clientShip->Position;
+				heading.Normalize();
+			}
+		}
+
+		// Sticks are in screen space with up positive; Ship::Update flips Y back into world space
+		clientShip->HoldInput(ShipInput(SimpleMath::Vector2(heading.x, -heading.y), SimpleMath::Vector2::Zero, false));
+		clientShip->RecordMove(elapsedTime);
+		clientShip->Update(elapsedTime);
+		Managers::Get<CollisionManager>()->Update(elapsedTime);
+		clientShip->RecordPredictedMotion();
+
+		// As World sends them
+		if (++updatesSinceShipInput >= World::c_UpdatesBetweenShipInputPackets)
+		{
+			updatesSinceShipInput = 0;
+			dataWriter.Reset();
+			clientShip->SerializeMoves(dataWriter);
+			report.BytesUp += dataWriter.View().size();
+			Send(up, now, dataWriter, clientShip->Position, 0);
+		}
+
+		// Host: apply the moves that have arrived and report back where they left the ship
+		host->MakeCurrent();
+
+		while (!up.empty() && up.front().DeliverAt <= now)
+		{
+			hostShip->DeserializeMoves(DataBufferView(up.front().Data.data(), up.front().Data.size()));
+			up.pop_front();
+		}
+
+		hostShip->Update(elapsedTime);
+		Managers::Get<CollisionManager>()->Update(elapsedTime);
+
+		if (++updatesSinceShipData >= World::c_UpdatesBetweenShipDataPackets)
+		{
+			updatesSinceShipData = 0;
+			dataWriter.Reset();
+			hostShip->Serialize(dataWriter, bounds);
+			report.BytesDown += dataWriter.View().size();
+			Send(down, now, dataWriter, hostShip->Position, ++shipDataSequence);
+		}
+	}
+
+	// Ships go first, each while its own match's managers are bound
+	host->MakeCurrent();
+	hostShip.reset();
+	host.reset();
+	client->MakeCurrent();
+	clientShip.reset();
+	client.reset();
+
+	return report;
+}
+
+// Lost packets are dropped here; the rest arrive in order after half the round trip
+void PredictionTest::Send(std::deque<Packet>& link, double now, const BitBufferWriter& dataWriter, const SimpleMath::Vector2& sentPosition, uint32_t sequence)
+{
+	if (std::uniform_real_distribution<float>(0.0f, 100.0f)(m_random) < m_settings.LossPercent)
+	{
+		return;
+	}
+
+	DataBufferView view = dataWriter.View();
+
+	Packet packet;
+	packet.DeliverAt = now + m_settings.LatencyMilliseconds * 0.0005;
+	packet.Data.assign(view.begin(), view.end());
+	packet.SentPosition = sentPosition;
+	packet.Sequence = sequence;
+	packet.HostTime = static_cast<float>(now);
+	link.push_back(std::move(packet));
+}
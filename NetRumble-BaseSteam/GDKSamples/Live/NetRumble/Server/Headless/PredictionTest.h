@@ -0,0 +1,67 @@
+//--------------------------------------------------------------------------------------
+// PredictionTest.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "pch.h"
+
+namespace NetRumble
+{
+	// Flies one ship between a client and a host over a simulated link and measures how far
+	// the client's prediction of it was from where the host put it. Each side is its own
+	// headless Game on this thread; ShipInput and ServerUpdateShipData packets are passed
+	// between them through delay queues, so only the prediction code is under test.
+	class PredictionTest final
+	{
+	public:
+		struct Settings
+		{
+			// Round trip, split evenly between the two directions
+			uint32_t LatencyMilliseconds = 150;
+			float LossPercent = 0.0f;
+			uint32_t TicksPerSecond = 60;
+			double DurationSeconds = 60.0;
+			uint32_t Seed = 1;
+		};
+
+		// Distances in pixels, one sample per ServerUpdateShipData the client applied.
+		// PredictionErrors is how far the client's prediction was from the host's state for
+		// the same move; SnapDistances is how far the ship would have jumped had the client
+		// simply taken the host's state, as it did before prediction.
+		struct Report
+		{
+			uint32_t Corrections = 0;
+			std::vector<float> PredictionErrors;
+			std::vector<float> SnapDistances;
+			uint64_t BytesUp = 0;
+			uint64_t BytesDown = 0;
+		};
+
+		explicit PredictionTest(const Settings& settings);
+
+		PredictionTest(PredictionTest const&) = delete;
+		PredictionTest& operator= (PredictionTest const&) = delete;
+
+		Report Run();
+
+	private:
+		struct Packet
+		{
+			double DeliverAt;
+			std::vector<uint8_t> Data;
+			DirectX::SimpleMath::Vector2 SentPosition;
+
+			// How World stamps ship data, for the receiving ship's snapshot buffer
+			uint32_t Sequence;
+			float HostTime;
+		};
+
+		void Send(std::deque<Packet>& link, double now, const BitBufferWriter& dataWriter, const DirectX::SimpleMath::Vector2& sentPosition, uint32_t sequence);
+
+		Settings m_settings;
+		std::minstd_rand m_random;
+	};
+}
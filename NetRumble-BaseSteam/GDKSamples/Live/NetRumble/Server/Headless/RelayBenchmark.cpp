@@ -0,0 +1,276 @@
+//--------------------------------------------------------------------------------------
+// RelayBenchmark.cpp
+//
+// Measures what NetRumbleServer spends relaying a client's ShipInput to the other
+// players, against the way it used to.
+//
+//   NetRumbleRelayBenchmark [--frames N]
+//
+// Every frame each player sends one ShipInput and the server relays it to everyone but
+// the sender and the host. The previous relay scanned every slot for the sender, built a
+// std::set of connections to ignore, looked each slot up in it, and copied the message
+// into the destination's bundle run; the runs went out at the end of the frame. The
+// current one finds the sender through ServerSlots and ignores by SlotMask, and still
+// bundles each destination's relays into one send at the end of the frame. The send is a
+// stub standing in for Steam, so only the server's own work is timed.
+//
+// Reported for 4, 16 and 64 players: relays and deliveries per second, nanoseconds per
+// relay, and heap allocations per relay.
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DataBuffer.h"
+#include "ServerSlots.h"
+
+using namespace NetRumble;
+
+namespace
+{
+	uint64_t g_allocations = 0;
+}
+
+void* operator new(size_t size)
+{
+	g_allocations++;
+	if (void* memory = malloc(size == 0 ? 1 : size))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	constexpr uint32_t c_playerCounts[] = { 4, 16, 64 };
+	// A ShipInput with its type and source ID header and a few moves
+	constexpr size_t c_messageBytes = 72;
+	// Steam hands out connection handles close together, but not starting at 0
+	constexpr uint32_t c_firstConnection = 0x10001;
+	// The host's own client holds slot 0
+	constexpr uint32_t c_hostSlot = 0;
+
+	// Stands in for SteamGameServerNetworkingSockets()->SendMessageToConnection
+	struct Sink
+	{
+		uint64_t Bytes = 0;
+		uint32_t Checksum = 0;
+
+		inline void Send(uint32_t connection, DataBufferView message)
+		{
+			Bytes += message.size();
+			Checksum += connection ^ message[0];
+		}
+	};
+
+	struct ClientSlot
+	{
+		uint32_t Connection = 0;
+	};
+
+	// The relay as NetRumbleServer used to do it
+	class SetRelay
+	{
+	public:
+		explicit SetRelay(uint32_t players) :
+			m_clients(players),
+			m_runs(players)
+		{
+			for (uint32_t i = 0; i < players; ++i)
+			{
+				m_clients[i].Connection = c_firstConnection + i;
+			}
+		}
+
+		void Relay(uint32_t sender, DataBufferView message, Sink& sink)
+		{
+			// Found only for the debug log
+			for (uint32_t j = 0; j < m_clients.size(); ++j)
+			{
+				if (m_clients[j].Connection == sender)
+				{
+					sink.Checksum += j;
+				}
+			}
+
+			std::set<uint32_t> ignoreSet = { sender, m_clients[c_hostSlot].Connection };
+			ignoreSet.emplace(0);
+			for (uint32_t i = 0; i < m_clients.size(); ++i)
+			{
+				if (ignoreSet.find(m_clients[i].Connection) == ignoreSet.end())
+				{
+					std::vector<uint8_t>& run = m_runs[i];
+					run.insert(run.end(), message.begin(), message.end());
+				}
+			}
+		}
+
+		void Flush(Sink& sink)
+		{
+			for (uint32_t i = 0; i < m_runs.size(); ++i)
+			{
+				if (!m_runs[i].empty())
+				{
+					sink.Send(m_clients[i].Connection, m_runs[i]);
+					m_runs[i].clear();
+				}
+			}
+		}
+
+	private:
+		std::vector<ClientSlot> m_clients;
+		std::vector<std::vector<uint8_t>> m_runs;
+	};
+
+	// The relay as NetRumbleServer does it now
+	class SlotRelay
+	{
+	public:
+		explicit SlotRelay(uint32_t players) :
+			m_slots(players),
+			m_runs(players)
+		{
+			for (uint32_t i = 0; i < players; ++i)
+			{
+				m_slots.Assign(i, c_firstConnection + i);
+			}
+		}
+
+		void Relay(uint32_t sender, DataBufferView message, Sink& sink)
+		{
+			const uint32_t senderSlot = m_slots.Find(sender);
+			sink.Checksum += senderSlot;
+
+			const SlotMask ignoreSlots = ServerSlots::Bit(senderSlot) | m_slots.MaskOf(m_slots.ConnectionAt(c_hostSlot));
+			ServerSlots::ForEachSlot(m_slots.Held() & ~ignoreSlots, [&](uint32_t slot)
+				{
+					std::vector<uint8_t>& run = m_runs[slot];
+					run.insert(run.end(), message.begin(), message.end());
+				});
+		}
+
+		void Flush(Sink& sink)
+		{
+			ServerSlots::ForEachSlot(m_slots.Held(), [&](uint32_t slot)
+				{
+					if (!m_runs[slot].empty())
+					{
+						sink.Send(m_slots.ConnectionAt(slot), m_runs[slot]);
+						m_runs[slot].clear();
+					}
+				});
+		}
+
+	private:
+		ServerSlots m_slots;
+		std::vector<std::vector<uint8_t>> m_runs;
+	};
+
+	struct Result
+	{
+		double Seconds = 0.0;
+		uint64_t Relays = 0;
+		uint64_t Deliveries = 0;
+		uint64_t Allocations = 0;
+	};
+
+	template<class Relay>
+	Result Run(uint32_t players, uint32_t frames)
+	{
+		Relay relay(players);
+		Sink sink;
+		std::vector<uint8_t> message(c_messageBytes, 0);
+
+		// A frame first, so both start with their buffers grown
+		auto Frame = [&](uint32_t frame)
+		{
+			for (uint32_t player = 0; player < players; ++player)
+			{
+				message[0] = static_cast<uint8_t>(frame + player);
+				relay.Relay(c_firstConnection + player, message, sink);
+			}
+			relay.Flush(sink);
+		};
+		Frame(0);
+
+		const uint64_t sentBefore = sink.Bytes;
+		const uint64_t allocationsBefore = g_allocations;
+		const Clock::time_point start = Clock::now();
+		for (uint32_t frame = 1; frame <= frames; ++frame)
+		{
+			Frame(frame);
+		}
+
+		Result result;
+		result.Seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		result.Allocations = g_allocations - allocationsBefore;
+		result.Relays = static_cast<uint64_t>(players) * frames;
+		result.Deliveries = (sink.Bytes - sentBefore) / c_messageBytes;
+
+		// Kept so the sends can't be optimized away
+		if (sink.Checksum == 1)
+		{
+			printf(" ");
+		}
+
+		return result;
+	}
+
+	void Print(const char* name, uint32_t players, const Result& result)
+	{
+		printf("%-10s %8u %14.0f %14.0f %10.1f %12.2f\n",
+			name,
+			players,
+			result.Relays / result.Seconds,
+			result.Deliveries / result.Seconds,
+			result.Seconds * 1e9 / std::max<uint64_t>(result.Relays, 1),
+			static_cast<double>(result.Allocations) / std::max<uint64_t>(result.Relays, 1));
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	uint32_t frames = 20000;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--frames") == 0)
+		{
+			frames = std::max<uint32_t>(static_cast<uint32_t>(strtoul(argv[i + 1], nullptr, 10)), 1);
+		}
+	}
+
+	printf("%u frames, one %zu byte ShipInput per player per frame\n", frames, c_messageBytes);
+	printf("%-10s %8s %14s %14s %10s %12s\n", "relay", "players", "relays/s", "deliveries/s", "ns/relay", "allocs/relay");
+	for (uint32_t players : c_playerCounts)
+	{
+		Print("set", players, Run<SetRelay>(players, frames));
+		Print("slot mask", players, Run<SlotRelay>(players, frames));
+	}
+
+	return EXIT_SUCCESS;
+}
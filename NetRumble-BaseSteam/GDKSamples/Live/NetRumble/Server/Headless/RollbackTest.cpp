@@ -0,0 +1,279 @@
+//--------------------------------------------------------------------------------------
+// RollbackTest.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "RollbackTest.h"
+#include "LoopbackNetwork.h"
+
+#include <chrono>
+
+using namespace NetRumble;
+using namespace DirectX;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// How long a pilot holds a heading and a firing burst before picking others, in seconds
+	constexpr float c_pilotHoldMinimum = 0.25f;
+	constexpr float c_pilotHoldMaximum = 1.5f;
+
+	// Chance per second that a pilot drops a mine
+	constexpr float c_pilotMineRate = 0.1f;
+
+	// Long enough after the last input for every peer to settle every tick
+	constexpr double c_drainSeconds = 2.0;
+
+	float MicrosecondsBetween(double before, double after)
+	{
+		return static_cast<float>((after - before) * 1.0e6);
+	}
+}
+
+RollbackTest::RollbackTest(const Settings& settings) :
+	m_settings(settings)
+{
+	m_settings.Players = std::max<uint32_t>(m_settings.Players, 2);
+	m_settings.TicksPerSecond = std::max<uint32_t>(m_settings.TicksPerSecond, 1);
+	m_settings.LossPercent = std::clamp(m_settings.LossPercent, 0.0f, 100.0f);
+	m_settings.RewindTicks = std::clamp<uint32_t>(m_settings.RewindTicks, 1, RollbackSession::c_maximumRollback);
+}
+
+RollbackTest::Report RollbackTest::Run()
+{
+	Report report;
+	RunNetworked(report);
+	RunRewindBenchmark(report);
+	return report;
+}
+
+// Every peer's copy of the match has every player, as the lobby would have left them
+std::unique_ptr<Game> RollbackTest::CreateMatch() const
+{
+	auto game = std::make_unique<Game>();
+	game->Initialize(m_settings.TicksPerSecond);
+	for (uint32_t i = 0; i < m_settings.Players; ++i)
+	{
+		game->AddSimulatedPlayer("Player " + std::to_string(i + 1));
+	}
+	return game;
+}
+
+ShipInput RollbackTest::Fly(Pilot& pilot, float elapsedTime)
+{
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	pilot.Timer -= elapsedTime;
+	if (pilot.Timer <= 0.0f)
+	{
+		float heading = unit(pilot.Random) * XM_2PI;
+		float aim = unit(pilot.Random) * XM_2PI;
+		pilot.Heading = SimpleMath::Vector2(std::cos(heading), std::sin(heading));
+		pilot.Aim = SimpleMath::Vector2(std::cos(aim), std::sin(aim));
+		pilot.Firing = unit(pilot.Random) < 0.5f;
+		pilot.Timer = c_pilotHoldMinimum + unit(pilot.Random) * (c_pilotHoldMaximum - c_pilotHoldMinimum);
+	}
+
+	bool mineFired = unit(pilot.Random) < c_pilotMineRate * elapsedTime;
+
+	return ShipInput(pilot.Heading, pilot.Firing ? pilot.Aim : SimpleMath::Vector2::Zero, mineFired);
+}
+
+void RollbackTest::RunNetworked(Report& report)
+{
+	struct Peer
+	{
+		std::unique_ptr<Game> Match;
+		RollbackSession Session;
+		uint64_t PeerId = 0;
+		uint64_t Endpoint = 0;
+		Pilot Autopilot;
+		// Indexed by tick - 1, filled in as ticks settle
+		std::vector<uint64_t> Checksums;
+	};
+
+	LoopbackNetwork::Settings networkSettings;
+	networkSettings.LatencyMilliseconds = m_settings.LatencyMilliseconds;
+	networkSettings.JitterMilliseconds = m_settings.JitterMilliseconds;
+	networkSettings.LossPercent = m_settings.LossPercent;
+	networkSettings.Seed = m_settings.Seed;
+	LoopbackNetwork network(networkSettings);
+
+	std::vector<std::unique_ptr<Peer>> peers;
+	std::map<uint64_t, uint64_t> peerForEndpoint;
+	for (uint32_t i = 0; i < m_settings.Players; ++i)
+	{
+		auto peer = std::make_unique<Peer>();
+		peer->Match = CreateMatch();
+		peer->PeerId = i + 1;
+		peer->Endpoint = network.Connect();
+		peer->Autopilot.Random.seed(m_settings.Seed * 7919u + i);
+
+		peer->Match->MakeCurrent();
+		peer->Session.Start(*peer->Match->GetWorld(), peer->PeerId, m_settings.Seed, m_settings.TicksPerSecond);
+		peer->Session.SetChecksumsEnabled(true);
+
+		peerForEndpoint[peer->Endpoint] = peer->PeerId;
+		peers.push_back(std::move(peer));
+	}
+
+	const float elapsedTime = 1.0f / m_settings.TicksPerSecond;
+	const uint64_t ticks = static_cast<uint64_t>(m_settings.DurationSeconds * m_settings.TicksPerSecond);
+	const uint64_t drainTicks = static_cast<uint64_t>(c_drainSeconds * m_settings.TicksPerSecond);
+	BitBufferWriter dataWriter;
+
+	for (uint64_t tick = 0; tick < ticks + drainTicks; ++tick)
+	{
+		network.Advance(elapsedTime);
+
+		for (auto& peer : peers)
+		{
+			peer->Match->MakeCurrent();
+
+			network.Receive(peer->Endpoint, [&](uint64_t from, DataBufferView data)
+				{
+					peer->Session.DeserializeInputs(peerForEndpoint[from], data);
+				});
+
+			// Once the run is over the pilots let go, and the peers play on until they agree
+			peer->Session.SetLocalInput(tick < ticks ? Fly(peer->Autopilot, elapsedTime) : ShipInput());
+			peer->Session.Advance();
+
+			// Sent even when stalled: the acknowledgements are what gets the others going again
+			for (auto& other : peers)
+			{
+				if (other == peer)
+				{
+					continue;
+				}
+
+				dataWriter.Reset();
+				peer->Session.SerializeInputs(other->PeerId, dataWriter);
+				network.Send(peer->Endpoint, other->Endpoint, LoopbackNetwork::Delivery::Unreliable, dataWriter.View());
+				report.InputBytes += dataWriter.TotalBytes();
+				report.InputPackets++;
+			}
+
+			const uint32_t settled = peer->Session.GetSettledTick();
+			while (peer->Checksums.size() < settled)
+			{
+				peer->Checksums.push_back(peer->Session.GetChecksum(static_cast<uint32_t>(peer->Checksums.size() + 1)));
+			}
+		}
+	}
+
+	size_t compared = peers.front()->Checksums.size();
+	for (auto& peer : peers)
+	{
+		compared = std::min(compared, peer->Checksums.size());
+	}
+
+	for (size_t i = 0; i < compared; ++i)
+	{
+		for (auto& peer : peers)
+		{
+			if (peer->Checksums[i] != peers.front()->Checksums[i] || peer->Checksums[i] == 0)
+			{
+				report.Desyncs++;
+				break;
+			}
+		}
+	}
+	report.ComparedTicks = compared;
+
+	for (auto& peer : peers)
+	{
+		const RollbackSession::Statistics& statistics = peer->Session.GetStatistics();
+		report.Sessions.Ticks += statistics.Ticks;
+		report.Sessions.Stalls += statistics.Stalls;
+		report.Sessions.Mispredictions += statistics.Mispredictions;
+		report.Sessions.Rollbacks += statistics.Rollbacks;
+		report.Sessions.ResimulatedTicks += statistics.ResimulatedTicks;
+		report.Sessions.LongestRollback = std::max(report.Sessions.LongestRollback, statistics.LongestRollback);
+		report.Sessions.SaveSeconds += statistics.SaveSeconds;
+		report.Sessions.RestoreSeconds += statistics.RestoreSeconds;
+		report.Sessions.ResimulateSeconds += statistics.ResimulateSeconds;
+
+		peer->Match->MakeCurrent();
+		peer->Session.Stop();
+	}
+}
+
+// Both copies are told every input for a tick before simulating it, so the straight one
+// never rolls back and any difference between them is the rewind's doing
+void RollbackTest::RunRewindBenchmark(Report& report)
+{
+	std::unique_ptr<Game> straight = CreateMatch();
+	std::unique_ptr<Game> rewound = CreateMatch();
+	RollbackSession straightSession;
+	RollbackSession rewoundSession;
+
+	straight->MakeCurrent();
+	straightSession.Start(*straight->GetWorld(), 1, m_settings.Seed, m_settings.TicksPerSecond);
+	rewound->MakeCurrent();
+	rewoundSession.Start(*rewound->GetWorld(), 1, m_settings.Seed, m_settings.TicksPerSecond);
+
+	std::vector<Pilot> pilots(m_settings.Players);
+	for (uint32_t i = 0; i < m_settings.Players; ++i)
+	{
+		pilots[i].Random.seed(m_settings.Seed * 104729u + i);
+	}
+
+	const float elapsedTime = 1.0f / m_settings.TicksPerSecond;
+	const uint64_t ticks = static_cast<uint64_t>(m_settings.DurationSeconds * m_settings.TicksPerSecond);
+	std::vector<ShipInput> inputs(m_settings.Players);
+
+	for (uint64_t tick = 1; tick <= ticks; ++tick)
+	{
+		for (uint32_t i = 0; i < m_settings.Players; ++i)
+		{
+			inputs[i] = Fly(pilots[i], elapsedTime);
+		}
+
+		auto feed = [&](RollbackSession& session)
+			{
+				session.SetLocalInput(inputs[0]);
+				for (uint32_t i = 1; i < m_settings.Players; ++i)
+				{
+					session.AddRemoteInput(i + 1, static_cast<uint32_t>(tick), inputs[i]);
+				}
+			};
+
+		straight->MakeCurrent();
+		feed(straightSession);
+		const RollbackSession::Statistics straightBefore = straightSession.GetStatistics();
+		const Clock::time_point begin = Clock::now();
+		straightSession.Advance();
+		report.TickMicroseconds.push_back(std::chrono::duration<float, std::micro>(Clock::now() - begin).count());
+		report.SaveMicroseconds.push_back(MicrosecondsBetween(straightBefore.SaveSeconds, straightSession.GetStatistics().SaveSeconds));
+		const uint64_t straightChecksum = straight->GetWorld()->ComputeChecksum();
+
+		rewound->MakeCurrent();
+		feed(rewoundSession);
+		const bool rewind = tick > m_settings.RewindTicks;
+		if (rewind)
+		{
+			rewoundSession.ForceRollback(m_settings.RewindTicks);
+		}
+		const RollbackSession::Statistics rewoundBefore = rewoundSession.GetStatistics();
+		rewoundSession.Advance();
+		if (rewind)
+		{
+			report.RestoreMicroseconds.push_back(MicrosecondsBetween(rewoundBefore.RestoreSeconds, rewoundSession.GetStatistics().RestoreSeconds));
+			report.ResimulateMicroseconds.push_back(MicrosecondsBetween(rewoundBefore.ResimulateSeconds, rewoundSession.GetStatistics().ResimulateSeconds));
+		}
+
+		if (rewound->GetWorld()->ComputeChecksum() != straightChecksum)
+		{
+			report.RewindDesyncs++;
+		}
+	}
+
+	straight->MakeCurrent();
+	straightSession.Stop();
+	rewound->MakeCurrent();
+	rewoundSession.Stop();
+}
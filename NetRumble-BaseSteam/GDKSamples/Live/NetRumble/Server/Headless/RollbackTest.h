@@ -0,0 +1,83 @@
+//--------------------------------------------------------------------------------------
+// RollbackTest.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "pch.h"
+#include "RollbackSession.h"
+
+namespace NetRumble
+{
+	// Plays a match in rollback mode, then measures what a rewind costs.
+	//
+	// First each player is its own peer: a headless Game on this thread with a RollbackSession,
+	// sending its inputs to the others over a LoopbackNetwork. Every tick all of them have
+	// settled is checksummed, and every peer must agree on every one.
+	//
+	// Then two copies of one match are fed the same inputs; one is forced to rewind and
+	// simulate RewindTicks again before every tick. The time to save, restore and resimulate
+	// is sampled, and both copies must end every tick in the same state.
+	class RollbackTest final
+	{
+	public:
+		struct Settings
+		{
+			uint32_t Players = 4;
+			// Round trip, split evenly between the two directions
+			uint32_t LatencyMilliseconds = 100;
+			uint32_t JitterMilliseconds = 10;
+			float LossPercent = 0.0f;
+			uint32_t TicksPerSecond = 60;
+			double DurationSeconds = 30.0;
+			uint32_t RewindTicks = RollbackSession::c_maximumRollback;
+			uint32_t Seed = 1;
+		};
+
+		struct Report
+		{
+			// Totals across every peer of the networked match
+			RollbackSession::Statistics Sessions;
+			uint64_t InputBytes = 0;
+			uint64_t InputPackets = 0;
+			uint64_t ComparedTicks = 0;
+			uint64_t Desyncs = 0;
+
+			// One sample per tick of the rewind benchmark, in microseconds
+			std::vector<float> TickMicroseconds;
+			std::vector<float> SaveMicroseconds;
+			std::vector<float> RestoreMicroseconds;
+			std::vector<float> ResimulateMicroseconds;
+			uint64_t RewindDesyncs = 0;
+		};
+
+		explicit RollbackTest(const Settings& settings);
+
+		RollbackTest(RollbackTest const&) = delete;
+		RollbackTest& operator= (RollbackTest const&) = delete;
+
+		Report Run();
+
+	private:
+		// Steers like a player: a heading and a firing burst held for a while, then others
+		struct Pilot
+		{
+			std::minstd_rand Random;
+			DirectX::SimpleMath::Vector2 Heading;
+			DirectX::SimpleMath::Vector2 Aim;
+			bool Firing = false;
+			float Timer = 0.0f;
+		};
+
+		static ShipInput Fly(Pilot& pilot, float elapsedTime);
+
+		void RunNetworked(Report& report);
+		void RunRewindBenchmark(Report& report);
+
+		std::unique_ptr<Game> CreateMatch() const;
+
+		Settings m_settings;
+	};
+}
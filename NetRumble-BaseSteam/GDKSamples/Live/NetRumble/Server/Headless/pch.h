@@ -0,0 +1,87 @@
+//
+// pch.h
+// Header for standard system include files.
+//
+// The headless server builds the gameplay simulation from Common against the
+// Renderer\Headless backend, with NETRUMBLE_HEADLESS defined. Nothing here may pull
+// in Direct3D, XAudio, input devices or the Steam client.
+//
+
+#pragma once
+
+#ifndef NETRUMBLE_HEADLESS
+#error The headless server must be built with NETRUMBLE_HEADLESS defined
+#endif
+
+#define MAX(a,b)  (((a) > (b)) ? (a) : (b))
+#define MIN(a,b)  (((a) < (b)) ? (a) : (b))
+
+#include <algorithm>
+#include <atomic>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include "HeadlessPlatform.h"
+#endif
+
+#include "HeadlessSteamTypes.h"
+
+#define _XM_NO_XMVECTOR_OVERLOADS_
+
+#include <DirectXMath.h>
+#include <DirectXColors.h>
+
+#include "SimpleMath.h"
+
+#include "StepTimer.h"
+
+#include "Managers.h"
+
+#include "Debug.h"
+
+#include "ArrayView.h"
+
+#include "ServerConfig.h"
+#include "PowerUp.h"
+#include "Asteroid.h"
+#include "Starfield.h"
+#include "Ship.h"
+#include "DataBuffer.h"
+#include "Weapon.h"
+#include "LaserWeapon.h"
+#include "MineWeapon.h"
+#include "DoubleLaserWeapon.h"
+#include "TripleLaserWeapon.h"
+#include "RocketWeapon.h"
+#include "DoubleLaserPowerUp.h"
+#include "TripleLaserPowerUp.h"
+#include "RocketPowerUp.h"
+#include "RandomMath.h"
+#include "World.h"
+#include "Game.h"
+#include "PlayerState.h"
+#include "NetworkMessages.h"
+#include "CollisionManager.h"
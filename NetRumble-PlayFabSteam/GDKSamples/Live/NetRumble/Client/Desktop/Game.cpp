@@ -25,6 +25,7 @@ Game::~Game()
 	CleanupUser();
 	Managers::Shutdown();
 	WaitForAndCleanupHandles();
+	DebugShutdown();
 }
 
 // Initialize the Direct3D resources required to run.
@@ -40,9 +41,8 @@ void Game::Initialize(HWND window)
 	DebugInit();
 #endif
 
-	// Lock the game to 60FPS
-	m_timer.SetFixedTimeStep(true);
-	m_timer.SetTargetElapsedSeconds(1.0 / 60);
+	// Frames follow the display; only the world keeps a fixed step, on m_simulationClock
+	m_timer.SetFixedTimeStep(false);
 
 	Managers::Initialize();
 
@@ -61,10 +61,44 @@ void Game::Initialize(HWND window)
 
 	Managers::Get<ScreenManager>()->AddBackgroundScreen(std::make_unique<StarfieldScreen>());
 	Managers::Get<ScreenManager>()->AddForegroundScreen(std::make_unique<DebugOverlayScreen>());
-	Managers::Get<OnlineManager>()->RegisterOnlineMessageHandler([this](std::string source, GameMessage* message)
+	Managers::Get<OnlineManager>()->RegisterOnlineMessageHandler([this](std::string source, const GameMessageView& message)
 		{
 			Managers::Get<OnlineManager>()->ProcessGameNetworkMessage(source, message);
 		});
+
+	RegisterFrameSystems();
+}
+
+// Registers every per-frame system once, in the order they run. Particles run after the
+// screens so effects spawned by this frame's world update are advanced in the same frame.
+// Send runs last so everything the frame queued leaves in one bundle per delivery class.
+void Game::RegisterFrameSystems()
+{
+	m_scheduler.AddSystem("Steam", [](DX::StepTimer const&) { SteamAPI_RunCallbacks(); });
+	m_scheduler.AddSystem("PlayFab", [](DX::StepTimer const&) { PlayFabClientAPI::Update(); });
+	m_scheduler.AddSystem("Audio", [](DX::StepTimer const&) { Managers::Get<AudioManager>()->Tick(); });
+	m_scheduler.AddSystem("GameState", [](DX::StepTimer const&) { Managers::Get<GameStateManager>()->Update(); });
+	m_scheduler.AddSystem("Input", [](DX::StepTimer const&) { Managers::Get<InputManager>()->Update(); });
+	m_scheduler.AddSystem("Screens", [](DX::StepTimer const& timer) { Managers::Get<ScreenManager>()->Update(timer); });
+	m_scheduler.AddSystem("Particles", [](DX::StepTimer const& timer)
+		{
+			Managers::Get<ParticleEffectManager>()->Update(static_cast<float_t>(timer.GetElapsedSeconds()));
+		});
+	m_scheduler.AddSystem("Online", [this](DX::StepTimer const& timer)
+		{
+			if (m_isLoggedIn)
+			{
+				Managers::Get<OnlineManager>()->Tick(static_cast<float_t>(timer.GetElapsedSeconds()));
+				Managers::Get<OnlineManager>()->PlayfabPartyDoWork();
+			}
+		});
+	m_scheduler.AddSystem("Send", [this](DX::StepTimer const&)
+		{
+			if (m_isLoggedIn)
+			{
+				Managers::Get<OnlineManager>()->FlushGameMessages();
+			}
+		});
 }
 
 // Executes the basic game loop.
@@ -81,18 +115,7 @@ void Game::Tick()
 // Updates the world.
 void Game::Update(DX::StepTimer const& timer)
 {
-	SteamAPI_RunCallbacks();
-	PlayFabClientAPI::Update();
-	Managers::Get<AudioManager>()->Tick();
-	Managers::Get<GameStateManager>()->Update();
-	Managers::Get<InputManager>()->Update();
-	Managers::Get<ParticleEffectManager>()->Update(static_cast<float_t>(timer.GetElapsedSeconds()));
-	Managers::Get<ScreenManager>()->Update(timer);
-	if (m_isLoggedIn)
-	{
-		Managers::Get<OnlineManager>()->Tick(static_cast<float_t>(timer.GetElapsedSeconds()));
-		Managers::Get<OnlineManager>()->PlayfabPartyDoWork();
-	}
+	m_scheduler.Update(timer);
 }
 
 // Draws the scene.
@@ -132,6 +155,7 @@ void Game::OnResuming()
 	Managers::Get<RenderManager>()->Resume();
 
 	m_timer.ResetElapsedTime();
+	m_simulationClock.ResetLeftOver();
 
 	// We need to go back to the start menu (this already waits for networking connectivity)
 	Managers::Get<GameStateManager>()->SwitchToState(GameState::MainMenu);
@@ -211,13 +235,6 @@ std::shared_ptr<PlayerState> Game::GetPlayerState(const std::string& peer)
 	return nullptr;
 }
 
-std::shared_ptr<PlayerState> Game::GetLocalPlayerState()
-{
-	std::string localPlayerId = Managers::Get<OnlineManager>()->GetEntityKey().Id;
-	auto itrLocalPlayer = m_peers.find(localPlayerId);
-	return (*itrLocalPlayer).second;
-}
-
 void Game::ClearPlayerScores()
 {
 	for (auto& peer : m_peers)
@@ -233,6 +250,9 @@ void Game::RemovePlayerFromLobbyPeers(std::string playerId)
 	{
 		DEBUGLOG(" There is not player ID[%s] in peers\n", playerId.c_str());
 	}
+
+	PlayersChanged();
+	UpdatePeerSlots();
 }
 
 void Game::AddPlayerToLobbyPeers(std::shared_ptr<PlayerState> player)
@@ -240,6 +260,8 @@ void Game::AddPlayerToLobbyPeers(std::shared_ptr<PlayerState> player)
 	if (player)
 	{
 		m_peers[player->EntityId] = player;
+		PlayersChanged();
+		UpdatePeerSlots();
 	}
 }
 
@@ -261,6 +283,159 @@ void Game::DeleteOtherPlayerInPeersAndExitLobby()
 			item++;
 		}
 	}
+
+	PlayersChanged();
+	ClearPeerSlots();
+}
+
+// Keeps the local player and leaves its lobby state alone
+void Game::RemoveRemotePlayers()
+{
+	for (auto item = m_peers.begin(); item != m_peers.end();)
+	{
+		if (!item->second->IsLocalPlayer)
+		{
+			item = m_peers.erase(item);
+		}
+		else
+		{
+			item++;
+		}
+	}
+
+	PlayersChanged();
+	ClearPeerSlots();
+}
+
+std::shared_ptr<PlayerState> Game::GetPlayerStateBySlot(uint8_t slot) const
+{
+	if (slot < MaxPeerSlots)
+	{
+		return m_slotPeers[slot];
+	}
+
+	return nullptr;
+}
+
+// The host keeps a player's slot for as long as it stays in the lobby and hands a
+// player who joins the lowest free one, then tells everyone if anything changed.
+// Clients only learn the table from the host, and rebind it as players come and go.
+void Game::UpdatePeerSlots()
+{
+	if (Managers::Get<OnlineManager>()->IsHost())
+	{
+		bool changed = false;
+
+		for (auto& entityId : m_slotEntityIds)
+		{
+			if (!entityId.empty() && m_peers.find(entityId) == m_peers.end())
+			{
+				entityId.clear();
+				changed = true;
+			}
+		}
+
+		for (auto& [entityId, player] : m_peers)
+		{
+			if (std::find(m_slotEntityIds.begin(), m_slotEntityIds.end(), entityId) != m_slotEntityIds.end())
+			{
+				continue;
+			}
+
+			auto freeSlot = std::find_if(m_slotEntityIds.begin(), m_slotEntityIds.end(), [](const std::string& id) { return id.empty(); });
+			if (freeSlot == m_slotEntityIds.end())
+			{
+				DEBUGLOG("No free peer slot for player ID[%s]\n", entityId.c_str());
+				continue;
+			}
+
+			*freeSlot = entityId;
+			changed = true;
+		}
+
+		if (changed)
+		{
+			Managers::Get<OnlineManager>()->SendGameMessage(
+				GameMessage(
+					GameMessageType::PeerSlots,
+					SerializePeerSlots()
+				)
+			);
+		}
+	}
+
+	BindPeerSlots();
+}
+
+std::vector<uint8_t> Game::SerializePeerSlots() const
+{
+	DataBufferWriter dataWriter;
+
+	uint8_t count = static_cast<uint8_t>(std::count_if(m_slotEntityIds.begin(), m_slotEntityIds.end(), [](const std::string& id) { return !id.empty(); }));
+	dataWriter.WriteByte(count);
+	for (uint8_t slot = 0; slot < MaxPeerSlots; ++slot)
+	{
+		if (!m_slotEntityIds[slot].empty())
+		{
+			dataWriter.WriteByte(slot);
+			dataWriter.WriteString(m_slotEntityIds[slot]);
+		}
+	}
+
+	return dataWriter.GetBuffer();
+}
+
+void Game::DeserializePeerSlots(DataBufferView data)
+{
+	DataBufferReader dataReader(data);
+
+	std::array<std::string, MaxPeerSlots> slotEntityIds;
+	uint8_t count = dataReader.ReadByte();
+	for (uint8_t i = 0; i < count; ++i)
+	{
+		uint8_t slot = dataReader.ReadByte();
+		if (slot >= MaxPeerSlots)
+		{
+			throw std::runtime_error("Peer slot out of range");
+		}
+		slotEntityIds[slot] = dataReader.ReadString();
+	}
+
+	m_slotEntityIds = std::move(slotEntityIds);
+	BindPeerSlots();
+}
+
+void Game::ClearPeerSlots()
+{
+	for (auto& entityId : m_slotEntityIds)
+	{
+		entityId.clear();
+	}
+
+	BindPeerSlots();
+}
+
+// A slot can name a player this peer hasn't heard from yet; it's bound when they arrive
+void Game::BindPeerSlots()
+{
+	for (auto& [entityId, player] : m_peers)
+	{
+		player->Slot = NoPeerSlot;
+	}
+
+	for (uint8_t slot = 0; slot < MaxPeerSlots; ++slot)
+	{
+		m_slotPeers[slot] = nullptr;
+		if (!m_slotEntityIds[slot].empty())
+		{
+			auto itr = m_peers.find(m_slotEntityIds[slot]);
+			if (itr != m_peers.end())
+			{
+				itr->second->Slot = slot;
+				m_slotPeers[slot] = itr->second;
+			}
+		}
+	}
 }
 
 bool Game::CheckAllPlayerReady()
@@ -316,19 +491,22 @@ void Game::StartGame()
 				)
 			);
 
-			std::map<std::string, std::shared_ptr<Ship>> ships;
-			for (auto item : m_peers)
+			// Everyone has to know the slots before the world setup names ships by them
+			UpdatePeerSlots();
+
+			std::vector<std::shared_ptr<PlayerState>> members;
+			for (auto& [entityId, player] : m_peers)
 			{
-				if (item.second && !item.second->IsInactive())
+				if (player && !player->IsInactive() && player->Slot != NoPeerSlot)
 				{
-					ships[item.first] = item.second->GetShip();
+					members.push_back(player);
 				}
 			}
 
 			Managers::Get<OnlineManager>()->SendGameMessage(
 				GameMessage(
 					GameMessageType::WorldSetup,
-					m_world->SerializeWorldSetup(ships)
+					m_world->SerializeWorldSetup(members)
 				)
 			);
 		}
@@ -339,15 +517,27 @@ void Game::DrawWorld(float elapsedTime)
 {
 	if (m_world->IsInitialized())
 	{
+		m_world->SetDrawBlend(m_simulationClock.GetBlend());
 		m_world->Draw(elapsedTime);
 	}
 }
 
 void Game::UpdateWorld(float totalTime, float elapsedTime)
 {
+	UNREFERENCED_PARAMETER(totalTime);
+
 	if (m_world->IsInitialized())
 	{
-		m_world->Update(totalTime, elapsedTime);
+		// However long the frame was, the world only ever moves in whole steps of the same
+		// length; a capture records each step, so a replay runs the same ones
+		FrameScheduler::Section section = m_scheduler.Measure("World");
+		m_simulationClock.Advance(DX::StepTimer::SecondsToTicks(elapsedTime), [&]()
+			{
+				const float stepTotalTime = m_simulationClock.GetTotalSeconds();
+				const float stepTime = m_simulationClock.GetStepSeconds();
+				Managers::Get<OnlineManager>()->RecordWorldUpdate(stepTotalTime, stepTime);
+				m_world->Update(stepTotalTime, stepTime);
+			});
 	}
 }
 
@@ -363,6 +553,11 @@ std::vector<std::shared_ptr<PlayerState>> Game::GetAllPlayerStates()
 	return players;
 }
 
+void Game::PlayersChanged()
+{
+	m_roster.Rebuild(m_peers);
+}
+
 void Game::ResetGameplayData()
 {
 	// Reset any existing game world to its defaults
@@ -429,6 +624,7 @@ void Game::LocalPlayerInitialize()
 	localPlayer->PeerId = Managers::Get<OnlineManager>()->GetLocalUserId();
 	localPlayer->EntityId = Managers::Get<OnlineManager>()->GetLocalUserEntityId();
 	m_peers[localPlayer->EntityId] = localPlayer;
+	PlayersChanged();
 	Managers::Get<OnlineManager>()->SetLocalSteamID(SteamUser()->GetSteamID());
 }
 
@@ -447,14 +643,18 @@ void Game::CleanupUser()
 	{
 		m_peers.erase(Managers::Get<OnlineManager>()->GetLocalEntityId());
 		m_localPlayerName.clear();
+		PlayersChanged();
 	}
 
+	ClearPeerSlots();
+
 	HANDLE shutdownEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
 	AddHandleToWaitSet(shutdownEvent);
 }
 
 void Game::ExitGame()
 {
+	Managers::Get<OnlineManager>()->StopRecording();
 	Managers::Get<OnlineManager>()->LeaveMultiplayerGame();
 }
 
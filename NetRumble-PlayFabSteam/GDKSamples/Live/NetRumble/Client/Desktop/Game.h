@@ -7,6 +7,10 @@
 #pragma once
 
 #include "pch.h"
+#include "FrameScheduler.h"
+#include "PlayerState.h"
+#include "PlayerRoster.h"
+#include "SimulationClock.h"
 
 namespace NetRumble
 {
@@ -52,20 +56,40 @@ namespace NetRumble
 
 		// Game Player Management
 		std::shared_ptr<PlayerState> GetPlayerState(const std::string& peer);
-		std::shared_ptr<PlayerState> GetLocalPlayerState();
+		inline const std::shared_ptr<PlayerState>& GetLocalPlayerState() const { return m_roster.LocalPlayer(); }
+		// A copy for callers that keep players; per-frame code walks GetPlayers instead
 		std::vector<std::shared_ptr<PlayerState>> GetAllPlayerStates();
 		void ClearPlayerScores();
 		void LocalPlayerInitialize();
 		void RemovePlayerFromLobbyPeers(std::string playerId);
 		void AddPlayerToLobbyPeers(std::shared_ptr<PlayerState> player);
 		void DeleteOtherPlayerInPeersAndExitLobby();
+		void RemoveRemotePlayers();
 		bool CheckAllPlayerReady();
 
+		// Peer slots: the host gives every player a small number, and messages name players
+		// by it instead of by their entity ID
+		std::shared_ptr<PlayerState> GetPlayerStateBySlot(uint8_t slot) const;
+		void UpdatePeerSlots();
+		std::vector<uint8_t> SerializePeerSlots() const;
+		void DeserializePeerSlots(DataBufferView data);
+		void ClearPeerSlots();
+
 		inline bool IsGameWon() const { return m_world->IsGameWon; }
 		inline std::unique_ptr<World>& GetWorld() { return m_world; }
+		inline FrameScheduler& GetScheduler() { return m_scheduler; }
+
+		// World updates per second, whatever the frame rate; a 30 Hz host halves the simulation's cost
+		inline uint32_t GetSimulationRate() const { return m_simulationClock.GetStepsPerSecond(); }
+		inline void SetSimulationRate(uint32_t stepsPerSecond) { m_simulationClock.SetStepsPerSecond(stepsPerSecond); }
+
 		inline std::string_view GetWinnerName() const { return m_world->WinnerName; }
 		inline std::string_view GetLocalPlayerName() const { return m_localPlayerName; }
-		inline std::map<std::string, std::shared_ptr<PlayerState>>& GetPeers() { return m_peers; }
+		inline const std::map<std::string, std::shared_ptr<PlayerState>>& GetPeers() const { return m_peers; }
+
+		// Every player, and the local one, without allocating; see PlayerRoster
+		inline PlayerRoster::View GetPlayers() const { return m_roster.Players(); }
+		inline PlayerState* GetLocalPlayer() const { return m_roster.LocalPlayer().get(); }
 		inline DirectX::XMVECTORF32 GetWinningColor() const { return m_world->WinningColor; }
 		template<typename ...Types>
 		void WriteDebugLogMessage(const Types& ...args);
@@ -85,11 +109,17 @@ namespace NetRumble
 		void AddHandleToWaitSet(HANDLE handle);
 		void WaitForAndCleanupHandles();
 
+		void RegisterFrameSystems();
 		void Update(DX::StepTimer const& timer);
 		void Render();
 
 		void PrefetchContent();
 
+		void BindPeerSlots();
+
+		// Called after every change to m_peers
+		void PlayersChanged();
+
 		uint32_t m_signInCallbackToken{ 0 };
 		uint32_t m_signOutCallbackToken{ 0 };
 
@@ -106,9 +136,20 @@ namespace NetRumble
 		// Players
 		std::string m_localPlayerName;
 		std::map<std::string, std::shared_ptr<PlayerState>> m_peers;
+		PlayerRoster m_roster;
+
+		// The host's slot table, and the players it names among m_peers
+		std::array<std::string, MaxPeerSlots> m_slotEntityIds;
+		std::array<std::shared_ptr<PlayerState>, MaxPeerSlots> m_slotPeers;
 
 		// Rendering loop timer.
 		DX::StepTimer m_timer;
+
+		// Steps the world at its own fixed rate within the rendered frames
+		SimulationClock m_simulationClock;
+
+		// Per-frame system updates and their timings
+		FrameScheduler m_scheduler;
 	};
 
 	template<typename ...Types>
@@ -2,6 +2,9 @@
 #include "pch.h"
 #include <appnotify.h>
 
+#include "TrafficReplayer.h"
+#include "PeerSlotBenchmark.h"
+
 using namespace NetRumble;
 using namespace DirectX;
 
@@ -16,6 +19,7 @@ LPCWSTR g_szAppName = L"NetRumble";
 LRESULT CALLBACK WndProc(HWND, UINT, WPARAM, LPARAM);
 
 bool ParseCommandLine(const char* pchCmdLine, const char** ppchServerAddress, const char** ppchLobbyID);
+std::wstring GetCommandLineValue(const wchar_t* cmdLine, const wchar_t* name);
 
 // Entry point
 int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ int nCmdShow)
@@ -112,6 +116,59 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 				pOnlineManager->SetHasPendingInvite(true);
 			}
 		}
+
+		// -replay <file> [-realtime] runs a capture through the game and exits;
+		// -record <file> captures this session's traffic
+		std::wstring replayPath = GetCommandLineValue(lpCmdLine, L"-replay");
+		if (!replayPath.empty())
+		{
+			int result = EXIT_SUCCESS;
+			try
+			{
+				TrafficReplayer replayer(replayPath);
+				replayer.Run(wcsstr(lpCmdLine, L"-realtime") != nullptr).Log();
+			}
+			catch (const std::runtime_error& error)
+			{
+				DEBUGLOG("Unable to replay traffic: %s\n", error.what());
+				result = EXIT_FAILURE;
+			}
+
+			g_game.reset();
+			return result;
+		}
+
+		// -peer-benchmark compares messages naming players by slot with entity IDs, and exits
+		if (wcsstr(lpCmdLine, L"-peer-benchmark") != nullptr)
+		{
+			int result = EXIT_SUCCESS;
+			try
+			{
+				PeerSlotBenchmark benchmark(PeerSlotBenchmark::Settings{});
+				benchmark.Run().Log();
+			}
+			catch (const std::runtime_error& error)
+			{
+				DEBUGLOG("Unable to run the peer slot benchmark: %s\n", error.what());
+				result = EXIT_FAILURE;
+			}
+
+			g_game.reset();
+			return result;
+		}
+
+		std::wstring recordPath = GetCommandLineValue(lpCmdLine, L"-record");
+		if (!recordPath.empty())
+		{
+			Managers::Get<OnlineManager>()->StartRecording(recordPath);
+		}
+
+		// -tick-rate <N> steps the world N times a second, however fast frames are drawn
+		std::wstring tickRate = GetCommandLineValue(lpCmdLine, L"-tick-rate");
+		if (!tickRate.empty())
+		{
+			g_game->SetSimulationRate(static_cast<uint32_t>(wcstoul(tickRate.c_str(), nullptr, 10)));
+		}
 	}
 
 	// CommandLine
@@ -353,3 +410,29 @@ bool ParseCommandLine(const char* pchCmdLine, const char** ppchServerAddress, co
 
 	return *ppchServerAddress || *ppchLobbyID;
 }
+
+// Returns the word after name on the command line, or an empty string if name isn't there
+std::wstring GetCommandLineValue(const wchar_t* cmdLine, const wchar_t* name)
+{
+	std::wstring_view line(cmdLine);
+	std::wstring_view param(name);
+
+	for (size_t start = line.find(param); start != std::wstring_view::npos; start = line.find(param, start + 1))
+	{
+		size_t valueStart = start + param.size();
+		if ((start > 0 && line[start - 1] != L' ') || valueStart >= line.size() || line[valueStart] != L' ')
+		{
+			continue;
+		}
+
+		valueStart = line.find_first_not_of(L' ', valueStart);
+		if (valueStart == std::wstring_view::npos)
+		{
+			break;
+		}
+
+		return std::wstring(line.substr(valueStart, line.find(L' ', valueStart) - valueStart));
+	}
+
+	return {};
+}
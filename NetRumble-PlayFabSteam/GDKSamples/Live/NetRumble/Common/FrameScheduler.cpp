@@ -0,0 +1,94 @@
+//--------------------------------------------------------------------------------------
+// FrameScheduler.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "FrameScheduler.h"
+
+using namespace NetRumble;
+
+namespace
+{
+	// Weight of the newest sample in the running average shown on the overlay
+	constexpr float c_timingSmoothing = 0.05f;
+}
+
+FrameScheduler::Section::Section(FrameScheduler& scheduler, size_t timingIndex) :
+	m_scheduler(scheduler),
+	m_timingIndex(timingIndex),
+	m_startTime(std::chrono::steady_clock::now())
+{
+	m_scheduler.m_depth++;
+}
+
+FrameScheduler::Section::~Section()
+{
+	std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - m_startTime;
+	m_scheduler.m_depth--;
+	m_scheduler.RecordTiming(m_timingIndex, elapsed.count());
+}
+
+void FrameScheduler::AddSystem(std::string_view name, SystemUpdate update)
+{
+	for (size_t i = 0; i < m_systems.size(); ++i)
+	{
+		if (m_timings[i].Name == name)
+		{
+			throw std::logic_error("System is already scheduled");
+		}
+	}
+
+	// Systems stay ahead of any measured sections so their timings line up by index
+	m_timings.insert(m_timings.begin() + static_cast<ptrdiff_t>(m_systems.size()), SystemTiming{ std::string(name), 0, 0.0f, 0.0f });
+	m_systems.push_back(std::move(update));
+}
+
+void FrameScheduler::Update(DX::StepTimer const& timer)
+{
+	if (m_updating)
+	{
+		throw std::logic_error("FrameScheduler::Update is not re-entrant");
+	}
+
+	m_updating = true;
+	auto frameStart = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < m_systems.size(); ++i)
+	{
+		Section section(*this, i);
+		m_systems[i](timer);
+	}
+
+	std::chrono::duration<float, std::milli> frameTime = std::chrono::steady_clock::now() - frameStart;
+	m_lastFrameMilliseconds = frameTime.count();
+
+	// Running variance weighted the same way as the average, so the two cover the same frames
+	const float difference = m_lastFrameMilliseconds - m_averageFrameMilliseconds;
+	m_averageFrameMilliseconds += difference * c_timingSmoothing;
+	m_frameVariance = (1.0f - c_timingSmoothing) * (m_frameVariance + difference * difference * c_timingSmoothing);
+	m_updating = false;
+}
+
+FrameScheduler::Section FrameScheduler::Measure(std::string_view name)
+{
+	int depth = m_depth;
+	for (size_t i = m_systems.size(); i < m_timings.size(); ++i)
+	{
+		if (m_timings[i].Depth == depth && m_timings[i].Name == name)
+		{
+			return Section(*this, i);
+		}
+	}
+
+	m_timings.push_back(SystemTiming{ std::string(name), depth, 0.0f, 0.0f });
+	return Section(*this, m_timings.size() - 1);
+}
+
+void FrameScheduler::RecordTiming(size_t timingIndex, float milliseconds)
+{
+	SystemTiming& timing = m_timings[timingIndex];
+	timing.LastMilliseconds = milliseconds;
+	timing.AverageMilliseconds += (milliseconds - timing.AverageMilliseconds) * c_timingSmoothing;
+}
@@ -0,0 +1,78 @@
+//--------------------------------------------------------------------------------------
+// FrameScheduler.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+
+#include "StepTimer.h"
+
+namespace NetRumble
+{
+	/// <summary>
+	/// Runs the per-frame subsystem updates in a fixed, explicit order and records how long
+	/// each one takes. Every system is registered exactly once, so nothing can be ticked twice
+	/// in the same frame. Work nested inside a system (the world, collision) can be timed
+	/// with Measure so the overlay can break a system's cost down further.
+	/// </summary>
+	class FrameScheduler
+	{
+	public:
+		using SystemUpdate = std::function<void(DX::StepTimer const& timer)>;
+
+		struct SystemTiming
+		{
+			std::string Name;
+			// 0 for scheduled systems, deeper for sections measured inside them
+			int Depth;
+			float LastMilliseconds;
+			float AverageMilliseconds;
+		};
+
+		// Times the enclosing scope into the named section until it is destroyed
+		class Section
+		{
+		public:
+			Section(FrameScheduler& scheduler, size_t timingIndex);
+			~Section();
+
+			Section(const Section&) = delete;
+			Section& operator=(const Section&) = delete;
+
+		private:
+			FrameScheduler& m_scheduler;
+			size_t m_timingIndex;
+			std::chrono::steady_clock::time_point m_startTime;
+		};
+
+		FrameScheduler() = default;
+
+		// Appends a system to the end of the frame; throws if the name is already scheduled
+		void AddSystem(std::string_view name, SystemUpdate update);
+		void Update(DX::StepTimer const& timer);
+
+		[[nodiscard]] Section Measure(std::string_view name);
+
+		inline const std::vector<SystemTiming>& GetTimings() const { return m_timings; }
+		inline float GetLastFrameMilliseconds() const { return m_lastFrameMilliseconds; }
+		inline float GetAverageFrameMilliseconds() const { return m_averageFrameMilliseconds; }
+		// How far frames typically stray from the average; a steady frame keeps this low
+		inline float GetFrameDeviationMilliseconds() const { return std::sqrt(m_frameVariance); }
+
+	private:
+		void RecordTiming(size_t timingIndex, float milliseconds);
+
+		// Parallel to the first m_systems.size() entries of m_timings
+		std::vector<SystemUpdate> m_systems;
+		std::vector<SystemTiming> m_timings;
+		float m_lastFrameMilliseconds = 0.0f;
+		float m_averageFrameMilliseconds = 0.0f;
+		float m_frameVariance = 0.0f;
+		int m_depth = 0;
+		bool m_updating = false;
+	};
+}
@@ -18,10 +18,13 @@ GameplayObject::GameplayObject() :
 
 void GameplayObject::Initialize()
 {
+	// Wherever a new or respawned object starts, it is not flying there from its last pose
+	m_hasStepStart = false;
+
 	if (!m_active)
 	{
 		m_active = true;
-		Managers::Get<CollisionManager>()->Collection().push_back(shared_from_this());
+		m_collisionHandle = Managers::Get<CollisionManager>()->Collection().push_back(shared_from_this());
 	}
 }
 
@@ -30,13 +33,33 @@ void GameplayObject::Update(float /*elapsedTime*/)
 	CollidedThisFrame = false;
 }
 
+void GameplayObject::BeginStepBlend(float blend)
+{
+	m_simulatedPosition = Position;
+	m_simulatedRotation = Rotation;
+
+	if (m_hasStepStart && SimpleMath::Vector2::DistanceSquared(m_stepStartPosition, Position) <= c_MaximumStepBlendDistance * c_MaximumStepBlendDistance)
+	{
+		Position = SimpleMath::Vector2::Lerp(m_stepStartPosition, Position, blend);
+
+		// The short way round, so a rotation that wrapped doesn't spin back through a full turn
+		Rotation = m_stepStartRotation + std::remainder(Rotation - m_stepStartRotation, XM_2PI) * blend;
+	}
+}
+
+void GameplayObject::EndStepBlend()
+{
+	Position = m_simulatedPosition;
+	Rotation = m_simulatedRotation;
+}
+
 void GameplayObject::Draw(float /*elapsedTime*/, RenderContext* renderContext, const TextureHandle& texture, XMVECTOR color)
 {
 	renderContext->Draw(
 		texture,
 		Position,
 		Rotation,
-		2.0f * Radius / static_cast<float>(std::min<int>(texture.Texture->Width(), texture.Texture->Height())),
+		2.0f * Radius / static_cast<float>(std::min(texture.GetTextureSize().x, texture.GetTextureSize().y)),
 		color,
 		TexturePosition::Centered);
 }
@@ -78,6 +101,6 @@ void GameplayObject::Die(GameplayObject*, bool)
 	if (m_active)
 	{
 		m_active = false;
-		Managers::Get<CollisionManager>()->Collection().QueuePendingRemoval(shared_from_this());
+		Managers::Get<CollisionManager>()->Collection().QueuePendingRemoval(m_collisionHandle);
 	}
 }
\ No newline at end of file
@@ -10,17 +10,13 @@
 using namespace NetRumble;
 using namespace DirectX;
 
-LaserProjectile::LaserProjectile(Ship* owner, DirectX::SimpleMath::Vector2 direction) : Projectile(owner, direction)
+LaserProjectile::LaserProjectile(Ship* owner) : Projectile(owner)
 {
-	// Set the gameplay data
-	Velocity *= initialSpeed;
-
 	// Set the collision data
 	Radius = 4.0f;
 	Mass = 0.5f;
 
 	// Set the projectile data
-	m_duration = 5.0f;
 	m_damageAmount = 20.0f;
 	m_damageRadius = 0.0f;
 	m_damageOwner = false;
@@ -28,6 +24,15 @@ LaserProjectile::LaserProjectile(Ship* owner, DirectX::SimpleMath::Vector2 direc
 	m_texture = Managers::Get<ContentManager>()->LoadTexture(L"Assets\\Textures\\laser.png");
 }
 
+void LaserProjectile::Launch(DirectX::SimpleMath::Vector2 direction)
+{
+	Projectile::Launch(direction);
+
+	// Set the gameplay data
+	Velocity *= initialSpeed;
+	m_duration = 5.0f;
+}
+
 void LaserProjectile::Draw(float elapsedTime, RenderContext* renderContext)
 {
 	// Ignore the parameter color if we have an owner
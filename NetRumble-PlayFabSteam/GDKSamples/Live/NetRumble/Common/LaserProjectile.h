@@ -13,7 +13,9 @@ namespace NetRumble
 	class LaserProjectile final : public Projectile
 	{
 	public:
-		LaserProjectile(Ship* owner, DirectX::SimpleMath::Vector2 direction);
+		explicit LaserProjectile(Ship* owner);
+
+		virtual void Launch(DirectX::SimpleMath::Vector2 direction) override;
 
 		virtual void Draw(float elapsedTime, RenderContext* renderContext) override;
 		virtual void Die(GameplayObject* source, bool cleanupOnly) override;
@@ -0,0 +1,125 @@
+//--------------------------------------------------------------------------------------
+// MessageBundle.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "MessageBundle.h"
+
+using namespace NetRumble;
+
+MessageBundler::MessageBundler(SendHandler send) :
+	m_send(std::move(send))
+{
+}
+
+void MessageBundler::Queue(uint64_t destination, int deliveryClass, DataBufferView packet)
+{
+	if (packet.empty())
+	{
+		return;
+	}
+
+	m_counters.Packets++;
+	Run& run = FindRun(destination, deliveryClass);
+
+	// Too big to share a bundle; send what was queued ahead of it first to keep the order
+	if (MsgTypeSize + sizeof(PacketLength) + packet.size() > c_maximumBundleSize)
+	{
+		SendRun(run);
+		m_counters.Sends++;
+		m_send(destination, deliveryClass, packet);
+		return;
+	}
+
+	if (run.Packets > 0 && run.Data.size() + sizeof(PacketLength) + packet.size() > c_maximumBundleSize)
+	{
+		SendRun(run);
+	}
+
+	if (run.Packets == 0)
+	{
+		const GameMessageType type = GameMessageType::MessageBundle;
+		run.Data.resize(MsgTypeSize);
+		memcpy(run.Data.data(), &type, MsgTypeSize);
+	}
+
+	const PacketLength length = static_cast<PacketLength>(packet.size());
+	const size_t offset = run.Data.size();
+	run.Data.resize(offset + sizeof(length) + packet.size());
+	memcpy(run.Data.data() + offset, &length, sizeof(length));
+	memcpy(run.Data.data() + offset + sizeof(length), packet.data(), packet.size());
+	run.Packets++;
+}
+
+void MessageBundler::Flush()
+{
+	for (Run& run : m_runs)
+	{
+		SendRun(run);
+	}
+}
+
+void MessageBundler::Clear()
+{
+	for (Run& run : m_runs)
+	{
+		run.Packets = 0;
+		run.Data.clear();
+	}
+}
+
+// A handful of peers and two or three delivery classes, so a linear search is cheapest
+MessageBundler::Run& MessageBundler::FindRun(uint64_t destination, int deliveryClass)
+{
+	Run* idle = nullptr;
+	for (Run& run : m_runs)
+	{
+		if (run.Destination == destination && run.DeliveryClass == deliveryClass)
+		{
+			return run;
+		}
+
+		if (idle == nullptr && run.Packets == 0)
+		{
+			idle = &run;
+		}
+	}
+
+	// Destinations come and go with connections; take over an empty run's buffer before growing
+	if (idle == nullptr)
+	{
+		m_runs.emplace_back();
+		idle = &m_runs.back();
+	}
+
+	idle->Destination = destination;
+	idle->DeliveryClass = deliveryClass;
+	idle->Packets = 0;
+	idle->Data.clear();
+	return *idle;
+}
+
+void MessageBundler::SendRun(Run& run)
+{
+	if (run.Packets == 0)
+	{
+		return;
+	}
+
+	if (run.Packets == 1)
+	{
+		const size_t header = MsgTypeSize + sizeof(PacketLength);
+		m_send(run.Destination, run.DeliveryClass, DataBufferView(run.Data.data() + header, run.Data.size() - header));
+	}
+	else
+	{
+		m_counters.FramingBytes += MsgTypeSize + run.Packets * sizeof(PacketLength);
+		m_send(run.Destination, run.DeliveryClass, run.Data);
+	}
+
+	m_counters.Sends++;
+	run.Packets = 0;
+	run.Data.clear();
+}
@@ -0,0 +1,115 @@
+//--------------------------------------------------------------------------------------
+// MessageBundle.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "NetworkMessages.h"
+
+namespace NetRumble
+{
+	// Collects the packets a frame sends and hands them to the transport as few messages as
+	// possible. Packets are queued per destination and delivery class, since one transport
+	// message goes out with one set of send options, and the runs are flushed once at the end
+	// of the frame, in the order they were queued. A bundle is a MessageBundle type followed
+	// by each packet behind a 16-bit length. A run of one packet is sent as it is, so a
+	// receiver sees exactly the old wire format whenever there was nothing to share with.
+	class MessageBundler final
+	{
+	public:
+		// Keeps a bundle inside one datagram, so losing a fragment never drops the lot
+		static constexpr size_t c_maximumBundleSize = 1100;
+
+		// Sends one transport message; the bytes are only valid for the call
+		using SendHandler = std::function<void(uint64_t destination, int deliveryClass, DataBufferView message)>;
+
+		struct Counters
+		{
+			// Packets queued, counted once per destination
+			uint64_t Packets = 0;
+			// Transport messages handed to the send handler
+			uint64_t Sends = 0;
+			// Bundle headers and length prefixes added on top of the packets
+			uint64_t FramingBytes = 0;
+		};
+
+		explicit MessageBundler(SendHandler send);
+
+		MessageBundler(MessageBundler const&) = delete;
+		MessageBundler& operator= (MessageBundler const&) = delete;
+
+		// Copies the packet. It goes out on Flush, or earlier if its run would outgrow a bundle.
+		void Queue(uint64_t destination, int deliveryClass, DataBufferView packet);
+		void Flush();
+		// Forgets anything queued, for when the connections it was meant for have closed
+		void Clear();
+
+		inline const Counters& GetCounters() const { return m_counters; }
+		inline void ResetCounters() { m_counters = Counters(); }
+
+		// Calls handler with each packet in a received transport message, which is either a
+		// bundle or a single packet. Returns false if a bundle is malformed; the packets before
+		// the fault have already been handled.
+		template<typename Handler>
+		static bool ForEachPacket(DataBufferView message, Handler&& handler);
+
+	private:
+		using PacketLength = uint16_t;
+
+		struct Run
+		{
+			uint64_t Destination;
+			int DeliveryClass;
+			uint32_t Packets;
+			std::vector<uint8_t> Data;
+		};
+
+		Run& FindRun(uint64_t destination, int deliveryClass);
+		void SendRun(Run& run);
+
+		SendHandler m_send;
+		// Emptied rather than erased when sent, so their buffers are reused frame after frame
+		std::vector<Run> m_runs;
+		Counters m_counters;
+	};
+
+	template<typename Handler>
+	bool MessageBundler::ForEachPacket(DataBufferView message, Handler&& handler)
+	{
+		GameMessageType type = GameMessageType::Unknown;
+		if (message.size() >= MsgTypeSize)
+		{
+			memcpy(&type, message.data(), MsgTypeSize);
+		}
+
+		if (type != GameMessageType::MessageBundle)
+		{
+			handler(message);
+			return true;
+		}
+
+		size_t offset = MsgTypeSize;
+		while (offset < message.size())
+		{
+			PacketLength length = 0;
+			if (message.size() - offset < sizeof(length))
+			{
+				return false;
+			}
+			memcpy(&length, message.data() + offset, sizeof(length));
+			offset += sizeof(length);
+
+			if (length == 0 || message.size() - offset < length)
+			{
+				return false;
+			}
+
+			handler(DataBufferView(message.data() + offset, length));
+			offset += length;
+		}
+
+		return true;
+	}
+}
@@ -9,6 +9,7 @@
 #include <map>
 
 #include "ServerConfig.h"
+#include "DataBuffer.h"
 
 namespace NetRumble
 {
@@ -28,6 +29,9 @@ namespace NetRumble
 		GameStart = 1,
 		GameOver = 2,
 
+		// Several packets sent together, see MessageBundler
+		MessageBundle = 3,
+
 		PlayerJoined = 11,
 		SynPlayerData = 12,
 		PlayerState = 13,
@@ -39,8 +43,12 @@ namespace NetRumble
 		ShipData = 18,
 		ShipDeath = 19,
 
+		// The host's table of which player has which slot, see Game::UpdatePeerSlots
+		PeerSlots = 20,
+
 		WorldSetup = 21,
 		WorldData = 22,
+		WorldDataAck = 23,
 
 		ServerWorldSetup = 31,
 		ServerUpdateWorldData = 32,
@@ -89,6 +97,7 @@ namespace NetRumble
 		GameMessage(GameMessageType type, uint32_t data);
 		GameMessage(GameMessageType type, std::string_view data);
 		GameMessage(GameMessageType type, const std::vector<uint8_t>& data);
+		GameMessage(GameMessageType type, std::vector<uint8_t>&& data);
 		GameMessage(const std::vector<uint8_t>& data);
 
 		inline const GameMessageType MessageType() const { return m_type; }
@@ -109,6 +118,36 @@ namespace NetRumble
 		std::vector<uint8_t> m_data;
 	};
 
+	/// <summary>
+	/// Non-owning view of a game message. Received messages point straight into the
+	/// transport's receive buffer, so a view is only valid until the handler returns.
+	/// </summary>
+	class GameMessageView final
+	{
+	public:
+		GameMessageView() = default;
+		GameMessageView(GameMessageType type, DataBufferView data) : m_type{ type }, m_data{ data } {}
+		GameMessageView(const GameMessage& message) : m_type{ message.MessageType() }, m_data{ message.RawData() } {}
+
+		// Reads the GameMessageType header in place; ill-formed packets give an Unknown view
+		static GameMessageView FromPacket(DataBufferView packet);
+
+		inline const GameMessageType MessageType() const { return m_type; }
+		inline DataBufferView RawData() const { return m_data; }
+
+		std::string StringValue() const;
+		uint32_t UnsignedValue() const;
+
+		// Writes GameMessageType|MessagePayload into the packet, reusing its capacity
+		void SerializeTo(std::vector<uint8_t>& packet) const;
+		// Writes GameMessageType|SourceID|MessagePayload for the game server host to dispatch
+		void SerializeWithSourceIDTo(std::vector<uint8_t>& packet) const;
+
+	private:
+		GameMessageType m_type = GameMessageType::Unknown;
+		DataBufferView m_data;
+	};
+
 	// Defines the wire protocol for the game
 #pragma pack( push, 1 )
 
@@ -10,8 +10,8 @@
 
 namespace NetRumble
 {
-	class GameMessage;
-	using OnlineMessageHandler = std::function<void(std::string, GameMessage*)>;
+	class GameMessageView;
+	using OnlineMessageHandler = std::function<void(std::string, const GameMessageView&)>;
 
 	struct OnlineUser
 	{
@@ -56,7 +56,7 @@ namespace NetRumble
 		virtual bool IsMatchmaking() = 0;
 		virtual void CancelMatchmaking() = 0;
 		virtual void LeaveMultiplayerGame() = 0;
-		virtual void SendGameMessage(const GameMessage&) = 0;
+		virtual void SendGameMessage(const GameMessageView&) = 0;
 		virtual void RegisterOnlineMessageHandler(OnlineMessageHandler handler) = 0;
 		virtual bool IsNetworkAvailable() const = 0;
 		virtual bool IsConnected() const = 0;
@@ -203,7 +203,7 @@ void PlayFabLobby::CreateLobby(PFLobbyAccessPolicy accessPolicy)
 	if (FAILED(hr))
 	{
 		g_game->WriteDebugLogMessage("Failed to create and join lobby: 0x%08X, %s\n", static_cast<unsigned int>(hr), GetPlayFabErrorMessage(hr));
-		onlineManager->GetOnlineMessageHandler()(onlineManager->GetLocalEntityId(), &CreateLobbyFailed);
+		onlineManager->GetOnlineMessageHandler()(onlineManager->GetLocalEntityId(), CreateLobbyFailed);
 		return;
 	}
 }
@@ -235,7 +235,7 @@ void PlayFabLobby::JoinLobby(const std::string& connectionString) {
 	if (FAILED(hr))
 	{
 		g_game->WriteDebugLogMessage("Failed to join lobby: connectionString(%s),\n ErrorCode(0x%08X) %s\n", static_cast<unsigned int>(hr), connectionString.c_str(), GetPlayFabErrorMessage(hr));
-		onlineManager->GetOnlineMessageHandler()(onlineManager->GetLocalEntityId(), &CreateLobbyFailed);
+		onlineManager->GetOnlineMessageHandler()(onlineManager->GetLocalEntityId(), CreateLobbyFailed);
 		return;
 	}
 }
@@ -382,7 +382,7 @@ void PlayFabLobby::LeaveLobby()
 	{
 		g_game->WriteDebugLogMessage("Failed to leave lobby: 0x%08X %s\n", static_cast<unsigned int>(hr), GetPlayFabErrorMessage(hr));
 		const auto& onlineManager = Managers::Get<OnlineManager>();
-		onlineManager->GetOnlineMessageHandler()(onlineManager->GetLocalEntityId(), &CreateLobbyFailed);
+		onlineManager->GetOnlineMessageHandler()(onlineManager->GetLocalEntityId(), CreateLobbyFailed);
 		return;
 	}
 	m_lobbyHandle = nullptr;
@@ -513,7 +513,7 @@ void PlayFabLobby::OnMemberRemoved(const PFLobbyStateChange* change)
 			[this]()
 			{
 				auto onlineManager = Managers::Get<OnlineManager>();
-				onlineManager->m_messageHandler(onlineManager->GetLocalEntityId(), &LeaveGameComplete);
+				onlineManager->m_messageHandler(onlineManager->GetLocalEntityId(), LeaveGameComplete);
 			});
 		break;
 	}
@@ -651,7 +651,7 @@ void PlayFabLobby::FindLobbies()
 	if (FAILED(hr))
 	{
 		g_game->WriteDebugLogMessage("Failed to create and join lobby: 0x%08X %s\n", static_cast<unsigned int>(hr), GetPlayFabErrorMessage(hr));
-		onlineManager->GetOnlineMessageHandler()(onlineManager->GetLocalEntityId(), &CreateLobbyFailed);
+		onlineManager->GetOnlineMessageHandler()(onlineManager->GetLocalEntityId(), CreateLobbyFailed);
 		return;
 	}
 }
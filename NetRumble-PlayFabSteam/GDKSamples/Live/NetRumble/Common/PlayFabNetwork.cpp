@@ -18,13 +18,16 @@ const char* NetRumble::MessageTypeString(GameMessageType type)
 	case GameMessageType::Unknown:            return STRINGIFY(GameMessageType::Unknown);
 	case GameMessageType::GameStart:          return STRINGIFY(GameMessageType::GameStart);
 	case GameMessageType::GameOver:           return STRINGIFY(GameMessageType::GameOver);
+	case GameMessageType::MessageBundle:      return STRINGIFY(GameMessageType::MessageBundle);
 	case GameMessageType::PlayerJoined:       return STRINGIFY(GameMessageType::PlayerJoined);
 	case GameMessageType::SynPlayerData:      return STRINGIFY(GameMessageType::SynPlayerData);
 	case GameMessageType::PlayerState:        return STRINGIFY(GameMessageType::PlayerState);
+	case GameMessageType::PeerSlots:          return STRINGIFY(GameMessageType::PeerSlots);
 	case GameMessageType::JoiningGame:        return STRINGIFY(GameMessageType::JoiningGame);
 	case GameMessageType::PowerUpSpawn:       return STRINGIFY(GameMessageType::PowerUpSpawn);
 	case GameMessageType::WorldSetup:         return STRINGIFY(GameMessageType::WorldSetup);
 	case GameMessageType::WorldData:          return STRINGIFY(GameMessageType::WorldData);
+	case GameMessageType::WorldDataAck:       return STRINGIFY(GameMessageType::WorldDataAck);
 	case GameMessageType::ShipSpawn:          return STRINGIFY(GameMessageType::ShipSpawn);
 	case GameMessageType::ShipInput:          return STRINGIFY(GameMessageType::ShipInput);
 	case GameMessageType::ShipData:           return STRINGIFY(GameMessageType::ShipData);
@@ -43,20 +46,39 @@ const char* NetRumble::MessageTypeString(GameMessageType type)
 	}
 }
 
-void PlayFabOnlineManager::SendGameMessage(const GameMessage& message)
+void PlayFabOnlineManager::SendGameMessage(const GameMessageView& message)
 {
-	DEBUGLOG("Sending message: %s\n", MessageTypeString(message.MessageType()));
-	auto packet = message.Serialize();
-	Managers::Get<OnlineManager>()->m_playfabParty.SendGameMessage(packet);
+	DEBUGLOG_PACKET("Sending message: %s\n", MessageTypeString(message.MessageType()));
+
+	if (m_recorder != nullptr)
+	{
+		RecordSessionIfChanged();
+		m_recorder->RecordSent(message);
+	}
+
+	if (m_isReplaying)
+	{
+		m_replaySentMessages++;
+		m_replaySentBytes += MsgTypeSize + message.RawData().size();
+		return;
+	}
+
+	Managers::Get<OnlineManager>()->m_playfabParty.SendGameMessage(message);
 }
 
-void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameMessage* message)
+void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, const GameMessageView& message)
 {
-	std::string localId = Managers::Get<OnlineManager>()->m_playfabParty.GetLocalUserEntityId();
+	if (m_recorder != nullptr)
+	{
+		RecordSessionIfChanged();
+		m_recorder->RecordReceived(sourceId, message);
+	}
+
+	const char* localId = GetLocalUserEntityId();
 	std::unique_ptr<World>& world = g_game->GetWorld();
 	std::shared_ptr<PlayerState> player = g_game->GetPlayerState(sourceId);
 
-	switch (message->MessageType())
+	switch (message.MessageType())
 	{
 	case GameMessageType::MPPrivilegeError:
 	{
@@ -68,7 +90,7 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 		DEBUGLOG("Received a RegionLatency message\n");
 		if (player != nullptr)
 		{
-			std::string raw = message->StringValue();
+			std::string raw = message.StringValue();
 			std::string region = raw.substr(0, raw.find(":"));
 			uint64_t latency = std::strtoull(raw.substr(raw.find(":") + 1).c_str(), nullptr, 10);
 
@@ -94,7 +116,7 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 			{
 				world->IsGameWon = true;
 				world->SetGameInProgress(false);
-				world->DeserializeGameOver(message->RawData());
+				world->DeserializeGameOver(message.RawData());
 			}
 			else
 			{
@@ -115,10 +137,10 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 	}
 	case GameMessageType::ServerUpdateWorldData:
 	{
-		DEBUGLOG("Received a ServerUpdateWorldData message\n");
+		DEBUGLOG_PACKET("Received a ServerUpdateWorldData message\n");
 		if (world->IsInitialized())
 		{
-			world->DeserializeWorldData(message->RawData());
+			world->DeserializeWorldData(message.RawData());
 		}
 		else
 		{
@@ -129,15 +151,13 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 	case GameMessageType::PlayerJoined:
 	{
 		DEBUGLOG("Received a PlayerJoined message\n");
-		auto& peers = g_game->GetPeers();
-		const auto& itr = peers.find(sourceId);
-		auto entityid = sourceId;
-		if (itr == peers.end())
+		if (player == nullptr)
 		{
 			auto playerState = std::make_shared<PlayerState>();
-			playerState->DeserializePlayerStateData(message->RawData());
+			playerState->EntityId = sourceId;
+			playerState->DeserializePlayerStateData(message.RawData());
 
-			peers[sourceId] = playerState;
+			g_game->AddPlayerToLobbyPeers(playerState);
 
 			Managers::Get<OnlineManager>()->SendGameMessage(GameMessage(
 				GameMessageType::PlayerState,
@@ -156,7 +176,7 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 		}
 		if (player != nullptr)
 		{
-			player->DeserializePlayerStateData(message->RawData());
+			player->DeserializePlayerStateData(message.RawData());
 		}
 		else
 		{
@@ -166,25 +186,36 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 	}
 	case GameMessageType::PlayerState:
 	{
-		DEBUGLOG("Received a PlayerState message from %u\n", sourceId);
+		DEBUGLOG_PACKET("Received a PlayerState message from %u\n", sourceId);
 		if (player != nullptr)
 		{
-			player->DeserializePlayerStateData(message->RawData());
+			player->DeserializePlayerStateData(message.RawData());
 		}
 		else
 		{
 			player = std::make_shared<PlayerState>();
-			player->DeserializePlayerStateData(message->RawData());
+			player->EntityId = sourceId;
+			player->DeserializePlayerStateData(message.RawData());
 			g_game->AddPlayerToLobbyPeers(player);
 		}
 		break;
 	}
+	case GameMessageType::PeerSlots:
+	{
+		DEBUGLOG("Received a PeerSlots message\n");
+		// The host keeps its own table
+		if (!Managers::Get<OnlineManager>()->IsHost())
+		{
+			g_game->DeserializePeerSlots(message.RawData());
+		}
+		break;
+	}
 	case GameMessageType::PowerUpSpawn:
 	{
 		DEBUGLOG("Received a PowerUpSpawn message\n");
 		if (world->IsInitialized())
 		{
-			world->DeserializePowerUpSpawn(message->RawData());
+			world->DeserializePowerUpSpawn(message.RawData());
 		}
 		else
 		{
@@ -194,13 +225,10 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 	}
 	case GameMessageType::ShipData:
 	{
-		DEBUGLOG("Received a ShipData message\n");
+		DEBUGLOG_PACKET("Received a ShipData message\n");
 		if (world->IsInitialized())
 		{
-			if (player != nullptr)
-			{
-				player->GetShip()->Deserialize(message->RawData());
-			}
+			world->DeserializeShipData(message.RawData());
 		}
 		else
 		{
@@ -210,16 +238,16 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 	}
 	case GameMessageType::ShipDeath:
 	{
-		DEBUGLOG("Received a ShipDeath message from %u\n", sourceId);
+		DEBUGLOG("Received a ShipDeath message from %s\n", sourceId.c_str());
 		if (world->IsInitialized())
 		{
 			if (player != nullptr)
 			{
-				world->DeserializeShipDeath(sourceId, message->RawData());
+				world->DeserializeShipDeath(player, message.RawData());
 			}
 			else
 			{
-				DEBUGLOG("PlayerState not found for %u\n", sourceId);
+				DEBUGLOG("PlayerState not found for %s\n", sourceId.c_str());
 			}
 		}
 		else
@@ -232,9 +260,10 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 	{
 		if (world->IsInitialized())
 		{
-			if (player != nullptr)
+			// Every peer steers the owner's ship with its moves; the host also reports back where they left it
+			if (player != nullptr && !player->IsLocalPlayer)
 			{
-				player->GetShip()->Deserialize(message->RawData());
+				player->GetShip()->DeserializeMoves(message.RawData());
 			}
 		}
 		else
@@ -248,7 +277,7 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 		DEBUGLOG("Received a ShipSpawn message\n");
 		if (world->IsInitialized())
 		{
-			world->DeserializeShipSpawn(message->RawData());
+			world->DeserializeShipSpawn(message.RawData());
 		}
 		else
 		{
@@ -258,10 +287,10 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 	}
 	case GameMessageType::WorldData:
 	{
-		DEBUGLOG("Received a WorldData message\n");
+		DEBUGLOG_PACKET("Received a WorldData message\n");
 		if (world->IsInitialized())
 		{
-			world->DeserializeWorldData(message->RawData());
+			world->DeserializeWorldData(message.RawData());
 		}
 		else
 		{
@@ -269,12 +298,20 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 		}
 		break;
 	}
+	case GameMessageType::WorldDataAck:
+	{
+		if (Managers::Get<OnlineManager>()->IsHost() && player != nullptr)
+		{
+			world->AcknowledgeWorldData(*player, message.UnsignedValue());
+		}
+		break;
+	}
 	case GameMessageType::WorldSetup:
 	{
 		DEBUGLOG("Received a WorldSetup message\n");
 		if (!world->IsInitialized())
 		{
-			world->DeserializeWorldSetup(message->RawData());
+			world->DeserializeWorldSetup(message.RawData());
 		}
 		else
 		{
@@ -342,23 +379,11 @@ void PlayFabOnlineManager::ProcessGameNetworkMessage(std::string sourceId, GameM
 	{
 		DEBUGLOG("Received a LeaveGameComplete message\n");
 		// Remove all remote peers
-		std::vector<std::string> remotePlayers;
-		auto& peers = g_game->GetPeers();
-		for (auto&& [id, playerState] : peers)
-		{
-			if (!playerState->IsLocalPlayer)
-			{
-				remotePlayers.push_back(id);
-			}
-			else
-			{
-				g_game->ResetGameplayData();
-			}
-		}
-		for (auto& id : remotePlayers)
+		if (g_game->GetLocalPlayer() != nullptr)
 		{
-			peers.erase(id);
+			g_game->ResetGameplayData();
 		}
+		g_game->RemoveRemotePlayers();
 
 		if (Managers::Get<OnlineManager>()->IsHost())
 		{
@@ -387,9 +412,82 @@ void PlayFabOnlineManager::RegisterOnlineMessageHandler(OnlineMessageHandler han
 	m_messageHandler = handler;
 
 	Managers::Get<OnlineManager>()->m_playfabParty.SetGameMessageHandler(
-		[this](std::string uid, std::shared_ptr<GameMessage> message)
+		[this](std::string uid, const GameMessageView& message)
 		{
-			DEBUGLOG("Received message: %s\n", MessageTypeString(message->MessageType()));
-			m_messageHandler(uid, message.get());
+			DEBUGLOG_PACKET("Received message: %s\n", MessageTypeString(message.MessageType()));
+			m_messageHandler(uid, message);
 		});
 }
+
+void PlayFabOnlineManager::StartRecording(const std::wstring& path)
+{
+	StopRecording();
+
+	try
+	{
+		m_recorder = std::make_unique<TrafficRecorder>(path);
+	}
+	catch (const std::runtime_error& error)
+	{
+		DEBUGLOG("Unable to record traffic: %s\n", error.what());
+		return;
+	}
+
+	m_recordedEntityId = GetLocalUserEntityId();
+	m_recordedIsHost = IsHost();
+	m_recorder->RecordSession(m_recordedEntityId, m_recordedIsHost);
+	DEBUGLOG("Recording traffic\n");
+}
+
+void PlayFabOnlineManager::StopRecording()
+{
+	if (m_recorder != nullptr)
+	{
+		DEBUGLOG("Recorded %llu bytes of traffic%s\n", m_recorder->GetBytesWritten(), m_recorder->HasFailed() ? " before the capture failed" : "");
+		m_recorder.reset();
+	}
+}
+
+void PlayFabOnlineManager::RecordWorldUpdate(float totalTime, float elapsedTime)
+{
+	if (m_recorder != nullptr)
+	{
+		RecordSessionIfChanged();
+		m_recorder->RecordWorldUpdate(totalTime, elapsedTime);
+	}
+}
+
+void PlayFabOnlineManager::BeginReplay()
+{
+	m_isReplaying = true;
+	m_replayEntityId.clear();
+	m_replayIsHost = false;
+	m_replaySentMessages = 0;
+	m_replaySentBytes = 0;
+}
+
+void PlayFabOnlineManager::EndReplay()
+{
+	m_isReplaying = false;
+}
+
+void PlayFabOnlineManager::SetReplaySession(const std::string& localEntityId, bool isHost)
+{
+	m_replayEntityId = localEntityId;
+	m_replayIsHost = isHost;
+}
+
+// The local player isn't known until sign-in finishes, and hosting can start or stop
+// mid-session, so each frame checks before it's written
+void PlayFabOnlineManager::RecordSessionIfChanged()
+{
+	const char* entityId = GetLocalUserEntityId();
+	const bool isHost = IsHost();
+
+	if (isHost != m_recordedIsHost || m_recordedEntityId != entityId)
+	{
+		m_recordedEntityId = entityId;
+		m_recordedIsHost = isHost;
+		m_recorder->RecordSession(m_recordedEntityId, m_recordedIsHost);
+	}
+}
@@ -9,6 +9,7 @@
 #include "StatsAndAchievements.h"
 #include "SteamInventory.h"
 #include "SteamLeaderboard.h"
+#include "TrafficCapture.h"
 
 namespace NetRumble
 {
@@ -45,7 +46,7 @@ namespace NetRumble
 		// Handling when leaving the game
 		virtual void LeaveMultiplayerGame() override;
 		// Send in-game messages to other players
-		virtual void SendGameMessage(const GameMessage& message) override;
+		virtual void SendGameMessage(const GameMessageView& message) override;
 		// Registers a GameMessage message handle
 		virtual void RegisterOnlineMessageHandler(OnlineMessageHandler handler) override;
 		virtual bool IsNetworkAvailable() const override;
@@ -70,23 +71,27 @@ namespace NetRumble
 		OnlineMessageHandler& GetOnlineMessageHandler() { return m_messageHandler; }
 		void JoinMultiplayerGame(const std::string& connectionString);
 		// Checks for any incoming network data, then dispatches it
-		void ProcessGameNetworkMessage(std::string sourceId, GameMessage* message);
+		void ProcessGameNetworkMessage(std::string sourceId, const GameMessageView& message);
 		inline void SwitchToOnlineState(OnlineState toState) { m_onlineState = toState; }
 		inline void SetPartyLocalEntityId(std::string& entityId) { m_playfabParty.SetPartyLocalEntityId(entityId); }
 		inline void SetPartyLocalEntityToken(std::string& entityId) { m_playfabParty.SetPartyLocalEntityToken(entityId); }
 		inline void SetPartyEntityTokenExpireTime(time_t expireTime) { m_playfabParty.SetPartyEntityTokenExpireTime(expireTime); }
 		void PlayfabPartyDoWork() { m_playfabParty.DoWork(); }
+		void FlushGameMessages() { m_playfabParty.FlushGameMessages(); }
+		const ApplyLatency& GetApplyLatency() const { return m_playfabParty.GetApplyLatency(); }
 		void InitializePlayfabParty() { m_playfabParty.Initialize(); }
 		void PopulatePartyRegionLatencies(bool send = true) { m_playfabParty.PopulatePartyRegionLatencies(); }
-		bool IsHost() const { return m_playfabParty.IsHost(); }
+		bool IsHost() const { return m_isReplaying ? m_replayIsHost : m_playfabParty.IsHost(); }
 		void SetHost(bool isHost) { m_playfabParty.SetHost(isHost); }
 		bool IsPartyInitialized() const { return m_playfabParty.IsPartyInitialized(); }
-		const char* GetLocalUserEntityId() const { return m_playfabParty.GetLocalUserEntityId(); }
+		const char* GetLocalUserEntityId() const { return m_isReplaying ? m_replayEntityId.c_str() : m_playfabParty.GetLocalUserEntityId(); }
 		inline void FindLobbies() { m_pfLobby.FindLobbies(); }
 		void UpdateLobbyState(const PFLobbyAccessPolicy accessPolicy) { m_pfLobby.UpdateLobbyState(accessPolicy); }
 		void SetFindLobbyCallback(FindLobbyCallback completionCallback) { m_pfLobby.SetFindLobbyCallback(completionCallback); }
 		void GetAllItems() { m_inventory.GetAllItems(); }
 		inline const PlayFab::ClientModels::EntityKey& GetEntityKey() { return m_playfabLogin.GetEntityKey(); }
+		// The key the local PlayerState is stored under in Game::GetPeers
+		std::string GetLocalPlayerEntityId() { return m_isReplaying ? m_replayEntityId : GetEntityKey().Id; }
 		bool IsJoiningArrangedLobby() { return m_isJoiningArrangedLobby; }
 		// Leaves and shuts down PlayFab Party
 		void CleanupOnlineServices();
@@ -120,6 +125,22 @@ namespace NetRumble
 		inline CSteamID GetLocalSteamID() const { return m_localPlayerSteamID; }
 		inline void SetLocalSteamID(CSteamID playerID) { m_localPlayerSteamID = playerID; };
 
+		// Traffic capture: every game message sent and received, and every world update,
+		// until StopRecording or the game exits
+		void StartRecording(const std::wstring& path);
+		void StopRecording();
+		void RecordWorldUpdate(float totalTime, float elapsedTime);
+		inline bool IsRecording() const { return m_recorder != nullptr; }
+
+		// Replay stands in for the platform: the local player and host status come from the
+		// capture, and game messages are counted rather than sent
+		void BeginReplay();
+		void EndReplay();
+		void SetReplaySession(const std::string& localEntityId, bool isHost);
+		inline bool IsReplaying() const { return m_isReplaying; }
+		inline uint64_t GetReplaySentMessages() const { return m_replaySentMessages; }
+		inline uint64_t GetReplaySentBytes() const { return m_replaySentBytes; }
+
 	private:
 		friend PlayFabLobby;
 		friend PlayFabMatchmaking;
@@ -163,6 +184,7 @@ namespace NetRumble
 
 		PFMultiplayerHandle& GetMultiplayerHandle() { return m_pfMultiplayerHandle; }
 		void OnPFPartyNetworkCreated(const std::string& descriptor);
+		void RecordSessionIfChanged();
 
 		uint64_t m_localUserId{ 0 };
 		std::string m_networkId;
@@ -172,6 +194,16 @@ namespace NetRumble
 		OnlineMessageHandler m_messageHandler{};
 		bool m_isJoiningArrangedLobby{ false };
 		OnlineState m_onlineState{ OnlineState::Ready };
+
+		std::unique_ptr<TrafficRecorder> m_recorder;
+		std::string m_recordedEntityId;
+		bool m_recordedIsHost{ false };
+
+		bool m_isReplaying{ false };
+		std::string m_replayEntityId;
+		bool m_replayIsHost{ false };
+		uint64_t m_replaySentMessages{ 0 };
+		uint64_t m_replaySentBytes{ 0 };
 	};
 
 	extern const char* MessageTypeString(GameMessageType type);
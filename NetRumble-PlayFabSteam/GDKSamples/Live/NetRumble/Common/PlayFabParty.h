@@ -9,6 +9,8 @@
 #include "Party.h"
 #include "Manager.h"
 #include "NetworkMessages.h"
+#include "MessageBundle.h"
+#include "NetworkThread.h"
 
 namespace NetRumble
 {
@@ -33,8 +35,10 @@ namespace NetRumble
 		void CreateLocalUser();
 		void CreateAndConnectToNetwork(const char* networkId, std::function<void(std::string)> onNetworkCreated = nullptr);
 		void ConnectToNetwork(const char* networkId, const char* descriptor, std::function<void(void)> onNetworkConnected = nullptr);
-		void SendGameMessage(const GameMessage& message);
-		void SetGameMessageHandler(std::function<void(std::string, std::shared_ptr<GameMessage>)> onMessageReceived);
+		void SendGameMessage(const GameMessageView& message);
+		// Broadcasts everything SendGameMessage queued this frame
+		void FlushGameMessages();
+		void SetGameMessageHandler(std::function<void(std::string, const GameMessageView&)> onMessageReceived);
 		void SetEndpointChangeHandler(std::function<void(uint64_t, bool)> onEndpointChanged);
 		void SendTextAsVoice(std::string text);
 		void SendTextMessage(std::string text);
@@ -43,10 +47,15 @@ namespace NetRumble
 		void MigrateToNetwork(const char* descriptor, std::function<void(bool)> callback = nullptr);
 		void Shutdown();
 
+		// Applies whatever state changes Party has ready now
 		void DoWork();
 
 		void TryEntityTokenRefresh();
 
+		// How long messages waited between a Party pump finding them and the game applying them
+		inline const ApplyLatency& GetApplyLatency() const { return m_applyLatency; }
+		inline void ResetApplyLatency() { m_applyLatency.Reset(); }
+
 		// PartyStateChange Functions
 		void OnRegionsChanged(const Party::PartyStateChange* change);
 		void OnDestroyLocalUserCompleted(const Party::PartyStateChange* change);
@@ -70,6 +79,7 @@ namespace NetRumble
 		void OnLeaveNetworkCompleted(const Party::PartyStateChange* change);
 		void OnNetworkDestroyed(const Party::PartyStateChange* change);
 		void OnEndpointMessageReceived(const Party::PartyStateChange* change);
+		void SendBundledMessage(Party::PartySendMessageOptions deliveryOptions, DataBufferView message);
 		void OnDataBuffersReturned(const Party::PartyStateChange* change);
 		void OnEndpointPropertiesChanged(const Party::PartyStateChange* change);
 		void OnSynchronizeMessagesBetweenEndpointsCompleted(const Party::PartyStateChange* change);
@@ -132,13 +142,16 @@ namespace NetRumble
 		void CreateLocalChatControl();
 		std::string DisplayNameFromChatControl(Party::PartyChatControl* control);
 		bool ReportPartyError(const PartyError& error);
+		void DispatchStateChange(const Party::PartyStateChange* change);
+		void ApplyGameMessage(const char* sender, DataBufferView message);
+		void SendOnEndpoint(Party::PartyLocalEndpoint* endpoint, Party::PartySendMessageOptions deliveryOptions, DataBufferView message);
 
 		std::function<void(std::string)> m_onNetworkCreated;
 		std::function<void(void)> m_onNetworkConnected;
 		std::function<void(void)> m_onNetworkDestroyed;
 		std::function<void(bool)> m_onNetworkMigrated;
 		std::function<void(bool, const char*)> m_onRegionMigrated;
-		std::function<void(std::string, std::shared_ptr<GameMessage>)> m_onMessageReceived;
+		std::function<void(std::string, const GameMessageView&)> m_onMessageReceived;
 		std::function<void(uint64_t, bool)> m_onEndpointChanged;
 		NetworkManagerState m_state = NetworkManagerState::Initialize;
 		std::map<std::string, Party::PartyChatControl*> m_chatControls;
@@ -148,6 +161,12 @@ namespace NetRumble
 		Party::PartyNetwork* m_newNetwork = nullptr;
 		Party::PartyLocalUser* m_localUser = nullptr;
 		Party::PartyLocalChatControl* m_localChatControl = nullptr;
+		std::vector<uint8_t> m_sendBuffer;
+		// Every message is broadcast, so there is one destination and a run per delivery option set
+		MessageBundler m_bundler{ [this](uint64_t, int deliveryOptions, DataBufferView message)
+			{
+				SendBundledMessage(static_cast<Party::PartySendMessageOptions>(deliveryOptions), message);
+			} };
 		bool m_partyInitialized = false;
 		bool m_host = false;
 		bool m_localUserReady = false;
@@ -164,6 +183,10 @@ namespace NetRumble
 		std::map<std::string, uint64_t> m_entityIdToUid;
 		std::map<uint64_t, std::string> m_uidToEntityId;
 		Party::PartyNetworkDescriptor m_networkDescriptor{};
+
+		ApplyLatency m_applyLatency;
+		// When the last pump finished; anything the next one finds arrived since
+		NetworkThread::Clock::time_point m_lastPump;
 	};
 
 }
@@ -9,6 +9,13 @@
 using namespace NetRumble;
 using namespace DirectX;
 
+namespace
+{
+	constexpr uint8_t c_inGameFlag = 0x01;
+	constexpr uint8_t c_inLobbyFlag = 0x02;
+	constexpr uint8_t c_lobbyReadyFlag = 0x04;
+}
+
 PlayerState::PlayerState(std::string_view displayName)
 {
 	m_playerShip = std::make_shared<Ship>();
@@ -50,52 +57,49 @@ void PlayerState::ReactivatePlayer()
 	m_isInactive = false;
 }
 
-void PlayerState::DeserializePlayerStateData(const std::vector<uint8_t>& data)
+// Layout: lobby flags, ship color, ship variation, display name
+void PlayerState::DeserializePlayerStateData(DataBufferView data)
 {
-	PlayerStateData rcvdPlayerStateData = PlayerStateData();
-	CopyMemory(&rcvdPlayerStateData, data.data(), sizeof(PlayerStateData));
+	DataBufferReader dataReader(data);
+
+	uint8_t flags = dataReader.ReadByte();
+	uint8_t shipColorIndex = dataReader.ReadByte();
+	uint8_t shipVariation = dataReader.ReadByte();
+	std::string displayName = dataReader.ReadString();
 
 	DEBUGLOG("Received player state data: DisplayName = %s; EntityId = %s; InGame = %u; InLobby = %u;LobbyReady = %u; ColorIndex = %u; ColorVariation = %u\n",
-		rcvdPlayerStateData.displayName,
-		rcvdPlayerStateData.entityId,
-		rcvdPlayerStateData.inGame,
-		rcvdPlayerStateData.inLobby,
-		rcvdPlayerStateData.lobbyReady,
-		rcvdPlayerStateData.shipColorIndex,
-		rcvdPlayerStateData.shipVariation);
-
-	if (rcvdPlayerStateData.displayName[MaxSteamUserNameLength - 1] != '\0')
-	{
-		std::string nameBuffer(rcvdPlayerStateData.displayName, rcvdPlayerStateData.displayName + MaxSteamUserNameLength);
-		DisplayName = nameBuffer;
-	}
-	else
-	{
-		DisplayName = rcvdPlayerStateData.displayName;
-	}
-	if (rcvdPlayerStateData.entityId[MaxSteamUserNameLength - 1] != '\0')
-	{
-		std::string nameBuffer(rcvdPlayerStateData.entityId, rcvdPlayerStateData.entityId + MaxSteamUserNameLength);
-		EntityId = nameBuffer;
-	}
-	else
+		displayName.c_str(),
+		EntityId.c_str(),
+		(flags & c_inGameFlag) != 0,
+		(flags & c_inLobbyFlag) != 0,
+		(flags & c_lobbyReadyFlag) != 0,
+		shipColorIndex,
+		shipVariation);
+
+	if (displayName.length() > static_cast<size_t>(MaxSteamUserNameLength))
 	{
-		EntityId = rcvdPlayerStateData.entityId;
+		displayName.resize(MaxSteamUserNameLength);
 	}
+	DisplayName = displayName;
 
-	InGame = rcvdPlayerStateData.inGame;
-	InLobby = rcvdPlayerStateData.inLobby;
-	LobbyReady = rcvdPlayerStateData.lobbyReady;
-	ShipColor(rcvdPlayerStateData.shipColorIndex);
-	ShipVariation(rcvdPlayerStateData.shipVariation);
+	InGame = (flags & c_inGameFlag) != 0;
+	InLobby = (flags & c_inLobbyFlag) != 0;
+	LobbyReady = (flags & c_lobbyReadyFlag) != 0;
+	ShipColor(shipColorIndex);
+	ShipVariation(shipVariation);
 }
 
 std::vector<uint8_t> PlayerState::SerializePlayerStateData() const
 {
-	PlayerStateData playerStateData = { InGame, InLobby, LobbyReady, m_shipColor, m_shipVariation };
+	DataBufferWriter dataWriter;
 
-	CopyMemory(playerStateData.displayName, DisplayName.c_str(), DisplayName.length());
-	CopyMemory(playerStateData.entityId, EntityId.c_str(), EntityId.length());
+	dataWriter.WriteByte(static_cast<uint8_t>(
+		(InGame ? c_inGameFlag : 0) |
+		(InLobby ? c_inLobbyFlag : 0) |
+		(LobbyReady ? c_lobbyReadyFlag : 0)));
+	dataWriter.WriteByte(m_shipColor);
+	dataWriter.WriteByte(m_shipVariation);
+	dataWriter.WriteString(std::string_view(DisplayName).substr(0, MaxSteamUserNameLength));
 
 	DEBUGLOG("Serializing player state data: PlayerName = %s; EntityId = %s; InGame = %u; InLobby = %u; LobbyReady = %u; ColorIndex = %d; ColorVariation = %d\n",
 		DisplayName.c_str(),
@@ -106,10 +110,7 @@ std::vector<uint8_t> PlayerState::SerializePlayerStateData() const
 		m_shipColor,
 		m_shipVariation);
 
-	std::vector<uint8_t> data(sizeof(PlayerStateData));
-	CopyMemory(data.data(), &playerStateData, sizeof(PlayerStateData));
-
-	return data;
+	return dataWriter.GetBuffer();
 }
 
 void PlayerState::SetRegionLatency(std::string_view region, uint64_t latency)
@@ -8,16 +8,23 @@
 
 using namespace NetRumble;
 
-Projectile::Projectile(Ship* owner, DirectX::SimpleMath::Vector2 direction) :
+Projectile::Projectile(Ship* owner) :
 	m_owner(owner)
+{
+}
+
+void Projectile::Launch(DirectX::SimpleMath::Vector2 direction)
 {
 	Velocity = direction;
-	Position = owner->Position;
+	Position = m_owner->Position;
 	Rotation = std::acos(direction.y); // Safe for all angles, but assumes direction is a unit vector
 	if (direction.x > 0.0f)
 	{
 		Rotation *= -1.0f;
 	}
+
+	Life = 0.0f;
+	CollidedThisFrame = false;
 }
 
 void Projectile::Update(float elapsedTime)
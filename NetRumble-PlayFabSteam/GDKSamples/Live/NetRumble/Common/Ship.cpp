@@ -48,6 +48,29 @@ namespace
 
 	// The value of velocity squared is less than 0.0001f, we consider ship stopped.
 	constexpr float c_minimumVelocityThreshold = 0.0001f;
+
+	// The fraction of a prediction correction eased out per second, and the distance past which
+	// the ship jumps straight to the corrected position (it collided on one side and not the other).
+	constexpr float c_correctionPerSecond = 10.0f;
+	constexpr float c_correctionSnapDistanceSquared = 100.0f * 100.0f;
+	constexpr float c_correctionSettledSquared = 0.01f * 0.01f;
+
+	// Most moves in one ShipInput packet; at 60 Hz the packet before last is well inside this
+	constexpr uint32_t c_maxMovesPerPacket = 32;
+
+	// Seconds of remote moves held back before applying them: a ShipInput packet's worth and a
+	// frame to spare. Moves queued beyond the maximum are applied at once rather than falling
+	// further behind, and a remote ship starved of moves for too long coasts.
+	constexpr float c_moveBufferTime = 0.06f;
+	constexpr size_t c_maxQueuedMoves = 12;
+	constexpr float c_moveStarvationTime = 0.25f;
+
+	// Quantization of the ShipData packet fields.
+	constexpr uint32_t c_positionBits = 16;
+	constexpr uint32_t c_velocityBits = 16;
+	constexpr uint32_t c_rotationBits = 12;
+	constexpr uint32_t c_lifeBits = 10;
+	constexpr uint32_t c_shieldBits = 10;
 }
 
 const std::array<DirectX::XMVECTORF32, 18> Ship::Colors =
@@ -85,6 +108,15 @@ void Ship::Initialize(bool isLocal, bool useSpawnEffect)
 	m_safeTimer = c_safeTimerMaximum;
 	m_shieldPulseTime = 0.0f;
 	m_shieldRechargeTimer = 0.0f;
+
+	// Moves from before the respawn don't apply to the new ship
+	m_moves.Clear();
+	m_positionCorrection = SimpleMath::Vector2::Zero;
+	m_queuedMoves.clear();
+	m_queuedMoveTime = 0.0f;
+	m_bufferingMoves = true;
+	m_snapshots.Clear();
+
 	PrimaryWeapon = std::make_shared<LaserWeapon>(this);
 	DroppedWeapon = std::make_shared<MineWeapon>(this);
 
@@ -107,42 +139,32 @@ void Ship::Update(float elapsedTime)
 {
 	// Calculate the current forward vector
 	SimpleMath::Vector2 forward = SimpleMath::Vector2{ std::sin(Rotation), -std::cos(Rotation) };
-	SimpleMath::Vector2 right = SimpleMath::Vector2{ -forward.y, forward.x };
-
-	// Calculate the new forward vector with the left stick
-	Input.LeftStick.y *= -1.0f;
 
-	float d = Input.LeftStick.LengthSquared();
-
-	if (d > 0.0f)
+	if (IsLocal)
 	{
-		d = sqrt(d);
-
-		SimpleMath::Vector2 wantedForward = XMVectorScale(Input.LeftStick, 1.0f / d);
-		float angleDiff = std::acos(wantedForward.Dot(forward));
-		float facing = wantedForward.Dot(right) > 0.0f ? 1.0f : -1.0f;
+		ShipMotion motion{ Position, Velocity, Rotation };
+		Steer(motion, Input.LeftStick, elapsedTime);
+		Velocity = motion.Velocity;
+		Rotation = motion.Rotation;
 
-		if (angleDiff > 0.001f)
+		// Ease out whatever the last correction from the host left over
+		if (m_positionCorrection != SimpleMath::Vector2::Zero)
 		{
-			Rotation += std::min<float>(angleDiff, facing * elapsedTime * c_rotationRadiansPerSecond);
-		}
-		Velocity += Input.LeftStick * elapsedTime * c_fullSpeed;
-
-		d = Velocity.Length();
-
-		if (d > c_velocityMaximum)
-		{
-			Velocity *= c_velocityMaximum / d;
+			SimpleMath::Vector2 step = m_positionCorrection * std::min<float>(1.0f, elapsedTime * c_correctionPerSecond);
+			Position += step;
+			m_positionCorrection -= step;
+			if (m_positionCorrection.LengthSquared() < c_correctionSettledSquared)
+			{
+				Position += m_positionCorrection;
+				m_positionCorrection = SimpleMath::Vector2::Zero;
+			}
 		}
 	}
-	Input.LeftStick = SimpleMath::Vector2{ 0, 0 };
-
-	// Apply drag to the velocity
-	Velocity -= Velocity * (elapsedTime * c_dragPerSecond);
-	if (Velocity.LengthSquared() <= c_minimumVelocityThreshold)
+	else
 	{
-		Velocity = XMFLOAT2(0, 0);
+		ApplyQueuedMoves(elapsedTime);
 	}
+	Input.LeftStick = SimpleMath::Vector2{ 0, 0 };
 
 	// Check for firing with the right stick
 	Input.RightStick.y *= -1.0f;
@@ -195,15 +217,16 @@ void Ship::Update(float elapsedTime)
 	}
 
 	// Update the projectiles
-	for (auto& projectile : Projectiles)
+	for (size_t i = 0; i < Projectiles.size(); i++)
 	{
+		auto& projectile = Projectiles[i];
 		if (projectile->Active())
 		{
 			projectile->Update(elapsedTime);
 		}
 		else
 		{
-			Projectiles.QueuePendingRemoval(projectile);
+			Projectiles.QueuePendingRemoval(Projectiles.handle_at(i));
 		}
 	}
 
@@ -344,8 +367,14 @@ void Ship::Die(GameplayObject* source, bool cleanupOnly)
 			projectile->Die(nullptr, true);
 		}
 
-		// Get these projectiles out of the collision system before we destroy them for good
-		Managers::Get<CollisionManager>()->Collection().ApplyPendingRemovals();
+		// Get these projectiles out of the collision system before we let go of them. If the
+		// ship died colliding, the walk has objects still to move, and the next collision
+		// update applies the removals instead.
+		CollisionManager* collisionManager = Managers::Get<CollisionManager>();
+		if (!collisionManager->IsWalkingObjects())
+		{
+			collisionManager->Collection().ApplyPendingRemovals();
+		}
 
 		Projectiles.clear();
 
@@ -368,30 +397,309 @@ void Ship::SetSafe(bool isSafe)
 	}
 }
 
-std::vector<unsigned char> Ship::Serialize()
+void Ship::Serialize(BitBufferWriter& dataWriter, const RECT& worldBounds) const
+{
+	dataWriter.WriteVarUInt32(IsLocal ? m_moves.GetNewestSequence() : m_lastAppliedMove);
+	dataWriter.WritePosition(Position, worldBounds, c_positionBits);
+	dataWriter.WriteSignedQuantized(Velocity.x, c_velocityMaximum, c_velocityBits);
+	dataWriter.WriteSignedQuantized(Velocity.y, c_velocityMaximum, c_velocityBits);
+	dataWriter.WriteAngle(Rotation, c_rotationBits);
+	// Life goes negative on the killing blow, anything past -c_lifeMaximum is just as dead
+	dataWriter.WriteSignedQuantized(Life, c_lifeMaximum, c_lifeBits);
+	dataWriter.WriteQuantized(Shield, 0.0f, c_shieldMaximum, c_shieldBits);
+}
+
+void Ship::Deserialize(BitBufferReader& dataReader, const RECT& worldBounds, uint32_t sequence, float hostTime)
+{
+	uint32_t lastAppliedMove = dataReader.ReadVarUInt32();
+
+	ShipMotion motion;
+	motion.Position = dataReader.ReadPosition(worldBounds, c_positionBits);
+	motion.Velocity.x = dataReader.ReadSignedQuantized(c_velocityMaximum, c_velocityBits);
+	motion.Velocity.y = dataReader.ReadSignedQuantized(c_velocityMaximum, c_velocityBits);
+	motion.Rotation = dataReader.ReadAngle(c_rotationBits);
+	float life = dataReader.ReadSignedQuantized(c_lifeMaximum, c_lifeBits);
+	float shield = dataReader.ReadQuantized(0.0f, c_shieldMaximum, c_shieldBits);
+
+	if (IsLocal)
+	{
+		// The owner stays the authority on its own damage and death
+		Reconcile(motion, lastAppliedMove);
+		return;
+	}
+
+	// A packet that arrived behind a newer one has nothing to add
+	if (!m_snapshots.Add(MotionSnapshot{ sequence, hostTime, motion.Position, motion.Velocity, motion.Rotation }))
+	{
+		return;
+	}
+
+	Life = life;
+	Shield = shield;
+}
+
+void Ship::Interpolate(float hostTime, float maximumExtrapolation)
+{
+	MotionSnapshot motion;
+	if (m_snapshots.Sample(hostTime, maximumExtrapolation, motion))
+	{
+		Position = motion.Position;
+		Velocity = motion.Velocity;
+		Rotation = motion.Rotation;
+	}
+}
+
+void Ship::HoldInput(const ShipInput& input)
+{
+	ShipInput held = input;
+
+	// A shot or mine from a frame that no step has run since is kept, even once let go
+	if (!m_heldInputTaken)
+	{
+		if (input.RightStick.LengthSquared() <= c_fireThresholdSquared)
+		{
+			held.RightStick = m_heldInput.RightStick;
+		}
+		held.MineFired = held.MineFired || m_heldInput.MineFired;
+	}
+
+	m_heldInput = held;
+	m_heldInputTaken = false;
+	m_sampledInput = input;
+}
+
+void Ship::ClearHeldInput()
+{
+	m_heldInput = ShipInput();
+	m_sampledInput = ShipInput();
+	m_heldInputTaken = true;
+}
+
+void Ship::RecordMove(float elapsedTime)
+{
+	Input = m_heldInput;
+	m_moves.Add(elapsedTime, Input);
+
+	// The step has taken the held shot and mine; until the next frame only what is still pressed counts
+	m_heldInput = m_sampledInput;
+	m_heldInputTaken = true;
+}
+
+void Ship::RecordPredictedMotion()
+{
+	PredictedShipMove* move = m_moves.Find(m_moves.GetNewestSequence());
+	if (move != nullptr && !move->HasPrediction)
+	{
+		// Predictions are kept where the ship is heading, not where the correction has eased it to so far
+		move->Predicted = ShipMotion{ Position + m_positionCorrection, Velocity, Rotation };
+		move->HasPrediction = true;
+	}
+}
+
+void Ship::SerializeMoves(BitBufferWriter& dataWriter)
+{
+	uint32_t newest = m_moves.GetNewestSequence();
+
+	// Repeat the previous packet's moves so a single lost packet loses nothing
+	uint32_t first = std::max({ m_movesSentThrough[1] + 1, m_lastReconciledMove + 1, m_moves.GetOldestSequence() });
+	if (newest >= c_maxMovesPerPacket)
+	{
+		first = std::max(first, newest - c_maxMovesPerPacket + 1);
+	}
+	uint32_t count = newest >= first ? newest - first + 1 : 0;
+
+	dataWriter.WriteVarUInt32(newest);
+	dataWriter.WriteBits(count, BitsRequired(c_maxMovesPerPacket));
+	for (uint32_t sequence = first; sequence <= newest; ++sequence)
+	{
+		m_moves.Find(sequence)->Move.Serialize(dataWriter);
+	}
+
+	m_movesSentThrough[1] = m_movesSentThrough[0];
+	m_movesSentThrough[0] = newest;
+}
+
+void Ship::DeserializeMoves(DataBufferView data)
+{
+	BitBufferReader dataReader(data);
+
+	uint32_t newest = dataReader.ReadVarUInt32();
+	uint32_t count = dataReader.ReadBits(BitsRequired(c_maxMovesPerPacket));
+	if (count > c_maxMovesPerPacket || count > newest)
+	{
+		DEBUGLOG("Ill-formed ShipInput data: %u moves through %u\n", count, newest);
+		return;
+	}
+
+	// The owner's numbering went backwards a long way, so it has restarted
+	if (newest + ShipMoveHistory::c_capacity < m_lastQueuedMove)
+	{
+		m_lastQueuedMove = 0;
+		m_lastAppliedMove = 0;
+	}
+
+	for (uint32_t sequence = newest - count + 1; sequence <= newest; ++sequence)
+	{
+		ShipMove move;
+		move.Sequence = sequence;
+		move.Deserialize(dataReader);
+
+		if (sequence > m_lastQueuedMove)
+		{
+			m_queuedMoves.push_back(move);
+			m_lastQueuedMove = sequence;
+		}
+	}
+}
+
+void Ship::Steer(ShipMotion& motion, SimpleMath::Vector2 leftStick, float elapsedTime)
+{
+	// Calculate the new forward vector with the left stick
+	leftStick.y *= -1.0f;
+
+	float d = leftStick.LengthSquared();
+
+	if (d > 0.0f)
+	{
+		d = sqrt(d);
+
+		SimpleMath::Vector2 forward = SimpleMath::Vector2{ std::sin(motion.Rotation), -std::cos(motion.Rotation) };
+		SimpleMath::Vector2 right = SimpleMath::Vector2{ -forward.y, forward.x };
+		SimpleMath::Vector2 wantedForward = XMVectorScale(leftStick, 1.0f / d);
+		float angleDiff = std::acos(std::clamp(wantedForward.Dot(forward), -1.0f, 1.0f));
+		float facing = wantedForward.Dot(right) > 0.0f ? 1.0f : -1.0f;
+
+		if (angleDiff > 0.001f)
+		{
+			motion.Rotation += std::min<float>(angleDiff, facing * elapsedTime * c_rotationRadiansPerSecond);
+		}
+		motion.Velocity += leftStick * elapsedTime * c_fullSpeed;
+
+		d = motion.Velocity.Length();
+
+		if (d > c_velocityMaximum)
+		{
+			motion.Velocity *= c_velocityMaximum / d;
+		}
+	}
+
+	// Apply drag to the velocity
+	motion.Velocity -= motion.Velocity * (elapsedTime * c_dragPerSecond);
+	if (motion.Velocity.LengthSquared() <= c_minimumVelocityThreshold)
+	{
+		motion.Velocity = XMFLOAT2(0, 0);
+	}
+}
+
+// Remote ships are steered by their owner's moves, each for the time it took on the owner's
+// machine, so the host ends up where the owner predicted. Moves arrive a packet at a time, so
+// a few are held back to keep one applied every frame until the next packet. Fire and mine
+// input is merged so a shot in any of the moves applied this frame is taken.
+void Ship::ApplyQueuedMoves(float elapsedTime)
 {
-	DataBufferWriter dataWriter;
+	ShipMotion motion{ Position, Velocity, Rotation };
+
+	if (m_bufferingMoves)
+	{
+		float queuedTime = 0.0f;
+		for (const ShipMove& move : m_queuedMoves)
+		{
+			queuedTime += move.ElapsedTime;
+		}
+
+		if (queuedTime < c_moveBufferTime)
+		{
+			// An owner that has gone quiet coasts as if it let go of the stick
+			m_queuedMoveTime += elapsedTime;
+			if (m_queuedMoveTime > c_moveStarvationTime)
+			{
+				Steer(motion, SimpleMath::Vector2::Zero, elapsedTime);
+				Velocity = motion.Velocity;
+			}
+			return;
+		}
+
+		m_bufferingMoves = false;
+		m_queuedMoveTime = 0.0f;
+	}
+
+	// Apply each move once its time has mostly come, so moves and frames of nearly equal
+	// length pair up one to one
+	m_queuedMoveTime += elapsedTime;
+	size_t applied = 0;
+	while (applied < m_queuedMoves.size() &&
+		(m_queuedMoves[applied].ElapsedTime * 0.5f <= m_queuedMoveTime || m_queuedMoves.size() - applied > c_maxQueuedMoves))
+	{
+		const ShipMove& move = m_queuedMoves[applied];
+		Steer(motion, move.Input.LeftStick, move.ElapsedTime);
+		m_queuedMoveTime -= move.ElapsedTime;
+
+		if (move.Input.RightStick.LengthSquared() > Input.RightStick.LengthSquared())
+		{
+			Input.RightStick = move.Input.RightStick;
+		}
+		Input.MineFired = Input.MineFired || move.Input.MineFired;
+
+		m_lastAppliedMove = move.Sequence;
+		applied++;
+	}
+	m_queuedMoves.erase(m_queuedMoves.begin(), m_queuedMoves.begin() + applied);
 
-	dataWriter.WriteStruct(Position);
-	dataWriter.WriteStruct(Velocity);
-	dataWriter.WriteSingle(Rotation);
-	dataWriter.WriteSingle(Life);
-	dataWriter.WriteSingle(Shield);
-	dataWriter.WriteStruct(Input);
+	if (m_queuedMoves.empty())
+	{
+		m_bufferingMoves = true;
+		m_queuedMoveTime = 0.0f;
+	}
 
-	return dataWriter.GetBuffer();
+	Velocity = motion.Velocity;
+	Rotation = motion.Rotation;
 }
 
-void Ship::Deserialize(const std::vector<unsigned char>& data)
+// Rebuild the local prediction on top of the host's state: start from where the host put the
+// ship after the last move it applied, then replay every later move the client has made.
+void Ship::Reconcile(const ShipMotion& authoritative, uint32_t lastAppliedMove)
 {
-	DataBufferReader dataReader(data);
-
-	dataReader.ReadStruct(Position);
-	dataReader.ReadStruct(Velocity);
-	Rotation = dataReader.ReadSingle();
-	Life = dataReader.ReadSingle();
-	Shield = dataReader.ReadSingle();
-	dataReader.ReadStruct(Input);
+	// Ignore a late or repeated packet, and one from before this ship's moves began
+	if (lastAppliedMove <= m_lastReconciledMove || lastAppliedMove > m_moves.GetNewestSequence())
+	{
+		return;
+	}
+	m_lastReconciledMove = lastAppliedMove;
+
+	const PredictedShipMove* confirmed = m_moves.Find(lastAppliedMove);
+	if (confirmed == nullptr || !confirmed->HasPrediction)
+	{
+		return;
+	}
+
+	m_lastPredictionError = SimpleMath::Vector2::Distance(confirmed->Predicted.Position, authoritative.Position);
+	m_predictionCorrections++;
+
+	ShipMotion motion = authoritative;
+	for (uint32_t sequence = lastAppliedMove + 1; sequence <= m_moves.GetNewestSequence(); ++sequence)
+	{
+		PredictedShipMove* move = m_moves.Find(sequence);
+
+		// A move whose step left the ship dead has nothing to replay from
+		if (!move->HasPrediction)
+		{
+			break;
+		}
+
+		Steer(motion, move->Move.Input.LeftStick, move->Move.ElapsedTime);
+		motion.Position += motion.Velocity * move->Move.ElapsedTime;
+		move->Predicted = motion;
+	}
+
+	Velocity = motion.Velocity;
+	Rotation = motion.Rotation;
+
+	m_positionCorrection = motion.Position - Position;
+	if (m_positionCorrection.LengthSquared() > c_correctionSnapDistanceSquared)
+	{
+		Position = motion.Position;
+		m_positionCorrection = SimpleMath::Vector2::Zero;
+	}
 }
 
 void Ship::SetShipTexture(uint32_t index)
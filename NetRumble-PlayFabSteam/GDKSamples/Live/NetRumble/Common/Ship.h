@@ -8,13 +8,20 @@
 
 #include "GameplayObject.h"
 #include "ShipInput.h"
+#include "ShipPrediction.h"
+#include "SnapshotBuffer.h"
 #include "Projectile.h"
 #include "Weapon.h"
 #include "BatchRemovalCollection.h"
+#include "BitBuffer.h"
+#include "ObjectPool.h"
 
 namespace NetRumble
 {
 	class PlayerState;
+	class LaserProjectile;
+	class RocketProjectile;
+	class MineProjectile;
 
 	class Ship : public GameplayObject
 	{
@@ -30,11 +37,43 @@ namespace NetRumble
 
 		void SetSafe(bool isSafe);
 
-		// Prepare the ship input data for the ShipInput packet
-		std::vector<unsigned char> Serialize();
+		// Prepare the host's view of the ship for the ShipData packet, quantized against the world bounds
+		void Serialize(BitBufferWriter& dataWriter, const RECT& worldBounds) const;
 
-		// Get the latest ship input from the ShipInput packet
-		void Deserialize(const std::vector<unsigned char>& data);
+		// Apply the host's view of the ship from the ShipData packet. The local ship
+		// keeps its own prediction, corrected by replaying the moves the host has not yet applied;
+		// a remote ship buffers it, stamped with the packet's sequence and host time, to be shown later.
+		void Deserialize(BitBufferReader& dataReader, const RECT& worldBounds, uint32_t sequence, float hostTime);
+
+		// Remote ship: move to where the buffered host states put it at the given host time
+		void Interpolate(float hostTime, float maximumExtrapolation);
+
+		// Local ship: hold the frame's input for the steps run before the next frame. The sticks
+		// and mine trigger are replaced, but a shot or mine stays held until a step takes it.
+		void HoldInput(const ShipInput& input);
+
+		// Local ship: forget the held input, shots and mines included
+		void ClearHeldInput();
+
+		// Local ship: take the held input as this step's Input, number it as the next move and
+		// remember it for replay
+		void RecordMove(float elapsedTime);
+
+		// Local ship: remember where the newest move left the ship, once the step's physics has run
+		void RecordPredictedMotion();
+
+		// Local ship: prepare the moves made since the packet before last for the ShipInput packet
+		void SerializeMoves(BitBufferWriter& dataWriter);
+
+		// Remote ship: queue the moves from the ShipInput packet that have not been seen yet
+		void DeserializeMoves(DataBufferView data);
+
+		// Turn toward and accelerate along a screen-space left stick, then apply drag
+		static void Steer(ShipMotion& motion, DirectX::SimpleMath::Vector2 leftStick, float elapsedTime);
+
+		// How far the host's state was from the local prediction for the same move at the last correction
+		inline float GetLastPredictionError() const { return m_lastPredictionError; }
+		inline uint32_t GetPredictionCorrections() const { return m_predictionCorrections; }
 
 		void SetShipTexture(uint32_t index);
 
@@ -58,6 +97,11 @@ namespace NetRumble
 		void RunFrame() {}
 
 		BatchRemovalCollection<std::shared_ptr<Projectile>> Projectiles;
+
+		// Every projectile this ship's weapons have made, launched again once it is done with
+		ObjectPool<LaserProjectile> LaserProjectiles;
+		ObjectPool<RocketProjectile> RocketProjectiles;
+		ObjectPool<MineProjectile> MineProjectiles;
 	private:
 		TextureHandle m_primaryTexture;
 		TextureHandle m_overlayTexture;
@@ -67,6 +111,31 @@ namespace NetRumble
 		float m_shieldPulseTime = 0;
 		float m_shieldRechargeTimer = 0;
 
+		void ApplyQueuedMoves(float elapsedTime);
+		void Reconcile(const ShipMotion& authoritative, uint32_t lastAppliedMove);
+
+		// Local prediction
+		ShipInput m_heldInput;
+		ShipInput m_sampledInput;
+		bool m_heldInputTaken = true;
+		ShipMoveHistory m_moves;
+		std::array<uint32_t, 2> m_movesSentThrough = {};
+		uint32_t m_lastReconciledMove = 0;
+		DirectX::SimpleMath::Vector2 m_positionCorrection = DirectX::SimpleMath::Vector2::Zero;
+		float m_lastPredictionError = 0.0f;
+		uint32_t m_predictionCorrections = 0;
+
+		// Remote moves, applied at the pace their owner made them. Applied ones are erased
+		// from the front a frame's worth at a time, so the queue keeps its capacity.
+		std::vector<ShipMove> m_queuedMoves;
+		float m_queuedMoveTime = 0.0f;
+		bool m_bufferingMoves = true;
+		uint32_t m_lastQueuedMove = 0;
+		uint32_t m_lastAppliedMove = 0;
+
+		// Host states of a remote ship, shown a little behind
+		SnapshotBuffer m_snapshots;
+
 	public:
 		// The colors used for each ship.
 		static const std::array<DirectX::XMVECTORF32, 18> Colors;
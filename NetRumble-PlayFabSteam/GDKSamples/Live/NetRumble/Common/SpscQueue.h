@@ -0,0 +1,86 @@
+//--------------------------------------------------------------------------------------
+// SpscQueue.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Bounded queue from exactly one producer thread to exactly one consumer thread. Items are
+// moved in and out of slots that live as long as the queue, so an item that owns a buffer
+// carries it across without copying, and pushing or popping never takes a lock or
+// allocates. Each side caches the other's position and only rereads it when the queue
+// looks full or empty, so the two threads rarely touch the same cache line.
+template<typename T>
+class SpscQueue
+{
+public:
+	// Capacity must be a power of two
+	explicit SpscQueue(size_t capacity) :
+		m_slots(new T[capacity]),
+		m_mask(capacity - 1)
+	{
+	}
+
+	SpscQueue(SpscQueue const&) = delete;
+	SpscQueue& operator= (SpscQueue const&) = delete;
+
+	// Producer only. Moves from item and returns true, or leaves it alone if the queue is full.
+	bool TryPush(T& item)
+	{
+		const size_t position = m_writePosition.load(std::memory_order_relaxed);
+		if (position - m_cachedReadPosition > m_mask)
+		{
+			m_cachedReadPosition = m_readPosition.load(std::memory_order_acquire);
+			if (position - m_cachedReadPosition > m_mask)
+			{
+				return false;
+			}
+		}
+
+		m_slots[position & m_mask] = std::move(item);
+		m_writePosition.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer only. Moves the oldest item into item, or returns false if there is none.
+	bool TryPop(T& item)
+	{
+		const size_t position = m_readPosition.load(std::memory_order_relaxed);
+		if (position == m_cachedWritePosition)
+		{
+			m_cachedWritePosition = m_writePosition.load(std::memory_order_acquire);
+			if (position == m_cachedWritePosition)
+			{
+				return false;
+			}
+		}
+
+		item = std::move(m_slots[position & m_mask]);
+		m_readPosition.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Either thread; only a hint, since the other side may move at any moment
+	inline bool Empty() const
+	{
+		return m_readPosition.load(std::memory_order_acquire) == m_writePosition.load(std::memory_order_acquire);
+	}
+
+	inline size_t Capacity() const { return m_mask + 1; }
+
+private:
+	std::unique_ptr<T[]> m_slots;
+	size_t m_mask;
+
+	alignas(64) std::atomic<size_t> m_writePosition{ 0 };
+	size_t m_cachedReadPosition = 0;
+
+	alignas(64) std::atomic<size_t> m_readPosition{ 0 };
+	size_t m_cachedWritePosition = 0;
+};
@@ -0,0 +1,355 @@
+//--------------------------------------------------------------------------------------
+// TrafficCapture.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "TrafficCapture.h"
+
+using namespace NetRumble;
+
+namespace
+{
+	constexpr uint32_t c_captureMagic = 0x4354524E; // "NRTC"
+	constexpr uint16_t c_captureVersion = 1;
+
+	// A match's worth of traffic fits in a few of these; the mapping doubles when it fills
+	constexpr uint64_t c_initialCapacity = 4 * 1024 * 1024;
+
+#pragma pack( push, 1 )
+	struct CaptureFileHeader
+	{
+		uint32_t Magic;
+		uint16_t Version;
+	};
+
+	struct CaptureFrameHeader
+	{
+		CaptureFrameKind Kind;
+		uint32_t DeltaMicroseconds;
+		uint32_t Size;
+	};
+#pragma pack( pop )
+
+	void CloseHandles(HANDLE& file, HANDLE& mapping)
+	{
+		if (mapping != nullptr)
+		{
+			CloseHandle(mapping);
+			mapping = nullptr;
+		}
+
+		if (file != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file);
+			file = INVALID_HANDLE_VALUE;
+		}
+	}
+}
+
+TrafficRecorder::TrafficRecorder(const std::wstring& path)
+{
+	m_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("Unable to create the capture file");
+	}
+
+	try
+	{
+		Map(c_initialCapacity);
+	}
+	catch (const std::runtime_error&)
+	{
+		Unmap();
+		CloseHandles(m_file, m_mapping);
+		throw;
+	}
+
+	CaptureFileHeader header = {};
+	header.Magic = c_captureMagic;
+	header.Version = c_captureVersion;
+
+	memcpy(m_view, &header, sizeof(header));
+	m_size = sizeof(header);
+
+	QueryPerformanceFrequency(&m_frequency);
+	QueryPerformanceCounter(&m_lastFrameTime);
+}
+
+TrafficRecorder::~TrafficRecorder()
+{
+	Unmap();
+
+	// The mapping grew the file to its capacity; cut it back to the frames
+	if (m_file != INVALID_HANDLE_VALUE)
+	{
+		LARGE_INTEGER size = {};
+		size.QuadPart = static_cast<LONGLONG>(m_size);
+		if (SetFilePointerEx(m_file, size, nullptr, FILE_BEGIN))
+		{
+			SetEndOfFile(m_file);
+		}
+	}
+
+	CloseHandles(m_file, m_mapping);
+}
+
+void TrafficRecorder::RecordSession(std::string_view localEntityId, bool isHost)
+{
+	uint8_t* data = BeginFrame(CaptureFrameKind::Session, sizeof(uint8_t) + localEntityId.size());
+	if (data == nullptr)
+	{
+		return;
+	}
+
+	*data++ = isHost ? 1 : 0;
+	memcpy(data, localEntityId.data(), localEntityId.size());
+}
+
+void TrafficRecorder::RecordReceived(std::string_view sender, const GameMessageView& message)
+{
+	const uint8_t senderLength = static_cast<uint8_t>(std::min<size_t>(sender.size(), UINT8_MAX));
+	const DataBufferView payload = message.RawData();
+	const GameMessageType type = message.MessageType();
+
+	uint8_t* data = BeginFrame(CaptureFrameKind::Received, sizeof(senderLength) + senderLength + MsgTypeSize + payload.size());
+	if (data == nullptr)
+	{
+		return;
+	}
+
+	*data++ = senderLength;
+	memcpy(data, sender.data(), senderLength);
+	data += senderLength;
+	memcpy(data, &type, MsgTypeSize);
+	memcpy(data + MsgTypeSize, payload.data(), payload.size());
+}
+
+void TrafficRecorder::RecordSent(const GameMessageView& message)
+{
+	const DataBufferView payload = message.RawData();
+	const GameMessageType type = message.MessageType();
+
+	uint8_t* data = BeginFrame(CaptureFrameKind::Sent, MsgTypeSize + payload.size());
+	if (data == nullptr)
+	{
+		return;
+	}
+
+	memcpy(data, &type, MsgTypeSize);
+	memcpy(data + MsgTypeSize, payload.data(), payload.size());
+}
+
+void TrafficRecorder::RecordWorldUpdate(float totalTime, float elapsedTime)
+{
+	uint8_t* data = BeginFrame(CaptureFrameKind::WorldUpdate, sizeof(totalTime) + sizeof(elapsedTime));
+	if (data == nullptr)
+	{
+		return;
+	}
+
+	memcpy(data, &totalTime, sizeof(totalTime));
+	memcpy(data + sizeof(totalTime), &elapsedTime, sizeof(elapsedTime));
+}
+
+uint8_t* TrafficRecorder::BeginFrame(CaptureFrameKind kind, size_t size)
+{
+	if (m_failed)
+	{
+		return nullptr;
+	}
+
+	const uint64_t frameSize = sizeof(CaptureFrameHeader) + size;
+	if (m_size + frameSize > m_capacity)
+	{
+		uint64_t capacity = m_capacity * 2;
+		while (m_size + frameSize > capacity)
+		{
+			capacity *= 2;
+		}
+
+		Unmap();
+		try
+		{
+			Map(capacity);
+		}
+		catch (const std::runtime_error& error)
+		{
+			DEBUGLOG("Traffic capture stopped at %llu bytes: %s\n", m_size, error.what());
+			Unmap();
+			m_failed = true;
+			return nullptr;
+		}
+	}
+
+	LARGE_INTEGER now = {};
+	QueryPerformanceCounter(&now);
+	const uint64_t deltaMicroseconds = static_cast<uint64_t>(now.QuadPart - m_lastFrameTime.QuadPart) * 1000000 / static_cast<uint64_t>(m_frequency.QuadPart);
+	m_lastFrameTime = now;
+
+	CaptureFrameHeader header = {};
+	header.Kind = kind;
+	header.DeltaMicroseconds = static_cast<uint32_t>(std::min<uint64_t>(deltaMicroseconds, UINT32_MAX));
+	header.Size = static_cast<uint32_t>(size);
+
+	uint8_t* frame = m_view + m_size;
+	memcpy(frame, &header, sizeof(header));
+	m_size += frameSize;
+	return frame + sizeof(header);
+}
+
+void TrafficRecorder::Map(uint64_t capacity)
+{
+	m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READWRITE, static_cast<DWORD>(capacity >> 32), static_cast<DWORD>(capacity), nullptr);
+	if (m_mapping == nullptr)
+	{
+		throw std::runtime_error("Unable to map the capture file");
+	}
+
+	m_view = static_cast<uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_WRITE, 0, 0, static_cast<SIZE_T>(capacity)));
+	if (m_view == nullptr)
+	{
+		throw std::runtime_error("Unable to map a view of the capture file");
+	}
+
+	m_capacity = capacity;
+}
+
+void TrafficRecorder::Unmap()
+{
+	if (m_view != nullptr)
+	{
+		UnmapViewOfFile(m_view);
+		m_view = nullptr;
+	}
+
+	if (m_mapping != nullptr)
+	{
+		CloseHandle(m_mapping);
+		m_mapping = nullptr;
+	}
+}
+
+TrafficCapture::TrafficCapture(const std::wstring& path)
+{
+	m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("Unable to open the capture file");
+	}
+
+	LARGE_INTEGER size = {};
+	if (!GetFileSizeEx(m_file, &size) || static_cast<uint64_t>(size.QuadPart) < sizeof(CaptureFileHeader))
+	{
+		CloseHandles(m_file, m_mapping);
+		throw std::runtime_error("Capture file is too short");
+	}
+	m_size = static_cast<uint64_t>(size.QuadPart);
+
+	m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	m_view = m_mapping ? static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+	if (m_view == nullptr)
+	{
+		CloseHandles(m_file, m_mapping);
+		throw std::runtime_error("Unable to map the capture file");
+	}
+
+	CaptureFileHeader header = {};
+	memcpy(&header, m_view, sizeof(header));
+	if (header.Magic != c_captureMagic || header.Version != c_captureVersion)
+	{
+		UnmapViewOfFile(m_view);
+		m_view = nullptr;
+		CloseHandles(m_file, m_mapping);
+		throw std::runtime_error("Not a NetRumble capture file");
+	}
+
+	m_firstFrame = sizeof(header);
+	Rewind();
+}
+
+TrafficCapture::~TrafficCapture()
+{
+	if (m_view != nullptr)
+	{
+		UnmapViewOfFile(m_view);
+	}
+
+	CloseHandles(m_file, m_mapping);
+}
+
+bool TrafficCapture::Next(Frame& frame)
+{
+	CaptureFrameHeader header = {};
+	if (m_size - m_offset < sizeof(header))
+	{
+		return false;
+	}
+
+	memcpy(&header, m_view + m_offset, sizeof(header));
+	if (m_size - m_offset - sizeof(header) < header.Size)
+	{
+		return false;
+	}
+
+	const uint8_t* data = m_view + m_offset + sizeof(header);
+	m_timeMicroseconds += header.DeltaMicroseconds;
+
+	frame = Frame();
+	frame.Kind = header.Kind;
+	frame.Time = static_cast<double>(m_timeMicroseconds) * 0.000001;
+
+	switch (header.Kind)
+	{
+	case CaptureFrameKind::Session:
+		if (header.Size < sizeof(uint8_t))
+		{
+			return false;
+		}
+
+		frame.IsHost = data[0] != 0;
+		frame.EntityId = std::string_view(reinterpret_cast<const char*>(data + 1), header.Size - 1);
+		break;
+
+	case CaptureFrameKind::Received:
+	{
+		const uint8_t senderLength = header.Size > 0 ? data[0] : 0;
+		if (header.Size < sizeof(senderLength) + senderLength)
+		{
+			return false;
+		}
+
+		frame.EntityId = std::string_view(reinterpret_cast<const char*>(data + 1), senderLength);
+		frame.Packet = DataBufferView(data + 1 + senderLength, header.Size - 1 - senderLength);
+		break;
+	}
+	case CaptureFrameKind::Sent:
+		frame.Packet = DataBufferView(data, header.Size);
+		break;
+
+	case CaptureFrameKind::WorldUpdate:
+		if (header.Size < sizeof(frame.TotalTime) + sizeof(frame.ElapsedTime))
+		{
+			return false;
+		}
+
+		memcpy(&frame.TotalTime, data, sizeof(frame.TotalTime));
+		memcpy(&frame.ElapsedTime, data + sizeof(frame.TotalTime), sizeof(frame.ElapsedTime));
+		break;
+
+	default:
+		// A newer build's frame; skip it
+		break;
+	}
+
+	m_offset += sizeof(header) + header.Size;
+	return true;
+}
+
+void TrafficCapture::Rewind()
+{
+	m_offset = m_firstFrame;
+	m_timeMicroseconds = 0;
+}
@@ -0,0 +1,108 @@
+//--------------------------------------------------------------------------------------
+// TrafficCapture.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "NetworkMessages.h"
+
+namespace NetRumble
+{
+	// A capture file is a header followed by frames, each a kind, the time since the frame
+	// before it and the size of what follows, packed with no padding:
+	//
+	//   Session:     is host (1 byte) | local entity ID
+	//   Received:    sender length (1 byte) | sender entity ID | packet
+	//   Sent:        packet
+	//   WorldUpdate: total time (float) | elapsed time (float)
+	//
+	// Packets are GameMessageType|MessagePayload, exactly as they crossed the network. A
+	// Session frame comes before the first message and again whenever the local player
+	// signs in as someone else or starts or stops hosting.
+	enum class CaptureFrameKind : uint8_t
+	{
+		Session = 1,
+		Received = 2,
+		Sent = 3,
+		WorldUpdate = 4
+	};
+
+	// Appends frames to a capture file through a mapped view, growing the mapping as it
+	// fills; the file is cut to what was written when the recorder closes. Throws
+	// std::runtime_error if the file can't be created. If it can't be grown later, the
+	// recorder fails: the frames so far are kept and the rest are ignored.
+	class TrafficRecorder final
+	{
+	public:
+		explicit TrafficRecorder(const std::wstring& path);
+		~TrafficRecorder();
+
+		TrafficRecorder(TrafficRecorder const&) = delete;
+		TrafficRecorder& operator= (TrafficRecorder const&) = delete;
+
+		void RecordSession(std::string_view localEntityId, bool isHost);
+		void RecordReceived(std::string_view sender, const GameMessageView& message);
+		void RecordSent(const GameMessageView& message);
+		void RecordWorldUpdate(float totalTime, float elapsedTime);
+
+		inline uint64_t GetBytesWritten() const { return m_size; }
+		inline bool HasFailed() const { return m_failed; }
+
+	private:
+		uint8_t* BeginFrame(CaptureFrameKind kind, size_t size);
+		void Map(uint64_t capacity);
+		void Unmap();
+
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+		uint8_t* m_view = nullptr;
+		uint64_t m_capacity = 0;
+		uint64_t m_size = 0;
+		bool m_failed = false;
+
+		LARGE_INTEGER m_lastFrameTime = {};
+		LARGE_INTEGER m_frequency = {};
+	};
+
+	// Reads a capture file through a read-only mapped view; the views Next hands out stay
+	// valid for the life of the capture. Throws std::runtime_error if the file can't be
+	// opened or isn't a capture.
+	class TrafficCapture final
+	{
+	public:
+		struct Frame
+		{
+			CaptureFrameKind Kind;
+			// Seconds since the capture started
+			double Time;
+			// The sender of a received packet, or the local player for a session
+			std::string_view EntityId;
+			bool IsHost;
+			DataBufferView Packet;
+			float TotalTime;
+			float ElapsedTime;
+		};
+
+		explicit TrafficCapture(const std::wstring& path);
+		~TrafficCapture();
+
+		TrafficCapture(TrafficCapture const&) = delete;
+		TrafficCapture& operator= (TrafficCapture const&) = delete;
+
+		// Returns false at the end of the capture, or at a truncated frame
+		bool Next(Frame& frame);
+		void Rewind();
+
+	private:
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = nullptr;
+		const uint8_t* m_view = nullptr;
+		uint64_t m_size = 0;
+
+		uint64_t m_firstFrame = 0;
+		uint64_t m_offset = 0;
+		uint64_t m_timeMicroseconds = 0;
+	};
+}
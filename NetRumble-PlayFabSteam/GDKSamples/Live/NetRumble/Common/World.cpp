@@ -9,6 +9,26 @@
 using namespace NetRumble;
 using namespace DirectX;
 
+// Field mask bits for each asteroid in a ServerUpdateWorldData packet
+constexpr uint8_t c_worldDataPositionField = 0x1;
+constexpr uint8_t c_worldDataVelocityField = 0x2;
+constexpr uint32_t c_worldDataFieldBits = 2;
+
+// Quantization of the asteroid fields in a ServerUpdateWorldData packet
+constexpr uint32_t c_worldDataPositionBits = 16;
+constexpr uint32_t c_worldDataVelocityBits = 16;
+constexpr float c_worldDataVelocityRange = 512.0f;
+
+// Width of a ship's owner slot in a ShipData packet
+constexpr uint32_t c_peerSlotBits = BitsRequired(MaxPeerSlots - 1);
+
+static SimpleMath::Vector2 QuantizeWorldDataVelocity(const SimpleMath::Vector2& velocity)
+{
+	return SimpleMath::Vector2(
+		BitBufferWriter::SignedQuantize(velocity.x, c_worldDataVelocityRange, c_worldDataVelocityBits),
+		BitBufferWriter::SignedQuantize(velocity.y, c_worldDataVelocityRange, c_worldDataVelocityBits));
+}
+
 World::World()
 {
 	m_isGameInProgress = false;
@@ -16,6 +36,9 @@ World::World()
 
 	ResetDefaults();
 
+	m_sentSnapshots.Reserve(c_Asteroids);
+	m_receivedSnapshots.Reserve(c_Asteroids);
+
 	m_starfield = std::make_unique<Starfield>(SimpleMath::Vector2());
 
 	// Set outer barrier and world dimensions
@@ -78,6 +101,22 @@ void World::ResetDefaults()
 
 	m_isInitialized = false;
 	m_updatesSinceWorldDataSent = 0;
+	m_updatesSinceShipDataSent = 0;
+	m_updatesSinceShipInputSent = 0;
+	m_shipDataSequence = 0;
+	m_lastShipDataReceived = 0;
+	m_worldDataSequence = 0;
+	m_lastWorldDataReceived = 0;
+	m_worldDataTime = 0.0f;
+	m_worldDataLogTimer = 0.0f;
+	m_sentSnapshots.Clear();
+	m_receivedSnapshots.Clear();
+	m_hostClock.Reset();
+	for (SnapshotBuffer& asteroidSnapshots : m_asteroidSnapshots)
+	{
+		asteroidSnapshots.Clear();
+	}
+	m_worldDataReceived.Reset();
 	m_powerUp = nullptr;
 	m_powerUpTimer = c_maximumPowerUpTimer;
 
@@ -88,10 +127,21 @@ void World::ResetDefaults()
 	if (g_game)
 	{
 		g_game->ClearPlayerScores();
+
+		// Nobody holds a snapshot of the new world yet
+		for (PlayerState* playerState : g_game->GetPlayers())
+		{
+			if (playerState)
+			{
+				playerState->LastAckedWorldData = 0;
+				playerState->WorldDataBandwidth.Reset();
+			}
+		}
 	}
 
 	Managers::Get<CollisionManager>()->Collection().ApplyPendingRemovals();
 	Managers::Get<CollisionManager>()->Collection().clear();
+	Managers::Get<CollisionManager>()->CancelExplosions();
 }
 
 // Generate the world, placing asteroids and all ships
@@ -104,11 +154,11 @@ void World::GenerateWorld()
 	CollisionManager* collisionMgr = Managers::Get<CollisionManager>();
 
 	// Initialize the ships, finding spawn points and resetting score
-	for (const auto& playerState : g_game->GetAllPlayerStates())
+	for (PlayerState* playerState : g_game->GetPlayers())
 	{
 		if (playerState && playerState->LobbyReady)
 		{
-			std::shared_ptr<Ship> ship = playerState->GetShip();
+			const std::shared_ptr<Ship>& ship = playerState->GetShip();
 			ship->Initialize(playerState->IsLocalPlayer);
 			ship->Position = collisionMgr->FindSpawnPoint(ship.get(), ship->Radius);
 		}
@@ -140,7 +190,7 @@ void World::GenerateWorld()
 		m_asteroids.push_back(asteroid);
 	}
 
-	std::shared_ptr<PlayerState> localPlayerState = g_game->GetLocalPlayerState();
+	PlayerState* localPlayerState = g_game->GetLocalPlayer();
 	if (localPlayerState)
 	{
 		m_starfield->Reset(localPlayerState->GetShip()->Position);
@@ -149,42 +199,38 @@ void World::GenerateWorld()
 	m_isInitialized = true;
 }
 
-std::vector<uint8_t> World::SerializeShipSpawn(std::string entityId) const
+std::vector<uint8_t> World::SerializeShipSpawn(const PlayerState& playerState) const
 {
-	std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(entityId);
-	if (playerState != nullptr)
+	const auto& ship = playerState.GetShip();
+	if (ship != nullptr && playerState.Slot != NoPeerSlot)
 	{
-		std::shared_ptr<Ship> ship = playerState->GetShip();
-		if (ship != nullptr)
-		{
-			SimpleMath::Vector2 spawnPt = Managers::Get<CollisionManager>()->FindSpawnPoint(ship.get(), ship->Radius);
-			DataBufferWriter dataWriter;
+		SimpleMath::Vector2 spawnPt = Managers::Get<CollisionManager>()->FindSpawnPoint(ship.get(), ship->Radius);
+		DataBufferWriter dataWriter;
 
-			dataWriter.WriteString(entityId);
-			dataWriter.WriteStruct(spawnPt);
+		dataWriter.WriteByte(playerState.Slot);
+		dataWriter.WriteStruct(spawnPt);
 
-			return dataWriter.GetBuffer();
-		}
+		return dataWriter.GetBuffer();
 	}
 
 	return std::vector<uint8_t>();
 }
 
-void World::DeserializeShipSpawn(const std::vector<uint8_t>& data)
+void World::DeserializeShipSpawn(DataBufferView data)
 {
 	DataBufferReader dataReader(data);
 
-	std::string entityId = dataReader.ReadString();
+	uint8_t slot = dataReader.ReadByte();
 	float x = dataReader.ReadSingle();
 	float y = dataReader.ReadSingle();
 	SimpleMath::Vector2 position = SimpleMath::Vector2(x, y);
 
-	DEBUGLOG("Received entityId %s at (%f, %f)\n", entityId.c_str(), position.x, position.y);
+	DEBUGLOG("Received slot %u at (%f, %f)\n", slot, position.x, position.y);
 
-	std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(entityId);
+	std::shared_ptr<PlayerState> playerState = g_game->GetPlayerStateBySlot(slot);
 	if (playerState != nullptr)
 	{
-		std::shared_ptr<Ship> ship = playerState->GetShip();
+		const std::shared_ptr<Ship>& ship = playerState->GetShip();
 		if (ship != nullptr)
 		{
 			ship->Position = position;
@@ -205,7 +251,7 @@ std::vector<unsigned char> World::SerializePowerUpSpawn() const
 	return dataWriter.GetBuffer();
 }
 
-void World::DeserializePowerUpSpawn(const std::vector<uint8_t>& data)
+void World::DeserializePowerUpSpawn(DataBufferView data)
 {
 	DataBufferReader dataReader(data);
 
@@ -216,45 +262,373 @@ void World::DeserializePowerUpSpawn(const std::vector<uint8_t>& data)
 }
 
 // Prepare the world data for the ServerUpdateWorldData packet
-std::vector<unsigned char> World::SerializeWorldData() const
+//
+// Layout: sequence, distance back to the baseline sequence (0 for absolute), snapshot time,
+// changed asteroid count, then per changed asteroid its index, a field mask and the fields
+// that changed, quantized. Anything not sent is dead-reckoned by the receiver from the baseline.
+void World::SerializeWorldData(BitBufferWriter& dataWriter)
 {
-	DataBufferWriter dataWriter;
+	constexpr uint32_t c_countBits = BitsRequired(c_asteroids);
+	constexpr uint32_t c_indexBits = BitsRequired(c_asteroids - 1);
 
-	// Write the asteroid data
+	const WorldSnapshot* baseline = FindWorldDataBaseline();
+	WorldSnapshot& snapshot = m_sentSnapshots.Add(++m_worldDataSequence, m_worldDataTime);
+
+	std::array<uint8_t, c_asteroids> changedFields{};
+	uint32_t changedCount = 0;
+
+	// Record the quantized state the receivers will rebuild so later deltas stay in step with them
 	for (size_t i = 0; i < c_asteroids; ++i)
 	{
-		dataWriter.WriteStruct(m_asteroids[i]->Position);
-		dataWriter.WriteStruct(m_asteroids[i]->Velocity);
+		AsteroidSnapshot actual{ m_asteroids[i]->Position, m_asteroids[i]->Velocity };
+		AsteroidSnapshot predicted = baseline ? baseline->Predict(i, snapshot.Time) : actual;
+		if (baseline == nullptr || SimpleMath::Vector2::DistanceSquared(actual.Position, predicted.Position) > c_snapshotPositionTolerance * c_snapshotPositionTolerance)
+		{
+			changedFields[i] = static_cast<uint8_t>(changedFields[i] | c_worldDataPositionField);
+			predicted.Position = BitBufferWriter::QuantizePosition(actual.Position, m_worldDimensions, c_worldDataPositionBits);
+		}
+		if (baseline == nullptr || SimpleMath::Vector2::DistanceSquared(actual.Velocity, predicted.Velocity) > c_snapshotVelocityTolerance * c_snapshotVelocityTolerance)
+		{
+			changedFields[i] = static_cast<uint8_t>(changedFields[i] | c_worldDataVelocityField);
+			predicted.Velocity = QuantizeWorldDataVelocity(actual.Velocity);
+		}
+		snapshot.Asteroids.push_back(predicted);
+
+		if (changedFields[i] != 0)
+		{
+			changedCount++;
+		}
 	}
 
-	return dataWriter.GetBuffer();
+	dataWriter.WriteVarUInt32(snapshot.Sequence);
+	dataWriter.WriteVarUInt32(baseline ? snapshot.Sequence - baseline->Sequence : 0);
+	dataWriter.WriteSingle(snapshot.Time);
+	dataWriter.WriteBits(changedCount, c_countBits);
+
+	// Write the asteroids that changed
+	for (size_t i = 0; i < c_asteroids; ++i)
+	{
+		if (changedFields[i] == 0)
+		{
+			continue;
+		}
+
+		dataWriter.WriteBits(static_cast<uint32_t>(i), c_indexBits);
+		dataWriter.WriteBits(changedFields[i], c_worldDataFieldBits);
+		if (changedFields[i] & c_worldDataPositionField)
+		{
+			dataWriter.WritePosition(snapshot.Asteroids[i].Position, m_worldDimensions, c_worldDataPositionBits);
+		}
+		if (changedFields[i] & c_worldDataVelocityField)
+		{
+			dataWriter.WriteSignedQuantized(snapshot.Asteroids[i].Velocity.x, c_worldDataVelocityRange, c_worldDataVelocityBits);
+			dataWriter.WriteSignedQuantized(snapshot.Asteroids[i].Velocity.y, c_worldDataVelocityRange, c_worldDataVelocityBits);
+		}
+	}
 }
 
-void World::DeserializeWorldData(const std::vector<uint8_t>& data)
+void World::DeserializeWorldData(DataBufferView data)
 {
-	DataBufferReader dataReader(data);
+	constexpr uint32_t c_countBits = BitsRequired(c_asteroids);
+	constexpr uint32_t c_indexBits = BitsRequired(c_asteroids - 1);
+
+	m_worldDataReceived.AddBytes(data.size() + MsgTypeSize);
 
-	// Update the asteroid data
+	BitBufferReader dataReader(data);
+
+	uint32_t sequence = dataReader.ReadVarUInt32();
+	uint32_t baselineDistance = dataReader.ReadVarUInt32();
+	float time = dataReader.ReadSingle();
+
+	// A late packet from the last game can leave the count ahead of this one's
+	if (IsSnapshotSequenceRestart(sequence, m_lastWorldDataReceived))
+	{
+		DEBUGLOG("World data %u restarts the count from %u\n", sequence, m_lastWorldDataReceived);
+		m_receivedSnapshots.Clear();
+		m_lastWorldDataReceived = 0;
+	}
+
+	// Ignore anything older than what has already been applied
+	if (sequence <= m_lastWorldDataReceived)
+	{
+		return;
+	}
+
+	const WorldSnapshot* baseline = nullptr;
+	if (baselineDistance != 0)
+	{
+		uint32_t baselineSequence = sequence - baselineDistance;
+		baseline = m_receivedSnapshots.Find(baselineSequence);
+		if (baseline == nullptr)
+		{
+			// Keep acknowledging the last snapshot we have, the host will fall back to it
+			DEBUGLOG("World data %u references unknown baseline %u, dropping\n", sequence, baselineSequence);
+			return;
+		}
+	}
+
+	WorldSnapshot& snapshot = m_receivedSnapshots.Add(sequence, time);
 	for (size_t i = 0; i < c_asteroids; ++i)
 	{
-		dataReader.ReadStruct(m_asteroids[i]->Position);
-		dataReader.ReadStruct(m_asteroids[i]->Velocity);
+		snapshot.Asteroids.push_back(baseline ? baseline->Predict(i, time) : AsteroidSnapshot{});
+	}
+
+	// Read the asteroids that changed
+	uint32_t changedCount = dataReader.ReadBits(c_countBits);
+	for (uint32_t n = 0; n < changedCount; ++n)
+	{
+		size_t i = dataReader.ReadBits(c_indexBits);
+		uint32_t changedFields = dataReader.ReadBits(c_worldDataFieldBits);
+		if (i >= c_asteroids)
+		{
+			// Forget the half-built snapshot so nothing is ever predicted from it
+			snapshot.Sequence = 0;
+			DEBUGLOG("Ill-formed world data %u: asteroid index %zu out of range\n", sequence, i);
+			return;
+		}
+		if (changedFields & c_worldDataPositionField)
+		{
+			snapshot.Asteroids[i].Position = dataReader.ReadPosition(m_worldDimensions, c_worldDataPositionBits);
+		}
+		if (changedFields & c_worldDataVelocityField)
+		{
+			snapshot.Asteroids[i].Velocity.x = dataReader.ReadSignedQuantized(c_worldDataVelocityRange, c_worldDataVelocityBits);
+			snapshot.Asteroids[i].Velocity.y = dataReader.ReadSignedQuantized(c_worldDataVelocityRange, c_worldDataVelocityBits);
+		}
+	}
+
+	// The host's asteroids are the authority; everyone else shows them a little behind,
+	// between the snapshots either side
+	if (Managers::Get<OnlineManager>()->IsHost())
+	{
+		for (size_t i = 0; i < c_asteroids; ++i)
+		{
+			m_asteroids[i]->Position = snapshot.Asteroids[i].Position;
+			m_asteroids[i]->Velocity = snapshot.Asteroids[i].Velocity;
+		}
+	}
+	else
+	{
+		m_hostClock.Observe(time);
+		for (size_t i = 0; i < c_asteroids; ++i)
+		{
+			m_asteroidSnapshots[i].Add(MotionSnapshot{ sequence, time, snapshot.Asteroids[i].Position, snapshot.Asteroids[i].Velocity, 0.0f });
+		}
+	}
+
+	m_lastWorldDataReceived = sequence;
+	Managers::Get<OnlineManager>()->SendGameMessage(GameMessageView(
+		GameMessageType::WorldDataAck,
+		DataBufferView(reinterpret_cast<const uint8_t*>(&sequence), sizeof(sequence))
+	));
+}
+
+void World::AcknowledgeWorldData(PlayerState& playerState, uint32_t sequence)
+{
+	if (sequence > playerState.LastAckedWorldData && sequence <= m_worldDataSequence)
+	{
+		playerState.LastAckedWorldData = sequence;
+	}
+}
+
+// The newest snapshot every remote player in the game is known to hold, or nullptr to send absolute
+// state. The one broadcast has to suit them all, so a lagging player holds everyone to its baseline.
+const WorldSnapshot* World::FindWorldDataBaseline() const
+{
+	uint32_t baselineSequence = UINT32_MAX;
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState && playerState->InGame && !playerState->IsLocalPlayer)
+		{
+			baselineSequence = std::min(baselineSequence, playerState->LastAckedWorldData);
+		}
+	}
+
+	// The slot for the next sequence must not be the baseline's
+	if (baselineSequence == UINT32_MAX || m_worldDataSequence + 1 - baselineSequence >= WorldSnapshotHistory::c_capacity)
+	{
+		return nullptr;
+	}
+
+	return m_sentSnapshots.Find(baselineSequence);
+}
+
+void World::SendWorldData()
+{
+	m_worldDataWriter.Reset();
+	SerializeWorldData(m_worldDataWriter);
+	size_t packetSize = m_worldDataWriter.TotalBytes() + MsgTypeSize;
+
+	Managers::Get<OnlineManager>()->SendGameMessage(
+		GameMessageView(
+			GameMessageType::ServerUpdateWorldData,
+			m_worldDataWriter.View()
+		)
+	);
+
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState && playerState->InGame && !playerState->IsLocalPlayer)
+		{
+			playerState->WorldDataBandwidth.AddBytes(packetSize);
+		}
+	}
+}
+
+// Layout: sequence, host time and ship count, then per active ship its owner's slot and the ship as Ship::Serialize writes it
+void World::SerializeShipData(BitBufferWriter& dataWriter)
+{
+	auto SendsShip = [](const PlayerState* playerState)
+	{
+		return playerState->InGame && playerState->Slot != NoPeerSlot && playerState->GetShip() && playerState->GetShip()->Active();
+	};
+
+	// Counted first so the ships are written straight from the roster
+	uint32_t shipCount = 0;
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (SendsShip(playerState))
+		{
+			shipCount++;
+		}
+	}
+
+	dataWriter.WriteVarUInt32(++m_shipDataSequence);
+	dataWriter.WriteSingle(m_worldDataTime);
+	dataWriter.WriteVarUInt32(shipCount);
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (SendsShip(playerState))
+		{
+			dataWriter.WriteBits(playerState->Slot, c_peerSlotBits);
+			playerState->GetShip()->Serialize(dataWriter, m_worldDimensions);
+		}
+	}
+}
+
+void World::DeserializeShipData(DataBufferView data)
+{
+	// The host's ships are the authority, it has nothing to apply
+	if (Managers::Get<OnlineManager>()->IsHost())
+	{
+		return;
+	}
+
+	BitBufferReader dataReader(data);
+
+	uint32_t sequence = dataReader.ReadVarUInt32();
+	float time = dataReader.ReadSingle();
+
+	// Ignore anything older than what has already been applied, unless it starts a new game
+	if (sequence <= m_lastShipDataReceived && !IsSnapshotSequenceRestart(sequence, m_lastShipDataReceived))
+	{
+		return;
+	}
+	m_lastShipDataReceived = sequence;
+	m_hostClock.Observe(time);
+
+	uint32_t count = dataReader.ReadVarUInt32();
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint8_t slot = static_cast<uint8_t>(dataReader.ReadBits(c_peerSlotBits));
+
+		std::shared_ptr<PlayerState> playerState = g_game->GetPlayerStateBySlot(slot);
+		if (playerState == nullptr || playerState->GetShip() == nullptr)
+		{
+			// Entries have no length, the rest of the packet can't be found
+			DEBUGLOG("Ship data for unknown slot %u\n", slot);
+			return;
+		}
+
+		playerState->GetShip()->Deserialize(dataReader, m_worldDimensions, sequence, time);
+	}
+}
+
+void World::SendShipData()
+{
+	m_shipDataWriter.Reset();
+	SerializeShipData(m_shipDataWriter);
+
+	Managers::Get<OnlineManager>()->SendGameMessage(
+		GameMessageView(
+			GameMessageType::ShipData,
+			m_shipDataWriter.View()
+		)
+	);
+}
+
+// Show every remote ship and asteroid where the host had it the interpolation delay ago
+void World::ApplySnapshots()
+{
+	if (!m_hostClock.IsValid())
+	{
+		return;
+	}
+
+	float time = m_hostClock.GetTime() - m_interpolationDelay;
+
+	for (size_t i = 0; i < m_asteroids.size() && i < m_asteroidSnapshots.size(); ++i)
+	{
+		MotionSnapshot motion;
+		if (m_asteroidSnapshots[i].Sample(time, c_maximumExtrapolation, motion))
+		{
+			m_asteroids[i]->Position = motion.Position;
+			m_asteroids[i]->Velocity = motion.Velocity;
+		}
+	}
+
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState == nullptr)
+		{
+			continue;
+		}
+
+		const auto& ship = playerState->GetShip();
+		if (ship && !ship->IsLocal && ship->Active())
+		{
+			ship->Interpolate(time, c_maximumExtrapolation);
+		}
+	}
+}
+
+void World::UpdateWorldDataBandwidth(float elapsedTime)
+{
+	m_worldDataReceived.Update(elapsedTime);
+
+	bool logBandwidth = false;
+	m_worldDataLogTimer += elapsedTime;
+	if (m_worldDataLogTimer >= 1.0f)
+	{
+		m_worldDataLogTimer = 0.0f;
+		logBandwidth = true;
+	}
+
+	for (PlayerState* playerState : g_game->GetPlayers())
+	{
+		if (playerState && !playerState->IsLocalPlayer)
+		{
+			playerState->WorldDataBandwidth.Update(elapsedTime);
+			if (logBandwidth && playerState->InGame && Managers::Get<OnlineManager>()->IsHost())
+			{
+				DEBUGLOG("World data to %s: %.0f bytes/sec, acked snapshot %u of %u\n", playerState->DisplayName.c_str(), playerState->WorldDataBandwidth.BytesPerSecond(), playerState->LastAckedWorldData, m_worldDataSequence);
+			}
+		}
 	}
 }
 
 // Prepare the member ships and world data for the ServerWorldSetup packet
-std::vector<uint8_t> World::SerializeWorldSetup(std::map<std::string, std::shared_ptr<Ship>>& ships) const
+std::vector<uint8_t> World::SerializeWorldSetup(const std::vector<std::shared_ptr<PlayerState>>& members) const
 {
 	DataBufferWriter dataWriter;
 
-	dataWriter.WriteUInt32(static_cast<uint32_t>(ships.size()));
+	dataWriter.WriteByte(static_cast<uint8_t>(members.size()));
 	// Write active ship data
-	for (auto& activeShipPair : ships)
+	for (const auto& member : members)
 	{
-		std::string entityId = activeShipPair.first;
-		std::shared_ptr<Ship> ship = activeShipPair.second;
+		const auto& ship = member->GetShip();
 
-		dataWriter.WriteString(entityId);
+		dataWriter.WriteByte(member->Slot);
 		dataWriter.WriteStruct(ship->Position);
 
 		WeaponType currentWeaponType = WeaponType::Unknown;
@@ -264,7 +638,7 @@ std::vector<uint8_t> World::SerializeWorldSetup(std::map<std::string, std::share
 		}
 		dataWriter.WriteByte(static_cast<uint8_t>(currentWeaponType));
 
-		DEBUGLOG("SerializeWorldSetup() sending entityId %s at (%f, %f) with weapon %u\n", entityId.c_str(), ship->Position.x, ship->Position.y, currentWeaponType);
+		DEBUGLOG("SerializeWorldSetup() sending slot %u at (%f, %f) with weapon %u\n", member->Slot, ship->Position.x, ship->Position.y, currentWeaponType);
 	}
 	// Write the asteroid data
 	for (size_t i = 0; i < c_asteroids; ++i)
@@ -292,7 +666,7 @@ std::vector<uint8_t> World::SerializeWorldSetup(std::map<std::string, std::share
 	return dataWriter.GetBuffer();
 }
 
-void World::DeserializeWorldSetup(const std::vector<uint8_t>& data)
+void World::DeserializeWorldSetup(DataBufferView data)
 {
 	DataBufferReader dataReader(data);
 
@@ -300,22 +674,22 @@ void World::DeserializeWorldSetup(const std::vector<uint8_t>& data)
 	ResetDefaults();
 
 	// Read the members' ship data
-	uint32_t memberSize = dataReader.ReadUInt32();
-	for (uint32_t i = 0; i < memberSize; ++i)
+	uint8_t memberSize = dataReader.ReadByte();
+	for (uint8_t i = 0; i < memberSize; ++i)
 	{
-		std::string entityId = dataReader.ReadString();
+		uint8_t slot = dataReader.ReadByte();
 
 		SimpleMath::Vector2 position;
 		dataReader.ReadStruct(position);
 
 		WeaponType currentWeaponType = static_cast<WeaponType>(dataReader.ReadByte());
 
-		DEBUGLOG("DeserializeWorldSetup() received entityId %s at (%f, %f) with weapon %u\n", entityId.c_str(), position.x, position.y, currentWeaponType);
+		DEBUGLOG("DeserializeWorldSetup() received slot %u at (%f, %f) with weapon %u\n", slot, position.x, position.y, currentWeaponType);
 
-		std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(entityId);
+		std::shared_ptr<PlayerState> playerState = g_game->GetPlayerStateBySlot(slot);
 		if (playerState != nullptr)
 		{
-			std::shared_ptr<Ship> ship = playerState->GetShip();
+			const std::shared_ptr<Ship>& ship = playerState->GetShip();
 
 			ship->Initialize(playerState->IsLocalPlayer);
 			ship->Position = position;
@@ -364,7 +738,7 @@ void World::DeserializeWorldSetup(const std::vector<uint8_t>& data)
 	// Read the game mode and winning score
 	WinningScore = dataReader.ReadInt32();
 
-	std::shared_ptr<PlayerState> localPlayerState = g_game->GetLocalPlayerState();
+	PlayerState* localPlayerState = g_game->GetLocalPlayer();
 	if (localPlayerState && localPlayerState->GetShip())
 	{
 		m_starfield->Reset(localPlayerState->GetShip()->Position);
@@ -380,25 +754,25 @@ std::vector<uint8_t> World::SerializeShipDeath(std::shared_ptr<Ship> localShip)
 		DataBufferWriter dataWriter;
 
 		GameplayObject* lastDamagedBy = localShip->LastDamagedBy;
-		std::string killer = "";
+		uint8_t killer = NoPeerSlot;
 		if (lastDamagedBy != nullptr &&
 			lastDamagedBy->GetType() == GameplayObjectType::Ship &&
 			lastDamagedBy != localShip.get())
 		{
-			for (const auto& playerState : g_game->GetAllPlayerStates())
+			for (PlayerState* playerState : g_game->GetPlayers())
 			{
 				if (playerState && playerState->InGame)
 				{
-					std::shared_ptr<Ship> ship = playerState->GetShip();
+					const std::shared_ptr<Ship>& ship = playerState->GetShip();
 					if (ship && ship.get() == lastDamagedBy)
 					{
-						killer = playerState->EntityId;
+						killer = playerState->Slot;
 						break;
 					}
 				}
 			}
 		}
-		dataWriter.WriteString(killer);
+		dataWriter.WriteByte(killer);
 
 		return dataWriter.GetBuffer();
 	}
@@ -406,16 +780,15 @@ std::vector<uint8_t> World::SerializeShipDeath(std::shared_ptr<Ship> localShip)
 	return std::vector<unsigned char>();
 }
 
-void World::DeserializeShipDeath(std::string entityId, const std::vector<uint8_t>& data)
+void World::DeserializeShipDeath(const std::shared_ptr<PlayerState>& playerState, DataBufferView data)
 {
-	DEBUGLOG("DeserializeShipDeath() received for entityId %s\n", entityId.c_str());
-
-	std::shared_ptr<PlayerState> playerState = g_game->GetPlayerState(entityId);
 	if (playerState == nullptr)
 	{
 		return;
 	}
 
+	DEBUGLOG("DeserializeShipDeath() received for slot %u\n", playerState->Slot);
+
 	std::shared_ptr<Ship> shipKilled = playerState->GetShip();
 	if (shipKilled == nullptr)
 	{
@@ -425,10 +798,10 @@ void World::DeserializeShipDeath(std::string entityId, const std::vector<uint8_t
 	DataBufferReader dataReader(data);
 
 	std::shared_ptr<Ship> killerShip = nullptr;
-	std::string killerid = dataReader.ReadString();
-	if (!killerid.empty())
+	uint8_t killerSlot = dataReader.ReadByte();
+	if (killerSlot != NoPeerSlot)
 	{
-		std::shared_ptr<PlayerState> killerState = g_game->GetPlayerState(killerid);
+		std::shared_ptr<PlayerState> killerState = g_game->GetPlayerStateBySlot(killerSlot);
 		if (killerState)
 		{
 			killerShip = killerState->GetShip();
@@ -448,7 +821,7 @@ std::vector<unsigned char> World::SerializeGameOver() const
 	return dataWriter.GetBuffer();
 }
 
-void World::DeserializeGameOver(const std::vector<uint8_t>& data)
+void World::DeserializeGameOver(DataBufferView data)
 {
 	DataBufferReader dataReader(data);
 
@@ -463,13 +836,18 @@ void World::Update(float totalTime, float elapsedTime)
 {
 	UNREFERENCED_PARAMETER(totalTime);
 
+	for (const std::shared_ptr<GameplayObject>& object : Managers::Get<CollisionManager>()->Collection())
+	{
+		object->RecordStepStart();
+	}
+
 	if (!IsGameWon)
 	{
 		int highScore = MININT;
 		std::string highScoreName = "";
 		DirectX::XMVECTORF32 highScoreColor = Colors::White;
 
-		std::vector<std::shared_ptr<PlayerState>> playerStates = g_game->GetAllPlayerStates();
+		PlayerRoster::View playerStates = g_game->GetPlayers();
 
 		if (playerStates.size() < 0)
 		{
@@ -479,11 +857,11 @@ void World::Update(float totalTime, float elapsedTime)
 		}
 		else
 		{
-			for (const auto& playerState : playerStates)
+			for (PlayerState* playerState : playerStates)
 			{
 				if (playerState && playerState->InGame)
 				{
-					std::shared_ptr<Ship> ship = playerState->GetShip();
+					const std::shared_ptr<Ship>& ship = playerState->GetShip();
 					if (!ship)
 					{
 						continue;
@@ -501,9 +879,9 @@ void World::Update(float totalTime, float elapsedTime)
 					if (!ship->Active() && ship->RespawnTimer <= 0.0f)
 					{
 						// Send ship spawn message and immediately process locally
-						if (playerState->EntityId == Managers::Get<OnlineManager>()->GetLocalEntityId())
+						if (playerState->IsLocalPlayer)
 						{
-							std::vector<uint8_t> messageData = SerializeShipSpawn(playerState->EntityId);
+							std::vector<uint8_t> messageData = SerializeShipSpawn(*playerState);
 							Managers::Get<OnlineManager>()->SendGameMessage(
 								GameMessage(
 									GameMessageType::ShipSpawn,
@@ -537,15 +915,20 @@ void World::Update(float totalTime, float elapsedTime)
 		}
 	}
 	// Update all player ships based on last input
-	for (const auto& playerState : g_game->GetAllPlayerStates())
+	for (PlayerState* playerState : g_game->GetPlayers())
 	{
 		if (playerState && playerState->InGame)
 		{
-			std::shared_ptr<Ship> ship = playerState->GetShip();
+			const std::shared_ptr<Ship>& ship = playerState->GetShip();
 			if (ship)
 			{
 				if (ship->Active())
 				{
+					// The local ship steps on the input held for it, one move per step
+					if (playerState->IsLocalPlayer && !IsGameWon)
+					{
+						ship->RecordMove(elapsedTime);
+					}
 					ship->Update(elapsedTime);
 
 					// Check for ship death
@@ -561,7 +944,7 @@ void World::Update(float totalTime, float elapsedTime)
 							)
 						);
 						Managers::Get<OnlineManager>()->SetDeathCount();
-						DeserializeShipDeath(playerState->EntityId, messageData);
+						DeserializeShipDeath(playerState, messageData);
 					}
 				}
 				else if (ship->RespawnTimer > 0.0f)
@@ -596,27 +979,80 @@ void World::Update(float totalTime, float elapsedTime)
 	}
 
 	// Update collision manager to apply all physics
-	Managers::Get<CollisionManager>()->Update(elapsedTime);
+	{
+		FrameScheduler::Section section = g_game->GetScheduler().Measure("Collision");
+		Managers::Get<CollisionManager>()->Update(elapsedTime);
+	}
+
+	// Physics has moved the remote objects on from their snapshots, put them back on the host's track
+	if (!Managers::Get<OnlineManager>()->IsHost())
+	{
+		m_hostClock.Update(elapsedTime);
+		ApplySnapshots();
+	}
+
+	// Remember where this step left the local ship, to compare with the host's view of it later
+	PlayerState* localPlayerState = g_game->GetLocalPlayer();
+	if (localPlayerState)
+	{
+		const std::shared_ptr<Ship>& localShip = localPlayerState->GetShip();
+		if (localShip && localShip->Active())
+		{
+			localShip->RecordPredictedMotion();
+
+			// Send the moves made since the last ShipInput packet, along with the ones before
+			// them in case that packet was lost. The host answers with its own view of the ship.
+			if (!IsGameWon && ++m_updatesSinceShipInputSent >= c_updatesBetweenShipInputPackets)
+			{
+				m_updatesSinceShipInputSent = 0;
+				m_shipInputWriter.Reset();
+				localShip->SerializeMoves(m_shipInputWriter);
+				Managers::Get<OnlineManager>()->SendGameMessage(
+					GameMessageView(
+						GameMessageType::ShipInput,
+						m_shipInputWriter.View()
+					)
+				);
+			}
+		}
+	}
 
-	// Update the particle-effect manager
-	Managers::Get<ParticleEffectManager>()->Update(elapsedTime);
+	// Particle effects are advanced once per frame by the game's frame scheduler
 
 	if (Managers::Get<OnlineManager>()->IsHost())
 	{
-		Managers::Get<OnlineManager>()->SendGameMessage(
-			GameMessage(
-				GameMessageType::ServerUpdateWorldData,
-				SerializeWorldData()
-			)
-		);
+		m_worldDataTime += elapsedTime;
+
+		if (++m_updatesSinceShipDataSent >= c_updatesBetweenShipDataPackets)
+		{
+			SendShipData();
+			m_updatesSinceShipDataSent = 0;
+		}
+
+		// Send everyone an update on the latest state of the world
+		if (++m_updatesSinceWorldDataSent >= m_updatesBetweenWorldDataPackets)
+		{
+			SendWorldData();
+			m_updatesSinceWorldDataSent = 0;
+		}
 	}
+
+	UpdateWorldDataBandwidth(elapsedTime);
 }
 
 void World::Draw(float elapsedTime) const
 {
 	float viewportWidth = static_cast<float>(g_game->GetWindowWidth());
 	float viewportHeight = static_cast<float>(g_game->GetWindowHeight());
-	std::shared_ptr<Ship> localShip = g_game->GetLocalPlayerState()->GetShip();
+	const std::shared_ptr<Ship>& localShip = g_game->GetLocalPlayer()->GetShip();
+
+	// Everything, the camera's ship included, is drawn part way through the step; the
+	// simulated poses go back once the sprites are queued
+	BatchRemovalCollection<std::shared_ptr<GameplayObject>>& collection = Managers::Get<CollisionManager>()->Collection();
+	for (const std::shared_ptr<GameplayObject>& object : collection)
+	{
+		object->BeginStepBlend(m_drawBlend);
+	}
 
 	XMFLOAT2 center = XMFLOAT2(localShip->Position.x - viewportWidth / 2.0f, localShip->Position.y - viewportHeight / 2.0f);
 
@@ -660,11 +1096,11 @@ void World::Draw(float elapsedTime) const
 		}
 
 		// Draw each ship
-		for (const auto& playerState : g_game->GetAllPlayerStates())
+		for (PlayerState* playerState : g_game->GetPlayers())
 		{
 			if (playerState && playerState->InGame)
 			{
-				std::shared_ptr<Ship> ship = playerState->GetShip();
+				const std::shared_ptr<Ship>& ship = playerState->GetShip();
 				if (ship && ship->Active())
 				{
 					ship->Draw(elapsedTime, renderContext.get(), false);
@@ -686,6 +1122,11 @@ void World::Draw(float elapsedTime) const
 
 		renderContext->End();
 	}
+
+	for (const std::shared_ptr<GameplayObject>& object : collection)
+	{
+		object->EndStepBlend();
+	}
 }
 
 void World::SpawnPowerUp(PowerUpType type, const DirectX::SimpleMath::Vector2& position)
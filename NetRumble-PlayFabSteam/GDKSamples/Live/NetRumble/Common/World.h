@@ -7,9 +7,14 @@
 #pragma once
 
 #include "pch.h"
+#include "WorldSnapshot.h"
+#include "SnapshotBuffer.h"
+#include "BitBuffer.h"
 
 namespace NetRumble
 {
+	class PlayerState;
+
 	struct ShipSerialization
 	{
 		float xPos;
@@ -45,50 +50,76 @@ namespace NetRumble
 		// Generate the world, placing asteroids and all ships
 		void GenerateWorld();
 
-		// Prepare the member ships and world data for the ServerWorldSetup packet
-		std::vector<uint8_t> SerializeWorldSetup(std::map<std::string, std::shared_ptr<Ship>>& ships) const;
+		// Prepare the members' ships, by slot, and world data for the ServerWorldSetup packet
+		std::vector<uint8_t> SerializeWorldSetup(const std::vector<std::shared_ptr<PlayerState>>& members) const;
 
 		// Initialize the member ships and world with the data from the ServerWorldSetup packet
-		void DeserializeWorldSetup(const std::vector<uint8_t>& data);
+		void DeserializeWorldSetup(DataBufferView data);
+
+		// Prepare the world data for the ServerUpdateWorldData packet, delta-encoded against the snapshot every peer has acknowledged
+		void SerializeWorldData(BitBufferWriter& dataWriter);
+
+		// Update the world with the data from the ServerUpdateWorldData packet and acknowledge it
+		void DeserializeWorldData(DataBufferView data);
+
+		// Record that a peer has applied the given ServerUpdateWorldData snapshot
+		void AcknowledgeWorldData(PlayerState& playerState, uint32_t sequence);
+
+		// Prepare the host's view of every active ship, with the last move it applied from each owner, for the ShipData packet
+		void SerializeShipData(BitBufferWriter& dataWriter);
+
+		// Update the ships with the data from the host's ShipData packet; the local ship reconciles its prediction
+		void DeserializeShipData(DataBufferView data);
+
+		// Number of simulation updates between ServerUpdateWorldData packets
+		inline int GetWorldDataSendInterval() const { return m_updatesBetweenWorldDataPackets; }
+		inline void SetWorldDataSendInterval(int updates) { m_updatesBetweenWorldDataPackets = std::max(1, updates); }
 
-		// Prepare the world data for the ServerUpdateWorldData packet
-		std::vector<uint8_t> SerializeWorldData() const;
+		// Seconds behind the host's clock that remote ships and asteroids are shown
+		inline float GetInterpolationDelay() const { return m_interpolationDelay; }
+		inline void SetInterpolationDelay(float seconds) { m_interpolationDelay = std::max(0.0f, seconds); }
 
-		// Update the world with the data from the ServerUpdateWorldData packet
-		void DeserializeWorldData(const std::vector<uint8_t>& data);
+		// Bytes per second of ServerUpdateWorldData received by this client
+		inline float GetWorldDataBytesPerSecondReceived() const { return m_worldDataReceived.BytesPerSecond(); }
 
 		// Serialize powerUp spawn packet
 		std::vector<uint8_t> SerializePowerUpSpawn() const;
 
 		// Handle powerUp spawn packet
-		void DeserializePowerUpSpawn(const std::vector<uint8_t>& data);
+		void DeserializePowerUpSpawn(DataBufferView data);
 
 		// Serialize a suitable ship spawn point for the indicated player
-		std::vector<uint8_t> SerializeShipSpawn(std::string entityId) const;
+		std::vector<uint8_t> SerializeShipSpawn(const PlayerState& playerState) const;
 
 		// Spawn ship for indicated player
-		void DeserializeShipSpawn(const std::vector<uint8_t>& data);
+		void DeserializeShipSpawn(DataBufferView data);
 
 		// Prepare local ship death packet
 		std::vector<uint8_t> SerializeShipDeath(std::shared_ptr<Ship> localShip) const;
 
-		// Handle ship death packet
-		void DeserializeShipDeath(std::string entityId, const std::vector<uint8_t>& data);
+		// Handle ship death packet from the player whose ship died
+		void DeserializeShipDeath(const std::shared_ptr<PlayerState>& playerState, DataBufferView data);
 
 		// Serialize game over packet
 		std::vector<uint8_t> SerializeGameOver() const;
 
 		// Handle game over packet
-		void DeserializeGameOver(const std::vector<uint8_t>& data);
+		void DeserializeGameOver(DataBufferView data);
 
 		inline bool IsGameInProgress() const { return m_isGameInProgress; }
 		inline bool IsInitialized() const { return m_isInitialized; }
+		inline const RECT& GetDimensions() const { return m_worldDimensions; }
 		inline void SetGameInProgress(bool isGameInProgress) { m_isGameInProgress = isGameInProgress; }
 		inline void SetInitialized(bool isInitialized) { m_isInitialized = isInitialized; }
 
 		void Update(float totalTime, float elapsedTime);
 		void Draw(float elapsedTime) const;
 
+		// How far the frame being drawn is between the last update and the next, from the
+		// game's SimulationClock; objects are drawn that far from where the last update began
+		inline float GetDrawBlend() const { return m_drawBlend; }
+		inline void SetDrawBlend(float blend) { m_drawBlend = std::min(std::max(blend, 0.0f), 1.0f); }
+
 		bool IsGameWon;
 		std::string WinnerName;
 		DirectX::XMVECTORF32 WinningColor;
@@ -102,15 +133,65 @@ namespace NetRumble
 		// The length of time it takes for another power-up to spawn.
 		static constexpr float c_maximumPowerUpTimer = 10.0f;
 
-		static constexpr int c_updatesBetweenWorldDataPackets = 5;
+		// Receivers interpolate between snapshots and asteroids fly straight, so a few a second is plenty
+		static constexpr int c_updatesBetweenWorldDataPackets = 10;
+
+		// Owners predict their own ships, so the host's view of them is only needed to correct drift
+		static constexpr int c_updatesBetweenShipDataPackets = 6;
+
+		// Each step's move is sent, but a few steps' worth to a ShipInput packet
+		static constexpr int c_updatesBetweenShipInputPackets = 3;
+
+		// Remote objects are shown this far behind the host: a ship data interval, and half
+		// again to ride out a late packet
+		static constexpr float c_defaultInterpolationDelay = 0.15f;
+
+		// A remote object whose snapshots stop coming is dead-reckoned at most this far
+		static constexpr float c_maximumExtrapolation = 0.25f;
 
 	private:
 		void SpawnPowerUp(PowerUpType type, const DirectX::SimpleMath::Vector2& position);
+		const WorldSnapshot* FindWorldDataBaseline() const;
+		void SendWorldData();
+		void SendShipData();
+		void ApplySnapshots();
+		void UpdateWorldDataBandwidth(float elapsedTime);
+
+		// Snapshot drift below these is left to the receivers' dead reckoning
+		static constexpr float c_snapshotPositionTolerance = 0.5f;
+		static constexpr float c_snapshotVelocityTolerance = 0.01f;
 
 		bool m_isGameInProgress;
 		bool m_isInitialized;
+		float m_drawBlend = 1.0f;
 		float m_powerUpTimer;
 		int m_updatesSinceWorldDataSent;
+		int m_updatesBetweenWorldDataPackets = c_updatesBetweenWorldDataPackets;
+
+		// World snapshot replication
+		uint32_t m_worldDataSequence;
+		uint32_t m_lastWorldDataReceived;
+		float m_worldDataTime;
+		float m_worldDataLogTimer;
+		WorldSnapshotHistory m_sentSnapshots;
+		WorldSnapshotHistory m_receivedSnapshots;
+		BandwidthMeter m_worldDataReceived;
+		BitBufferWriter m_worldDataWriter;
+
+		// Ship state replication
+		int m_updatesSinceShipDataSent;
+		uint32_t m_shipDataSequence;
+		uint32_t m_lastShipDataReceived;
+		BitBufferWriter m_shipDataWriter;
+
+		// Local ship moves
+		int m_updatesSinceShipInputSent;
+		BitBufferWriter m_shipInputWriter;
+
+		// Interpolation of remote objects
+		HostClock m_hostClock;
+		float m_interpolationDelay = c_defaultInterpolationDelay;
+		std::array<SnapshotBuffer, c_asteroids> m_asteroidSnapshots;
 
 		// World contents
 		RECT m_worldDimensions;
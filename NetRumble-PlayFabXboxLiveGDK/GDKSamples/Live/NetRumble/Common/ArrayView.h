@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 // Adapter while we wait for C++20 std::span
 namespace NetRunbleTools
 {
@@ -7,8 +9,14 @@ namespace NetRunbleTools
 	class ArrayView
 	{
 	public:
+		ArrayView() : m_data(nullptr), m_size(0) { }
 		ArrayView(T* data, size_t size) : m_data(data), m_size(size) { }
 
+		template<typename U>
+		ArrayView(std::vector<U>& container) : m_data(container.data()), m_size(container.size()) { }
+		template<typename U>
+		ArrayView(const std::vector<U>& container) : m_data(container.data()), m_size(container.size()) { }
+
 		T* begin() { return m_data; }
 		T* end() { return m_data + m_size; }
 
@@ -18,7 +26,9 @@ namespace NetRunbleTools
 		T& operator[](size_t index) { return m_data[index]; }
 		const T& operator[](size_t index) const { return m_data[index]; }
 
+		T* data() const { return m_data; }
 		size_t size() const { return m_size; }
+		bool empty() const { return m_size == 0; }
 	private:
 		T* m_data;
 		size_t m_size;
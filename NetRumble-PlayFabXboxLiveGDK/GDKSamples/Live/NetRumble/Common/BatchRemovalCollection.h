@@ -6,6 +6,12 @@
 
 #pragma once
 
+// Active objects are kept densely packed for iteration. Each one also owns a slot that
+// maps its handle to its current index, so a queued removal goes straight to the item
+// and swaps the last element into the gap instead of searching and shifting the vector.
+// Removal therefore does not preserve iteration order, and removing while a loop walks
+// the collection can move an element it has yet to reach behind it. Loops queue their
+// removals and apply them once the walk is done.
 template<class T>
 class BatchRemovalCollection
 {
@@ -18,34 +24,84 @@ public:
 	using const_iterator = typename container::const_iterator;
 	using size_type = typename container::size_type;
 
-	inline void QueuePendingRemoval(const value_type& item)
+	// Names one item for as long as it stays in the collection. Removing the item retires
+	// the handle, so a stale or repeated removal is ignored rather than hitting whatever
+	// reuses the slot.
+	struct handle
+	{
+		uint32_t index = UINT32_MAX;
+		uint32_t generation = 0;
+	};
+
+	inline void QueuePendingRemoval(handle item)
 	{
 		pendingRemovals.push_back(item);
 	}
 
 	void ApplyPendingRemovals()
 	{
-		activeObjects.insert(activeObjects.end(), pendingAdds.begin(), pendingAdds.end());
+		if (!pendingAdds.empty() || !pendingRemovals.empty())
+		{
+			generation++;
+		}
+
+		for (size_t i = 0; i < pendingAdds.size(); i++)
+		{
+			slots[pendingAddSlots[i]].dense = static_cast<uint32_t>(activeObjects.size());
+			activeObjects.push_back(std::move(pendingAdds[i]));
+			activeSlots.push_back(pendingAddSlots[i]);
+		}
 		pendingAdds.clear();
+		pendingAddSlots.clear();
 
-		for (size_t i = 0; i < pendingRemovals.size(); i++)
+		for (const handle& item : pendingRemovals)
 		{
-			auto itr = std::find(std::begin(activeObjects), std::end(activeObjects), pendingRemovals[i]);
-			activeObjects.erase(itr);
+			if (contains(item))
+			{
+				RemoveAt(slots[item.index].dense);
+			}
 		}
 		pendingRemovals.clear();
 	}
 
 	inline void clear()
 	{
+		for (uint32_t slot : pendingAddSlots)
+		{
+			ReleaseSlot(slot);
+		}
+		for (uint32_t slot : activeSlots)
+		{
+			ReleaseSlot(slot);
+		}
+
 		pendingAdds.clear();
+		pendingAddSlots.clear();
 		pendingRemovals.clear();
 		activeObjects.clear();
+		activeSlots.clear();
+		generation++;
 	}
 
-	inline void push_back(const value_type& item)
+	// The item becomes active at the next ApplyPendingRemovals; its handle is valid at once
+	inline handle push_back(const value_type& item)
 	{
+		uint32_t slot = AllocateSlot();
 		pendingAdds.push_back(item);
+		pendingAddSlots.push_back(slot);
+		return handle{ slot, slots[slot].generation };
+	}
+
+	// True while the item is active or waiting to be added
+	inline bool contains(handle item) const
+	{
+		return item.index < slots.size() && slots[item.index].generation == item.generation;
+	}
+
+	inline handle handle_at(size_type index) const
+	{
+		uint32_t slot = activeSlots[index];
+		return handle{ slot, slots[slot].generation };
 	}
 
 	inline iterator begin()
@@ -88,13 +144,75 @@ public:
 		return activeObjects[index];
 	}
 
-	inline const_iterator erase(const_iterator itr)
+	// The last element moves into the erased position, which the returned iterator points at.
+	// A loop that erases must not advance past it, or that element is skipped; one that walks
+	// the collection while something else may erase should queue the removal instead.
+	inline iterator erase(const_iterator itr)
+	{
+		size_type index = static_cast<size_type>(itr - activeObjects.cbegin());
+		generation++;
+		RemoveAt(index);
+		return activeObjects.begin() + index;
+	}
+
+	// Bumped whenever the set of active objects changes, so that anything
+	// holding indices into the collection knows when they have gone stale.
+	inline size_t current_generation() const
 	{
-		return activeObjects.erase(itr);
+		return generation;
 	}
 
 private:
+	struct Slot
+	{
+		uint32_t dense = 0;
+		uint32_t generation = 0;
+	};
+
+	uint32_t AllocateSlot()
+	{
+		if (!freeSlots.empty())
+		{
+			uint32_t slot = freeSlots.back();
+			freeSlots.pop_back();
+			return slot;
+		}
+
+		slots.push_back(Slot{});
+		return static_cast<uint32_t>(slots.size() - 1);
+	}
+
+	inline void ReleaseSlot(uint32_t slot)
+	{
+		slots[slot].generation++;
+		freeSlots.push_back(slot);
+	}
+
+	void RemoveAt(size_type index)
+	{
+		uint32_t slot = activeSlots[index];
+		size_type last = activeObjects.size() - 1;
+
+		if (index != last)
+		{
+			activeObjects[index] = std::move(activeObjects[last]);
+			activeSlots[index] = activeSlots[last];
+			slots[activeSlots[index]].dense = static_cast<uint32_t>(index);
+		}
+
+		activeObjects.pop_back();
+		activeSlots.pop_back();
+		ReleaseSlot(slot);
+	}
+
 	container pendingAdds;
-	container pendingRemovals;
+	std::vector<uint32_t> pendingAddSlots;
+	std::vector<handle> pendingRemovals;
+
 	container activeObjects;
-};
\ No newline at end of file
+	std::vector<uint32_t> activeSlots;
+
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+	size_t generation = 0;
+};
@@ -0,0 +1,263 @@
+//--------------------------------------------------------------------------------------
+// BitBuffer.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "BitBuffer.h"
+
+using namespace NetRumble;
+using namespace DirectX;
+
+namespace
+{
+	uint32_t MaxCode(uint32_t bitCount)
+	{
+		return bitCount >= 32 ? UINT32_MAX : (1u << bitCount) - 1;
+	}
+
+	uint32_t EncodeRange(float value, float minimum, float maximum, uint32_t bitCount)
+	{
+		double normalized = (std::clamp(value, minimum, maximum) - minimum) / static_cast<double>(maximum - minimum);
+		return static_cast<uint32_t>(normalized * MaxCode(bitCount) + 0.5);
+	}
+
+	float DecodeRange(uint32_t code, float minimum, float maximum, uint32_t bitCount)
+	{
+		return static_cast<float>(minimum + (maximum - minimum) * (static_cast<double>(code) / MaxCode(bitCount)));
+	}
+
+	// Signed values use 2 * (2^(bits - 1) - 1) + 1 codes centered on zero
+	uint32_t EncodeSigned(float value, float magnitude, uint32_t bitCount)
+	{
+		int32_t maxMagnitude = static_cast<int32_t>(MaxCode(bitCount - 1));
+		float normalized = std::clamp(value / magnitude, -1.0f, 1.0f);
+		return static_cast<uint32_t>(std::lround(normalized * static_cast<float>(maxMagnitude)) + maxMagnitude);
+	}
+
+	float DecodeSigned(uint32_t code, float magnitude, uint32_t bitCount)
+	{
+		int32_t maxMagnitude = static_cast<int32_t>(MaxCode(bitCount - 1));
+		return static_cast<float>(static_cast<int32_t>(code) - maxMagnitude) * magnitude / static_cast<float>(maxMagnitude);
+	}
+
+	uint32_t EncodeAngle(float radians, uint32_t bitCount)
+	{
+		double wrapped = std::fmod(static_cast<double>(radians), static_cast<double>(XM_2PI));
+		if (wrapped < 0.0)
+		{
+			wrapped += XM_2PI;
+		}
+		return static_cast<uint32_t>(wrapped / XM_2PI * (static_cast<double>(MaxCode(bitCount)) + 1.0) + 0.5) & MaxCode(bitCount);
+	}
+
+	float DecodeAngle(uint32_t code, uint32_t bitCount)
+	{
+		return static_cast<float>(code * (XM_2PI / (static_cast<double>(MaxCode(bitCount)) + 1.0)));
+	}
+}
+
+BitBufferReader::BitBufferReader(DataBufferView buffer) :
+	m_bitPos(0),
+	m_buffer(buffer)
+{
+}
+
+uint32_t BitBufferReader::ReadBits(uint32_t bitCount)
+{
+	if (bitCount > RemainingBits())
+	{
+		// Read past the end of the buffer
+		throw std::runtime_error("Attempted to read beyond the length of the buffer");
+	}
+
+	uint32_t value = 0;
+	uint32_t shift = 0;
+	while (bitCount > 0)
+	{
+		uint32_t bitOffset = static_cast<uint32_t>(m_bitPos % 8);
+		uint32_t count = std::min(8 - bitOffset, bitCount);
+		uint32_t bits = (static_cast<uint32_t>(m_buffer[m_bitPos / 8]) >> bitOffset) & ((1u << count) - 1);
+
+		value |= bits << shift;
+		shift += count;
+		bitCount -= count;
+		m_bitPos += count;
+	}
+
+	return value;
+}
+
+bool BitBufferReader::ReadBool()
+{
+	return ReadBits(1) != 0;
+}
+
+uint32_t BitBufferReader::ReadVarUInt32()
+{
+	uint32_t value = 0;
+	for (uint32_t shift = 0; shift < 35; shift += 7)
+	{
+		uint32_t group = ReadBits(8);
+		value |= (group & 0x7f) << shift;
+		if ((group & 0x80) == 0)
+		{
+			return value;
+		}
+	}
+
+	throw std::runtime_error("Ill-formed variable length integer");
+}
+
+float BitBufferReader::ReadSingle()
+{
+	uint32_t bits = ReadBits(32);
+
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+float BitBufferReader::ReadQuantized(float minimum, float maximum, uint32_t bitCount)
+{
+	return DecodeRange(ReadBits(bitCount), minimum, maximum, bitCount);
+}
+
+float BitBufferReader::ReadSignedQuantized(float magnitude, uint32_t bitCount)
+{
+	return DecodeSigned(ReadBits(bitCount), magnitude, bitCount);
+}
+
+float BitBufferReader::ReadAngle(uint32_t bitCount)
+{
+	return DecodeAngle(ReadBits(bitCount), bitCount);
+}
+
+SimpleMath::Vector2 BitBufferReader::ReadPosition(const RECT& bounds, uint32_t bitCount)
+{
+	float x = ReadQuantized(static_cast<float>(bounds.left), static_cast<float>(bounds.right), bitCount);
+	float y = ReadQuantized(static_cast<float>(bounds.top), static_cast<float>(bounds.bottom), bitCount);
+	return SimpleMath::Vector2(x, y);
+}
+
+std::string BitBufferReader::ReadString()
+{
+	uint32_t length = ReadVarUInt32();
+	if (static_cast<size_t>(length) * 8 > RemainingBits())
+	{
+		throw std::runtime_error("Attempted to read beyond the length of the buffer");
+	}
+
+	std::string value(length, '\0');
+	for (auto& character : value)
+	{
+		character = static_cast<char>(ReadBits(8));
+	}
+
+	return value;
+}
+
+BitBufferWriter::BitBufferWriter(size_t initialSize) :
+	m_bitPos(0)
+{
+	m_buffer.reserve(initialSize);
+}
+
+void BitBufferWriter::WriteBits(uint32_t value, uint32_t bitCount)
+{
+	if (bitCount < 32)
+	{
+		value &= (1u << bitCount) - 1;
+	}
+
+	// New bytes come in zeroed, so bits only ever need to be or'ed in
+	m_buffer.resize((m_bitPos + bitCount + 7) / 8);
+
+	while (bitCount > 0)
+	{
+		size_t byteIndex = m_bitPos / 8;
+		uint32_t bitOffset = static_cast<uint32_t>(m_bitPos % 8);
+		uint32_t count = std::min(8 - bitOffset, bitCount);
+
+		m_buffer[byteIndex] = static_cast<uint8_t>(m_buffer[byteIndex] | ((value & ((1u << count) - 1)) << bitOffset));
+		value >>= count;
+		bitCount -= count;
+		m_bitPos += count;
+	}
+}
+
+void BitBufferWriter::WriteBool(bool value)
+{
+	WriteBits(value ? 1u : 0u, 1);
+}
+
+void BitBufferWriter::WriteVarUInt32(uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		WriteBits((value & 0x7f) | 0x80, 8);
+		value >>= 7;
+	}
+	WriteBits(value, 8);
+}
+
+void BitBufferWriter::WriteSingle(float value)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	WriteBits(bits, 32);
+}
+
+void BitBufferWriter::WriteQuantized(float value, float minimum, float maximum, uint32_t bitCount)
+{
+	WriteBits(EncodeRange(value, minimum, maximum, bitCount), bitCount);
+}
+
+void BitBufferWriter::WriteSignedQuantized(float value, float magnitude, uint32_t bitCount)
+{
+	WriteBits(EncodeSigned(value, magnitude, bitCount), bitCount);
+}
+
+void BitBufferWriter::WriteAngle(float radians, uint32_t bitCount)
+{
+	WriteBits(EncodeAngle(radians, bitCount), bitCount);
+}
+
+void BitBufferWriter::WritePosition(const SimpleMath::Vector2& position, const RECT& bounds, uint32_t bitCount)
+{
+	WriteQuantized(position.x, static_cast<float>(bounds.left), static_cast<float>(bounds.right), bitCount);
+	WriteQuantized(position.y, static_cast<float>(bounds.top), static_cast<float>(bounds.bottom), bitCount);
+}
+
+void BitBufferWriter::WriteString(std::string_view value)
+{
+	WriteVarUInt32(static_cast<uint32_t>(value.length()));
+	for (char character : value)
+	{
+		WriteBits(static_cast<uint8_t>(character), 8);
+	}
+}
+
+float BitBufferWriter::Quantize(float value, float minimum, float maximum, uint32_t bitCount)
+{
+	return DecodeRange(EncodeRange(value, minimum, maximum, bitCount), minimum, maximum, bitCount);
+}
+
+float BitBufferWriter::SignedQuantize(float value, float magnitude, uint32_t bitCount)
+{
+	return DecodeSigned(EncodeSigned(value, magnitude, bitCount), magnitude, bitCount);
+}
+
+SimpleMath::Vector2 BitBufferWriter::QuantizePosition(const SimpleMath::Vector2& position, const RECT& bounds, uint32_t bitCount)
+{
+	return SimpleMath::Vector2(
+		Quantize(position.x, static_cast<float>(bounds.left), static_cast<float>(bounds.right), bitCount),
+		Quantize(position.y, static_cast<float>(bounds.top), static_cast<float>(bounds.bottom), bitCount));
+}
+
+void BitBufferWriter::Reset()
+{
+	m_buffer.clear();
+	m_bitPos = 0;
+}
@@ -0,0 +1,94 @@
+//--------------------------------------------------------------------------------------
+// BitBuffer.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "DataBuffer.h"
+
+namespace NetRumble
+{
+	// Number of bits needed to store every value up to and including maxValue
+	constexpr uint32_t BitsRequired(size_t maxValue)
+	{
+		uint32_t bits = 1;
+		while ((maxValue >> bits) != 0)
+		{
+			bits++;
+		}
+		return bits;
+	}
+
+	/// <summary>
+	/// Bit-level counterpart of DataBufferReader for the compact wire encoding.
+	/// Bits are packed least significant first; reading past the end throws.
+	/// </summary>
+	class BitBufferReader
+	{
+	public:
+		BitBufferReader(DataBufferView buffer);
+
+		uint32_t ReadBits(uint32_t bitCount);
+		bool ReadBool();
+		uint32_t ReadVarUInt32();
+
+		float ReadSingle();
+		float ReadQuantized(float minimum, float maximum, uint32_t bitCount);
+		float ReadSignedQuantized(float magnitude, uint32_t bitCount);
+		float ReadAngle(uint32_t bitCount);
+		DirectX::SimpleMath::Vector2 ReadPosition(const RECT& bounds, uint32_t bitCount);
+
+		std::string ReadString();
+
+		inline size_t TotalBytes() const { return m_buffer.size(); }
+		inline size_t RemainingBits() const { return m_buffer.size() * 8 - m_bitPos; }
+
+	private:
+		size_t m_bitPos;
+		DataBufferView m_buffer;
+	};
+
+	/// <summary>
+	/// Bit-level counterpart of DataBufferWriter. Values are quantized to the requested
+	/// bit count; the static Quantize helpers return exactly what the reader will decode,
+	/// so senders can keep their own copy of the state in step with the receivers.
+	/// </summary>
+	class BitBufferWriter
+	{
+	public:
+		BitBufferWriter(size_t initialSize = 64);
+
+		void WriteBits(uint32_t value, uint32_t bitCount);
+		void WriteBool(bool value);
+		void WriteVarUInt32(uint32_t value);
+
+		void WriteSingle(float value);
+		// Maps [minimum, maximum] onto the bit range; both ends are exact
+		void WriteQuantized(float value, float minimum, float maximum, uint32_t bitCount);
+		// Maps [-magnitude, magnitude] symmetrically so zero stays exactly zero
+		void WriteSignedQuantized(float value, float magnitude, uint32_t bitCount);
+		// Wraps the angle into [0, 2pi) before quantizing
+		void WriteAngle(float radians, uint32_t bitCount);
+		void WritePosition(const DirectX::SimpleMath::Vector2& position, const RECT& bounds, uint32_t bitCount);
+
+		void WriteString(std::string_view value);
+
+		static float Quantize(float value, float minimum, float maximum, uint32_t bitCount);
+		static float SignedQuantize(float value, float magnitude, uint32_t bitCount);
+		static DirectX::SimpleMath::Vector2 QuantizePosition(const DirectX::SimpleMath::Vector2& position, const RECT& bounds, uint32_t bitCount);
+
+		// Rewinds the writer but keeps its buffer, so a long-lived writer stops allocating once warmed up
+		void Reset();
+		// The bytes written so far, the last one zero-padded; invalidated by the next write or Reset
+		DataBufferView View() const { return m_buffer; }
+
+		size_t TotalBytes() const { return m_buffer.size(); }
+		size_t TotalBits() const { return m_bitPos; }
+
+	private:
+		size_t m_bitPos;
+		std::vector<uint8_t> m_buffer;
+	};
+}
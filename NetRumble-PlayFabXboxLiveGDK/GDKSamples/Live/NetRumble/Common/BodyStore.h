@@ -0,0 +1,59 @@
+//--------------------------------------------------------------------------------------
+// BodyStore.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "BatchRemovalCollection.h"
+
+namespace NetRumble
+{
+	class GameplayObject;
+
+	/// <summary>
+	/// The fields CollisionManager::Update works on for every object, copied out into one
+	/// array per field so its passes walk memory in order rather than chasing a pointer and
+	/// a virtual call per object. Bodies are numbered in collection order as of Gather, and
+	/// Scatter writes the moves back. The objects stay the authority for everything else:
+	/// an event that changes one mid-update goes through the object, and Refresh copies the
+	/// result back into its body.
+	/// </summary>
+	class BodyStore
+	{
+	public:
+		void Gather(BatchRemovalCollection<std::shared_ptr<GameplayObject>>& collection);
+		void Refresh(uint32_t body);
+
+		// A ship that dies mid-update takes its projectiles out of the collection without
+		// an event for each; this catches the bodies up if the membership has changed.
+		void RefreshActive(size_t generation);
+
+		// Writes position and velocity back to every body still active
+		void Scatter() const;
+
+		// Lets go of the objects, keeping the capacity for the next update
+		void Clear();
+
+		uint32_t Size() const { return static_cast<uint32_t>(m_objects.size()); }
+		GameplayObject* Object(uint32_t body) const { return m_objects[body].get(); }
+
+		std::vector<DirectX::SimpleMath::Vector2> Positions;
+		std::vector<DirectX::SimpleMath::Vector2> Velocities;
+		std::vector<float> Radii;
+		std::vector<float> Masses;
+		std::vector<float> Lives;
+		std::vector<uint8_t> Active;
+		std::vector<uint8_t> Collided;
+		std::vector<uint8_t> Projectile;
+
+		// Cleared for a body that stopped against another this update, so it doesn't move
+		std::vector<uint8_t> Moving;
+
+	private:
+		// Held so an object removed from the collection mid-update outlives it
+		std::vector<std::shared_ptr<GameplayObject>> m_objects;
+		size_t m_generation = SIZE_MAX;
+	};
+}
@@ -30,7 +30,7 @@ namespace CollisionMath
 	/// <remarks>The output parameter "point" is only valid
 	/// when the return value is true.</remarks>
 	/// <returns>True if intersecting, false otherwise.</returns>
-	bool LineLineIntersect(const SimpleMath::Vector2& a, const SimpleMath::Vector2& b, const SimpleMath::Vector2& c, const SimpleMath::Vector2& d, SimpleMath::Vector2& point)
+	inline bool LineLineIntersect(const SimpleMath::Vector2& a, const SimpleMath::Vector2& b, const SimpleMath::Vector2& c, const SimpleMath::Vector2& d, SimpleMath::Vector2& point)
 	{
 		point = SimpleMath::Vector2::Zero;
 
@@ -69,7 +69,7 @@ namespace CollisionMath
 	/// <param name="center2">The center of the second circle.</param>
 	/// <param name="radius2">The radius of the second circle.</param>
 	/// <returns>True if the circles intersect or contain one another.</returns>
-	bool CircleCircleIntersect(SimpleMath::Vector2 center1, float radius1, SimpleMath::Vector2 center2, float radius2)
+	inline bool CircleCircleIntersect(SimpleMath::Vector2 center1, float radius1, SimpleMath::Vector2 center2, float radius2)
 	{
 		SimpleMath::Vector2 line = center2 - center1;
 		// We use LengthSquared to avoid a costly square-root call
@@ -77,6 +77,115 @@ namespace CollisionMath
 		return (lengthSquared <= (radius1 + radius2) * (radius1 + radius2));
 	}
 
+	/// <summary>
+	/// Determines whether a moving circle could reach a stationary one, by comparing the
+	/// gap between them with the length of the movement and how much of it is towards
+	/// the other circle.
+	/// </summary>
+	/// <param name="center">The center of the moving circle before it moves.</param>
+	/// <param name="radius">The radius of the moving circle.</param>
+	/// <param name="movement">How far the moving circle travels.</param>
+	/// <param name="target">The center of the stationary circle.</param>
+	/// <param name="targetRadius">The radius of the stationary circle.</param>
+	/// <param name="distance">The output gap between the two circles.</param>
+	/// <remarks>Cheap, but not a swept test: it ignores how far to the side of the movement
+	/// the other circle lies, so it reports circles the movement passes wide of, and the
+	/// longer the movement the more of them. The output parameter "distance" is only valid
+	/// when the return value is true.</remarks>
+	/// <returns>True if the movement may reach the other circle, false otherwise.</returns>
+	inline bool CircleMovementReachesCircle(const SimpleMath::Vector2& center, float radius, const SimpleMath::Vector2& movement, const SimpleMath::Vector2& target, float targetRadius, float& distance)
+	{
+		distance = 0.0f;
+
+		SimpleMath::Vector2 checkVector = target - center;
+		float checkVectorLength = checkVector.Length();
+		if (checkVectorLength <= 0.0f)
+		{
+			return false;
+		}
+
+		float distanceBetween = std::max<float>(checkVectorLength - (radius + targetRadius), 0.0f);
+
+		// Check if they could possibly touch no matter the direction
+		if (movement.Length() < distanceBetween)
+		{
+			return false;
+		}
+
+		// Determine how much of the movement is bringing the two together; moving away,
+		// or not far enough towards, means no touch
+		float movementTowards = movement.Dot(checkVector);
+		if (movementTowards < 0.0f || movementTowards < distanceBetween)
+		{
+			return false;
+		}
+
+		distance = distanceBetween;
+		return true;
+	}
+
+	/// <summary>
+	/// Determines when a moving circle first touches a stationary one.
+	/// </summary>
+	/// <param name="center">The center of the moving circle before it moves.</param>
+	/// <param name="radius">The radius of the moving circle.</param>
+	/// <param name="movement">How far the moving circle travels.</param>
+	/// <param name="target">The center of the stationary circle.</param>
+	/// <param name="targetRadius">The radius of the stationary circle.</param>
+	/// <param name="timeOfImpact">The output fraction of the movement, from 0 to 1, at
+	/// which the circles first touch.</param>
+	/// <remarks>Exact for the whole path, so a small fast circle cannot pass through another
+	/// between where it starts and where it stops. Circles that already overlap touch at 0
+	/// if the movement brings them closer, and not at all if it separates them. The output
+	/// parameter "timeOfImpact" is only valid when the return value is true.</remarks>
+	/// <returns>True if the circles touch during the movement, false otherwise.</returns>
+	inline bool SweptCircleCircle(const SimpleMath::Vector2& center, float radius, const SimpleMath::Vector2& movement, const SimpleMath::Vector2& target, float targetRadius, float& timeOfImpact)
+	{
+		timeOfImpact = 0.0f;
+
+		// Solve |offset + t * movement| = combinedRadius for the first t, as
+		// a * t^2 + 2 * b * t + c = 0; in doubles, since b * b and a * c are both the
+		// square of a squared distance across the world
+		double offsetX = static_cast<double>(center.x) - target.x;
+		double offsetY = static_cast<double>(center.y) - target.y;
+		double combinedRadius = static_cast<double>(radius) + targetRadius;
+
+		double b = offsetX * movement.x + offsetY * movement.y;
+		double c = offsetX * offsetX + offsetY * offsetY - combinedRadius * combinedRadius;
+
+		// Already touching: it's a hit now if they're closing, and none if they're parting
+		if (c <= 0.0)
+		{
+			return b < 0.0;
+		}
+
+		// Moving apart, or not moving
+		if (b >= 0.0)
+		{
+			return false;
+		}
+
+		double a = static_cast<double>(movement.x) * movement.x + static_cast<double>(movement.y) * movement.y;
+		double discriminant = b * b - a * c;
+
+		// The line of the movement passes wide
+		if (discriminant < 0.0)
+		{
+			return false;
+		}
+
+		double t = (-b - std::sqrt(discriminant)) / a;
+
+		// Touches only beyond the end of the movement
+		if (t > 1.0)
+		{
+			return false;
+		}
+
+		timeOfImpact = static_cast<float>(t);
+		return true;
+	}
+
 	/// <summary>
 	/// Determines if a circle and rectangle intersect, and if so, how they do.
 	/// </summary>
@@ -85,7 +194,7 @@ namespace CollisionMath
 	/// <param name="rectangle">The rectangle.</param>
 	/// <param name="result">The result data for the collision.</param>
 	/// <returns>True if a collision occurs, provided for convenience.</returns>
-	bool CircleRectangleCollide(const SimpleMath::Vector2& center, float radius, RECT rectangle, CircleLineCollisionResult& result)
+	inline bool CircleRectangleCollide(const SimpleMath::Vector2& center, float radius, RECT rectangle, CircleLineCollisionResult& result)
 	{
 		SimpleMath::Vector2 point = center;
 		if (point.x < rectangle.left) point.x = static_cast<float>(rectangle.left);
@@ -121,7 +230,7 @@ namespace CollisionMath
 	/// <param name="lineEnd">The second point on the line segment.</param>
 	/// <param name="result">The result data for the collision.</param>
 	/// <returns>True if a collision occurs, provided for convenience.</returns>
-	bool CircleLineCollide(const SimpleMath::Vector2& center, float radius, const SimpleMath::Vector2& lineStart, const SimpleMath::Vector2& lineEnd, CircleLineCollisionResult& result)
+	inline bool CircleLineCollide(const SimpleMath::Vector2& center, float radius, const SimpleMath::Vector2& lineStart, const SimpleMath::Vector2& lineEnd, CircleLineCollisionResult& result)
 	{
 		SimpleMath::Vector2 AC = center - lineStart;
 		SimpleMath::Vector2 AB = lineEnd - lineStart;
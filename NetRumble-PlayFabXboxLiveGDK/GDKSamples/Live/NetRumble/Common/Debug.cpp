@@ -4,10 +4,14 @@
 
 #include "pch.h"
 #include "Debug.h"
+#include "LogRingBuffer.h"
 #include "StringUtil.h"
 
+#include <thread>
+
 std::string g_logFilePath(DEBUG_LOG_FILENAME);
 
+// Only called while the log writer is stopped and holds its lock, see DebugInit
 void SetLogPath()
 {
 	SYSTEMTIME localTime;
@@ -25,88 +29,217 @@ void SetLogPath()
 }
 
 // Debug Helpers
-#define DEBUG_BUFFER_SIZE 8192
+#define DEBUG_LOG_CAPACITY              4096    // Lines queued before new ones are dropped
+#define DEBUG_LOG_FLUSH_INTERVAL_MS     10      // How long the writer sleeps when the queue is empty
 
-std::mutex __debug_mutex;
+namespace
+{
+	// Owns the log file for the life of the process. Logging threads only queue lines; this
+	// thread formats their timestamps, forwards them to the debugger and writes each batch
+	// with a single fwrite and fflush.
+	class DebugLogWriter
+	{
+	public:
+		DebugLogWriter() :
+			m_lines(DEBUG_LOG_CAPACITY)
+		{
+		}
+
+		~DebugLogWriter()
+		{
+			Stop(true);
+		}
+
+		void Start()
+		{
+			std::lock_guard<std::mutex> lock(m_controlMutex);
+			StartThread();
+		}
+
+		void Stop(bool final = false)
+		{
+			std::lock_guard<std::mutex> lock(m_controlMutex);
+			if (final)
+			{
+				m_finished = true;
+			}
+			StopThread();
+		}
+
+		// Stops the writer, lets the caller move the log file and starts the writer on it again.
+		// The lock is held throughout, so a line logged meanwhile on another thread waits
+		// instead of starting the writer while the path is changing.
+		template<class MoveLog>
+		void Reopen(MoveLog moveLog)
+		{
+			std::lock_guard<std::mutex> lock(m_controlMutex);
+			StopThread();
+			moveLog();
+			StartThread();
+		}
+
+		inline void Write(const char* format, va_list args)
+		{
+			// Lines logged before DebugInit go to the default log file, as they always have
+			if (!m_started.load(std::memory_order_acquire) && !m_finished)
+			{
+				Start();
+			}
+
+			FILETIME now;
+			GetSystemTimeAsFileTime(&now);
+
+			m_lines.Write(
+				GetCurrentThreadId(),
+				(static_cast<uint64_t>(now.dwHighDateTime) << 32) | now.dwLowDateTime,
+				format,
+				args);
+		}
+
+	private:
+		// Both are called with m_controlMutex held
+		void StartThread()
+		{
+			if (!m_thread.joinable())
+			{
+				m_running = true;
+				m_thread = std::thread([this]() { Run(); });
+			}
+			m_started.store(true, std::memory_order_release);
+		}
+
+		void StopThread()
+		{
+			m_started.store(false, std::memory_order_release);
+			if (m_thread.joinable())
+			{
+				m_running = false;
+				m_thread.join();
+			}
+		}
+
+		void Run()
+		{
+			FILE* file = nullptr;
+#ifdef DEBUG_LOGGING
+			errno_t err = fopen_s(&file, g_logFilePath.c_str(), "at+");
+			if (err != 0)
+			{
+				std::string errMsg(DEBUG_LOG_ENTRY_PREFIX "Unable to open log file: ");
+				errMsg += std::to_string(err);
+				errMsg += "\n";
+				OutputDebugStringA(errMsg.c_str());
+				file = nullptr;
+			}
+#endif
+
+			std::string batch;
+			uint64_t reportedDrops = 0;
+
+			for (;;)
+			{
+				// Read the flag first so lines queued before Stop are still written
+				bool running = m_running;
+
+				batch.clear();
+				m_lines.Drain([&](const LogRingBuffer::Line& line) { AppendLine(batch, line); });
+
+				uint64_t dropped = m_lines.Dropped();
+				if (dropped != reportedDrops)
+				{
+					batch += std::to_string(dropped - reportedDrops);
+					batch += " log lines dropped: the log queue was full\n";
+					reportedDrops = dropped;
+				}
+
+				if (!batch.empty())
+				{
+					if (file != nullptr)
+					{
+						fwrite(batch.data(), sizeof(char), batch.size(), file);
+						fflush(file);
+					}
+				}
+				else if (!running)
+				{
+					break;
+				}
+				else
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(DEBUG_LOG_FLUSH_INTERVAL_MS));
+				}
+			}
+
+			if (file != nullptr)
+			{
+				fclose(file);
+			}
+		}
+
+		static void AppendLine(std::string& batch, const LogRingBuffer::Line& line)
+		{
+			std::string debugLine(DEBUG_LOG_ENTRY_PREFIX);
+			debugLine.append(line.Text, line.Length);
+			OutputDebugStringA(debugLine.c_str());
+
+			// Note the log time
+			FILETIME fileTime;
+			fileTime.dwLowDateTime = static_cast<DWORD>(line.Timestamp);
+			fileTime.dwHighDateTime = static_cast<DWORD>(line.Timestamp >> 32);
+
+			FILETIME localFileTime;
+			SYSTEMTIME localTime;
+			FileTimeToLocalFileTime(&fileTime, &localFileTime);
+			FileTimeToSystemTime(&localFileTime, &localTime);
+
+			char prefix[100];
+			sprintf_s(prefix, 100, "%lu \t%02u:%02u:%02u.%03u ",
+				line.ThreadId,
+				localTime.wHour,
+				localTime.wMinute,
+				localTime.wSecond,
+				localTime.wMilliseconds); // Format: "thread \thh:mm:ss.ms"
+
+			batch += prefix;
+			batch.append(line.Text, line.Length);
+		}
+
+		LogRingBuffer m_lines;
+		std::atomic<bool> m_started{ false };
+		std::atomic<bool> m_running{ false };
+		std::atomic<bool> m_finished{ false };
+		std::mutex m_controlMutex;
+		std::thread m_thread;
+	};
+
+	DebugLogWriter s_debugLogWriter;
+}
 
 void DebugInit()
 {
+	// Reopen the log under its timestamped name
+	s_debugLogWriter.Reopen([]()
+	{
 #ifdef DEBUG_LOGGING
-	SetLogPath();
+		SetLogPath();
 
 #if DEBUG_LOG_CREATE_NEW_ON_LAUNCH == 1
-	// Delete logfile, ignoring failures
-	remove(g_logFilePath.c_str());
+		// Delete logfile, ignoring failures
+		remove(g_logFilePath.c_str());
 #endif
 #endif
+	});
 }
 
-std::string DebugWrite(const char* format, ...)
+void DebugShutdown()
 {
-	std::lock_guard<std::mutex> lock(__debug_mutex);
-	static char msgbuffer[DEBUG_BUFFER_SIZE];
-	std::string returnLine{};
+	s_debugLogWriter.Stop(true);
+}
 
+void DebugWrite(const char* format, ...)
+{
 	va_list args;
 	va_start(args, format);
-	vsprintf_s(msgbuffer, DEBUG_BUFFER_SIZE, format, args);
+	s_debugLogWriter.Write(format, args);
 	va_end(args);
-
-	std::string buffer(DEBUG_LOG_ENTRY_PREFIX);
-	buffer += msgbuffer;
-	OutputDebugStringA(buffer.c_str());
-
-	// Note the log time
-	SYSTEMTIME localTime;
-	GetLocalTime(&localTime);
-
-	char timeStr[100];
-	sprintf_s(timeStr, 100, "%02u:%02u:%02u.%03u ",
-		localTime.wHour,
-		localTime.wMinute,
-		localTime.wSecond,
-		localTime.wMilliseconds); // Format: "hh:mm:ss.ms"
-
-#ifdef DEBUG_LOGGING
-	// Log the string to a file
-	FILE* file = nullptr;
-
-	errno_t err = fopen_s(
-		&file,
-		g_logFilePath.c_str(),
-		"at+"
-	);
-
-	if (err != 0)
-	{
-		std::string err_msg("Unable to open log file: ");
-		err_msg += std::to_string(err);
-		err_msg += "\n";
-		DEBUGLOG(err_msg.c_str());
-	}
-	else
-	{
-		std::string fileStr{};
-		fileStr += std::to_string(GetCurrentThreadId());
-		fileStr += " \t";
-		fileStr += timeStr;
-		fileStr += msgbuffer;
-
-		fwrite(
-			(void*)fileStr.c_str(),
-			sizeof(char),
-			fileStr.length(),
-			file
-		);
-
-		fflush(file);
-		fclose(file);
-	}
-#endif
-
-	// Assemble return line
-	returnLine += timeStr;
-	returnLine += msgbuffer;
-
-	return returnLine;
 }
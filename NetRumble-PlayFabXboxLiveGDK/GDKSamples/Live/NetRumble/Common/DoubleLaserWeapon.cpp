@@ -23,13 +23,15 @@ void DoubleLaserWeapon::CreateProjectiles(const Vector2& direction)
 	Vector2 cross = Vector2(-direction.y, direction.x) * c_laserSpread;
 
 	// Create the first new projectile
-	std::shared_ptr<LaserProjectile> projectile1 = std::make_shared<LaserProjectile>(m_owner, direction);
+	std::shared_ptr<LaserProjectile> projectile1 = m_owner->LaserProjectiles.Acquire(m_owner);
+	projectile1->Launch(direction);
 	projectile1->Initialize();
 	projectile1->Position += cross;
 	m_owner->Projectiles.push_back(projectile1);
 
 	// Create the second projectile
-	std::shared_ptr<LaserProjectile> projectile2 = std::make_shared<LaserProjectile>(m_owner, direction);
+	std::shared_ptr<LaserProjectile> projectile2 = m_owner->LaserProjectiles.Acquire(m_owner);
+	projectile2->Launch(direction);
 	projectile2->Initialize();
 	projectile2->Position -= cross;
 	m_owner->Projectiles.push_back(projectile2);
@@ -29,7 +29,6 @@ namespace NetRumble
 
 		bool m_leavingGame;
 		float m_countdownTimer;
-		float m_frameTime;
 		std::string m_connectFailInGameMessage;
 
 		std::shared_ptr<DirectX::SpriteFont> m_playerFont;
@@ -33,8 +33,9 @@ LaserWeapon::LaserWeapon(Ship* owner) : Weapon(owner)
 
 void LaserWeapon::CreateProjectiles(const DirectX::SimpleMath::Vector2& direction)
 {
-	// Create the new projectile
-	std::shared_ptr<LaserProjectile> projectile = std::make_shared<LaserProjectile>(m_owner, direction);
+	// Launch the new projectile
+	std::shared_ptr<LaserProjectile> projectile = m_owner->LaserProjectiles.Acquire(m_owner);
+	projectile->Launch(direction);
 	projectile->Initialize();
 
 	m_owner->Projectiles.push_back(projectile);
@@ -0,0 +1,122 @@
+//--------------------------------------------------------------------------------------
+// LogRingBuffer.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+// Bounded queue of formatted log lines between any number of logging threads and the one
+// thread that writes them out. A writer claims a slot with a single compare-and-swap and
+// formats straight into it, so logging never takes a lock, allocates or touches a file.
+// When the queue is full the line is dropped and counted rather than stalling the caller.
+class LogRingBuffer
+{
+public:
+	static constexpr size_t LineSize = 512;
+
+	struct Line
+	{
+		uint32_t ThreadId;
+		uint64_t Timestamp;
+		uint32_t Length;
+		char Text[LineSize];
+	};
+
+	// Capacity must be a power of two
+	explicit LogRingBuffer(size_t capacity) :
+		m_slots(new Slot[capacity]),
+		m_mask(capacity - 1)
+	{
+		for (size_t i = 0; i < capacity; i++)
+		{
+			m_slots[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	LogRingBuffer(LogRingBuffer const&) = delete;
+	LogRingBuffer& operator= (LogRingBuffer const&) = delete;
+
+	// Any thread. Lines longer than LineSize are truncated.
+	bool Write(uint32_t threadId, uint64_t timestamp, const char* format, va_list args)
+	{
+		size_t position = m_writePosition.load(std::memory_order_relaxed);
+		Slot* slot = nullptr;
+
+		for (;;)
+		{
+			slot = &m_slots[position & m_mask];
+			size_t sequence = slot->Sequence.load(std::memory_order_acquire);
+			intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+			if (difference == 0)
+			{
+				if (m_writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (difference < 0)
+			{
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+			else
+			{
+				position = m_writePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		int length = vsnprintf(slot->Data.Text, LineSize, format, args);
+		slot->Data.ThreadId = threadId;
+		slot->Data.Timestamp = timestamp;
+		slot->Data.Length = length < 0 ? 0 : static_cast<uint32_t>(length < static_cast<int>(LineSize) ? length : LineSize - 1);
+
+		slot->Sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Writer thread only. Hands every published line to sink in order and returns how many.
+	template<typename Sink>
+	size_t Drain(Sink&& sink)
+	{
+		size_t count = 0;
+
+		for (;;)
+		{
+			Slot& slot = m_slots[m_readPosition & m_mask];
+			if (slot.Sequence.load(std::memory_order_acquire) != m_readPosition + 1)
+			{
+				return count;
+			}
+
+			sink(static_cast<const Line&>(slot.Data));
+
+			slot.Sequence.store(m_readPosition + m_mask + 1, std::memory_order_release);
+			m_readPosition++;
+			count++;
+		}
+	}
+
+	inline uint64_t Dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+	struct Slot
+	{
+		std::atomic<size_t> Sequence;
+		Line Data;
+	};
+
+	std::unique_ptr<Slot[]> m_slots;
+	size_t m_mask;
+
+	alignas(64) std::atomic<size_t> m_writePosition{ 0 };
+	alignas(64) size_t m_readPosition = 0;
+	std::atomic<uint64_t> m_dropped{ 0 };
+};
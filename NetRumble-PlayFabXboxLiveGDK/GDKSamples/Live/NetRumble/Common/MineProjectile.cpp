@@ -26,26 +26,32 @@ namespace
 	constexpr float c_rotationRadiansPerSecond = 1.0f;
 }
 
-MineProjectile::MineProjectile(Ship* owner, DirectX::SimpleMath::Vector2 direction) :
-	Projectile(owner, direction)
+MineProjectile::MineProjectile(Ship* owner) :
+	Projectile(owner)
 {
-	// Set the gameplay data
-	Velocity *= c_initialSpeed;
-
 	// Set the collision data
 	Radius = 10.0f;
 	Mass = 5.0f;
 
 	// Set the projectile data
-	m_duration = 20.0f;
 	m_damageAmount = 200.0f;
 	m_damageRadius = 300.0f;
 	m_damageOwner = false;
-	Life = c_initialLife;
 
 	m_texture = Managers::Get<ContentManager>()->LoadTexture(L"Assets\\Textures\\mine.png");
 }
 
+void MineProjectile::Launch(DirectX::SimpleMath::Vector2 direction)
+{
+	Projectile::Launch(direction);
+
+	// Set the gameplay data
+	Velocity *= c_initialSpeed;
+	m_duration = 20.0f;
+	Life = c_initialLife;
+	anchored = false;
+}
+
 void MineProjectile::Update(float elapsedTime)
 {
 	Projectile::Update(elapsedTime);
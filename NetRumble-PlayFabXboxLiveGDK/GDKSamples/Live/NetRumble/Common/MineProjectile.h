@@ -13,8 +13,9 @@ namespace NetRumble
 	class MineProjectile final : public Projectile
 	{
 	public:
-		MineProjectile(Ship* owner, DirectX::SimpleMath::Vector2 direction);
+		explicit MineProjectile(Ship* owner);
 
+		virtual void Launch(DirectX::SimpleMath::Vector2 direction) override;
 		virtual void Update(float elapsedTime) override;
 		virtual void Draw(float elapsedTime, RenderContext* renderContext) override;
 		virtual bool TakeDamage(GameplayObject* source, float damageAmount) override;
@@ -0,0 +1,69 @@
+//--------------------------------------------------------------------------------------
+// ObjectPool.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Objects of one type that are handed out again once nothing else holds them. The pool
+// keeps a reference to everything it has made, so an object is free exactly when the
+// pool's is the only one left; whoever acquires it resets whatever state it needs.
+// Going by the reference count rather than an explicit release means an object still
+// held by a rollback save, a particle effect or a pending removal is never handed out
+// twice. The search starts after the last object handed out, so in the usual case of
+// objects freed roughly in the order they were acquired it stops at the first one. It
+// gives up after a few objects in use and makes a new one instead, so acquiring from a
+// pool that is mostly busy costs no more than from one that is mostly free; the pool
+// grows a little past the most objects ever in use at once.
+template<typename T>
+class ObjectPool
+{
+public:
+	ObjectPool() = default;
+
+	ObjectPool(ObjectPool const&) = delete;
+	ObjectPool& operator= (ObjectPool const&) = delete;
+
+	// A free object, or a new one made from args if every object is in use
+	template<typename... Args>
+	std::shared_ptr<T> Acquire(Args&&... args)
+	{
+		m_acquired++;
+
+		const size_t count = m_objects.size();
+		const size_t scan = count < c_maximumScan ? count : c_maximumScan;
+		for (size_t scanned = 0; scanned < scan; scanned++)
+		{
+			const std::shared_ptr<T>& object = m_objects[m_next];
+			m_next = (m_next + 1 < count) ? m_next + 1 : 0;
+
+			if (object.use_count() == 1)
+			{
+				return object;
+			}
+		}
+
+		m_objects.push_back(std::make_shared<T>(std::forward<Args>(args)...));
+		return m_objects.back();
+	}
+
+	// Every object the pool has made, free or not
+	inline size_t Size() const { return m_objects.size(); }
+
+	// Every object handed out, new or free
+	inline uint64_t Acquired() const { return m_acquired; }
+
+private:
+	// Objects looked at before making a new one
+	static constexpr size_t c_maximumScan = 8;
+
+	std::vector<std::shared_ptr<T>> m_objects;
+	size_t m_next = 0;
+	uint64_t m_acquired = 0;
+};
@@ -10,75 +10,122 @@ using namespace NetRumble;
 using namespace DirectX;
 using namespace DirectX::SimpleMath;
 
-void Particle::Update(float elapsedTime, float angularVelocity, float scaleDeltaPerSecond, float opacityDeltaPerSecond)
+namespace
 {
-	Velocity.x += Acceleration.x * elapsedTime;
-	Velocity.y += Acceleration.y * elapsedTime;
+	// Floats processed per SIMD step; the particle arrays are padded to a multiple of this
+	constexpr size_t c_particleLanes = 4;
 
-	Position.x += Velocity.x * elapsedTime;
-	Position.y += Velocity.y * elapsedTime;
-
-	Rotation += angularVelocity * elapsedTime;
-	Scale += scaleDeltaPerSecond * elapsedTime;
-
-	if (Scale < 0.0f)
+	inline XMVECTOR LoadLanes(const std::vector<float>& values, size_t index)
 	{
-		Scale = 0.0f;
+		return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(&values[index]));
 	}
 
-	Opacity = std::min(std::max(Opacity + opacityDeltaPerSecond * elapsedTime, 0.0f), 1.0f);
-}
-
-ParticleCache::ParticleCache(size_t count) :
-	Particles(count)
-{
-	for (size_t i = 0; i < count; i++)
+	inline void StoreLanes(std::vector<float>& values, size_t index, FXMVECTOR lanes)
 	{
-		Particles[i] = std::make_shared<Particle>();
-		freeParticles.push(Particles[i]);
+		XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(&values[index]), lanes);
 	}
 }
 
-ParticleCache::~ParticleCache()
+ParticleCache::ParticleCache(size_t count) :
+	m_capacity(count),
+	m_count(0)
 {
-	for (size_t i = 0; i < Particles.size(); i++)
+	size_t paddedCount = (count + c_particleLanes - 1) / c_particleLanes * c_particleLanes;
+
+	for (auto field : { &PositionX, &PositionY, &VelocityX, &VelocityY, &AccelerationX, &AccelerationY, &Scale, &Rotation, &Opacity, &TimeRemaining })
 	{
-		Particles[i] = nullptr;
+		field->resize(paddedCount, 0.0f);
 	}
 }
 
 void ParticleCache::Reset()
 {
-	freeParticles = std::queue<std::shared_ptr<Particle>>();
+	m_count = 0;
+}
 
-	for (size_t i = 0; i < Particles.size(); i++)
+void ParticleCache::AddParticle(const Particle& particle)
+{
+	if (IsFull())
 	{
-		Particles[i]->TimeRemaining = 0.0f;
-		freeParticles.push(Particles[i]);
+		return;
 	}
+
+	size_t i = m_count++;
+	PositionX[i] = particle.Position.x;
+	PositionY[i] = particle.Position.y;
+	VelocityX[i] = particle.Velocity.x;
+	VelocityY[i] = particle.Velocity.y;
+	AccelerationX[i] = particle.Acceleration.x;
+	AccelerationY[i] = particle.Acceleration.y;
+	Scale[i] = particle.Scale;
+	Rotation[i] = particle.Rotation;
+	Opacity[i] = particle.Opacity;
+	TimeRemaining[i] = particle.TimeRemaining;
+}
+
+void ParticleCache::Update(float elapsedTime, float angularVelocity, float scaleDeltaPerSecond, float opacityDeltaPerSecond)
+{
+	Integrate(elapsedTime, angularVelocity, scaleDeltaPerSecond, opacityDeltaPerSecond);
+	RemoveExpired();
 }
 
-std::shared_ptr<Particle> ParticleCache::GetNextParticle()
+// Advances every live particle four at a time. DirectXMath maps this onto SSE/NEON, or onto
+// plain scalar code when built with _XM_NO_INTRINSICS_. The padding lanes past m_count hold
+// stale data that is never read back, so the last partial group needs no special case.
+void ParticleCache::Integrate(float elapsedTime, float angularVelocity, float scaleDeltaPerSecond, float opacityDeltaPerSecond)
 {
-	std::shared_ptr<Particle> p;
+	const XMVECTOR dt = XMVectorReplicate(elapsedTime);
+	const XMVECTOR rotationDelta = XMVectorReplicate(angularVelocity * elapsedTime);
+	const XMVECTOR scaleDelta = XMVectorReplicate(scaleDeltaPerSecond * elapsedTime);
+	const XMVECTOR opacityDelta = XMVectorReplicate(opacityDeltaPerSecond * elapsedTime);
 
-	if (freeParticles.size() > 0)
+	for (size_t i = 0; i < m_count; i += c_particleLanes)
 	{
-		p = freeParticles.front();
-		freeParticles.pop();
-	}
+		XMVECTOR velocityX = XMVectorMultiplyAdd(LoadLanes(AccelerationX, i), dt, LoadLanes(VelocityX, i));
+		XMVECTOR velocityY = XMVectorMultiplyAdd(LoadLanes(AccelerationY, i), dt, LoadLanes(VelocityY, i));
+		StoreLanes(VelocityX, i, velocityX);
+		StoreLanes(VelocityY, i, velocityY);
+
+		StoreLanes(PositionX, i, XMVectorMultiplyAdd(velocityX, dt, LoadLanes(PositionX, i)));
+		StoreLanes(PositionY, i, XMVectorMultiplyAdd(velocityY, dt, LoadLanes(PositionY, i)));
 
-	return p;
+		StoreLanes(Rotation, i, XMVectorAdd(LoadLanes(Rotation, i), rotationDelta));
+		StoreLanes(Scale, i, XMVectorMax(XMVectorAdd(LoadLanes(Scale, i), scaleDelta), XMVectorZero()));
+		StoreLanes(Opacity, i, XMVectorSaturate(XMVectorAdd(LoadLanes(Opacity, i), opacityDelta)));
+
+		StoreLanes(TimeRemaining, i, XMVectorSubtract(LoadLanes(TimeRemaining, i), dt));
+	}
 }
 
-void ParticleCache::ReleaseParticle(std::shared_ptr<Particle> p)
+void ParticleCache::RemoveExpired()
 {
-	if (p)
+	size_t i = 0;
+	while (i < m_count)
 	{
-		freeParticles.push(p);
+		if (TimeRemaining[i] > 0.0f)
+		{
+			++i;
+			continue;
+		}
+
+		// Fill the hole with the last live particle, which is checked on the next pass
+		MoveParticle(--m_count, i);
 	}
 }
 
+void ParticleCache::MoveParticle(size_t from, size_t to)
+{
+	PositionX[to] = PositionX[from];
+	PositionY[to] = PositionY[from];
+	VelocityX[to] = VelocityX[from];
+	VelocityY[to] = VelocityY[from];
+	AccelerationX[to] = AccelerationX[from];
+	AccelerationY[to] = AccelerationY[from];
+	Scale[to] = Scale[from];
+	Rotation[to] = Rotation[from];
+	Opacity[to] = Opacity[from];
+	TimeRemaining[to] = TimeRemaining[from];
+}
 
 ParticleSystem::ParticleSystem() noexcept :
 	Name(L"DefaultParticleSystem"),
@@ -176,7 +223,7 @@ void ParticleSystem::Initialize()
 	}
 
 	// Calculate the origin on the texture
-	TextureOrigin = SimpleMath::Vector2(static_cast<float>(texture.Texture->Width()) / 2.0f, static_cast<float>(texture.Texture->Height()) / 2.0f);
+	TextureOrigin = SimpleMath::Vector2(static_cast<float>(texture.GetTextureSize().x) / 2.0f, static_cast<float>(texture.GetTextureSize().y) / 2.0f);
 
 	// Allow us to start updating and drawing
 	active = true;
@@ -228,20 +275,17 @@ void ParticleSystem::Draw(RenderContext* renderContext)
 		return;
 	}
 
-	// Draw each particle
-	for (auto& particle : particles->Particles)
+	// Draw each live particle
+	for (size_t i = 0; i < static_cast<size_t>(particles->UsedCount()); ++i)
 	{
-		if (particle->TimeRemaining > 0.0f)
-		{
-			Color.f[3] = particle->Opacity;
-
-			renderContext->Draw(
-				texture,
-				particle->Position,
-				particle->Rotation,
-				particle->Scale,
-				Color);
-		}
+		Color.f[3] = particles->Opacity[i];
+
+		renderContext->Draw(
+			texture,
+			SimpleMath::Vector2(particles->PositionX[i], particles->PositionY[i]),
+			particles->Rotation[i],
+			particles->Scale[i],
+			Color);
 	}
 }
 
@@ -269,87 +313,58 @@ void ParticleSystem::GenerateParticles(float elapsedTime)
 
 	// Release some particles if it's time
 	ReleaseTimer += elapsedTime;
-	while (ReleaseTimer >= ReleaseRate)
+	// Only get new particles if you can
+	while (ReleaseTimer >= ReleaseRate && !particles->IsFull())
 	{
-		// Only get new particles if you can
-		std::shared_ptr<Particle> particle = particles->GetNextParticle();
-		if (particle == nullptr)
-		{
-			break;
-		}
-		else
-		{
-			// Initialize the new particle 
-			InitializeParticle(particle);
-			// Reduce the release timer for the release rate of a particle
-			ReleaseTimer -= ReleaseRate;
-		}
+		// Initialize the new particle
+		Particle particle;
+		InitializeParticle(particle);
+		particles->AddParticle(particle);
+
+		// Reduce the release timer for the release rate of a particle
+		ReleaseTimer -= ReleaseRate;
 	}
 }
 
 void ParticleSystem::UpdateParticles(float elapsedTime)
 {
-	for (size_t i = 0; i < particles->Particles.size(); ++i)
-	{
-		if (particles->Particles[i]->TimeRemaining > 0.0f)
-		{
-			// Update the timer on the particle
-			particles->Particles[i]->TimeRemaining -= elapsedTime;
-
-			// If the particle just timed out on this update, 
-			// Add it to the freed-list.
-			if (particles->Particles[i]->TimeRemaining <= 0.0f)
-			{
-				particles->ReleaseParticle(particles->Particles[i]);
-				continue;
-			}
-
-			// Update the particle
-			particles->Particles[i]->Update(
-				elapsedTime,
-				AngularVelocity,
-				ScaleDeltaPerSecond,
-				OpacityDeltaPerSecond
-			);
-		}
-	}
+	particles->Update(
+		elapsedTime,
+		AngularVelocity,
+		ScaleDeltaPerSecond,
+		OpacityDeltaPerSecond
+	);
 }
 
-void ParticleSystem::InitializeParticle(std::shared_ptr<Particle> particle)
+void ParticleSystem::InitializeParticle(Particle& particle)
 {
 	float t = 0.0f;
 
-	// Safety-check the parameter
-	if (particle == nullptr)
-	{
-		throw std::exception("particle cannot be null");
-	}
-
 	// Set the time remaining on the new particle
-	particle->TimeRemaining = RandomMath::RandomBetween(DurationMinimum, DurationMaximum);
+	particle.TimeRemaining = RandomMath::RandomBetween(DurationMinimum, DurationMaximum);
 
 	// Generate a random direction
 	SimpleMath::Vector2 direction = RandomMath::RandomDirection(ReleaseAngleMinimum, ReleaseAngleMaximum);
 
 	// Set the graphics data on the new particle
 	t = RandomMath::RandomBetween(ReleaseDistanceMinimum, ReleaseDistanceMaximum);
-	particle->Position = Position + direction * t;
+	particle.Position = Position + direction * t;
 
 	t = RandomMath::RandomBetween(VelocityMinimum, VelocityMaximum);
-	particle->Velocity = direction * t;
+	particle.Velocity = direction * t;
 
-	if (particle->Velocity.LengthSquared() > 0.0f)
+	if (particle.Velocity.LengthSquared() > 0.0f)
 	{
 		t = RandomMath::RandomBetween(AccelerationMinimum, AccelerationMaximum);
-		particle->Acceleration = direction * t;
+		particle.Acceleration = direction * t;
 	}
 	else
 	{
-		particle->Acceleration = SimpleMath::Vector2(0, 0);
+		particle.Acceleration = SimpleMath::Vector2(0, 0);
 	}
-	particle->Rotation = RandomMath::RandomBetween(0.0f, DirectX::XM_2PI);
-	particle->Scale = RandomMath::RandomBetween(ScaleMinimum, ScaleMaximum);
-	particle->Opacity = RandomMath::RandomBetween(OpacityMinimum, OpacityMaximum);
+	particle.Rotation = RandomMath::RandomBetween(0.0f, DirectX::XM_2PI);
+	particle.Scale = RandomMath::RandomBetween(ScaleMinimum, ScaleMaximum);
+	particle.Opacity = RandomMath::RandomBetween(OpacityMinimum, OpacityMaximum);
 }
 
 ParticleEffect::ParticleEffect() :
@@ -503,15 +518,16 @@ void ParticleEffectManager::Initialize()
 
 void ParticleEffectManager::Update(float elapsedTime)
 {
-	for (auto& effect : activeParticleEffects)
+	for (size_t i = 0; i < activeParticleEffects.size(); i++)
 	{
+		auto& effect = activeParticleEffects[i];
 		if (effect->IsActive())
 		{
 			effect->Update(elapsedTime);
 
 			if (!effect->IsActive())
 			{
-				activeParticleEffects.QueuePendingRemoval(effect);
+				activeParticleEffects.QueuePendingRemoval(activeParticleEffects.handle_at(i));
 			}
 		}
 	}
@@ -547,7 +563,7 @@ std::shared_ptr<ParticleEffect> ParticleEffectManager::SpawnEffect(ParticleEffec
 	auto itr = particleEffectCache.find(effectType);
 	if (itr != particleEffectCache.end())
 	{
-		auto availableSystems = itr->second;
+		auto& availableSystems = itr->second;
 
 		for (auto& system : availableSystems)
 		{
@@ -0,0 +1,224 @@
+//--------------------------------------------------------------------------------------
+// PeerSlotBenchmark.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "PeerSlotBenchmark.h"
+
+#include <chrono>
+
+using namespace NetRumble;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	// PlayerState messages used to be this fixed-size struct: five flags and bytes, then the
+	// display name and entity ID in 32 and 256 byte character arrays
+	constexpr size_t c_entityIdPlayerStateBytes = 5 + MaxUserNameLength + 256;
+
+	// The same width World::SerializeShipData writes a slot in
+	constexpr uint32_t c_peerSlotBits = BitsRequired(MaxPeerSlots - 1);
+
+	// PlayFab entity IDs are 16 hex digits
+	std::string MakeEntityId(std::mt19937_64& random)
+	{
+		char entityId[17] = {};
+		sprintf_s(entityId, "%016llX", static_cast<unsigned long long>(random()));
+		return entityId;
+	}
+
+	size_t StringBytes(const std::string& value)
+	{
+		DataBufferWriter dataWriter;
+		dataWriter.WriteString(value);
+		return dataWriter.GetBuffer().size();
+	}
+
+	size_t StringBits(const std::string& value)
+	{
+		BitBufferWriter dataWriter;
+		dataWriter.WriteString(value);
+		return dataWriter.TotalBits();
+	}
+
+	size_t BytesForBits(size_t bits)
+	{
+		return (bits + 7) / 8;
+	}
+}
+
+PeerSlotBenchmark::PeerSlotBenchmark(const Settings& settings) :
+	m_settings(settings)
+{
+	m_settings.Players = std::clamp<uint32_t>(m_settings.Players, 2, MaxPeerSlots);
+	m_settings.Lookups = std::max<uint32_t>(m_settings.Lookups, 1);
+}
+
+PeerSlotBenchmark::Report PeerSlotBenchmark::Run()
+{
+	Report report;
+	report.Players = m_settings.Players;
+
+	PlayFabOnlineManager* onlineManager = Managers::Get<OnlineManager>();
+	onlineManager->BeginReplay();
+
+	AddPlayers();
+	g_game->GetWorld()->GenerateWorld();
+
+	for (const auto& player : m_players)
+	{
+		if (g_game->GetPlayerStateBySlot(player->Slot) != player)
+		{
+			report.SlotMismatches++;
+		}
+	}
+
+	MeasureMessages(report);
+	MeasureLookups(report);
+
+	onlineManager->EndReplay();
+	return report;
+}
+
+// The local player is the host, so adding the others hands out their slots as a lobby would
+void PeerSlotBenchmark::AddPlayers()
+{
+	std::mt19937_64 random(m_settings.Seed);
+
+	const std::string localEntityId = MakeEntityId(random);
+	Managers::Get<OnlineManager>()->SetReplaySession(localEntityId, true);
+
+	for (uint32_t i = 0; i < m_settings.Players; ++i)
+	{
+		auto player = std::make_shared<PlayerState>("Player " + std::to_string(i + 1));
+		player->IsLocalPlayer = (i == 0);
+		player->EntityId = (i == 0) ? localEntityId : MakeEntityId(random);
+		player->InLobby = true;
+		player->LobbyReady = true;
+		player->InGame = true;
+
+		g_game->AddPlayerToLobbyPeers(player);
+		m_players.push_back(player);
+	}
+}
+
+// Each message is measured as the serializer now writes it; the entity ID layout is the
+// same message with each slot swapped back for the entity ID string it replaced
+void PeerSlotBenchmark::MeasureMessages(Report& report) const
+{
+	std::unique_ptr<World>& world = g_game->GetWorld();
+	const std::shared_ptr<PlayerState>& localPlayer = m_players.front();
+	const size_t entityIdBytes = StringBytes(localPlayer->EntityId);
+
+	{
+		MessageSize size;
+		size.Name = "PlayerState";
+		size.EntityIdBytes = c_entityIdPlayerStateBytes;
+		size.SlotBytes = localPlayer->SerializePlayerStateData().size();
+		report.Messages.push_back(size);
+	}
+
+	{
+		// The member count was a 32-bit integer
+		MessageSize size;
+		size.Name = "WorldSetup";
+		size.SlotBytes = world->SerializeWorldSetup(m_players).size();
+		size.EntityIdBytes = size.SlotBytes - 1 + sizeof(uint32_t) + m_players.size() * (entityIdBytes - 1);
+		report.Messages.push_back(size);
+	}
+
+	{
+		MessageSize size;
+		size.Name = "ShipSpawn";
+		size.SlotBytes = world->SerializeShipSpawn(*localPlayer).size();
+		size.EntityIdBytes = size.SlotBytes - 1 + entityIdBytes;
+		report.Messages.push_back(size);
+	}
+
+	{
+		std::shared_ptr<Ship> localShip = localPlayer->GetShip();
+		localShip->LastDamagedBy = m_players.back()->GetShip().get();
+
+		MessageSize size;
+		size.Name = "ShipDeath";
+		size.SlotBytes = world->SerializeShipDeath(localShip).size();
+		size.EntityIdBytes = size.SlotBytes - 1 + entityIdBytes;
+		report.Messages.push_back(size);
+
+		localShip->LastDamagedBy = nullptr;
+	}
+
+	{
+		BitBufferWriter dataWriter;
+		world->SerializeShipData(dataWriter);
+
+		size_t ships = 0;
+		for (const auto& player : m_players)
+		{
+			if (player->GetShip()->Active())
+			{
+				ships++;
+			}
+		}
+
+		MessageSize size;
+		size.Name = "ShipData";
+		size.SlotBytes = dataWriter.TotalBytes();
+		size.EntityIdBytes = BytesForBits(dataWriter.TotalBits() + ships * (StringBits(localPlayer->EntityId) - c_peerSlotBits));
+		report.Messages.push_back(size);
+	}
+}
+
+// Players are looked up round robin, the way messages arrive from each of them in turn
+void PeerSlotBenchmark::MeasureLookups(Report& report) const
+{
+	std::vector<std::string> entityIds;
+	std::vector<uint8_t> slots;
+	for (const auto& player : m_players)
+	{
+		entityIds.push_back(player->EntityId);
+		slots.push_back(player->Slot);
+	}
+
+	// Kept so the lookups can't be optimized away
+	uint32_t found = 0;
+
+	Clock::time_point begin = Clock::now();
+	for (uint32_t i = 0; i < m_settings.Lookups; ++i)
+	{
+		if (g_game->GetPlayerState(entityIds[i % entityIds.size()]) != nullptr)
+		{
+			found++;
+		}
+	}
+	report.EntityIdLookupNanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / m_settings.Lookups;
+
+	begin = Clock::now();
+	for (uint32_t i = 0; i < m_settings.Lookups; ++i)
+	{
+		if (g_game->GetPlayerStateBySlot(slots[i % slots.size()]) != nullptr)
+		{
+			found++;
+		}
+	}
+	report.SlotLookupNanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / m_settings.Lookups;
+
+	if (found != 2 * m_settings.Lookups)
+	{
+		report.SlotMismatches++;
+	}
+}
+
+void PeerSlotBenchmark::Report::Log() const
+{
+	DEBUGLOG("Peer slots with %u players, %u slot mismatches\n", Players, SlotMismatches);
+	DEBUGLOG("%-16s %12s %12s\n", "message", "entity ID", "slot");
+	for (const MessageSize& size : Messages)
+	{
+		DEBUGLOG("%-16s %12zu %12zu\n", size.Name, size.EntityIdBytes, size.SlotBytes);
+	}
+	DEBUGLOG("lookup: entity ID %.1f ns, slot %.1f ns\n", EntityIdLookupNanoseconds, SlotLookupNanoseconds);
+}
@@ -0,0 +1,61 @@
+//--------------------------------------------------------------------------------------
+// PeerSlotBenchmark.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+namespace NetRumble
+{
+	// Sets up a match of fake players offline, as the host, and compares the messages that
+	// name players with what they cost when every one of them carried an entity ID: bytes
+	// on the wire per message, and the time to find a player by entity ID or by slot.
+	class PeerSlotBenchmark final
+	{
+	public:
+		struct Settings
+		{
+			uint32_t Players = MaxPeerSlots;
+			uint32_t Lookups = 1000000;
+			uint32_t Seed = 1;
+		};
+
+		struct MessageSize
+		{
+			const char* Name = "";
+			size_t EntityIdBytes = 0;
+			size_t SlotBytes = 0;
+		};
+
+		struct Report
+		{
+			uint32_t Players = 0;
+			std::vector<MessageSize> Messages;
+
+			// Mean cost of one lookup, in nanoseconds
+			double EntityIdLookupNanoseconds = 0.0;
+			double SlotLookupNanoseconds = 0.0;
+
+			// Players whose slot didn't lead back to them
+			uint32_t SlotMismatches = 0;
+
+			void Log() const;
+		};
+
+		explicit PeerSlotBenchmark(const Settings& settings);
+
+		PeerSlotBenchmark(PeerSlotBenchmark const&) = delete;
+		PeerSlotBenchmark& operator= (PeerSlotBenchmark const&) = delete;
+
+		Report Run();
+
+	private:
+		void AddPlayers();
+		void MeasureMessages(Report& report) const;
+		void MeasureLookups(Report& report) const;
+
+		Settings m_settings;
+		std::vector<std::shared_ptr<PlayerState>> m_players;
+	};
+}
@@ -97,7 +97,7 @@ bool PlayFabMatchmaking::CreateMatchmakingTicket()
 	{
 		g_game->WriteDebugLogMessage("Failed to create matchmaking ticket: 0x%08X %s\n", static_cast<unsigned int>(hr), GetPlayFabErrorMessage(hr));
 		auto onlineManager = Managers::Get<OnlineManager>();
-		onlineManager->m_messageHandler(onlineManager->GetLocalEntityId(), &MatchmakingFailed);
+		onlineManager->m_messageHandler(onlineManager->GetLocalEntityId(), MatchmakingFailed);
 		return false;
 	}
 
@@ -164,7 +164,7 @@ void PlayFabMatchmaking::OnTicketStatusChanged(const PFMatchmakingStateChange* c
 			if (FAILED(hr))
 			{
 				DEBUGLOG("Failed to get match details from ticket: 0x%08X %s\n", static_cast<unsigned int>(hr), GetPlayFabErrorMessage(hr));
-				Managers::Get<OnlineManager>()->m_messageHandler(Managers::Get<OnlineManager>()->GetLocalEntityId(), &MatchmakingFailed);
+				Managers::Get<OnlineManager>()->m_messageHandler(Managers::Get<OnlineManager>()->GetLocalEntityId(), MatchmakingFailed);
 				return;
 			}
 		}
@@ -200,7 +200,7 @@ void PlayFabMatchmaking::OnTicketCompleted(const PFMatchmakingStateChange* chang
 	{
 		// Return the state change(s), bail out if we detected ticket failure.
 		DEBUGLOG("Matchmaking ticket failure detected: 0x%08X %s\n", static_cast<unsigned int>(ticketResult), GetPlayFabErrorMessage(ticketResult));
-		pfMessageHandle(curUserId, &MatchmakingFailed);
+		pfMessageHandle(curUserId, MatchmakingFailed);
 		return;
 	}
 
@@ -208,7 +208,7 @@ void PlayFabMatchmaking::OnTicketCompleted(const PFMatchmakingStateChange* chang
 	if (FAILED(hr))
 	{
 		DEBUGLOG("Failed to get match details from ticket: 0x%08X %s\n", static_cast<unsigned int>(hr), GetPlayFabErrorMessage(hr));
-		pfMessageHandle(curUserId, &MatchmakingFailed);
+		pfMessageHandle(curUserId, MatchmakingFailed);
 		return;
 	}
 }
@@ -83,7 +83,7 @@ void PlayFabOnlineManager::StartMatchmaking()
 	if (m_onlineState != OnlineState::Ready)
 	{
 		DEBUGLOG("Failed to start matchmaking. Multiplayer state is %d, expected %d.\n", m_onlineState, OnlineState::Ready);
-		m_messageHandler(GetLocalEntityId(), &MatchmakingFailed);
+		m_messageHandler(GetLocalEntityId(), MatchmakingFailed);
 		return;
 	}
 
@@ -105,7 +105,7 @@ void PlayFabOnlineManager::CancelMatchmaking()
 
 	m_pfMatchmaking.CancelMatchmaking();
 
-	m_messageHandler(GetLocalEntityId(), &MatchmakingCanceled);
+	m_messageHandler(GetLocalEntityId(), MatchmakingCanceled);
 	m_onlineState = OnlineState::Ready;
 }
 
@@ -127,7 +127,7 @@ void PlayFabOnlineManager::HostMultiplayerGame(PFLobbyAccessPolicy accessPolicy)
 	if (m_onlineState != OnlineState::Ready)
 	{
 		DEBUGLOG("Failed to host multiplayer game, online state is %d, expected %d.\n", m_onlineState, OnlineState::Ready);
-		m_messageHandler(GetLocalEntityId(), &JoinGameFailed);
+		m_messageHandler(GetLocalEntityId(), JoinGameFailed);
 		return;
 	}
 
@@ -151,7 +151,7 @@ void PlayFabOnlineManager::JoinMultiplayerGame(const std::string& connectionStri
 	if (m_onlineState != OnlineState::Joining)
 	{
 		LeaveMultiplayerGame();
-		m_messageHandler(GetLocalEntityId(), &JoinGameFailed);
+		m_messageHandler(GetLocalEntityId(), JoinGameFailed);
 		return;
 	}
 
@@ -227,7 +227,7 @@ void PlayFabOnlineManager::OnPFPartyNetworkCreated(const std::string& descriptor
 	// We're now ready to be in the game lobby
 	Managers::Get<OnlineManager>()->m_playfabParty.SetHost(true);
 	m_onlineState = OnlineState::InGame;
-	m_messageHandler(GetLocalEntityId(), &JoinGameCompleted);
+	m_messageHandler(GetLocalEntityId(), JoinGameCompleted);
 }
 
 void PlayFabOnlineManager::MigrateToNewNetwork()
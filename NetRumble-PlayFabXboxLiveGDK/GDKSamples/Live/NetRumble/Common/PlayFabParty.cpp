@@ -169,6 +169,9 @@ void PlayFabParty::Initialize()
 		}
 
 		m_partyInitialized = true;
+		m_lastPump = NetworkThread::Clock::now();
+		m_applyLatency.Reset();
+
 		CreateLocalUser();
 	}
 }
@@ -308,6 +311,7 @@ void PlayFabParty::Shutdown()
 	m_network = nullptr;
 	m_localUser = nullptr;
 	m_partyInitialized = false;
+	m_bundler.Clear();
 }
 
 PartyInvitationConfiguration PlayFabParty::GetPartyInvitationConfiguration(const char* networkId)
@@ -459,28 +463,23 @@ bool PlayFabParty::InternalConnectToNetwork(const char* networkId, PartyNetworkD
 	return true;
 }
 
-void PlayFabParty::SendGameMessage(const GameMessage& message)
+void PlayFabParty::SendGameMessage(const GameMessageView& message)
 {
 	if (m_localEndpoint)
 	{
-		std::vector<uint8_t> packet = message.Serialize();
-
-		// Form the data packet into a data buffer structure
-		PartyDataBuffer data[] = {
-			{
-				static_cast<const void*>(packet.data()),
-				static_cast<uint32_t>(packet.size())
-			},
-		};
+		// The bundler copies the packet, so one send buffer can be reused for every message
+		message.SerializeTo(m_sendBuffer);
 
 		PartySendMessageOptions deliveryOptions;
 
 		// ShipInput and ShipData messages don't need to be sent reliably
-		// or sequentially, but the rest are needed for gameplay
+		// or sequentially, and world data acks are cumulative, but the rest
+		// are needed for gameplay
 		switch (message.MessageType())
 		{
 		case GameMessageType::ShipInput:
 		case GameMessageType::ShipData:
+		case GameMessageType::WorldDataAck:
 			deliveryOptions = PartySendMessageOptions::Default;
 			break;
 
@@ -489,25 +488,52 @@ void PlayFabParty::SendGameMessage(const GameMessage& message)
 				PartySendMessageOptions::SequentialDelivery;
 		}
 
-		// Send out the message to all other peers
-		PartyError err = m_localEndpoint->SendMessage(
-			0,                                      // endpoint count; 0 = broadcast
-			nullptr,                                // endpoint list
-			deliveryOptions,                        // send message options
-			nullptr,                                // configuration
-			1,                                      // buffer count
-			data,                                   // buffer
-			nullptr                                 // async identifier
-		);
+		// Broadcast, so every message shares destination 0
+		m_bundler.Queue(0, static_cast<int>(deliveryOptions), m_sendBuffer);
+	}
+}
 
-		if (REPORT_PARTY_FAILED(err))
+void PlayFabParty::FlushGameMessages()
+{
+	m_bundler.Flush();
+}
+
+void PlayFabParty::SendBundledMessage(PartySendMessageOptions deliveryOptions, DataBufferView message)
+{
+	if (m_localEndpoint)
+	{
+		SendOnEndpoint(m_localEndpoint, deliveryOptions, message);
+	}
+}
+
+void PlayFabParty::SendOnEndpoint(PartyLocalEndpoint* endpoint, PartySendMessageOptions deliveryOptions, DataBufferView message)
+{
+	// Party copies the data before SendMessage returns
+	PartyDataBuffer data[] = {
 		{
-			g_game->WriteDebugLogMessage("Failed to SendMessage: %hs\n", GetErrorMessage(err));
-		}
+			static_cast<const void*>(message.data()),
+			static_cast<uint32_t>(message.size())
+		},
+	};
+
+	// Send out the message to all other peers
+	PartyError err = endpoint->SendMessage(
+		0,                                      // endpoint count; 0 = broadcast
+		nullptr,                                // endpoint list
+		deliveryOptions,                        // send message options
+		nullptr,                                // configuration
+		1,                                      // buffer count
+		data,                                   // buffer
+		nullptr                                 // async identifier
+	);
+
+	if (REPORT_PARTY_FAILED(err))
+	{
+		DEBUGLOG("Failed to SendMessage: %hs\n", GetErrorMessage(err));
 	}
 }
 
-void PlayFabParty::SetGameMessageHandler(std::function<void(std::string, std::shared_ptr<GameMessage>)> callback)
+void PlayFabParty::SetGameMessageHandler(std::function<void(std::string, const GameMessageView&)> callback)
 {
 	m_onMessageReceived = callback;
 }
@@ -741,66 +767,7 @@ void PlayFabParty::DoWork()
 		const PartyStateChange* change = changes[i];
 		if (change)
 		{
-			switch (change->stateChangeType)
-			{
-			case PartyStateChangeType::RegionsChanged: OnRegionsChanged(change); break;
-			case PartyStateChangeType::DestroyLocalUserCompleted: OnDestroyLocalUserCompleted(change); break;
-			case PartyStateChangeType::CreateNewNetworkCompleted: OnCreateNewNetworkCompleted(change); break;
-			case PartyStateChangeType::ConnectToNetworkCompleted: OnConnectToNetworkCompleted(change); break;
-			case PartyStateChangeType::AuthenticateLocalUserCompleted: OnAuthenticateLocalUserCompleted(change); break;
-			case PartyStateChangeType::NetworkConfigurationMadeAvailable: OnNetworkConfigurationMadeAvailable(change); break;
-			case PartyStateChangeType::NetworkDescriptorChanged: OnNetworkDescriptorChanged(change); break;
-			case PartyStateChangeType::LocalUserRemoved: OnLocalUserRemoved(change); break;
-			case PartyStateChangeType::RemoveLocalUserCompleted: OnRemoveLocalUserCompleted(change); break;
-			case PartyStateChangeType::LocalUserKicked: OnLocalUserKicked(change); break;
-			case PartyStateChangeType::CreateEndpointCompleted: OnCreateEndpointCompleted(change); break;
-			case PartyStateChangeType::DestroyEndpointCompleted: OnDestroyEndpointCompleted(change); break;
-			case PartyStateChangeType::EndpointCreated: OnEndpointCreated(change); break;
-			case PartyStateChangeType::EndpointDestroyed: OnEndpointDestroyed(change); break;
-			case PartyStateChangeType::RemoteDeviceCreated: OnRemoteDeviceCreated(change); break;
-			case PartyStateChangeType::RemoteDeviceDestroyed: OnRemoteDeviceDestroyed(change); break;
-			case PartyStateChangeType::RemoteDeviceJoinedNetwork: OnRemoteDeviceJoinedNetwork(change); break;
-			case PartyStateChangeType::RemoteDeviceLeftNetwork: OnRemoteDeviceLeftNetwork(change); break;
-			case PartyStateChangeType::DevicePropertiesChanged: OnDevicePropertiesChanged(change); break;
-			case PartyStateChangeType::LeaveNetworkCompleted: OnLeaveNetworkCompleted(change); break;
-			case PartyStateChangeType::NetworkDestroyed: OnNetworkDestroyed(change); break;
-			case PartyStateChangeType::EndpointMessageReceived: OnEndpointMessageReceived(change); break;
-			case PartyStateChangeType::DataBuffersReturned: OnDataBuffersReturned(change); break;
-			case PartyStateChangeType::EndpointPropertiesChanged: OnEndpointPropertiesChanged(change); break;
-			case PartyStateChangeType::SynchronizeMessagesBetweenEndpointsCompleted: OnSynchronizeMessagesBetweenEndpointsCompleted(change); break;
-			case PartyStateChangeType::CreateInvitationCompleted: OnCreateInvitationCompleted(change); break;
-			case PartyStateChangeType::RevokeInvitationCompleted: OnRevokeInvitationCompleted(change); break;
-			case PartyStateChangeType::InvitationCreated: OnInvitationCreated(change); break;
-			case PartyStateChangeType::InvitationDestroyed: OnInvitationDestroyed(change); break;
-			case PartyStateChangeType::NetworkPropertiesChanged: OnNetworkPropertiesChanged(change); break;
-			case PartyStateChangeType::KickDeviceCompleted: OnKickDeviceCompleted(change); break;
-			case PartyStateChangeType::KickUserCompleted: OnKickUserCompleted(change); break;
-			case PartyStateChangeType::CreateChatControlCompleted: OnCreateChatControlCompleted(change); break;
-			case PartyStateChangeType::DestroyChatControlCompleted: OnDestroyChatControlCompleted(change); break;
-			case PartyStateChangeType::ChatControlCreated: OnChatControlCreated(change); break;
-			case PartyStateChangeType::ChatControlDestroyed: OnChatControlDestroyed(change); break;
-			case PartyStateChangeType::SetChatAudioEncoderBitrateCompleted: OnSetChatAudioEncoderBitrateCompleted(change); break;
-			case PartyStateChangeType::ChatTextReceived: OnChatTextReceived(change); break;
-			case PartyStateChangeType::VoiceChatTranscriptionReceived: OnVoiceChatTranscriptionReceived(change); break;
-			case PartyStateChangeType::SetChatAudioInputCompleted: OnSetChatAudioInputCompleted(change); break;
-			case PartyStateChangeType::SetChatAudioOutputCompleted: OnSetChatAudioOutputCompleted(change); break;
-			case PartyStateChangeType::LocalChatAudioInputChanged: OnLocalChatAudioInputChanged(change); break;
-			case PartyStateChangeType::LocalChatAudioOutputChanged: OnLocalChatAudioOutputChanged(change); break;
-			case PartyStateChangeType::SetTextToSpeechProfileCompleted: OnSetTextToSpeechProfileCompleted(change); break;
-			case PartyStateChangeType::SynthesizeTextToSpeechCompleted: OnSynthesizeTextToSpeechCompleted(change); break;
-			case PartyStateChangeType::SetLanguageCompleted: OnSetLanguageCompleted(change); break;
-			case PartyStateChangeType::SetTranscriptionOptionsCompleted: OnSetTranscriptionOptionsCompleted(change); break;
-			case PartyStateChangeType::SetTextChatOptionsCompleted: OnSetTextChatOptionsCompleted(change); break;
-			case PartyStateChangeType::ChatControlPropertiesChanged: OnChatControlPropertiesChanged(change); break;
-			case PartyStateChangeType::ChatControlJoinedNetwork: OnChatControlJoinedNetwork(change); break;
-			case PartyStateChangeType::ChatControlLeftNetwork: OnChatControlLeftNetwork(change); break;
-			case PartyStateChangeType::ConnectChatControlCompleted: OnConnectChatControlCompleted(change); break;
-			case PartyStateChangeType::DisconnectChatControlCompleted: OnDisconnectChatControlCompleted(change); break;
-			case PartyStateChangeType::PopulateAvailableTextToSpeechProfilesCompleted: OnPopulateAvailableTextToSpeechProfilesCompleted(change); break;
-			case PartyStateChangeType::ConfigureAudioManipulationVoiceStreamCompleted: OnConfigureAudioManipulationVoiceStreamCompleted(change); break;
-			case PartyStateChangeType::ConfigureAudioManipulationCaptureStreamCompleted: OnConfigureAudioManipulationCaptureStreamCompleted(change); break;
-			case PartyStateChangeType::ConfigureAudioManipulationRenderStreamCompleted: OnConfigureAudioManipulationRenderStreamCompleted(change); break;
-			}
+			DispatchStateChange(change);
 		}
 	}
 
@@ -811,6 +778,72 @@ void PlayFabParty::DoWork()
 	{
 		DEBUGLOG("FinishProcessingStateChanges failed: %hs\n", GetErrorMessage(err));
 	}
+
+	m_lastPump = NetworkThread::Clock::now();
+}
+
+void PlayFabParty::DispatchStateChange(const PartyStateChange* change)
+{
+	switch (change->stateChangeType)
+	{
+	case PartyStateChangeType::RegionsChanged: OnRegionsChanged(change); break;
+	case PartyStateChangeType::DestroyLocalUserCompleted: OnDestroyLocalUserCompleted(change); break;
+	case PartyStateChangeType::CreateNewNetworkCompleted: OnCreateNewNetworkCompleted(change); break;
+	case PartyStateChangeType::ConnectToNetworkCompleted: OnConnectToNetworkCompleted(change); break;
+	case PartyStateChangeType::AuthenticateLocalUserCompleted: OnAuthenticateLocalUserCompleted(change); break;
+	case PartyStateChangeType::NetworkConfigurationMadeAvailable: OnNetworkConfigurationMadeAvailable(change); break;
+	case PartyStateChangeType::NetworkDescriptorChanged: OnNetworkDescriptorChanged(change); break;
+	case PartyStateChangeType::LocalUserRemoved: OnLocalUserRemoved(change); break;
+	case PartyStateChangeType::RemoveLocalUserCompleted: OnRemoveLocalUserCompleted(change); break;
+	case PartyStateChangeType::LocalUserKicked: OnLocalUserKicked(change); break;
+	case PartyStateChangeType::CreateEndpointCompleted: OnCreateEndpointCompleted(change); break;
+	case PartyStateChangeType::DestroyEndpointCompleted: OnDestroyEndpointCompleted(change); break;
+	case PartyStateChangeType::EndpointCreated: OnEndpointCreated(change); break;
+	case PartyStateChangeType::EndpointDestroyed: OnEndpointDestroyed(change); break;
+	case PartyStateChangeType::RemoteDeviceCreated: OnRemoteDeviceCreated(change); break;
+	case PartyStateChangeType::RemoteDeviceDestroyed: OnRemoteDeviceDestroyed(change); break;
+	case PartyStateChangeType::RemoteDeviceJoinedNetwork: OnRemoteDeviceJoinedNetwork(change); break;
+	case PartyStateChangeType::RemoteDeviceLeftNetwork: OnRemoteDeviceLeftNetwork(change); break;
+	case PartyStateChangeType::DevicePropertiesChanged: OnDevicePropertiesChanged(change); break;
+	case PartyStateChangeType::LeaveNetworkCompleted: OnLeaveNetworkCompleted(change); break;
+	case PartyStateChangeType::NetworkDestroyed: OnNetworkDestroyed(change); break;
+	case PartyStateChangeType::EndpointMessageReceived: OnEndpointMessageReceived(change); break;
+	case PartyStateChangeType::DataBuffersReturned: OnDataBuffersReturned(change); break;
+	case PartyStateChangeType::EndpointPropertiesChanged: OnEndpointPropertiesChanged(change); break;
+	case PartyStateChangeType::SynchronizeMessagesBetweenEndpointsCompleted: OnSynchronizeMessagesBetweenEndpointsCompleted(change); break;
+	case PartyStateChangeType::CreateInvitationCompleted: OnCreateInvitationCompleted(change); break;
+	case PartyStateChangeType::RevokeInvitationCompleted: OnRevokeInvitationCompleted(change); break;
+	case PartyStateChangeType::InvitationCreated: OnInvitationCreated(change); break;
+	case PartyStateChangeType::InvitationDestroyed: OnInvitationDestroyed(change); break;
+	case PartyStateChangeType::NetworkPropertiesChanged: OnNetworkPropertiesChanged(change); break;
+	case PartyStateChangeType::KickDeviceCompleted: OnKickDeviceCompleted(change); break;
+	case PartyStateChangeType::KickUserCompleted: OnKickUserCompleted(change); break;
+	case PartyStateChangeType::CreateChatControlCompleted: OnCreateChatControlCompleted(change); break;
+	case PartyStateChangeType::DestroyChatControlCompleted: OnDestroyChatControlCompleted(change); break;
+	case PartyStateChangeType::ChatControlCreated: OnChatControlCreated(change); break;
+	case PartyStateChangeType::ChatControlDestroyed: OnChatControlDestroyed(change); break;
+	case PartyStateChangeType::SetChatAudioEncoderBitrateCompleted: OnSetChatAudioEncoderBitrateCompleted(change); break;
+	case PartyStateChangeType::ChatTextReceived: OnChatTextReceived(change); break;
+	case PartyStateChangeType::VoiceChatTranscriptionReceived: OnVoiceChatTranscriptionReceived(change); break;
+	case PartyStateChangeType::SetChatAudioInputCompleted: OnSetChatAudioInputCompleted(change); break;
+	case PartyStateChangeType::SetChatAudioOutputCompleted: OnSetChatAudioOutputCompleted(change); break;
+	case PartyStateChangeType::LocalChatAudioInputChanged: OnLocalChatAudioInputChanged(change); break;
+	case PartyStateChangeType::LocalChatAudioOutputChanged: OnLocalChatAudioOutputChanged(change); break;
+	case PartyStateChangeType::SetTextToSpeechProfileCompleted: OnSetTextToSpeechProfileCompleted(change); break;
+	case PartyStateChangeType::SynthesizeTextToSpeechCompleted: OnSynthesizeTextToSpeechCompleted(change); break;
+	case PartyStateChangeType::SetLanguageCompleted: OnSetLanguageCompleted(change); break;
+	case PartyStateChangeType::SetTranscriptionOptionsCompleted: OnSetTranscriptionOptionsCompleted(change); break;
+	case PartyStateChangeType::SetTextChatOptionsCompleted: OnSetTextChatOptionsCompleted(change); break;
+	case PartyStateChangeType::ChatControlPropertiesChanged: OnChatControlPropertiesChanged(change); break;
+	case PartyStateChangeType::ChatControlJoinedNetwork: OnChatControlJoinedNetwork(change); break;
+	case PartyStateChangeType::ChatControlLeftNetwork: OnChatControlLeftNetwork(change); break;
+	case PartyStateChangeType::ConnectChatControlCompleted: OnConnectChatControlCompleted(change); break;
+	case PartyStateChangeType::DisconnectChatControlCompleted: OnDisconnectChatControlCompleted(change); break;
+	case PartyStateChangeType::PopulateAvailableTextToSpeechProfilesCompleted: OnPopulateAvailableTextToSpeechProfilesCompleted(change); break;
+	case PartyStateChangeType::ConfigureAudioManipulationVoiceStreamCompleted: OnConfigureAudioManipulationVoiceStreamCompleted(change); break;
+	case PartyStateChangeType::ConfigureAudioManipulationCaptureStreamCompleted: OnConfigureAudioManipulationCaptureStreamCompleted(change); break;
+	case PartyStateChangeType::ConfigureAudioManipulationRenderStreamCompleted: OnConfigureAudioManipulationRenderStreamCompleted(change); break;
+	}
 }
 
 void PlayFabParty::PopulatePartyRegionLatencies(bool send)
@@ -1258,32 +1291,45 @@ void PlayFabParty::OnEndpointMessageReceived(const PartyStateChange* change)
 	const PartyEndpointMessageReceivedStateChange* result = static_cast<const PartyEndpointMessageReceivedStateChange*>(change);
 	if (result)
 	{
-		const uint8_t* buffer = static_cast<const uint8_t*>(result->messageBuffer);
-		std::shared_ptr<GameMessage> packet = std::make_shared<GameMessage>(
-			std::vector<uint8_t>(buffer, buffer + result->messageSize)
-			);
+		m_applyLatency.Record(std::chrono::duration<float, std::milli>(NetworkThread::Clock::now() - m_lastPump).count());
 
 		PartyString sender = nullptr;
 		PartyError err = result->senderEndpoint->GetEntityId(&sender);
 
 		if (PARTY_SUCCEEDED(err))
 		{
-			// Give the message to the game engine
-			if (m_onMessageReceived)
+			// Read the message straight out of Party's buffer, which stays valid until the state change is returned
+			ApplyGameMessage(sender, DataBufferView(static_cast<const uint8_t*>(result->messageBuffer), result->messageSize));
+		}
+		else
+		{
+			DEBUGLOG("GetEntityId failed: %hs\n", GetErrorMessage(err));
+		}
+	}
+}
+
+// One message from a peer: a bundle of packets, or a single packet
+void PlayFabParty::ApplyGameMessage(const char* sender, DataBufferView message)
+{
+	// Give each message in the bundle to the game engine, in the order it was sent
+	if (m_onMessageReceived)
+	{
+		const bool wellFormed = MessageBundler::ForEachPacket(message, [&](DataBufferView bytes)
 			{
+				GameMessageView packet = GameMessageView::FromPacket(bytes);
 				if (sender != nullptr)
 				{
 					m_onMessageReceived(sender, packet);
 				}
 				else
 				{
-					DEBUGLOG("Message '%s' received from entityid %s but we don't know their xuid yet.\n", MessageTypeString(packet->MessageType()), sender);
+					DEBUGLOG("Message '%s' received from entityid %s but we don't know their xuid yet.\n", MessageTypeString(packet.MessageType()), sender);
 				}
-			}
-		}
-		else
+			});
+
+		if (!wellFormed)
 		{
-			DEBUGLOG("GetEntityId failed: %hs\n", GetErrorMessage(err));
+			DEBUGLOG("Dropped the rest of a malformed message bundle from entityid %s\n", sender);
 		}
 	}
 }
@@ -0,0 +1,52 @@
+//--------------------------------------------------------------------------------------
+// PlayerRoster.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "ArrayView.h"
+
+namespace NetRumble
+{
+	class PlayerState;
+
+	// The players of a match as one array of plain pointers, rebuilt from the game's peer
+	// map only when a player joins or leaves. Per-frame code walks Players() without
+	// allocating or touching a reference count. The map's shared_ptrs keep every player
+	// alive, so a pointer from here is good until the next Rebuild and no longer.
+	class PlayerRoster final
+	{
+	public:
+		using View = NetRunbleTools::ArrayView<PlayerState* const>;
+
+		// Empty entries in the map are left out; the local player is the first one marked so
+		template<typename PeerMap>
+		void Rebuild(const PeerMap& peers)
+		{
+			// Keeps its capacity, so only a roster bigger than any before allocates
+			m_players.clear();
+			m_localPlayer = nullptr;
+
+			for (const auto& [id, player] : peers)
+			{
+				if (player)
+				{
+					m_players.push_back(player.get());
+					if (m_localPlayer == nullptr && player->IsLocalPlayer)
+					{
+						m_localPlayer = player;
+					}
+				}
+			}
+		}
+
+		inline View Players() const { return View(m_players.data(), m_players.size()); }
+		inline const std::shared_ptr<PlayerState>& LocalPlayer() const { return m_localPlayer; }
+
+	private:
+		std::vector<PlayerState*> m_players;
+		std::shared_ptr<PlayerState> m_localPlayer;
+	};
+}
@@ -9,18 +9,11 @@
 namespace NetRumble
 {
 	const int MaxUserNameLength = 32;
-	const int MaxEntityIdLength = 256;
 
-	struct PlayerStateData
-	{
-		bool inGame;
-		bool inLobby;
-		bool lobbyReady;
-		byte shipColorIndex;
-		byte shipVariation;
-		char displayName[MaxUserNameLength];
-		char entityId[MaxEntityIdLength];
-	};
+	// Players are named on the wire by a slot the host hands out when they join, see
+	// Game::UpdatePeerSlots; a lobby never has more members than there are slots
+	const uint8_t MaxPeerSlots = 32;
+	const uint8_t NoPeerSlot = 0xFF;
 
 	class PlayerState final
 	{
@@ -32,7 +25,8 @@ namespace NetRumble
 		void EnterLobby();
 		void ReactivatePlayer();
 
-		void DeserializePlayerStateData(const std::vector<uint8_t>& data);
+		// The sender's entity ID is not part of the data; the transport already names the sender
+		void DeserializePlayerStateData(DataBufferView data);
 		std::vector<uint8_t> SerializePlayerStateData() const;
 
 		void SetRegionLatency(std::string_view region, uint64_t latency);
@@ -46,6 +40,11 @@ namespace NetRumble
 		bool LobbyReady;
 		uint64_t PeerId;
 		std::string EntityId;
+		uint8_t Slot = NoPeerSlot;
+
+		// Host-side bookkeeping for delta-compressed world snapshots
+		uint32_t LastAckedWorldData = 0;
+		BandwidthMeter WorldDataBandwidth;
 
 		byte ShipColor() const { return m_shipColor; }
 		void ShipColor(byte colorIndex)
@@ -77,7 +76,7 @@ namespace NetRumble
 
 		bool IsInactive() const { return m_isInactive; }
 
-		std::shared_ptr<Ship> GetShip() const { return m_playerShip; }
+		const std::shared_ptr<Ship>& GetShip() const { return m_playerShip; }
 
 	private:
 		std::shared_ptr<Ship> m_playerShip;
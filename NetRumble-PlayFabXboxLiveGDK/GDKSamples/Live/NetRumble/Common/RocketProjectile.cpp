@@ -10,26 +10,31 @@
 using namespace NetRumble;
 using namespace DirectX;
 
-RocketProjectile::RocketProjectile(Ship* owner, DirectX::SimpleMath::Vector2 direction) :
-	Projectile(owner, direction)
+RocketProjectile::RocketProjectile(Ship* owner) :
+	Projectile(owner)
 {
-	// Set the gameplay data
-	Velocity *= c_initialSpeed;
-
 	// Set the collision data
 	Radius = 8.0f;
 	Mass = 10.0f;
 
 	// Set the projectile data
-	m_duration = 4.0f;
 	m_damageAmount = 150.0f;
 	m_damageRadius = 128.0f;
 	m_damageOwner = false;
-	Rotation += DirectX::XM_PI;
 
 	m_rocketTexture = Managers::Get<ContentManager>()->LoadTexture(L"Assets\\Textures\\rocket.png");
 }
 
+void RocketProjectile::Launch(DirectX::SimpleMath::Vector2 direction)
+{
+	Projectile::Launch(direction);
+
+	// Set the gameplay data
+	Velocity *= c_initialSpeed;
+	m_duration = 4.0f;
+	Rotation += DirectX::XM_PI;
+}
+
 void RocketProjectile::Initialize()
 {
 	if (!Active())
@@ -67,10 +72,13 @@ void RocketProjectile::Die(GameplayObject* source, bool cleanupOnly)
 			Managers::Get<ParticleEffectManager>()->SpawnEffect(ParticleEffectType::RocketExplosion, Position);
 		}
 
-		// Stop the rocket trail effect
+		// Stop the rocket trail effect and let it finish where the rocket died. The trail
+		// following this rocket would keep it out of the pool until its particles expire.
 		if (m_rocketTrailEffect != nullptr)
 		{
 			m_rocketTrailEffect->Stop(false);
+			m_rocketTrailEffect->FollowObject = nullptr;
+			m_rocketTrailEffect = nullptr;
 		}
 	}
 
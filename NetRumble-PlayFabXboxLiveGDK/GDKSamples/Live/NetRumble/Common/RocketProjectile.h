@@ -15,8 +15,9 @@ namespace NetRumble
 	class RocketProjectile final : public Projectile
 	{
 	public:
-		RocketProjectile(Ship* owner, DirectX::SimpleMath::Vector2 direction);
+		explicit RocketProjectile(Ship* owner);
 
+		virtual void Launch(DirectX::SimpleMath::Vector2 direction) override;
 		void Initialize();
 		virtual void Draw(float elapsedTime, RenderContext* renderContext) override;
 		virtual void Die(GameplayObject* source, bool cleanupOnly) override;
@@ -28,8 +28,9 @@ RocketWeapon::RocketWeapon(Ship* owner) : Weapon(owner)
 
 void RocketWeapon::CreateProjectiles(const DirectX::SimpleMath::Vector2& direction)
 {
-	// Create the new projectile
-	std::shared_ptr<RocketProjectile> projectile = std::make_shared<RocketProjectile>(m_owner, direction);
+	// Launch the new projectile
+	std::shared_ptr<RocketProjectile> projectile = m_owner->RocketProjectiles.Acquire(m_owner);
+	projectile->Launch(direction);
 	projectile->Initialize();
 
 	m_owner->Projectiles.push_back(projectile);
@@ -10,6 +10,12 @@
 using namespace NetRumble;
 using namespace DirectX;
 
+namespace
+{
+	// Stick axes are sent in [-1, 1]; a combined gamepad and keyboard input is clamped
+	constexpr uint32_t c_stickAxisBits = 8;
+}
+
 ShipInput::ShipInput(const GamePad::State& gamePadState) :
 	LeftStick(SimpleMath::Vector2(gamePadState.thumbSticks.leftX, gamePadState.thumbSticks.leftY)),
 	RightStick(SimpleMath::Vector2(gamePadState.thumbSticks.rightX, gamePadState.thumbSticks.rightY)),
@@ -68,25 +74,20 @@ void ShipInput::Add(const ShipInput& moreInput)
 	}
 }
 
-std::vector<uint8_t> ShipInput::Serialize()
+void ShipInput::Serialize(BitBufferWriter& dataWriter) const
 {
-	size_t bufferLen = sizeof(ShipInput);
-	uint8_t* buffer = new uint8_t[bufferLen];
-
-	if (!buffer)
-	{
-		return std::vector<uint8_t>();
-	}
-
-	CopyMemory(buffer, this, bufferLen);
-
-	std::vector<uint8_t> serialized(buffer, buffer + bufferLen);
-
-	delete[] buffer;
-	return serialized;
+	dataWriter.WriteSignedQuantized(LeftStick.x, 1.0f, c_stickAxisBits);
+	dataWriter.WriteSignedQuantized(LeftStick.y, 1.0f, c_stickAxisBits);
+	dataWriter.WriteSignedQuantized(RightStick.x, 1.0f, c_stickAxisBits);
+	dataWriter.WriteSignedQuantized(RightStick.y, 1.0f, c_stickAxisBits);
+	dataWriter.WriteBool(MineFired);
 }
 
-void ShipInput::Deserialize(const std::vector<uint8_t>& data)
+void ShipInput::Deserialize(BitBufferReader& dataReader)
 {
-	CopyMemory(this, data.data(), sizeof(ShipInput));
+	LeftStick.x = dataReader.ReadSignedQuantized(1.0f, c_stickAxisBits);
+	LeftStick.y = dataReader.ReadSignedQuantized(1.0f, c_stickAxisBits);
+	RightStick.x = dataReader.ReadSignedQuantized(1.0f, c_stickAxisBits);
+	RightStick.y = dataReader.ReadSignedQuantized(1.0f, c_stickAxisBits);
+	MineFired = dataReader.ReadBool();
 }
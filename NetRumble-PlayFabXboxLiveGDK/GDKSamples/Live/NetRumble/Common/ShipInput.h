@@ -10,6 +10,8 @@
 #include <Keyboard.h>
 #include <DirectXMath.h>
 
+#include "BitBuffer.h"
+
 namespace NetRumble
 {
 	class ShipInput final
@@ -20,11 +22,11 @@ namespace NetRumble
 
 		void Add(const ShipInput& moreInput);
 
-		// Prepare the ship input data for the ShipInput packet
-		std::vector<unsigned char> Serialize();
+		// Prepare the ship input data for the ShipInput packet, with each stick axis packed into a byte
+		void Serialize(BitBufferWriter& dataWriter) const;
 
 		// Get the latest ship input from the ShipInput packet
-		void Deserialize(const std::vector<unsigned char>& data);
+		void Deserialize(BitBufferReader& dataReader);
 
 		DirectX::SimpleMath::Vector2 LeftStick;
 		DirectX::SimpleMath::Vector2 RightStick;
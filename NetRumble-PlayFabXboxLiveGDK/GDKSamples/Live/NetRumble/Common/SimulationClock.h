@@ -0,0 +1,88 @@
+//--------------------------------------------------------------------------------------
+// SimulationClock.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+namespace NetRumble
+{
+	// Steps the world at a fixed rate however often the game renders. Each frame adds its
+	// length, Advance runs as many whole steps as have built up, and what is left over says
+	// how far the frame is into the next step, for drawing between the last two. A frame
+	// that falls far behind runs at most c_maximumStepsPerFrame steps and drops the rest,
+	// so a stall slows the world for a moment rather than making every frame after it
+	// longer still. Time is kept in StepTimer ticks so whole steps add up exactly.
+	class SimulationClock final
+	{
+	public:
+		// StepTimer::TicksPerSecond
+		static constexpr uint64_t c_ticksPerSecond = 10000000;
+		static constexpr uint32_t c_defaultStepsPerSecond = 60;
+		static constexpr uint32_t c_maximumStepsPerFrame = 8;
+
+		explicit SimulationClock(uint32_t stepsPerSecond = c_defaultStepsPerSecond)
+		{
+			SetStepsPerSecond(stepsPerSecond);
+		}
+
+		// Also drops any part-built step
+		void SetStepsPerSecond(uint32_t stepsPerSecond)
+		{
+			m_stepsPerSecond = std::max<uint32_t>(stepsPerSecond, 1);
+			m_ticksPerStep = c_ticksPerSecond / m_stepsPerSecond;
+			m_leftOverTicks = 0;
+		}
+
+		// Calls step() once for every whole step the frame completes, and returns how many
+		template<typename Step>
+		uint32_t Advance(uint64_t frameTicks, Step&& step)
+		{
+			m_leftOverTicks += frameTicks;
+
+			uint32_t steps = 0;
+			while (m_leftOverTicks >= m_ticksPerStep)
+			{
+				if (steps == c_maximumStepsPerFrame)
+				{
+					m_droppedTicks += m_leftOverTicks - m_leftOverTicks % m_ticksPerStep;
+					m_leftOverTicks %= m_ticksPerStep;
+					break;
+				}
+
+				m_leftOverTicks -= m_ticksPerStep;
+				m_totalTicks += m_ticksPerStep;
+				steps++;
+				step();
+			}
+
+			return steps;
+		}
+
+		// After a pause that should not be caught up on
+		inline void ResetLeftOver() { m_leftOverTicks = 0; }
+
+		// How far the frame is from the last step to the next, in [0, 1)
+		inline float GetBlend() const { return static_cast<float>(m_leftOverTicks) / static_cast<float>(m_ticksPerStep); }
+
+		inline uint32_t GetStepsPerSecond() const { return m_stepsPerSecond; }
+		inline uint64_t GetStepTicks() const { return m_ticksPerStep; }
+		inline float GetStepSeconds() const { return static_cast<float>(m_ticksPerStep) / c_ticksPerSecond; }
+
+		// Simulated time so far, which runs behind the frames' by whatever was dropped
+		inline uint64_t GetTotalTicks() const { return m_totalTicks; }
+		inline float GetTotalSeconds() const { return static_cast<float>(static_cast<double>(m_totalTicks) / c_ticksPerSecond); }
+		inline uint64_t GetDroppedTicks() const { return m_droppedTicks; }
+
+	private:
+		uint32_t m_stepsPerSecond = c_defaultStepsPerSecond;
+		uint64_t m_ticksPerStep = c_ticksPerSecond / c_defaultStepsPerSecond;
+		uint64_t m_leftOverTicks = 0;
+		uint64_t m_totalTicks = 0;
+		uint64_t m_droppedTicks = 0;
+	};
+}
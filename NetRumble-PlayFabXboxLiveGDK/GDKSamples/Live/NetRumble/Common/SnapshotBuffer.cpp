@@ -0,0 +1,123 @@
+//--------------------------------------------------------------------------------------
+// SnapshotBuffer.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "SnapshotBuffer.h"
+
+using namespace NetRumble;
+using namespace DirectX;
+
+namespace
+{
+	// A clock this far ahead of the newest snapshot means the host stalled or restarted
+	constexpr float c_hostClockResetLead = 1.0f;
+}
+
+void SnapshotBuffer::Clear()
+{
+	m_first = 0;
+	m_count = 0;
+	m_newestSequence = 0;
+}
+
+bool SnapshotBuffer::Add(const MotionSnapshot& snapshot)
+{
+	if (m_count > 0 && IsSnapshotSequenceRestart(snapshot.Sequence, m_newestSequence))
+	{
+		Clear();
+	}
+
+	if (m_count > 0 && (snapshot.Sequence <= m_newestSequence || snapshot.Time <= At(m_count - 1).Time))
+	{
+		m_discarded++;
+		return false;
+	}
+
+	if (m_count == c_capacity)
+	{
+		m_first = (m_first + 1) % c_capacity;
+		m_count--;
+	}
+
+	m_snapshots[(m_first + m_count) % c_capacity] = snapshot;
+	m_count++;
+	m_newestSequence = snapshot.Sequence;
+	return true;
+}
+
+// Positions follow a cubic Hermite curve through the two snapshots either side, using their
+// velocities as tangents, so a turning ship is drawn on a curve rather than a polygon.
+bool SnapshotBuffer::Sample(float time, float maximumExtrapolation, MotionSnapshot& motion) const
+{
+	if (m_count == 0)
+	{
+		return false;
+	}
+
+	const MotionSnapshot& oldest = At(0);
+	if (time <= oldest.Time)
+	{
+		motion = oldest;
+		return true;
+	}
+
+	const MotionSnapshot& newest = At(m_count - 1);
+	if (time >= newest.Time)
+	{
+		float ahead = std::min(time - newest.Time, maximumExtrapolation);
+		motion = newest;
+		motion.Position += newest.Velocity * ahead;
+		return true;
+	}
+
+	size_t next = 1;
+	while (At(next).Time <= time)
+	{
+		++next;
+	}
+
+	const MotionSnapshot& from = At(next - 1);
+	const MotionSnapshot& to = At(next);
+
+	float span = to.Time - from.Time;
+	float s = (time - from.Time) / span;
+	float s2 = s * s;
+	float s3 = s2 * s;
+
+	motion.Sequence = from.Sequence;
+	motion.Time = time;
+	motion.Position =
+		from.Position * (2.0f * s3 - 3.0f * s2 + 1.0f) +
+		from.Velocity * (span * (s3 - 2.0f * s2 + s)) +
+		to.Position * (-2.0f * s3 + 3.0f * s2) +
+		to.Velocity * (span * (s3 - s2));
+	motion.Velocity = SimpleMath::Vector2::Lerp(from.Velocity, to.Velocity, s);
+	motion.Rotation = from.Rotation + std::remainder(to.Rotation - from.Rotation, XM_2PI) * s;
+	return true;
+}
+
+void HostClock::Reset()
+{
+	m_time = 0.0f;
+	m_valid = false;
+}
+
+void HostClock::Update(float elapsedTime)
+{
+	if (m_valid)
+	{
+		m_time += elapsedTime;
+	}
+}
+
+void HostClock::Observe(float hostTime)
+{
+	if (!m_valid || hostTime > m_time || m_time - hostTime > c_hostClockResetLead)
+	{
+		m_time = hostTime;
+		m_valid = true;
+	}
+}
@@ -0,0 +1,80 @@
+//--------------------------------------------------------------------------------------
+// SnapshotBuffer.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+namespace NetRumble
+{
+	// The host numbers its snapshots from 1 again every game. One this far behind the newest
+	// received is the start of a new game, whose packets trail a late one from the last,
+	// rather than a packet reordered on the way: no link reorders by seconds.
+	constexpr uint32_t c_SnapshotSequenceRestart = 32;
+
+	inline bool IsSnapshotSequenceRestart(uint32_t sequence, uint32_t newestSequence)
+	{
+		return sequence + c_SnapshotSequenceRestart < newestSequence;
+	}
+
+	// One received state of a remote object, stamped with the host's clock.
+	struct MotionSnapshot
+	{
+		uint32_t Sequence = 0;
+		float Time = 0.0f;
+		DirectX::SimpleMath::Vector2 Position;
+		DirectX::SimpleMath::Vector2 Velocity;
+		float Rotation = 0.0f;
+	};
+
+	// The last few states received for one remote object, oldest first. The object is shown
+	// a little in the past so there is usually a snapshot on either side of the time drawn;
+	// when the next one is late or lost the last is dead-reckoned for a while instead.
+	class SnapshotBuffer
+	{
+	public:
+		static constexpr size_t c_capacity = 8;
+
+		void Clear();
+
+		// Returns false, keeping nothing, for a snapshot no newer than the last one added.
+		// Unreliable packets can arrive out of order and must not move the object backwards.
+		// A new game's snapshot starts the buffer over.
+		bool Add(const MotionSnapshot& snapshot);
+
+		// The state at the given host time, or false if there is nothing to show yet
+		bool Sample(float time, float maximumExtrapolation, MotionSnapshot& motion) const;
+
+		inline bool IsEmpty() const { return m_count == 0; }
+		inline uint32_t GetNewestSequence() const { return m_newestSequence; }
+		inline uint32_t GetDiscarded() const { return m_discarded; }
+
+	private:
+		inline const MotionSnapshot& At(size_t index) const { return m_snapshots[(m_first + index) % c_capacity]; }
+
+		std::array<MotionSnapshot, c_capacity> m_snapshots;
+		size_t m_first = 0;
+		size_t m_count = 0;
+		uint32_t m_newestSequence = 0;
+		uint32_t m_discarded = 0;
+	};
+
+	// The receiver's estimate of the host's clock, which snapshots are stamped with. It runs
+	// at the local rate and is pulled forward by any snapshot that shows it has fallen behind,
+	// so it follows the quickest packets rather than the average ones.
+	class HostClock
+	{
+	public:
+		void Reset();
+		void Update(float elapsedTime);
+		void Observe(float hostTime);
+
+		inline bool IsValid() const { return m_valid; }
+		inline float GetTime() const { return m_time; }
+
+	private:
+		float m_time = 0.0f;
+		bool m_valid = false;
+	};
+}
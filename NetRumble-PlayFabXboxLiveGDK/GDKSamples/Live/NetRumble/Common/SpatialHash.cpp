@@ -0,0 +1,100 @@
+//--------------------------------------------------------------------------------------
+// SpatialHash.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "SpatialHash.h"
+
+using namespace NetRumble;
+using namespace DirectX::SimpleMath;
+
+void SpatialHash::Initialize(const RECT& bounds, float cellSize)
+{
+	m_left = static_cast<float>(bounds.left);
+	m_top = static_cast<float>(bounds.top);
+	m_inverseCellSize = 1.0f / cellSize;
+	m_columns = std::max(1, static_cast<int>(std::ceil(static_cast<float>(bounds.right - bounds.left) * m_inverseCellSize)));
+	m_rows = std::max(1, static_cast<int>(std::ceil(static_cast<float>(bounds.bottom - bounds.top) * m_inverseCellSize)));
+
+	m_cells.clear();
+	m_cells.resize(static_cast<size_t>(m_columns * m_rows));
+	m_itemCells.clear();
+	m_maxRadius = 0.0f;
+}
+
+void SpatialHash::Clear()
+{
+	// Keep the per-cell capacity around so steady-state rebuilds don't allocate
+	for (auto& cell : m_cells)
+	{
+		cell.clear();
+	}
+	m_itemCells.clear();
+	m_maxRadius = 0.0f;
+}
+
+void SpatialHash::Insert(uint32_t index, const Vector2& position, float radius)
+{
+	if (m_cells.empty())
+	{
+		return;
+	}
+
+	if (index >= m_itemCells.size())
+	{
+		m_itemCells.resize(index + 1, UINT32_MAX);
+	}
+
+	uint32_t cell = CellIndex(position);
+	m_cells[cell].push_back(index);
+	m_itemCells[index] = cell;
+	m_maxRadius = std::max(m_maxRadius, radius);
+}
+
+void SpatialHash::Move(uint32_t index, const Vector2& position, float radius)
+{
+	if (index >= m_itemCells.size() || m_itemCells[index] == UINT32_MAX)
+	{
+		Insert(index, position, radius);
+		return;
+	}
+
+	m_maxRadius = std::max(m_maxRadius, radius);
+
+	uint32_t oldCell = m_itemCells[index];
+	uint32_t newCell = CellIndex(position);
+	if (oldCell == newCell)
+	{
+		return;
+	}
+
+	auto& bucket = m_cells[oldCell];
+	auto itr = std::find(bucket.begin(), bucket.end(), index);
+	if (itr != bucket.end())
+	{
+		*itr = bucket.back();
+		bucket.pop_back();
+	}
+
+	m_cells[newCell].push_back(index);
+	m_itemCells[index] = newCell;
+}
+
+int SpatialHash::CellX(float x) const
+{
+	int cell = static_cast<int>(std::floor((x - m_left) * m_inverseCellSize));
+	return std::clamp(cell, 0, m_columns - 1);
+}
+
+int SpatialHash::CellY(float y) const
+{
+	int cell = static_cast<int>(std::floor((y - m_top) * m_inverseCellSize));
+	return std::clamp(cell, 0, m_rows - 1);
+}
+
+uint32_t SpatialHash::CellIndex(const Vector2& position) const
+{
+	return static_cast<uint32_t>(CellY(position.y) * m_columns + CellX(position.x));
+}
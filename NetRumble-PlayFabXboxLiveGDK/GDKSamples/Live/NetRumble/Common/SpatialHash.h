@@ -0,0 +1,72 @@
+//--------------------------------------------------------------------------------------
+// SpatialHash.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+namespace NetRumble
+{
+	/// <summary>
+	/// Uniform-grid broadphase over a fixed rectangle. Items are identified by a dense
+	/// index supplied by the owner and bucketed by the cell containing their center;
+	/// queries are widened by the largest radius seen so that no overlap is missed.
+	/// Positions outside the bounds are clamped into the border cells.
+	/// </summary>
+	class SpatialHash
+	{
+	public:
+		void Initialize(const RECT& bounds, float cellSize);
+		void Clear();
+		void Insert(uint32_t index, const DirectX::SimpleMath::Vector2& position, float radius);
+		void Move(uint32_t index, const DirectX::SimpleMath::Vector2& position, float radius);
+
+		bool IsInitialized() const { return !m_cells.empty(); }
+
+		// Invokes func(index) for every item whose cell may hold a circle touching the
+		// query circle. The callback returns false to stop the query early.
+		template<typename Func>
+		void Query(const DirectX::SimpleMath::Vector2& center, float radius, Func&& func) const
+		{
+			if (m_cells.empty())
+			{
+				return;
+			}
+
+			float reach = radius + m_maxRadius;
+			int minX = CellX(center.x - reach);
+			int maxX = CellX(center.x + reach);
+			int minY = CellY(center.y - reach);
+			int maxY = CellY(center.y + reach);
+
+			for (int y = minY; y <= maxY; y++)
+			{
+				for (int x = minX; x <= maxX; x++)
+				{
+					for (uint32_t index : m_cells[static_cast<size_t>(y * m_columns + x)])
+					{
+						if (!func(index))
+						{
+							return;
+						}
+					}
+				}
+			}
+		}
+
+	private:
+		int CellX(float x) const;
+		int CellY(float y) const;
+		uint32_t CellIndex(const DirectX::SimpleMath::Vector2& position) const;
+
+		std::vector<std::vector<uint32_t>> m_cells;
+		std::vector<uint32_t> m_itemCells;
+		float m_left = 0.0f;
+		float m_top = 0.0f;
+		float m_inverseCellSize = 1.0f;
+		int m_columns = 0;
+		int m_rows = 0;
+		float m_maxRadius = 0.0f;
+	};
+}
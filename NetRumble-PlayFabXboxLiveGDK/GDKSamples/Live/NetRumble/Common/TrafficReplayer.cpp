@@ -0,0 +1,145 @@
+//--------------------------------------------------------------------------------------
+// TrafficReplayer.cpp
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#include "pch.h"
+#include "TrafficReplayer.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace NetRumble;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	void AddSample(TrafficReplayer::MessageCost& cost, size_t bytes, Clock::duration elapsed)
+	{
+		const double microseconds = std::chrono::duration<double, std::micro>(elapsed).count();
+
+		cost.Count++;
+		cost.Bytes += bytes;
+		cost.TotalMicroseconds += microseconds;
+		cost.MaxMicroseconds = std::max(cost.MaxMicroseconds, microseconds);
+	}
+
+	void LogCost(const char* name, const TrafficReplayer::MessageCost& cost)
+	{
+		DEBUGLOG("%-36s %8llu %10llu %10.2f %10.2f\n",
+			name,
+			cost.Count,
+			cost.Bytes,
+			cost.Count > 0 ? cost.TotalMicroseconds / cost.Count : 0.0,
+			cost.MaxMicroseconds);
+	}
+}
+
+TrafficReplayer::TrafficReplayer(const std::wstring& path) :
+	m_capture(path)
+{
+}
+
+TrafficReplayer::Report TrafficReplayer::Run(bool realtime)
+{
+	Report report;
+
+	PlayFabOnlineManager* onlineManager = Managers::Get<OnlineManager>();
+	onlineManager->BeginReplay();
+
+	m_capture.Rewind();
+	const Clock::time_point start = Clock::now();
+
+	TrafficCapture::Frame frame = {};
+	while (m_capture.Next(frame))
+	{
+		if (realtime)
+		{
+			std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(frame.Time)));
+		}
+
+		switch (frame.Kind)
+		{
+		case CaptureFrameKind::Session:
+			BeginSession(frame.EntityId, frame.IsHost);
+			break;
+
+		case CaptureFrameKind::Received:
+		{
+			const std::string sender(frame.EntityId);
+			const GameMessageView message = GameMessageView::FromPacket(frame.Packet);
+
+			const Clock::time_point begin = Clock::now();
+			try
+			{
+				onlineManager->ProcessGameNetworkMessage(sender, message);
+			}
+			catch (const std::runtime_error& error)
+			{
+				DEBUGLOG("Replayed %s failed to decode: %s\n", MessageTypeString(message.MessageType()), error.what());
+				report.DecodeFailures++;
+			}
+			AddSample(report.Received[message.MessageType()], frame.Packet.size(), Clock::now() - begin);
+			break;
+		}
+		case CaptureFrameKind::Sent:
+			report.CapturedSentMessages++;
+			report.CapturedSentBytes += frame.Packet.size();
+			break;
+
+		case CaptureFrameKind::WorldUpdate:
+		{
+			const Clock::time_point begin = Clock::now();
+			g_game->UpdateWorld(frame.TotalTime, frame.ElapsedTime);
+			AddSample(report.WorldUpdates, 0, Clock::now() - begin);
+			break;
+		}
+		}
+
+		report.CaptureSeconds = frame.Time;
+	}
+
+	report.ReplaySeconds = std::chrono::duration<double>(Clock::now() - start).count();
+	report.ReplaySentMessages = onlineManager->GetReplaySentMessages();
+	report.ReplaySentBytes = onlineManager->GetReplaySentBytes();
+
+	onlineManager->EndReplay();
+	return report;
+}
+
+// The local player as Game::LocalPlayerInitialize makes it, without asking the platform who it is
+void TrafficReplayer::BeginSession(std::string_view localEntityId, bool isHost)
+{
+	const std::string entityId(localEntityId);
+	Managers::Get<OnlineManager>()->SetReplaySession(entityId, isHost);
+
+	auto& peers = g_game->GetPeers();
+	if (peers.find(entityId) == peers.end())
+	{
+		std::shared_ptr<PlayerState> localPlayer = std::make_shared<PlayerState>("Replay");
+		localPlayer->IsLocalPlayer = true;
+		localPlayer->InLobby = true;
+		localPlayer->EntityId = entityId;
+		g_game->AddPlayerToLobbyPeers(localPlayer);
+	}
+}
+
+void TrafficReplayer::Report::Log() const
+{
+	DEBUGLOG("Replayed %.1f s of capture in %.3f s, %u decode failures\n", CaptureSeconds, ReplaySeconds, DecodeFailures);
+	DEBUGLOG("%-36s %8s %10s %10s %10s\n", "received", "count", "bytes", "mean us", "max us");
+	for (const auto& [type, cost] : Received)
+	{
+		LogCost(MessageTypeString(type), cost);
+	}
+	LogCost("World update", WorldUpdates);
+	DEBUGLOG("sent: capture %llu messages, %llu bytes (%.0f bytes/s); replay %llu messages, %llu bytes (%.0f bytes/s)\n",
+		CapturedSentMessages,
+		CapturedSentBytes,
+		CaptureSeconds > 0.0 ? CapturedSentBytes / CaptureSeconds : 0.0,
+		ReplaySentMessages,
+		ReplaySentBytes,
+		CaptureSeconds > 0.0 ? ReplaySentBytes / CaptureSeconds : 0.0);
+}
@@ -0,0 +1,60 @@
+//--------------------------------------------------------------------------------------
+// TrafficReplayer.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+#include "TrafficCapture.h"
+
+namespace NetRumble
+{
+	// Feeds a capture back through PlayFabOnlineManager::ProcessGameNetworkMessage and
+	// Game::UpdateWorld in the order they happened, so a new build can be compared with the
+	// one that recorded it. Nothing is sent while replaying; the messages the replay would
+	// have sent are counted instead, next to the ones the capture sent.
+	class TrafficReplayer final
+	{
+	public:
+		struct MessageCost
+		{
+			uint64_t Count = 0;
+			uint64_t Bytes = 0;
+			double TotalMicroseconds = 0.0;
+			double MaxMicroseconds = 0.0;
+		};
+
+		struct Report
+		{
+			// Decode and dispatch cost of each received message type
+			std::map<GameMessageType, MessageCost> Received;
+			MessageCost WorldUpdates;
+			// Messages that threw while being decoded
+			uint32_t DecodeFailures = 0;
+
+			uint64_t CapturedSentMessages = 0;
+			uint64_t CapturedSentBytes = 0;
+			uint64_t ReplaySentMessages = 0;
+			uint64_t ReplaySentBytes = 0;
+
+			double CaptureSeconds = 0.0;
+			double ReplaySeconds = 0.0;
+
+			void Log() const;
+		};
+
+		explicit TrafficReplayer(const std::wstring& path);
+
+		TrafficReplayer(TrafficReplayer const&) = delete;
+		TrafficReplayer& operator= (TrafficReplayer const&) = delete;
+
+		// As fast as possible, or with each frame waiting for its time in the capture
+		Report Run(bool realtime);
+
+	private:
+		void BeginSession(std::string_view localEntityId, bool isHost);
+
+		TrafficCapture m_capture;
+	};
+}
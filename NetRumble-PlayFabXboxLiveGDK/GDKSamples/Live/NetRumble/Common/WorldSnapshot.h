@@ -0,0 +1,64 @@
+//--------------------------------------------------------------------------------------
+// WorldSnapshot.h
+//
+// Copyright (C) Microsoft Corporation. All rights reserved.
+//--------------------------------------------------------------------------------------
+
+#pragma once
+
+namespace NetRumble
+{
+	struct AsteroidSnapshot
+	{
+		DirectX::SimpleMath::Vector2 Position;
+		DirectX::SimpleMath::Vector2 Velocity;
+	};
+
+	// The asteroid state for one ServerUpdateWorldData packet, as the receivers will have rebuilt it.
+	struct WorldSnapshot
+	{
+		uint32_t Sequence = 0;
+		float Time = 0.0f;
+		std::vector<AsteroidSnapshot> Asteroids;
+
+		// Dead-reckon the asteroid forward to the given time.
+		AsteroidSnapshot Predict(size_t index, float time) const
+		{
+			const AsteroidSnapshot& asteroid = Asteroids[index];
+			return AsteroidSnapshot{ asteroid.Position + asteroid.Velocity * (time - Time), asteroid.Velocity };
+		}
+	};
+
+	// Ring of recently sent or received snapshots, looked up by sequence number.
+	// Sequence 0 is never stored, it means "no baseline" on the wire.
+	class WorldSnapshotHistory
+	{
+	public:
+		static constexpr uint32_t c_capacity = 32;
+
+		void Clear();
+		// Makes room in every snapshot for this many asteroids, so Add never allocates
+		void Reserve(size_t asteroids);
+		WorldSnapshot& Add(uint32_t sequence, float time);
+		const WorldSnapshot* Find(uint32_t sequence) const;
+
+	private:
+		std::array<WorldSnapshot, c_capacity> m_snapshots;
+	};
+
+	// Counts bytes over a rolling one second window.
+	class BandwidthMeter
+	{
+	public:
+		void AddBytes(size_t bytes) { m_bytesThisWindow += bytes; }
+		void Update(float elapsedTime);
+		void Reset();
+
+		float BytesPerSecond() const { return m_bytesPerSecond; }
+
+	private:
+		size_t m_bytesThisWindow = 0;
+		float m_windowTime = 0.0f;
+		float m_bytesPerSecond = 0.0f;
+	};
+}